@@ -5,10 +5,8 @@
 #include "Row.hpp"
 
 #include <isa_availability.h>
-#include <til/unicode.h>
 
 #include "textBuffer.hpp"
-#include "../../types/inc/GlyphWidth.hpp"
 
 // It would be nice to add checked array access in the future, but it's a little annoying to do so without impacting
 // performance (including Debug performance). Other languages are a little bit more ergonomic there than C++.
@@ -226,7 +224,7 @@ void ROW::Reset(const TextAttribute& attr) noexcept
     _chars = { _charsBuffer, _columnCount };
     // Constructing and then moving objects into place isn't free.
     // Modifying the existing object is _much_ faster.
-    *_attr.runs().unsafe_shrink_to_size(1) = til::rle_pair{ attr, _columnCount };
+    _attr.assign(_columnCount, attr);
     _lineRendition = LineRendition::SingleWidth;
     _wrapForced = false;
     _doubleBytePadded = false;
@@ -349,7 +347,7 @@ void ROW::_init() noexcept
 #pragma warning(push)
 }
 
-void ROW::TransferAttributes(const til::small_rle<TextAttribute, uint16_t, 1>& attr, til::CoordType newWidth)
+void ROW::TransferAttributes(const til::indexed_small_rle<TextAttribute, uint16_t, 1>& attr, til::CoordType newWidth)
 {
     _attr = attr;
     _attr.resize_trailing_extent(gsl::narrow<uint16_t>(newWidth));
@@ -550,6 +548,13 @@ void ROW::ReplaceAttributes(const til::CoordType beginIndex, const til::CoordTyp
     _attr.replace(_clampedColumnInclusive(beginIndex), _clampedColumnInclusive(endIndex), newAttr);
 }
 
+// Replaces the attributes of multiple ranges of columns in a single pass.
+// The ranges must be sorted and must not overlap.
+void ROW::ReplaceAttributes(const std::span<const til::rle_replacement<TextAttribute, uint16_t>> replacements)
+{
+    _attr.replace(replacements);
+}
+
 [[msvc::forceinline]] ROW::WriteHelper::WriteHelper(ROW& row, til::CoordType columnBegin, til::CoordType columnLimit, const std::wstring_view& chars) noexcept :
     row{ row },
     chars{ chars }
@@ -610,6 +615,42 @@ catch (...)
     }
 }
 
+// Writes each UTF-16 code unit in chars into its own column, starting at columnBegin.
+// Unlike ReplaceText() this doesn't measure the text. This matches the semantics of the
+// CHAR_INFO based console APIs where every cell is narrow unless explicitly marked as
+// being the leading or trailing half of a wide glyph and allows them to write entire
+// runs of cells at once instead of calling ReplaceCharacters() for each of them.
+void ROW::ReplaceNarrowCharacters(til::CoordType columnBegin, const std::wstring_view& chars)
+try
+{
+    WriteHelper h{ *this, columnBegin, _columnCount, chars };
+    if (!h.IsValid())
+    {
+        return;
+    }
+    h.ReplaceNarrowCharacters();
+    h.Finish();
+}
+catch (...)
+{
+    Reset(TextAttribute{});
+    throw;
+}
+
+[[msvc::forceinline]] void ROW::WriteHelper::ReplaceNarrowCharacters() noexcept
+{
+    const auto count = std::min<size_t>(chars.size(), colLimit - colBeg);
+    auto ch = chBeg;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        til::at(row._charOffsets, colEnd++) = ch++;
+    }
+
+    colEndDirty = colEnd;
+    charsConsumed = count;
+}
+
 void ROW::ReplaceText(RowWriteState& state)
 try
 {
@@ -655,8 +696,7 @@ catch (...)
     {
         if (*it >= 0x80) [[unlikely]]
         {
-            _replaceTextUnicode(ch, it);
-            return;
+            break;
         }
 
         til::at(row._charOffsets, colEnd) = gsl::narrow_cast<uint16_t>(ch);
@@ -665,42 +705,36 @@ catch (...)
         ++it;
     }
 
+    // Non-ASCII text may extend the preceding ASCII character into a longer grapheme cluster
+    // (e.g. "e" followed by U+0301 COMBINING ACUTE ACCENT). In that case we back up by one
+    // character and let the Unicode slow-path segment the text from there on.
+    if (it != chars.end() && *it >= 0x80) [[unlikely]]
+    {
+        if (it != chars.begin())
+        {
+            --colEnd;
+            --ch;
+            --it;
+        }
+        _replaceTextUnicode(ch, it);
+        return;
+    }
+
     colEndDirty = colEnd;
     charsConsumed = ch - chBeg;
 }
 
 [[msvc::forceinline]] void ROW::WriteHelper::_replaceTextUnicode(size_t ch, std::wstring_view::const_iterator it) noexcept
 {
-    const auto end = chars.end();
+    auto pos = gsl::narrow_cast<size_t>(it - chars.begin());
 
-    while (it != end)
+    while (pos != chars.size())
     {
-        unsigned int width = 1;
-        auto ptr = &*it;
-        const auto wch = *ptr;
-        size_t advance = 1;
-
-        ++it;
-
-        // Even in our slow-path we can avoid calling IsGlyphFullWidth if the current character is ASCII.
-        // It also allows us to skip the surrogate pair decoding at the same time.
-        if (wch >= 0x80)
-        {
-            if (til::is_surrogate(wch))
-            {
-                if (it != end && til::is_leading_surrogate(wch) && til::is_trailing_surrogate(*it))
-                {
-                    advance = 2;
-                    ++it;
-                }
-                else
-                {
-                    ptr = &UNICODE_REPLACEMENT;
-                }
-            }
-
-            width = IsGlyphFullWidth({ ptr, advance }) + 1u;
-        }
+        // Each grapheme cluster (UAX #29) gets stored in a single cell, together with its trailers if it's wide.
+        til::CoordType width = 1;
+        const auto next = TextBuffer::GraphemeNext(chars, pos, &width);
+        const auto advance = next - pos;
+        pos = next;
 
         const auto colEndNew = gsl::narrow_cast<uint16_t>(colEnd + width);
         if (colEndNew > colLimit)
@@ -710,6 +744,16 @@ catch (...)
             return;
         }
 
+        // Our offsets only have 15 bits. Finish() will keep the text after colEndNew (plus up to 1
+        // padding whitespace), so if the row would get longer than that we stop here, as if the row was full.
+        // The caller will then continue writing the remaining text into the next row.
+        if (ch + advance + 1 + row._charSize() - row._uncheckedCharOffset(colEndNew) > CharOffsetsMask) [[unlikely]]
+        {
+            colEndDirty = colEnd;
+            charsConsumed = ch - chBeg;
+            return;
+        }
+
         // Fill our char-offset buffer with 1 entry containing the mapping from the
         // current column (colEnd) to the start of the glyph in the string (ch)...
         til::at(row._charOffsets, colEnd++) = gsl::narrow_cast<uint16_t>(ch);
@@ -880,13 +924,16 @@ void ROW::_resizeChars(uint16_t colEndDirty, uint16_t chBegDirty, size_t chEndDi
     const auto currentLength = _charSize();
     const auto newLength = currentLength + diff;
 
+    // The offsets in _charOffsets are only 15 bits wide. The 16th bit is the CharOffsetsTrailer flag.
+    THROW_HR_IF(E_OUTOFMEMORY, newLength > CharOffsetsMask);
+
     if (newLength <= _chars.size())
     {
         std::copy_n(_chars.begin() + chEndDirtyOld, currentLength - chEndDirtyOld, _chars.begin() + chEndDirty);
     }
     else
     {
-        const auto minCapacity = std::min<size_t>(UINT16_MAX, _chars.size() + (_chars.size() >> 1));
+        const auto minCapacity = std::min<size_t>(CharOffsetsMask, _chars.size() + (_chars.size() >> 1));
         const auto newCapacity = gsl::narrow<uint16_t>(std::max(newLength, minCapacity));
 
         auto charsHeap = std::make_unique_for_overwrite<wchar_t[]>(newCapacity);
@@ -907,12 +954,12 @@ void ROW::_resizeChars(uint16_t colEndDirty, uint16_t chBegDirty, size_t chEndDi
     }
 }
 
-til::small_rle<TextAttribute, uint16_t, 1>& ROW::Attributes() noexcept
+til::indexed_small_rle<TextAttribute, uint16_t, 1>& ROW::Attributes() noexcept
 {
     return _attr;
 }
 
-const til::small_rle<TextAttribute, uint16_t, 1>& ROW::Attributes() const noexcept
+const til::indexed_small_rle<TextAttribute, uint16_t, 1>& ROW::Attributes() const noexcept
 {
     return _attr;
 }
@@ -1082,23 +1129,55 @@ til::CoordType ROW::GetTrailingColumnAtCharOffset(const ptrdiff_t offset) const
     return _createCharToColumnMapper(offset).GetTrailingColumnAt(offset);
 }
 
-DelimiterClass ROW::DelimiterClassAt(til::CoordType column, const std::wstring_view& wordDelimiters) const noexcept
+WordDelimiters::WordDelimiters(const std::wstring_view delimiters)
 {
-    const auto col = _clampedColumn(column);
-    // Safety: col is [0, _columnCount).
-    const auto glyph = _uncheckedChar(_uncheckedCharOffset(col));
-
-    if (glyph <= L' ')
+    for (const auto ch : delimiters)
     {
-        return DelimiterClass::ControlChar;
+        if (ch < 128)
+        {
+            til::at(_ascii, ch / 64) |= uint64_t{ 1 } << (ch % 64);
+        }
+        else
+        {
+            _other.push_back(ch);
+        }
     }
-    else if (wordDelimiters.find(glyph) != std::wstring_view::npos)
+
+    std::sort(_other.begin(), _other.end());
+    _other.erase(std::unique(_other.begin(), _other.end()), _other.end());
+}
+
+DelimiterClass WordDelimiters::Classify(const wchar_t ch) const noexcept
+{
+    if (ch <= L' ')
     {
-        return DelimiterClass::DelimiterChar;
+        return DelimiterClass::ControlChar;
     }
-    else
+
+    const auto isDelimiter = ch < 128 ?
+                                 ((til::at(_ascii, ch / 64) >> (ch % 64)) & 1) != 0 :
+                                 std::binary_search(_other.begin(), _other.end(), ch);
+    return isDelimiter ? DelimiterClass::DelimiterChar : DelimiterClass::RegularChar;
+}
+
+DelimiterClass ROW::DelimiterClassAt(til::CoordType column, const WordDelimiters& wordDelimiters) const noexcept
+{
+    const auto col = _clampedColumn(column);
+    // Safety: col is [0, _columnCount).
+    return wordDelimiters.Classify(_uncheckedChar(_uncheckedCharOffset(col)));
+}
+
+// Classifies the first classes.size() columns of this row (at most all of them) in one go.
+// Walking across a row this way is a lot cheaper than calling DelimiterClassAt() for each column.
+void ROW::DelimiterClasses(std::span<DelimiterClass> classes, const WordDelimiters& wordDelimiters) const noexcept
+{
+    const auto count = std::min<size_t>(classes.size(), _columnCount);
+    auto it = classes.begin();
+
+    // Safety: col is [0, _columnCount).
+    for (size_t col = 0; col < count; ++col, ++it)
     {
-        return DelimiterClass::RegularChar;
+        *it = wordDelimiters.Classify(_uncheckedChar(_uncheckedCharOffset(col)));
     }
 }
 
@@ -6,7 +6,6 @@
 #include "textBuffer.hpp"
 
 #include <til/hash.h>
-#include <til/unicode.h>
 
 #include "UTextAdapter.h"
 #include "../../types/inc/GlyphWidth.hpp"
@@ -40,6 +39,8 @@ static std::atomic<uint64_t> s_lastMutationIdInitialValue;
 // - cursorSize - The height of the cursor within this buffer
 // - isActiveBuffer - Whether this is the currently active buffer
 // - renderer - The renderer to use for triggering a redraw
+// - recycledBuffer - An optional buffer that is no longer needed. If it has the
+//   same dimensions, its memory is reused instead of allocating new memory.
 // Return Value:
 // - constructed object
 // Note: may throw exception
@@ -47,7 +48,8 @@ TextBuffer::TextBuffer(til::size screenBufferSize,
                        const TextAttribute defaultAttributes,
                        const UINT cursorSize,
                        const bool isActiveBuffer,
-                       Microsoft::Console::Render::Renderer& renderer) :
+                       Microsoft::Console::Render::Renderer& renderer,
+                       TextBuffer* const recycledBuffer) :
     _renderer{ renderer },
     _currentAttributes{ defaultAttributes },
     // This way every TextBuffer will start with a ""unique"" _lastMutationId
@@ -59,7 +61,10 @@ TextBuffer::TextBuffer(til::size screenBufferSize,
     // Guard against resizing the text buffer to 0 columns/rows, which would break being able to insert text.
     screenBufferSize.width = std::max(screenBufferSize.width, 1);
     screenBufferSize.height = std::max(screenBufferSize.height, 1);
-    _reserve(screenBufferSize, defaultAttributes);
+    if (!recycledBuffer || !_recycle(*recycledBuffer, screenBufferSize, defaultAttributes))
+    {
+        _reserve(screenBufferSize, defaultAttributes);
+    }
 }
 
 TextBuffer::~TextBuffer()
@@ -109,6 +114,7 @@ void TextBuffer::_reserve(til::size screenBufferSize, const TextAttribute& defau
     };
     _bufferEnd = _buffer.get() + allocSize;
     _commitWatermark = _buffer.get();
+    _recycleWatermark = _buffer.get();
     _initialAttributes = defaultAttributes;
     _bufferRowStride = rowStride;
     _bufferOffsetChars = rowSize;
@@ -117,6 +123,31 @@ void TextBuffer::_reserve(til::size screenBufferSize, const TextAttribute& defau
     _height = h;
 }
 
+// Takes over the memory arena of a buffer that's no longer needed, as long as it has the given dimensions.
+// This avoids the cost of reserving and committing memory and constructing the ROWs all over again,
+// which adds up for applications that frequently switch in and out of the alternate screen buffer.
+// The recycled buffer is left without an arena and must not be used for anything but destruction.
+bool TextBuffer::_recycle(TextBuffer& recycledBuffer, til::size screenBufferSize, const TextAttribute& defaultAttributes) noexcept
+{
+    if (!recycledBuffer._buffer || recycledBuffer._width != screenBufferSize.width || recycledBuffer._height != screenBufferSize.height)
+    {
+        return false;
+    }
+
+    // NOTE: Keep this in sync with _reserve().
+    _buffer = std::move(recycledBuffer._buffer);
+    _bufferEnd = recycledBuffer._bufferEnd;
+    _commitWatermark = _buffer.get();
+    _recycleWatermark = std::max(recycledBuffer._commitWatermark, recycledBuffer._recycleWatermark);
+    _initialAttributes = defaultAttributes;
+    _bufferRowStride = recycledBuffer._bufferRowStride;
+    _bufferOffsetChars = recycledBuffer._bufferOffsetChars;
+    _bufferOffsetCharOffsets = recycledBuffer._bufferOffsetCharOffsets;
+    _width = recycledBuffer._width;
+    _height = recycledBuffer._height;
+    return true;
+}
+
 // MEM_COMMITs the memory and constructs all ROWs up to and including the given row pointer.
 // It's expected that the caller verifies the parameter. It goes hand in hand with _getRowByOffsetDirect().
 //
@@ -128,6 +159,18 @@ __declspec(noinline) void TextBuffer::_commit(const std::byte* row)
     assert(row >= _commitWatermark);
 
     const auto rowEnd = row + _bufferRowStride;
+
+    // ROWs left behind by a recycled buffer only need their contents reset.
+    // We do this row by row, since an application may never use most of them.
+    for (; _commitWatermark < _recycleWatermark && _commitWatermark < rowEnd; _commitWatermark += _bufferRowStride)
+    {
+        reinterpret_cast<ROW*>(_commitWatermark)->Reset(_initialAttributes);
+    }
+    if (_commitWatermark >= rowEnd)
+    {
+        return;
+    }
+
     const auto remaining = gsl::narrow_cast<uintptr_t>(_bufferEnd - _commitWatermark);
     const auto minimum = gsl::narrow_cast<uintptr_t>(rowEnd - _commitWatermark);
     const auto ideal = minimum + _bufferRowStride * _commitReadAheadRowCount;
@@ -145,6 +188,7 @@ void TextBuffer::_decommit() noexcept
     _destroy();
     VirtualFree(_buffer.get(), 0, MEM_DECOMMIT);
     _commitWatermark = _buffer.get();
+    _recycleWatermark = _buffer.get();
 }
 
 // Constructs ROWs between [_commitWatermark,until).
@@ -159,10 +203,11 @@ void TextBuffer::_construct(const std::byte* until) noexcept
     }
 }
 
-// Destructs ROWs between [_buffer,_commitWatermark).
+// Destructs ROWs between [_buffer,_commitWatermark), as well as any recycled ROWs beyond that.
 void TextBuffer::_destroy() const noexcept
 {
-    for (auto it = _buffer.get(); it < _commitWatermark; it += _bufferRowStride)
+    const auto end = std::max(_commitWatermark, _recycleWatermark);
+    for (auto it = _buffer.get(); it < end; it += _bufferRowStride)
     {
         std::destroy_at(reinterpret_cast<ROW*>(it));
     }
@@ -406,18 +451,18 @@ void TextBuffer::_PrepareForDoubleByteSequence(const DbcsAttribute dbcsAttribute
 
 // Given the character offset `position` in the `chars` string, this function returns the starting position of the next grapheme.
 // For instance, given a `chars` of L"x\uD83D\uDE42y" and a `position` of 1 it'll return 3.
+// Graphemes are extended grapheme clusters as defined by UAX #29, so L"e\u0301" or an emoji ZWJ sequence are a single grapheme.
+// If `width` is given, it receives the number of columns the grapheme occupies.
 // GraphemePrev would do the exact inverse of this operation.
-// In the future, these functions are expected to also deliver information about how many columns a grapheme occupies.
-// (I know that mere UTF-16 code point iteration doesn't handle graphemes, but that's what we're working towards.)
-size_t TextBuffer::GraphemeNext(const std::wstring_view& chars, size_t position) noexcept
+size_t TextBuffer::GraphemeNext(const std::wstring_view& chars, size_t position, til::CoordType* width) noexcept
 {
-    return til::utf16_iterate_next(chars, position);
+    return GraphemeClusterNext(chars, position, width);
 }
 
 // It's the counterpart to GraphemeNext. See GraphemeNext.
-size_t TextBuffer::GraphemePrev(const std::wstring_view& chars, size_t position) noexcept
+size_t TextBuffer::GraphemePrev(const std::wstring_view& chars, size_t position, til::CoordType* width) noexcept
 {
-    return til::utf16_iterate_prev(chars, position);
+    return GraphemeClusterPrev(chars, position, width);
 }
 
 // Ever wondered how much space a piece of text needs before inserting it? This function will tell you!
@@ -444,43 +489,31 @@ size_t TextBuffer::FitTextIntoColumns(const std::wstring_view& chars, til::Coord
     {
     }
 
-    const auto dist = gsl::narrow_cast<size_t>(it - beg);
-    auto col = gsl::narrow_cast<til::CoordType>(dist);
-
-    if (it == asciiEnd) [[likely]]
+    // The fast-path result only holds if the next character doesn't extend the last ASCII character
+    // into a longer grapheme cluster (e.g. "e" followed by U+0301 COMBINING ACUTE ACCENT).
+    if (it == end || *it < 0x80) [[likely]]
     {
-        columns = col;
+        const auto dist = gsl::narrow_cast<size_t>(it - beg);
+        columns = gsl::narrow_cast<til::CoordType>(dist);
         return dist;
     }
 
     // Unicode slow-path where we need to count text and columns separately.
-    for (;;)
+    // Back up by one character, because it may be the base of the grapheme cluster that follows.
+    if (it != beg)
     {
-        auto ptr = &*it;
-        const auto wch = *ptr;
-        size_t len = 1;
+        --it;
+    }
 
-        col++;
+    auto pos = gsl::narrow_cast<size_t>(it - beg);
+    auto col = gsl::narrow_cast<til::CoordType>(pos);
 
-        // Even in our slow-path we can avoid calling IsGlyphFullWidth if the current character is ASCII.
-        // It also allows us to skip the surrogate pair decoding at the same time.
-        if (wch >= 0x80)
-        {
-            if (til::is_surrogate(wch))
-            {
-                const auto it2 = it + 1;
-                if (til::is_leading_surrogate(wch) && it2 != end && til::is_trailing_surrogate(*it2))
-                {
-                    len = 2;
-                }
-                else
-                {
-                    ptr = &UNICODE_REPLACEMENT;
-                }
-            }
+    for (;;)
+    {
+        til::CoordType width = 0;
+        const auto next = GraphemeNext(chars, pos, &width);
 
-            col += IsGlyphFullWidth({ ptr, len });
-        }
+        col += width;
 
         // If we ran out of columns, we need to always return `columnLimit` and not `cols`,
         // because if we tried inserting a wide glyph into just 1 remaining column it will
@@ -489,15 +522,15 @@ size_t TextBuffer::FitTextIntoColumns(const std::wstring_view& chars, til::Coord
         if (col > columnLimit)
         {
             columns = columnLimit;
-            return gsl::narrow_cast<size_t>(it - beg);
+            return pos;
         }
 
         // But if we simply ran out of text we just need to return the actual number of columns.
-        it += len;
-        if (it == end)
+        pos = next;
+        if (pos == chars.size())
         {
             columns = col;
-            return chars.size();
+            return pos;
         }
     }
 }
@@ -1213,6 +1246,7 @@ void TextBuffer::ResizeTraditional(til::size newSize)
     _buffer = std::move(newBuffer._buffer);
     _bufferEnd = newBuffer._bufferEnd;
     _commitWatermark = newBuffer._commitWatermark;
+    _recycleWatermark = newBuffer._recycleWatermark;
     _initialAttributes = newBuffer._initialAttributes;
     _bufferRowStride = newBuffer._bufferRowStride;
     _bufferOffsetChars = newBuffer._bufferOffsetChars;
@@ -1289,15 +1323,32 @@ void TextBuffer::TriggerNewTextNotification(const std::wstring_view newText)
 // Method Description:
 // - get delimiter class for buffer cell position
 // - used for double click selection and uia word navigation
+// - the classes of an entire row are computed at once and cached until a different row is requested
 // Arguments:
 // - pos: the buffer cell under observation
-// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// - cache: the precompiled word delimiters and the classes of the last row that was looked at
 // Return Value:
 // - the delimiter class for the given char
-DelimiterClass TextBuffer::_GetDelimiterClassAt(const til::point pos, const std::wstring_view wordDelimiters) const
+DelimiterClass TextBuffer::_GetDelimiterClassAt(const til::point pos, DelimiterClassCache& cache) const
 {
-    const auto realPos = ScreenToBufferPosition(pos);
-    return GetRowByOffset(realPos.y).DelimiterClassAt(realPos.x, wordDelimiters);
+    if (pos.y != cache.y)
+    {
+        const auto& row = GetRowByOffset(pos.y);
+        cache.classes.resize(row.size());
+        row.DelimiterClasses(cache.classes, cache.delimiters);
+        cache.y = pos.y;
+        cache.doubleWidth = row.GetLineRendition() != LineRendition::SingleWidth;
+    }
+
+    if (cache.classes.empty())
+    {
+        return DelimiterClass::ControlChar;
+    }
+
+    // Same as ScreenToBufferPosition() followed by the column clamping in ROW::DelimiterClassAt().
+    const auto x = pos.x >> (cache.doubleWidth ? 1 : 0);
+    const auto col = std::clamp<til::CoordType>(x, 0, gsl::narrow_cast<til::CoordType>(cache.classes.size() - 1));
+    return til::at(cache.classes, col);
 }
 
 // Method Description:
@@ -1344,13 +1395,14 @@ til::point TextBuffer::GetWordStart(const til::point target, const std::wstring_
         copy = limitOptional.value_or(bufferSize.BottomRightInclusive());
     }
 
+    DelimiterClassCache cache{ wordDelimiters };
     if (accessibilityMode)
     {
-        return _GetWordStartForAccessibility(copy, wordDelimiters);
+        return _GetWordStartForAccessibility(copy, cache);
     }
     else
     {
-        return _GetWordStartForSelection(copy, wordDelimiters);
+        return _GetWordStartForSelection(copy, cache);
     }
 }
 
@@ -1358,16 +1410,16 @@ til::point TextBuffer::GetWordStart(const til::point target, const std::wstring_
 // - Helper method for GetWordStart(). Get the til::point for the beginning of the word (accessibility definition) you are on
 // Arguments:
 // - target - a til::point on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - cache - the word delimiters and the delimiter classes of the last row that was looked at
 // Return Value:
 // - The til::point for the first character on the current/previous READABLE "word" (inclusive)
-til::point TextBuffer::_GetWordStartForAccessibility(const til::point target, const std::wstring_view wordDelimiters) const
+til::point TextBuffer::_GetWordStartForAccessibility(const til::point target, DelimiterClassCache& cache) const
 {
     auto result = target;
     const auto bufferSize = GetSize();
 
     // ignore left boundary. Continue until readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    while (_GetDelimiterClassAt(result, cache) != DelimiterClass::RegularChar)
     {
         if (result == bufferSize.Origin())
         {
@@ -1378,7 +1430,7 @@ til::point TextBuffer::_GetWordStartForAccessibility(const til::point target, co
     }
 
     // make sure we expand to the left boundary or the beginning of the word
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    while (_GetDelimiterClassAt(result, cache) == DelimiterClass::RegularChar)
     {
         if (result == bufferSize.Origin())
         {
@@ -1399,19 +1451,19 @@ til::point TextBuffer::_GetWordStartForAccessibility(const til::point target, co
 // - Helper method for GetWordStart(). Get the til::point for the beginning of the word (selection definition) you are on
 // Arguments:
 // - target - a til::point on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - cache - the word delimiters and the delimiter classes of the last row that was looked at
 // Return Value:
 // - The til::point for the first character on the current word or delimiter run (stopped by the left margin)
-til::point TextBuffer::_GetWordStartForSelection(const til::point target, const std::wstring_view wordDelimiters) const
+til::point TextBuffer::_GetWordStartForSelection(const til::point target, DelimiterClassCache& cache) const
 {
     auto result = target;
     const auto bufferSize = GetSize();
 
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
+    const auto initialDelimiter = _GetDelimiterClassAt(result, cache);
     const bool isControlChar = initialDelimiter == DelimiterClass::ControlChar;
 
     // expand left until we hit the left boundary or a different delimiter class
-    while (result != bufferSize.Origin() && _GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter)
+    while (result != bufferSize.Origin() && _GetDelimiterClassAt(result, cache) == initialDelimiter)
     {
         //prevent selection wrapping on whitespace selection
         if (isControlChar && result.x == bufferSize.Left())
@@ -1421,7 +1473,7 @@ til::point TextBuffer::_GetWordStartForSelection(const til::point target, const
         bufferSize.DecrementInBounds(result);
     }
 
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
+    if (_GetDelimiterClassAt(result, cache) != initialDelimiter)
     {
         // move off of delimiter
         bufferSize.IncrementInBounds(result);
@@ -1461,13 +1513,14 @@ til::point TextBuffer::GetWordEnd(const til::point target, const std::wstring_vi
         return target;
     }
 
+    DelimiterClassCache cache{ wordDelimiters };
     if (accessibilityMode)
     {
-        return _GetWordEndForAccessibility(target, wordDelimiters, limit);
+        return _GetWordEndForAccessibility(target, cache, limit);
     }
     else
     {
-        return _GetWordEndForSelection(target, wordDelimiters);
+        return _GetWordEndForSelection(target, cache);
     }
 }
 
@@ -1475,11 +1528,11 @@ til::point TextBuffer::GetWordEnd(const til::point target, const std::wstring_vi
 // - Helper method for GetWordEnd(). Get the til::point for the beginning of the next READABLE word
 // Arguments:
 // - target - a til::point on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - cache - the word delimiters and the delimiter classes of the last row that was looked at
 // - limit - the last "valid" position in the text buffer (to improve performance)
 // Return Value:
 // - The til::point for the first character of the next readable "word". If no next word, return one past the end of the buffer
-til::point TextBuffer::_GetWordEndForAccessibility(const til::point target, const std::wstring_view wordDelimiters, const til::point limit) const
+til::point TextBuffer::_GetWordEndForAccessibility(const til::point target, DelimiterClassCache& cache, const til::point limit) const
 {
     const auto bufferSize{ GetSize() };
     auto result{ target };
@@ -1495,13 +1548,13 @@ til::point TextBuffer::_GetWordEndForAccessibility(const til::point target, cons
     }
     else
     {
-        while (result != limit && result != bufferSize.BottomRightInclusive() && _GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+        while (result != limit && result != bufferSize.BottomRightInclusive() && _GetDelimiterClassAt(result, cache) == DelimiterClass::RegularChar)
         {
             // Iterate through readable text
             bufferSize.IncrementInBounds(result);
         }
 
-        while (result != limit && result != bufferSize.BottomRightInclusive() && _GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+        while (result != limit && result != bufferSize.BottomRightInclusive() && _GetDelimiterClassAt(result, cache) != DelimiterClass::RegularChar)
         {
             // expand to the beginning of the NEXT word
             bufferSize.IncrementInBounds(result);
@@ -1522,19 +1575,19 @@ til::point TextBuffer::_GetWordEndForAccessibility(const til::point target, cons
 // - Helper method for GetWordEnd(). Get the til::point for the beginning of the NEXT word
 // Arguments:
 // - target - a til::point on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - cache - the word delimiters and the delimiter classes of the last row that was looked at
 // Return Value:
 // - The til::point for the last character of the current word or delimiter run (stopped by right margin)
-til::point TextBuffer::_GetWordEndForSelection(const til::point target, const std::wstring_view wordDelimiters) const
+til::point TextBuffer::_GetWordEndForSelection(const til::point target, DelimiterClassCache& cache) const
 {
     const auto bufferSize = GetSize();
 
     auto result = target;
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
+    const auto initialDelimiter = _GetDelimiterClassAt(result, cache);
     const bool isControlChar = initialDelimiter == DelimiterClass::ControlChar;
 
     // expand right until we hit the right boundary as a ControlChar or a different delimiter class
-    while (result != bufferSize.BottomRightInclusive() && _GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter)
+    while (result != bufferSize.BottomRightInclusive() && _GetDelimiterClassAt(result, cache) == initialDelimiter)
     {
         if (isControlChar && result.x == bufferSize.RightInclusive())
         {
@@ -1543,7 +1596,7 @@ til::point TextBuffer::_GetWordEndForSelection(const til::point target, const st
         bufferSize.IncrementInBoundsCircular(result);
     }
 
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
+    if (_GetDelimiterClassAt(result, cache) != initialDelimiter)
     {
         // move off of delimiter
         bufferSize.DecrementInBounds(result);
@@ -1614,7 +1667,8 @@ bool TextBuffer::MoveToNextWord(til::point& pos, const std::wstring_view wordDel
     //       This is also the inclusive start of the next word.
     const auto bufferSize{ GetSize() };
     const auto limit{ limitOptional.value_or(bufferSize.EndExclusive()) };
-    const auto copy{ _GetWordEndForAccessibility(pos, wordDelimiters, limit) };
+    DelimiterClassCache cache{ wordDelimiters };
+    const auto copy{ _GetWordEndForAccessibility(pos, cache, limit) };
 
     if (bufferSize.CompareInBounds(copy, limit, true) >= 0)
     {
@@ -1785,6 +1839,95 @@ bool TextBuffer::MoveToPreviousGlyph(til::point& pos, std::optional<til::point>
     return success;
 }
 
+// Method Description:
+// - Moves pos by up to count glyphs. This is equivalent to calling MoveToNextGlyph() or MoveToPreviousGlyph()
+//   count times, but reads the glyph boundaries directly off each row instead of creating a cell iterator
+//   for every single step. Only steps that cross a row boundary take the slow path.
+// Arguments:
+// - pos - the position to move from
+// - count - the number of glyphs to move. Positive values move forward, negative values move backward.
+// - allowExclusiveEnd - allow result to be the exclusive limit (one past limit). Only used when moving forward.
+// - limitOptional - (optional) the last possible position in the buffer that can be explored.
+// Return Value:
+// - the number of glyphs pos was moved by (negative when moving backward)
+// - pos - The til::point for the first cell of the glyph we stopped on (inclusive)
+til::CoordType TextBuffer::MoveByGlyphs(til::point& pos, const til::CoordType count, bool allowExclusiveEnd, std::optional<til::point> limitOptional) const
+{
+    const auto bufferSize = GetSize();
+    const auto limit{ limitOptional.value_or(bufferSize.EndExclusive()) };
+    const auto rightInclusive = bufferSize.RightInclusive();
+    const auto bottomInclusive = bufferSize.BottomInclusive();
+    til::CoordType moved = 0;
+
+    const ROW* row = nullptr;
+    til::CoordType rowY = -1;
+    const auto getRow = [&](const til::CoordType y) -> const ROW& {
+        if (y != rowY)
+        {
+            row = &GetRowByOffset(y);
+            rowY = y;
+        }
+        return *row;
+    };
+
+    while (moved < count)
+    {
+        const auto distanceToLimit{ bufferSize.CompareInBounds(pos, limit, true) };
+        if (distanceToLimit >= 0)
+        {
+            pos = limit;
+            break;
+        }
+        if (!allowExclusiveEnd && distanceToLimit == -1)
+        {
+            break;
+        }
+
+        if (pos.x < rightInclusive)
+        {
+            const auto x = getRow(pos.y).NavigateToNext(pos.x);
+            if (x <= rightInclusive)
+            {
+                pos.x = x;
+                ++moved;
+                continue;
+            }
+        }
+
+        if (!MoveToNextGlyph(pos, allowExclusiveEnd, limit))
+        {
+            break;
+        }
+        ++moved;
+    }
+
+    while (moved > count)
+    {
+        if (pos.x > 0 && pos.y <= bottomInclusive && bufferSize.CompareInBounds(pos, limit, true) <= 0)
+        {
+            auto x = pos.x - 1;
+            if (getRow(pos.y).DbcsAttrAt(x) == DbcsAttribute::Leading)
+            {
+                --x;
+            }
+            if (x >= 0)
+            {
+                pos.x = x;
+                --moved;
+                continue;
+            }
+        }
+
+        if (!MoveToPreviousGlyph(pos, limit))
+        {
+            break;
+        }
+        --moved;
+    }
+
+    return moved;
+}
+
 // Method Description:
 // - Determines the line-by-line rectangles based on two COORDs
 // - expands the rectangles to support wide glyphs
@@ -2075,40 +2218,134 @@ std::wstring TextBuffer::GetPlainText(const CopyRequest& req) const
     return selectedText;
 }
 
+TextBuffer::CopyDeadline::CopyDeadline(const std::chrono::milliseconds timeout) :
+    _timer{ CreateThreadpoolTimer(&_timerCallback, &_stopSource, nullptr) }
+{
+    THROW_LAST_ERROR_IF(!_timer);
+
+    // A negative due time is relative to now, in 100ns units.
+    const auto dueTime = -std::chrono::duration_cast<std::chrono::duration<int64_t, std::ratio<1, 10000000>>>(timeout).count();
+    FILETIME ft;
+    memcpy(&ft, &dueTime, sizeof(ft));
+    SetThreadpoolTimerEx(_timer.get(), &ft, 0, 0);
+}
+
+std::stop_token TextBuffer::CopyDeadline::get_token() const noexcept
+{
+    return _stopSource.get_token();
+}
+
+void __stdcall TextBuffer::CopyDeadline::_timerCallback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PTP_TIMER /*timer*/) noexcept
+{
+    static_cast<std::stop_source*>(context)->request_stop();
+}
+
 // Routine Description:
-// - Generates a CF_HTML compliant structure from the selected region of the buffer
+// - Retrieves the plain text of the selected region and, optionally, its HTML and RTF representations.
+// - All of them are generated in a single pass over the selection: Each row is visited once, and the colors
+//   of each attribute are resolved once per copy instead of once per run.
 // Arguments:
 // - req - the copy request having the bounds of the selected region and other related configuration flags.
-// - fontHeightPoints - the unscaled font height
-// - fontFaceName - the name of the font used
-// - backgroundColor - default background color for characters, also used in padding
-// - isIntenseBold - true if being intense is treated as being bold
+// - formatting - the font and default colors to use, and which of the formatted representations to generate.
 // - GetAttributeColors - function to get the colors of the text attributes as they're rendered
+// - stopToken - (optional) allows a huge copy to be abandoned midway, in which case the result is empty.
 // Return Value:
-// - string containing the generated HTML. Empty if the copy request is invalid.
-std::string TextBuffer::GenHTML(const CopyRequest& req,
-                                const int fontHeightPoints,
-                                const std::wstring_view fontFaceName,
-                                const COLORREF backgroundColor,
-                                const bool isIntenseBold,
-                                std::function<std::tuple<COLORREF, COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors) const noexcept
+// - The generated plain text, HTML and RTF. Empty if the copy request is invalid or got cancelled.
+TextBuffer::CopyData TextBuffer::GenCopyData(const CopyRequest& req,
+                                             const CopyFormatting& formatting,
+                                             const GetAttributeColorsFn& GetAttributeColors,
+                                             const std::stop_token& stopToken) const
 {
     // GH#5347 - Don't provide a title for the generated HTML, as many
     // web applications will paste the title first, followed by the HTML
     // content, which is unexpected.
 
+    CopyData data;
+
     if (req.beg > req.end)
     {
-        return {};
+        return data;
     }
 
-    try
+    // Reserve enough for the common case up front, so that we don't spend
+    // most of a large copy reallocating (and temporarily doubling) the outputs.
+    const auto rowCount = gsl::narrow_cast<size_t>(req.end.y - req.beg.y + 1);
+    const auto plainCapacity = rowCount * (gsl::narrow_cast<size_t>(_width) + 2);
+    data.plainText.reserve(plainCapacity);
+
+    // Most copies only contain a handful of different attributes. Caching their colors avoids
+    // calling GetAttributeColors (which usually goes through the RenderSettings) for every run.
+    struct CachedColors
     {
-        std::string htmlBuilder;
+        TextAttribute attr;
+        std::tuple<COLORREF, COLORREF, COLORREF> colors;
+    };
+    static constexpr size_t colorCacheSize = 16;
+    til::small_vector<CachedColors, colorCacheSize> colorCache;
+    size_t colorCacheNext = 0;
+    const auto getAttributeColors = [&](const TextAttribute& attr) {
+        for (const auto& entry : colorCache)
+        {
+            if (entry.attr == attr)
+            {
+                return entry.colors;
+            }
+        }
+
+        auto colors = GetAttributeColors(attr);
+        if (colorCache.size() < colorCacheSize)
+        {
+            colorCache.emplace_back(attr, colors);
+        }
+        else
+        {
+            colorCache[colorCacheNext] = { attr, colors };
+            colorCacheNext = (colorCacheNext + 1) % colorCacheSize;
+        }
+        return colors;
+    };
+
+    // once filled with values, there will be exactly 157 bytes in the clipboard header
+    constexpr size_t ClipboardHeaderSize = 157;
+    constexpr std::string_view htmlHeader = "<!DOCTYPE><HTML><HEAD></HEAD><BODY>";
+    constexpr std::string_view htmlFooter = "</BODY></HTML>";
+    std::string& htmlBuilder = data.html;
+    std::string utf8Text;
+
+    // map to keep track of colors:
+    // keys are colors represented by COLORREF
+    // values are indices of the corresponding colors in the color table
+    std::unordered_map<COLORREF, size_t> colorMap;
+    // RTF color table
+    std::string colorTableBuilder;
+    // RTF content
+    std::string contentBuilder;
+
+    const auto getColorTableIndex = [&](const COLORREF color) -> size_t {
+        // Exclude the 0 index for the default color, and start with 1.
+
+        const auto [it, inserted] = colorMap.emplace(color, colorMap.size() + 1);
+        if (inserted)
+        {
+            const auto red = static_cast<int>(GetRValue(color));
+            const auto green = static_cast<int>(GetGValue(color));
+            const auto blue = static_cast<int>(GetBValue(color));
+            fmt::format_to(std::back_inserter(colorTableBuilder), FMT_COMPILE("\\red{}\\green{}\\blue{};"), red, green, blue);
+        }
+        return it->second;
+    };
+
+    if (formatting.html)
+    {
+        // Markup usually ends up a couple times larger than the text it describes.
+        htmlBuilder.reserve(ClipboardHeaderSize + 4 * plainCapacity);
+
+        // The clipboard header goes first, but we only know its contents once we're done.
+        // Reserve space for it now and fill it in at the end, instead of prepending it later.
+        htmlBuilder.append(ClipboardHeaderSize, ' ');
 
         // First we have to add some standard HTML boiler plate required for
         // CF_HTML as part of the HTML Clipboard format
-        constexpr std::string_view htmlHeader = "<!DOCTYPE><HTML><HEAD></HEAD><BODY>";
         htmlBuilder += htmlHeader;
 
         htmlBuilder += "<!--StartFragment -->";
@@ -2118,12 +2355,12 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
             htmlBuilder += "<DIV STYLE=\"";
             htmlBuilder += "display:inline-block;";
             htmlBuilder += "white-space:pre;";
-            fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("background-color:{};"), Utils::ColorToHexString(backgroundColor));
+            fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("background-color:{};"), Utils::ColorToHexString(formatting.backgroundColor));
 
             // even with different font, add monospace as fallback
-            fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("font-family:'{}',monospace;"), til::u16u8(fontFaceName));
+            fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("font-family:'{}',monospace;"), til::u16u8(formatting.fontFaceName));
 
-            fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("font-size:{}pt;"), fontHeightPoints);
+            fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("font-size:{}pt;"), formatting.fontHeightPoints);
 
             // note: MS Word doesn't support padding (in this way at least)
             // todo: customizable padding
@@ -2131,24 +2368,84 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
 
             htmlBuilder += "\">";
         }
+    }
+
+    if (formatting.rtf)
+    {
+        contentBuilder.reserve(4 * plainCapacity);
+        colorTableBuilder += "{\\colortbl ;";
 
-        for (auto iRow = req.beg.y; iRow <= req.end.y; ++iRow)
+        // \viewkindN: View mode of the document to be used. N=4 specifies that the document is in Normal view. (maybe unnecessary?)
+        // \ucN: Number of unicode fallback characters after each codepoint. (global)
+        contentBuilder += "\\viewkind4\\uc1";
+
+        // paragraph styles
+        // \pard: paragraph description
+        // \slmultN: line-spacing multiple
+        // \fN: font to be used for the paragraph, where N is the font index in the font table
+        contentBuilder += "\\pard\\slmult1\\f0";
+
+        // \fsN: specifies font size in half-points. E.g. \fs20 results in a font
+        // size of 10 pts. That's why, font size is multiplied by 2 here.
+        fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\fs{}"), 2 * formatting.fontHeightPoints);
+
+        // Set the background color for the page. But the standard way (\cbN) to do
+        // this isn't supported in Word. However, the following control words sequence
+        // works in Word (and other RTF editors also) for applying the text background
+        // color. See: Spec 1.9.1, Pg. 23.
+        fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\chshdng0\\chcbpat{}"), getColorTableIndex(formatting.backgroundColor));
+    }
+
+    for (auto iRow = req.beg.y; iRow <= req.end.y; ++iRow)
+    {
+        if (stopToken.stop_requested())
         {
-            const auto& row = GetRowByOffset(iRow);
-            const auto [rowBeg, rowEnd, addLineBreak] = _RowCopyHelper(req, iRow, row);
-            const auto rowBegU16 = gsl::narrow_cast<uint16_t>(rowBeg);
-            const auto rowEndU16 = gsl::narrow_cast<uint16_t>(rowEnd);
-            const auto runs = row.Attributes().slice(rowBegU16, rowEndU16).runs();
+            return {};
+        }
 
-            auto x = rowBegU16;
-            for (const auto& [attr, length] : runs)
+        const auto& row = GetRowByOffset(iRow);
+        const auto [rowBeg, rowEnd, addLineBreak] = _RowCopyHelper(req, iRow, row);
+        // never add line break to the last row.
+        const auto lineBreak = addLineBreak && iRow < req.end.y;
+
+        // save selected text
+        data.plainText += row.GetText(rowBeg, rowEnd);
+        if (lineBreak)
+        {
+            data.plainText += L"\r\n";
+        }
+
+        if (!formatting.html && !formatting.rtf)
+        {
+            continue;
+        }
+
+        // Walk the attribute runs that intersect with [rowBeg, rowEnd).
+        til::CoordType runEnd = 0;
+        for (const auto& [attr, length] : row.Attributes().runs())
+        {
+            const auto runBeg = runEnd;
+            runEnd += length;
+            if (runEnd <= rowBeg)
+            {
+                continue;
+            }
+            if (runBeg >= rowEnd)
+            {
+                break;
+            }
+
+            const auto x = std::max(runBeg, rowBeg);
+            const auto nextX = std::min(runEnd, rowEnd);
+            const auto text = row.GetText(x, nextX);
+            const auto [fg, bg, ul] = getAttributeColors(attr);
+            const auto ulStyle = attr.GetUnderlineStyle();
+
+            if (formatting.html)
             {
-                const auto nextX = gsl::narrow_cast<uint16_t>(x + length);
-                const auto [fg, bg, ul] = GetAttributeColors(attr);
                 const auto fgHex = Utils::ColorToHexString(fg);
                 const auto bgHex = Utils::ColorToHexString(bg);
                 const auto ulHex = Utils::ColorToHexString(ul);
-                const auto ulStyle = attr.GetUnderlineStyle();
                 const auto isUnderlined = ulStyle != UnderlineStyle::NoUnderline;
                 const auto isCrossedOut = attr.IsCrossedOut();
                 const auto isOverlined = attr.IsOverlined();
@@ -2157,7 +2454,7 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
                 fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("color:{};"), fgHex);
                 fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("background-color:{};"), bgHex);
 
-                if (isIntenseBold && attr.IsIntense())
+                if (formatting.isIntenseBold && attr.IsIntense())
                 {
                     htmlBuilder += "font-weight:bold;";
                 }
@@ -2210,25 +2507,8 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
                 htmlBuilder += "\">";
 
                 // text
-                std::string unescapedText;
-                THROW_IF_FAILED(til::u16u8(row.GetText(x, nextX), unescapedText));
-                for (const auto c : unescapedText)
-                {
-                    switch (c)
-                    {
-                    case '<':
-                        htmlBuilder += "&lt;";
-                        break;
-                    case '>':
-                        htmlBuilder += "&gt;";
-                        break;
-                    case '&':
-                        htmlBuilder += "&amp;";
-                        break;
-                    default:
-                        htmlBuilder += c;
-                    }
-                }
+                THROW_IF_FAILED(til::u16u8(text, utf8Text));
+                _AppendHTMLText(htmlBuilder, utf8Text);
 
                 if (isUnderlined)
                 {
@@ -2237,168 +2517,13 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
                 }
 
                 htmlBuilder += "</SPAN>";
-
-                // advance to next run of text
-                x = nextX;
             }
 
-            // never add line break to the last row.
-            if (addLineBreak && iRow < req.end.y)
+            if (formatting.rtf)
             {
-                htmlBuilder += "<BR>";
-            }
-        }
-
-        htmlBuilder += "</DIV>";
-
-        htmlBuilder += "<!--EndFragment -->";
-
-        constexpr std::string_view HtmlFooter = "</BODY></HTML>";
-        htmlBuilder += HtmlFooter;
-
-        // once filled with values, there will be exactly 157 bytes in the clipboard header
-        constexpr size_t ClipboardHeaderSize = 157;
-
-        // these values are byte offsets from start of clipboard
-        const auto htmlStartPos = ClipboardHeaderSize;
-        const auto htmlEndPos = ClipboardHeaderSize + gsl::narrow<size_t>(htmlBuilder.length());
-        const auto fragStartPos = ClipboardHeaderSize + gsl::narrow<size_t>(htmlHeader.length());
-        const auto fragEndPos = htmlEndPos - HtmlFooter.length();
-
-        // header required by HTML 0.9 format
-        std::string clipHeaderBuilder;
-        clipHeaderBuilder += "Version:0.9\r\n";
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("StartHTML:{:0>10}\r\n"), htmlStartPos);
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("EndHTML:{:0>10}\r\n"), htmlEndPos);
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("StartFragment:{:0>10}\r\n"), fragStartPos);
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("EndFragment:{:0>10}\r\n"), fragEndPos);
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("StartSelection:{:0>10}\r\n"), fragStartPos);
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("EndSelection:{:0>10}\r\n"), fragEndPos);
-
-        return clipHeaderBuilder + htmlBuilder;
-    }
-    catch (...)
-    {
-        LOG_HR(wil::ResultFromCaughtException());
-        return {};
-    }
-}
-
-// Routine Description:
-// - Generates an RTF document from the selected region of the buffer
-//   RTF 1.5 Spec: https://www.biblioscape.com/rtf15_spec.htm
-//   RTF 1.9.1 Spec: https://msopenspecs.azureedge.net/files/Archive_References/[MSFT-RTF].pdf
-// Arguments:
-// - req - the copy request having the bounds of the selected region and other related configuration flags.
-// - fontHeightPoints - the unscaled font height
-// - fontFaceName - the name of the font used
-// - backgroundColor - default background color for characters, also used in padding
-// - isIntenseBold - true if being intense is treated as being bold
-// - GetAttributeColors - function to get the colors of the text attributes as they're rendered
-// Return Value:
-// - string containing the generated RTF. Empty if the copy request is invalid.
-std::string TextBuffer::GenRTF(const CopyRequest& req,
-                               const int fontHeightPoints,
-                               const std::wstring_view fontFaceName,
-                               const COLORREF backgroundColor,
-                               const bool isIntenseBold,
-                               std::function<std::tuple<COLORREF, COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors) const noexcept
-{
-    if (req.beg > req.end)
-    {
-        return {};
-    }
-
-    try
-    {
-        std::string rtfBuilder;
-
-        // start rtf
-        rtfBuilder += "{";
-
-        // Standard RTF header.
-        // This is similar to the header generated by WordPad.
-        // \ansi:
-        //   Specifies that the ANSI char set is used in the current doc.
-        // \ansicpg1252:
-        //   Represents the ANSI code page which is used to perform
-        //   the Unicode to ANSI conversion when writing RTF text.
-        // \deff0:
-        //   Specifies that the default font for the document is the one
-        //   at index 0 in the font table.
-        // \nouicompat:
-        //   Some features are blocked by default to maintain compatibility
-        //   with older programs (Eg. Word 97-2003). `nouicompat` disables this
-        //   behavior, and unblocks these features. See: Spec 1.9.1, Pg. 51.
-        rtfBuilder += "\\rtf1\\ansi\\ansicpg1252\\deff0\\nouicompat";
-
-        // font table
-        // Brace escape: add an extra brace (of same kind) after a brace to escape it within the format string.
-        fmt::format_to(std::back_inserter(rtfBuilder), FMT_COMPILE("{{\\fonttbl{{\\f0\\fmodern\\fcharset0 {};}}}}"), til::u16u8(fontFaceName));
-
-        // map to keep track of colors:
-        // keys are colors represented by COLORREF
-        // values are indices of the corresponding colors in the color table
-        std::unordered_map<COLORREF, size_t> colorMap;
-
-        // RTF color table
-        std::string colorTableBuilder;
-        colorTableBuilder += "{\\colortbl ;";
-
-        const auto getColorTableIndex = [&](const COLORREF color) -> size_t {
-            // Exclude the 0 index for the default color, and start with 1.
-
-            const auto [it, inserted] = colorMap.emplace(color, colorMap.size() + 1);
-            if (inserted)
-            {
-                const auto red = static_cast<int>(GetRValue(color));
-                const auto green = static_cast<int>(GetGValue(color));
-                const auto blue = static_cast<int>(GetBValue(color));
-                fmt::format_to(std::back_inserter(colorTableBuilder), FMT_COMPILE("\\red{}\\green{}\\blue{};"), red, green, blue);
-            }
-            return it->second;
-        };
-
-        // content
-        std::string contentBuilder;
-
-        // \viewkindN: View mode of the document to be used. N=4 specifies that the document is in Normal view. (maybe unnecessary?)
-        // \ucN: Number of unicode fallback characters after each codepoint. (global)
-        contentBuilder += "\\viewkind4\\uc1";
-
-        // paragraph styles
-        // \pard: paragraph description
-        // \slmultN: line-spacing multiple
-        // \fN: font to be used for the paragraph, where N is the font index in the font table
-        contentBuilder += "\\pard\\slmult1\\f0";
-
-        // \fsN: specifies font size in half-points. E.g. \fs20 results in a font
-        // size of 10 pts. That's why, font size is multiplied by 2 here.
-        fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\fs{}"), 2 * fontHeightPoints);
-
-        // Set the background color for the page. But the standard way (\cbN) to do
-        // this isn't supported in Word. However, the following control words sequence
-        // works in Word (and other RTF editors also) for applying the text background
-        // color. See: Spec 1.9.1, Pg. 23.
-        fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\chshdng0\\chcbpat{}"), getColorTableIndex(backgroundColor));
-
-        for (auto iRow = req.beg.y; iRow <= req.end.y; ++iRow)
-        {
-            const auto& row = GetRowByOffset(iRow);
-            const auto [rowBeg, rowEnd, addLineBreak] = _RowCopyHelper(req, iRow, row);
-            const auto rowBegU16 = gsl::narrow_cast<uint16_t>(rowBeg);
-            const auto rowEndU16 = gsl::narrow_cast<uint16_t>(rowEnd);
-            const auto runs = row.Attributes().slice(rowBegU16, rowEndU16).runs();
-
-            auto x = rowBegU16;
-            for (auto& [attr, length] : runs)
-            {
-                const auto nextX = gsl::narrow_cast<uint16_t>(x + length);
-                const auto [fg, bg, ul] = GetAttributeColors(attr);
                 const auto fgIdx = getColorTableIndex(fg);
                 const auto bgIdx = getColorTableIndex(bg);
                 const auto ulIdx = getColorTableIndex(ul);
-                const auto ulStyle = attr.GetUnderlineStyle();
 
                 // start an RTF group that can be closed later to restore the
                 // default attribute.
@@ -2407,7 +2532,7 @@ std::string TextBuffer::GenRTF(const CopyRequest& req,
                 fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\cf{}"), fgIdx);
                 fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\chshdng0\\chcbpat{}"), bgIdx);
 
-                if (isIntenseBold && attr.IsIntense())
+                if (formatting.isIntenseBold && attr.IsIntense())
                 {
                     contentBuilder += "\\b";
                 }
@@ -2449,35 +2574,190 @@ std::string TextBuffer::GenRTF(const CopyRequest& req,
                 // be interpreted as part of the last command, and will be lost.
                 contentBuilder += " ";
 
-                const auto unescapedText = row.GetText(x, nextX); // including character at nextX
-                _AppendRTFText(contentBuilder, unescapedText);
+                _AppendRTFText(contentBuilder, text);
 
                 contentBuilder += "}"; // close RTF group
-
-                // advance to next run of text
-                x = nextX;
             }
+        }
 
-            // never add line break to the last row.
-            if (addLineBreak && iRow < req.end.y)
+        if (lineBreak)
+        {
+            if (formatting.html)
+            {
+                htmlBuilder += "<BR>";
+            }
+            if (formatting.rtf)
             {
                 contentBuilder += "\\line";
             }
         }
+    }
+
+    if (formatting.html)
+    {
+        htmlBuilder += "</DIV>";
+
+        htmlBuilder += "<!--EndFragment -->";
+
+        htmlBuilder += htmlFooter;
+
+        // these values are byte offsets from start of clipboard
+        const auto htmlStartPos = ClipboardHeaderSize;
+        const auto htmlEndPos = gsl::narrow<size_t>(htmlBuilder.length());
+        const auto fragStartPos = ClipboardHeaderSize + htmlHeader.length();
+        const auto fragEndPos = htmlEndPos - htmlFooter.length();
+
+        // header required by HTML 0.9 format
+        std::string clipHeaderBuilder;
+        clipHeaderBuilder += "Version:0.9\r\n";
+        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("StartHTML:{:0>10}\r\n"), htmlStartPos);
+        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("EndHTML:{:0>10}\r\n"), htmlEndPos);
+        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("StartFragment:{:0>10}\r\n"), fragStartPos);
+        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("EndFragment:{:0>10}\r\n"), fragEndPos);
+        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("StartSelection:{:0>10}\r\n"), fragStartPos);
+        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("EndSelection:{:0>10}\r\n"), fragEndPos);
+
+        assert(clipHeaderBuilder.size() == ClipboardHeaderSize);
+        htmlBuilder.replace(0, ClipboardHeaderSize, clipHeaderBuilder);
+    }
+
+    if (formatting.rtf)
+    {
+        std::string& rtfBuilder = data.rtf;
+        rtfBuilder.reserve(256 + colorTableBuilder.size() + contentBuilder.size());
+
+        // start rtf
+        rtfBuilder += "{";
+
+        // Standard RTF header.
+        // This is similar to the header generated by WordPad.
+        // \ansi:
+        //   Specifies that the ANSI char set is used in the current doc.
+        // \ansicpg1252:
+        //   Represents the ANSI code page which is used to perform
+        //   the Unicode to ANSI conversion when writing RTF text.
+        // \deff0:
+        //   Specifies that the default font for the document is the one
+        //   at index 0 in the font table.
+        // \nouicompat:
+        //   Some features are blocked by default to maintain compatibility
+        //   with older programs (Eg. Word 97-2003). `nouicompat` disables this
+        //   behavior, and unblocks these features. See: Spec 1.9.1, Pg. 51.
+        rtfBuilder += "\\rtf1\\ansi\\ansicpg1252\\deff0\\nouicompat";
+
+        // font table
+        // Brace escape: add an extra brace (of same kind) after a brace to escape it within the format string.
+        fmt::format_to(std::back_inserter(rtfBuilder), FMT_COMPILE("{{\\fonttbl{{\\f0\\fmodern\\fcharset0 {};}}}}"), til::u16u8(formatting.fontFaceName));
 
         // add color table to the final RTF
-        rtfBuilder += colorTableBuilder + "}";
+        rtfBuilder += colorTableBuilder;
+        rtfBuilder += "}";
 
         // add the text content to the final RTF
-        rtfBuilder += contentBuilder + "}";
-
-        return rtfBuilder;
+        rtfBuilder += contentBuilder;
+        rtfBuilder += "}";
     }
-    catch (...)
+
+    return data;
+}
+
+// Routine Description:
+// - Generates a CF_HTML compliant structure from the selected region of the buffer
+// Arguments:
+// - req - the copy request having the bounds of the selected region and other related configuration flags.
+// - fontHeightPoints - the unscaled font height
+// - fontFaceName - the name of the font used
+// - backgroundColor - default background color for characters, also used in padding
+// - isIntenseBold - true if being intense is treated as being bold
+// - GetAttributeColors - function to get the colors of the text attributes as they're rendered
+// Return Value:
+// - string containing the generated HTML. Empty if the copy request is invalid.
+std::string TextBuffer::GenHTML(const CopyRequest& req,
+                                const int fontHeightPoints,
+                                const std::wstring_view fontFaceName,
+                                const COLORREF backgroundColor,
+                                const bool isIntenseBold,
+                                std::function<std::tuple<COLORREF, COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors) const noexcept
+try
+{
+    const CopyFormatting formatting{
+        .fontHeightPoints = fontHeightPoints,
+        .fontFaceName = fontFaceName,
+        .backgroundColor = backgroundColor,
+        .isIntenseBold = isIntenseBold,
+        .html = true,
+    };
+    return std::move(GenCopyData(req, formatting, GetAttributeColors).html);
+}
+catch (...)
+{
+    LOG_HR(wil::ResultFromCaughtException());
+    return {};
+}
+
+// Routine Description:
+// - Generates an RTF document from the selected region of the buffer
+//   RTF 1.5 Spec: https://www.biblioscape.com/rtf15_spec.htm
+//   RTF 1.9.1 Spec: https://msopenspecs.azureedge.net/files/Archive_References/[MSFT-RTF].pdf
+// Arguments:
+// - req - the copy request having the bounds of the selected region and other related configuration flags.
+// - fontHeightPoints - the unscaled font height
+// - fontFaceName - the name of the font used
+// - backgroundColor - default background color for characters, also used in padding
+// - isIntenseBold - true if being intense is treated as being bold
+// - GetAttributeColors - function to get the colors of the text attributes as they're rendered
+// Return Value:
+// - string containing the generated RTF. Empty if the copy request is invalid.
+std::string TextBuffer::GenRTF(const CopyRequest& req,
+                               const int fontHeightPoints,
+                               const std::wstring_view fontFaceName,
+                               const COLORREF backgroundColor,
+                               const bool isIntenseBold,
+                               std::function<std::tuple<COLORREF, COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors) const noexcept
+try
+{
+    const CopyFormatting formatting{
+        .fontHeightPoints = fontHeightPoints,
+        .fontFaceName = fontFaceName,
+        .backgroundColor = backgroundColor,
+        .isIntenseBold = isIntenseBold,
+        .rtf = true,
+    };
+    return std::move(GenCopyData(req, formatting, GetAttributeColors).rtf);
+}
+catch (...)
+{
+    LOG_HR(wil::ResultFromCaughtException());
+    return {};
+}
+
+// Appends text to the HTML output, escaping the characters that have a special meaning in HTML.
+void TextBuffer::_AppendHTMLText(std::string& htmlBuilder, const std::string_view& text)
+{
+    size_t beg = 0;
+    for (size_t i = 0; i < text.size(); ++i)
     {
-        LOG_HR(wil::ResultFromCaughtException());
-        return {};
+        std::string_view entity;
+        switch (til::at(text, i))
+        {
+        case '<':
+            entity = "&lt;";
+            break;
+        case '>':
+            entity = "&gt;";
+            break;
+        case '&':
+            entity = "&amp;";
+            break;
+        default:
+            continue;
+        }
+
+        htmlBuilder.append(text.substr(beg, i - beg));
+        htmlBuilder.append(entity);
+        beg = i + 1;
     }
+    htmlBuilder.append(text.substr(beg));
 }
 
 void TextBuffer::_AppendRTFText(std::string& contentBuilder, const std::wstring_view& text)
@@ -49,6 +49,7 @@ filling in the last row, and updating the screen.
 
 #pragma once
 
+#include <stop_token>
 #include <vector>
 
 #include "cursor.h"
@@ -73,7 +74,8 @@ public:
                const TextAttribute defaultAttributes,
                const UINT cursorSize,
                const bool isActiveBuffer,
-               Microsoft::Console::Render::Renderer& renderer);
+               Microsoft::Console::Render::Renderer& renderer,
+               TextBuffer* const recycledBuffer = nullptr);
 
     TextBuffer(const TextBuffer&) = delete;
     TextBuffer(TextBuffer&&) = delete;
@@ -100,8 +102,8 @@ public:
 
     size_t GetCellDistance(const til::point from, const til::point to) const;
 
-    static size_t GraphemeNext(const std::wstring_view& chars, size_t position) noexcept;
-    static size_t GraphemePrev(const std::wstring_view& chars, size_t position) noexcept;
+    static size_t GraphemeNext(const std::wstring_view& chars, size_t position, til::CoordType* width = nullptr) noexcept;
+    static size_t GraphemePrev(const std::wstring_view& chars, size_t position, til::CoordType* width = nullptr) noexcept;
     static size_t FitTextIntoColumns(const std::wstring_view& chars, til::CoordType columnLimit, til::CoordType& columns) noexcept;
 
     til::point NavigateCursor(til::point position, til::CoordType distance) const;
@@ -184,6 +186,7 @@ public:
     til::point GetGlyphEnd(const til::point pos, bool accessibilityMode = false, std::optional<til::point> limitOptional = std::nullopt) const;
     bool MoveToNextGlyph(til::point& pos, bool allowBottomExclusive = false, std::optional<til::point> limitOptional = std::nullopt) const;
     bool MoveToPreviousGlyph(til::point& pos, std::optional<til::point> limitOptional = std::nullopt) const;
+    til::CoordType MoveByGlyphs(til::point& pos, til::CoordType count, bool allowBottomExclusive = false, std::optional<til::point> limitOptional = std::nullopt) const;
 
     const std::vector<til::inclusive_rect> GetTextRects(til::point start, til::point end, bool blockSelection, bool bufferCoordinates) const;
     std::vector<til::point_span> GetTextSpans(til::point start, til::point end, bool blockSelection, bool bufferCoordinates) const;
@@ -270,6 +273,57 @@ public:
 
     std::wstring GetPlainText(const CopyRequest& req) const;
 
+    struct CopyFormatting
+    {
+        int fontHeightPoints = 0;
+        std::wstring_view fontFaceName;
+        // default background color for characters, also used in padding
+        COLORREF backgroundColor = 0;
+        bool isIntenseBold = false;
+        bool html = false;
+        bool rtf = false;
+    };
+
+    struct CopyData
+    {
+        std::wstring plainText;
+        std::string html;
+        std::string rtf;
+    };
+
+    // Requests a stop on its token once the timeout has elapsed. Clipboard callers pass
+    // the token to GenCopyData(), so that formatting a huge selection can't hang them.
+    class CopyDeadline
+    {
+    public:
+        explicit CopyDeadline(std::chrono::milliseconds timeout);
+
+        // CopyDeadline uses the address of _stopSource when creating _timer.
+        // Since the timer cannot be recreated, instances cannot be moved either.
+        CopyDeadline(const CopyDeadline&) = delete;
+        CopyDeadline& operator=(const CopyDeadline&) = delete;
+        CopyDeadline(CopyDeadline&&) = delete;
+        CopyDeadline& operator=(CopyDeadline&&) = delete;
+
+        std::stop_token get_token() const noexcept;
+
+    private:
+        static void __stdcall _timerCallback(PTP_CALLBACK_INSTANCE instance, PVOID context, PTP_TIMER timer) noexcept;
+
+        std::stop_source _stopSource;
+        wil::unique_threadpool_timer _timer;
+    };
+
+    // How long clipboard callers are willing to wait for the HTML and RTF of a selection.
+    static constexpr std::chrono::seconds CopyFormattingTimeout{ 2 };
+
+    using GetAttributeColorsFn = std::function<std::tuple<COLORREF, COLORREF, COLORREF>(const TextAttribute&)>;
+
+    CopyData GenCopyData(const CopyRequest& req,
+                         const CopyFormatting& formatting,
+                         const GetAttributeColorsFn& GetAttributeColors,
+                         const std::stop_token& stopToken = {}) const;
+
     std::string GenHTML(const CopyRequest& req,
                         const int fontHeightPoints,
                         const std::wstring_view fontFaceName,
@@ -313,6 +367,7 @@ public:
 
 private:
     void _reserve(til::size screenBufferSize, const TextAttribute& defaultAttributes);
+    bool _recycle(TextBuffer& recycledBuffer, til::size screenBufferSize, const TextAttribute& defaultAttributes) noexcept;
     void _commit(const std::byte* row);
     void _decommit() noexcept;
     void _construct(const std::byte* until) noexcept;
@@ -328,11 +383,23 @@ private:
     // Assist with maintaining proper buffer state for Double Byte character sequences
     void _PrepareForDoubleByteSequence(const DbcsAttribute dbcsAttribute);
     void _ExpandTextRow(til::inclusive_rect& selectionRow) const;
-    DelimiterClass _GetDelimiterClassAt(const til::point pos, const std::wstring_view wordDelimiters) const;
-    til::point _GetWordStartForAccessibility(const til::point target, const std::wstring_view wordDelimiters) const;
-    til::point _GetWordStartForSelection(const til::point target, const std::wstring_view wordDelimiters) const;
-    til::point _GetWordEndForAccessibility(const til::point target, const std::wstring_view wordDelimiters, const til::point limit) const;
-    til::point _GetWordEndForSelection(const til::point target, const std::wstring_view wordDelimiters) const;
+    // Word navigation walks the buffer one cell at a time. This holds the delimiter
+    // classes of the row it's currently on, so that each step is a simple array lookup.
+    struct DelimiterClassCache
+    {
+        explicit DelimiterClassCache(const std::wstring_view wordDelimiters) :
+            delimiters{ wordDelimiters } {}
+
+        WordDelimiters delimiters;
+        std::vector<DelimiterClass> classes;
+        til::CoordType y = -1;
+        bool doubleWidth = false;
+    };
+    DelimiterClass _GetDelimiterClassAt(const til::point pos, DelimiterClassCache& cache) const;
+    til::point _GetWordStartForAccessibility(const til::point target, DelimiterClassCache& cache) const;
+    til::point _GetWordStartForSelection(const til::point target, DelimiterClassCache& cache) const;
+    til::point _GetWordEndForAccessibility(const til::point target, DelimiterClassCache& cache, const til::point limit) const;
+    til::point _GetWordEndForSelection(const til::point target, DelimiterClassCache& cache) const;
     void _PruneHyperlinks();
 
     std::wstring _commandForRow(const til::CoordType rowOffset, const til::CoordType bottomInclusive) const;
@@ -342,6 +409,7 @@ private:
     std::tuple<til::CoordType, til::CoordType, bool> _RowCopyHelper(const CopyRequest& req, const til::CoordType iRow, const ROW& row) const;
 
     static void _AppendRTFText(std::string& contentBuilder, const std::wstring_view& text);
+    static void _AppendHTMLText(std::string& htmlBuilder, const std::string_view& text);
 
     Microsoft::Console::Render::Renderer& _renderer;
 
@@ -381,6 +449,12 @@ private:
     // In other words, _commitWatermark itself will either point exactly onto the next ROW
     // that should be committed or be equal to _bufferEnd when all ROWs are committed.
     std::byte* _commitWatermark = nullptr;
+    // When a TextBuffer takes over the memory arena of a recycled buffer, the ROWs between _commitWatermark
+    // (inclusive) and _recycleWatermark (exclusive) are already committed and constructed, but still hold the
+    // contents of the old buffer. _commit() resets them one by one as they're first accessed, which is a lot
+    // cheaper than committing and constructing fresh ROWs. If _recycleWatermark is less than or equal to
+    // _commitWatermark, there are no such ROWs left.
+    std::byte* _recycleWatermark = nullptr;
     // This will MEM_COMMIT 128 rows more than we need, to avoid us from having to call VirtualAlloc too often.
     // This equates to roughly the following commit chunk sizes at these column counts:
     // *  80 columns (the usual minimum) =  60KB chunks,  4.1MB buffer at 9001 rows
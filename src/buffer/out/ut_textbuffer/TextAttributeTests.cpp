@@ -25,6 +25,7 @@ class TextAttributeTests
     TEST_METHOD(TestReverseDefaultColors);
     TEST_METHOD(TestRoundtripDefaultColors);
     TEST_METHOD(TestIntenseAsBright);
+    TEST_METHOD(TestPerceivableColorCache);
 
     RenderSettings _renderSettings;
     const COLORREF _defaultFg = RGB(1, 2, 3);
@@ -325,3 +326,40 @@ void TextAttributeTests::TestIntenseAsBright()
     // Restore the default IntenseIsBright mode.
     _renderSettings.SetRenderMode(RenderSettings::Mode::IntenseIsBright, true);
 }
+
+void TextAttributeTests::TestPerceivableColorCache()
+{
+    if constexpr (!Feature_AdjustIndistinguishableText::IsEnabled())
+    {
+        Log::Result(TestResults::Skipped);
+        return;
+    }
+
+    RenderSettings renderSettings;
+    renderSettings.SetRenderMode(RenderSettings::Mode::AlwaysDistinguishableColors, true);
+
+    TextAttribute attr{};
+    attr.SetForeground(TextColor{ RGB(0x10, 0x10, 0x10) });
+    attr.SetBackground(TextColor{ RGB(0x12, 0x12, 0x12) });
+
+    Log::Comment(L"The first lookup computes the adjusted color");
+    const auto first = renderSettings.GetAttributeColors(attr);
+    VERIFY_ARE_NOT_EQUAL(RGB(0x10, 0x10, 0x10), first.first);
+    VERIFY_ARE_EQUAL(0u, renderSettings.GetColorCacheStats().hits);
+    VERIFY_ARE_EQUAL(1u, renderSettings.GetColorCacheStats().misses);
+
+    Log::Comment(L"Subsequent lookups of the same colors are served from the cache");
+    attr.SetIntense(true);
+    attr.SetItalic(true);
+    VERIFY_ARE_EQUAL(first, renderSettings.GetAttributeColors(attr));
+    VERIFY_ARE_EQUAL(first, renderSettings.GetAttributeColors(attr));
+    VERIFY_ARE_EQUAL(2u, renderSettings.GetColorCacheStats().hits);
+    VERIFY_ARE_EQUAL(1u, renderSettings.GetColorCacheStats().misses);
+
+    Log::Comment(L"Changing the colors results in a different adjustment");
+    attr.SetBackground(TextColor{ RGB(0xf0, 0xf0, 0xf0) });
+    attr.SetForeground(TextColor{ RGB(0xee, 0xee, 0xee) });
+    const auto second = renderSettings.GetAttributeColors(attr);
+    VERIFY_ARE_NOT_EQUAL(first.first, second.first);
+    VERIFY_ARE_EQUAL(2u, renderSettings.GetColorCacheStats().misses);
+}
@@ -26,6 +26,9 @@ namespace TerminalAppLocalTests
         TEST_METHOD(VerifyWeight);
         TEST_METHOD(VerifyCompare);
         TEST_METHOD(VerifyCompareIgnoreCase);
+        TEST_METHOD(VerifySort);
+        TEST_METHOD(VerifyFilterSetter);
+        TEST_METHOD(VerifyDefaultConstructed);
     };
 
     void FilteredCommandTests::VerifyHighlighting()
@@ -43,7 +46,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing command name segmentation with empty filter");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"";
+                filteredCommand->UpdateFilter(L"");
                 auto segments = filteredCommand->_computeHighlightedName().Segments();
                 VERIFY_ARE_EQUAL(segments.Size(), 1u);
                 VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"AAAAAABBBBBBCCC");
@@ -52,7 +55,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing command name segmentation with filter equals to the string");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"AAAAAABBBBBBCCC";
+                filteredCommand->UpdateFilter(L"AAAAAABBBBBBCCC");
                 auto segments = filteredCommand->_computeHighlightedName().Segments();
                 VERIFY_ARE_EQUAL(segments.Size(), 1u);
                 VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"AAAAAABBBBBBCCC");
@@ -61,7 +64,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing command name segmentation with filter with first character matching");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"A";
+                filteredCommand->UpdateFilter(L"A");
                 auto segments = filteredCommand->_computeHighlightedName().Segments();
                 VERIFY_ARE_EQUAL(segments.Size(), 2u);
                 VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"A");
@@ -72,7 +75,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing command name segmentation with filter with other case");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"a";
+                filteredCommand->UpdateFilter(L"a");
                 auto segments = filteredCommand->_computeHighlightedName().Segments();
                 VERIFY_ARE_EQUAL(segments.Size(), 2u);
                 VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"A");
@@ -83,7 +86,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing command name segmentation with filter matching several characters");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"ab";
+                filteredCommand->UpdateFilter(L"ab");
                 auto segments = filteredCommand->_computeHighlightedName().Segments();
                 VERIFY_ARE_EQUAL(segments.Size(), 4u);
                 VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"A");
@@ -98,7 +101,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing command name segmentation with non matching filter");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"abcd";
+                filteredCommand->UpdateFilter(L"abcd");
                 auto segments = filteredCommand->_computeHighlightedName().Segments();
                 VERIFY_ARE_EQUAL(segments.Size(), 1u);
                 VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"AAAAAABBBBBBCCC");
@@ -123,7 +126,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing weight of command with empty filter");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"";
+                filteredCommand->UpdateFilter(L"");
                 filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
                 auto weight = filteredCommand->_computeWeight();
                 VERIFY_ARE_EQUAL(weight, 0);
@@ -131,7 +134,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing weight of command with filter equals to the string");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"AAAAAABBBBBBCCC";
+                filteredCommand->UpdateFilter(L"AAAAAABBBBBBCCC");
                 filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
                 auto weight = filteredCommand->_computeWeight();
                 VERIFY_ARE_EQUAL(weight, 30); // 1 point for the first char and 2 points for the 14 consequent ones + 1 point for the beginning of the word
@@ -139,7 +142,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing weight of command with filter with first character matching");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"A";
+                filteredCommand->UpdateFilter(L"A");
                 filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
                 auto weight = filteredCommand->_computeWeight();
                 VERIFY_ARE_EQUAL(weight, 2); // 1 point for the first char match + 1 point for the beginning of the word
@@ -147,7 +150,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing weight of command with filter with other case");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"a";
+                filteredCommand->UpdateFilter(L"a");
                 filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
                 auto weight = filteredCommand->_computeWeight();
                 VERIFY_ARE_EQUAL(weight, 2); // 1 point for the first char match + 1 point for the beginning of the word
@@ -155,7 +158,7 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing weight of command with filter matching several characters");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"ab";
+                filteredCommand->UpdateFilter(L"ab");
                 filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
                 auto weight = filteredCommand->_computeWeight();
                 VERIFY_ARE_EQUAL(weight, 3); // 1 point for the first char match + 1 point for the beginning of the word + 1 point for the match of "b"
@@ -181,12 +184,12 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing comparison of commands with empty filter");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"";
+                filteredCommand->UpdateFilter(L"");
                 filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
                 filteredCommand->_Weight = filteredCommand->_computeWeight();
 
                 const auto filteredCommand2 = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem2);
-                filteredCommand2->_Filter = L"";
+                filteredCommand2->UpdateFilter(L"");
                 filteredCommand2->_HighlightedName = filteredCommand2->_computeHighlightedName();
                 filteredCommand2->_Weight = filteredCommand2->_computeWeight();
 
@@ -196,12 +199,12 @@ namespace TerminalAppLocalTests
             {
                 Log::Comment(L"Testing comparison of commands with different weights");
                 const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
-                filteredCommand->_Filter = L"B";
+                filteredCommand->UpdateFilter(L"B");
                 filteredCommand->_HighlightedName = filteredCommand->_computeHighlightedName();
                 filteredCommand->_Weight = filteredCommand->_computeWeight();
 
                 const auto filteredCommand2 = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem2);
-                filteredCommand2->_Filter = L"B";
+                filteredCommand2->UpdateFilter(L"B");
                 filteredCommand2->_HighlightedName = filteredCommand2->_computeHighlightedName();
                 filteredCommand2->_Weight = filteredCommand2->_computeWeight();
 
@@ -229,4 +232,91 @@ namespace TerminalAppLocalTests
 
         VERIFY_SUCCEEDED(result);
     }
+
+    void FilteredCommandTests::VerifySort()
+    {
+        auto result = RunOnUIThread([]() {
+            std::vector<winrt::TerminalApp::FilteredCommand> commands;
+            for (const auto name : { L"Close Pane", L"split pane", L"Split Pane", L"New Tab" })
+            {
+                const auto paletteItem{ winrt::make<winrt::TerminalApp::implementation::CommandLinePaletteItem>(name) };
+                const auto filteredCommand = winrt::make<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
+                filteredCommand.UpdateFilter(L"sp");
+                commands.emplace_back(filteredCommand);
+            }
+
+            Log::Comment(L"\"New Tab\" doesn't match, \"Close Pane\" matches the \"s\" and \"p\" separately");
+            VERIFY_ARE_EQUAL(0, commands[3].Weight());
+            VERIFY_IS_TRUE(commands[0].Weight() < commands[1].Weight());
+            VERIFY_ARE_EQUAL(commands[1].Weight(), commands[2].Weight());
+
+            winrt::TerminalApp::implementation::FilteredCommand::Sort(commands);
+
+            VERIFY_ARE_EQUAL(4u, commands.size());
+            VERIFY_IS_TRUE(winrt::TerminalApp::implementation::FilteredCommand::Compare(commands[0], commands[2]));
+            VERIFY_ARE_EQUAL(L"Close Pane", commands[2].Item().Name());
+            VERIFY_ARE_EQUAL(L"New Tab", commands[3].Item().Name());
+
+            Log::Comment(L"Highlighting is computed on demand and matches case insensitively");
+            const auto segments = commands[0].HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(segments.Size(), 2u);
+            VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment().size(), 2u);
+            VERIFY_IS_TRUE(segments.GetAt(0).IsHighlighted());
+            VERIFY_IS_FALSE(segments.GetAt(1).IsHighlighted());
+        });
+
+        VERIFY_SUCCEEDED(result);
+    }
+
+    void FilteredCommandTests::VerifyFilterSetter()
+    {
+        auto result = RunOnUIThread([]() {
+            const auto paletteItem{ winrt::make<winrt::TerminalApp::implementation::CommandLinePaletteItem>(L"AAAAAABBBBBBCCC") };
+            const auto filteredCommand = winrt::make<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
+
+            Log::Comment(L"Setting the projected Filter property must update the match just like UpdateFilter()");
+            filteredCommand.Filter(L"ab");
+            VERIFY_ARE_EQUAL(L"ab", filteredCommand.Filter());
+            VERIFY_IS_TRUE(filteredCommand.Weight() > 0);
+            auto segments = filteredCommand.HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(segments.Size(), 4u);
+            VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"A");
+            VERIFY_IS_TRUE(segments.GetAt(0).IsHighlighted());
+
+            filteredCommand.Filter(L"abcd");
+            VERIFY_ARE_EQUAL(0, filteredCommand.Weight());
+            segments = filteredCommand.HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(segments.Size(), 1u);
+            VERIFY_IS_FALSE(segments.GetAt(0).IsHighlighted());
+        });
+
+        VERIFY_SUCCEEDED(result);
+    }
+
+    void FilteredCommandTests::VerifyDefaultConstructed()
+    {
+        auto result = RunOnUIThread([]() {
+            const auto filteredCommand = winrt::make<winrt::TerminalApp::implementation::FilteredCommand>();
+            VERIFY_IS_NULL(filteredCommand.Item());
+
+            Log::Comment(L"A FilteredCommand without an item has an empty name");
+            VERIFY_ARE_EQUAL(0u, filteredCommand.HighlightedName().Segments().Size());
+
+            filteredCommand.UpdateFilter(L"a");
+            VERIFY_ARE_EQUAL(0, filteredCommand.Weight());
+            VERIFY_ARE_EQUAL(0u, filteredCommand.HighlightedName().Segments().Size());
+
+            Log::Comment(L"It sorts like an item with an empty name");
+            const auto paletteItem{ winrt::make<winrt::TerminalApp::implementation::CommandLinePaletteItem>(L"New Tab") };
+            std::vector<winrt::TerminalApp::FilteredCommand> commands{
+                winrt::make<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem),
+                filteredCommand,
+            };
+            winrt::TerminalApp::implementation::FilteredCommand::Sort(commands);
+            VERIFY_IS_NULL(commands[0].Item());
+            VERIFY_IS_FALSE(winrt::TerminalApp::implementation::FilteredCommand::Compare(commands[1], commands[0]));
+        });
+
+        VERIFY_SUCCEEDED(result);
+    }
 }
@@ -23,34 +23,126 @@ namespace winrt::TerminalApp::implementation
     // It manages a highlighted text that is computed by matching search filter characters to item name
     FilteredCommand::FilteredCommand(const winrt::TerminalApp::PaletteItem& item) :
         _Item(item),
-        _Filter(L""),
-        _Weight(0)
+        _Weight(0),
+        _Filter(L"")
     {
-        _HighlightedName = _computeHighlightedName();
+        _foldedName = FoldCase(_Item.Name());
 
         // Recompute the highlighted name if the item name changes
         _itemChangedRevoker = _Item.PropertyChanged(winrt::auto_revoke, [weakThis{ get_weak() }](auto& /*sender*/, auto& e) {
             auto filteredCommand{ weakThis.get() };
             if (filteredCommand && e.PropertyName() == L"Name")
             {
-                filteredCommand->HighlightedName(filteredCommand->_computeHighlightedName());
+                filteredCommand->_foldedName = FoldCase(filteredCommand->_Item.Name());
+                filteredCommand->_invalidateHighlightedName();
                 filteredCommand->Weight(filteredCommand->_computeWeight());
             }
         });
     }
 
+    winrt::hstring FilteredCommand::Filter() const noexcept
+    {
+        return _Filter;
+    }
+
+    // The projected setter goes through UpdateFilter(), so that the folded
+    // filter, the highlighted name and the weight don't get out of sync.
+    void FilteredCommand::Filter(const winrt::hstring& filter)
+    {
+        UpdateFilter(filter);
+    }
+
     void FilteredCommand::UpdateFilter(const winrt::hstring& filter)
+    {
+        if (filter != _Filter)
+        {
+            UpdateFilter(filter, FoldCase(filter));
+        }
+    }
+
+    // Method Description:
+    // - Same as UpdateFilter(filter), but with a filter that was already passed through
+    //   FoldCase(). The palettes filter all of their items with the same text, so this
+    //   allows them to fold it once, instead of once per item.
+    // Arguments:
+    // - filter: the new filter text
+    // - foldedFilter: FoldCase(filter)
+    void FilteredCommand::UpdateFilter(const winrt::hstring& filter, const std::wstring_view& foldedFilter)
     {
         // If the filter was not changed we want to prevent the re-computation of matching
         // that might result in triggering a notification event
         if (filter != _Filter)
         {
-            Filter(filter);
-            HighlightedName(_computeHighlightedName());
+            _foldedFilter = foldedFilter;
+            _Filter = filter;
+            PropertyChanged.raise(*this, Windows::UI::Xaml::Data::PropertyChangedEventArgs{ L"Filter" });
+            _invalidateHighlightedName();
             Weight(_computeWeight());
         }
     }
 
+    winrt::TerminalApp::HighlightedText FilteredCommand::HighlightedName()
+    {
+        if (!_HighlightedName)
+        {
+            _HighlightedName = _computeHighlightedName();
+        }
+        return _HighlightedName;
+    }
+
+    // Method Description:
+    // - Drops the current highlighted name and notifies any bindings about it. Only
+    //   the items that are actually displayed are bound to, so only they'll call
+    //   HighlightedName() in response and recompute it.
+    void FilteredCommand::_invalidateHighlightedName()
+    {
+        _HighlightedName = nullptr;
+        PropertyChanged.raise(*this, Windows::UI::Xaml::Data::PropertyChangedEventArgs{ L"HighlightedName" });
+    }
+
+    // Function Description:
+    // - Lowercases the given text for the purpose of matching it against other folded text.
+    // - GH#9941: search should be locale-aware as well, which is why this uses the
+    //   user's locale, instead of just towlower().
+    // - NOTE: Filter characters used to be matched with lstrcmpi(), which compares them
+    //   with the user locale's collation rules. This only maps upper to lower case,
+    //   one UTF-16 unit at a time. Case insensitive matching is unchanged, but characters
+    //   that merely collate as equal don't match anymore, for instance a precomposed
+    //   "\u00E9" and the "e" of a decomposed "e\u0301", or a character that lstrcmpi()
+    //   ignores. Sorting still uses lstrcmpi(), see Compare() and Sort().
+    // Arguments:
+    // - text: the text to fold
+    // Return Value:
+    // - the folded text. It's guaranteed to have the same length as the input,
+    //   so that offsets into it can be used as offsets into the original text.
+    std::wstring FilteredCommand::FoldCase(const std::wstring_view& text)
+    {
+        static constexpr DWORD flags = LCMAP_LOWERCASE | LCMAP_LINGUISTIC_CASING;
+
+        std::wstring folded(text.size(), L'\0');
+        if (text.empty())
+        {
+            return folded;
+        }
+
+        const auto length = gsl::narrow<int>(text.size());
+        if (LCMapStringEx(LOCALE_NAME_USER_DEFAULT, flags, text.data(), length, folded.data(), length, nullptr, nullptr, 0) != length)
+        {
+            // The mapping changed the length of the text (or failed). Fold each character on its own,
+            // keeping those that don't map to exactly one character as they are.
+            for (size_t i = 0; i < text.size(); ++i)
+            {
+                auto& ch = til::at(folded, i);
+                if (LCMapStringEx(LOCALE_NAME_USER_DEFAULT, flags, &til::at(text, i), 1, &ch, 1, nullptr, nullptr, 0) != 1)
+                {
+                    ch = til::at(text, i);
+                }
+            }
+        }
+
+        return folded;
+    }
+
     // Method Description:
     // - Looks up the filter characters within the item name.
     // Iterating through the filter and the item name it tries to associate the next filter character
@@ -58,94 +150,101 @@ namespace winrt::TerminalApp::implementation
     //
     // E.g., for filter="c l t s" and name="close all tabs after this", the match will be "CLose TabS after this".
     //
-    // The item name is then split into segments (groupings of matched and non matched characters).
-    //
-    // E.g., the segments were the example above will be "CL", "ose ", "T", "ab", "S", "after this".
+    // Consecutively matched characters are grouped into runs and func(begin, end) is called
+    // for each run, with begin/end being offsets into the item name.
     //
-    // The segments matching the filter characters are marked as highlighted.
+    // E.g., for the example above the runs will be "CL", "T" and "S".
     //
-    // E.g., ("CL", true) ("ose ", false), ("T", true), ("ab", false), ("S", true), ("after this", false)
-    //
-    // TODO: we probably need to merge this logic with _getWeight computation?
+    // This works on the case folded name and filter and doesn't allocate, as it runs
+    // for every item in the palette on every keystroke.
     //
+    // Arguments:
+    // - func: a callable invoked as func(size_t begin, size_t end)
     // Return Value:
-    // - The HighlightedText object initialized with the segments computed according to the algorithm above.
-    winrt::TerminalApp::HighlightedText FilteredCommand::_computeHighlightedName()
+    // - false if not all filter characters could be matched, in which case func isn't called at all.
+    template<typename T>
+    bool FilteredCommand::_forEachMatchedRun(T&& func) const
     {
-        const auto segments = winrt::single_threaded_observable_vector<winrt::TerminalApp::HighlightedTextSegment>();
-        auto commandName = _Item.Name();
-        auto isProcessingMatchedSegment = false;
-        uint32_t nextOffsetToReport = 0;
-        uint32_t currentOffset = 0;
+        const std::wstring_view name{ _foldedName };
 
-        for (const auto searchChar : _Filter)
+        // Check whether all characters match before reporting any runs.
         {
-            const WCHAR searchCharAsString[] = { searchChar, L'\0' };
-            while (true)
+            size_t offset = 0;
+            for (const auto ch : _foldedFilter)
             {
-                if (currentOffset == commandName.size())
-                {
-                    // There are still unmatched filter characters but we finished scanning the name.
-                    // In this case we return the entire item name as unmatched
-                    auto entireNameSegment{ winrt::make<HighlightedTextSegment>(commandName, false) };
-                    segments.Clear();
-                    segments.Append(entireNameSegment);
-                    return winrt::make<HighlightedText>(segments);
-                }
-
-                // GH#9941: search should be locale-aware as well
-                // We use the same comparison method as upon sorting to guarantee consistent behavior
-                const WCHAR currentCharAsString[] = { commandName[currentOffset], L'\0' };
-                auto isCurrentCharMatched = lstrcmpi(searchCharAsString, currentCharAsString) == 0;
-                if (isProcessingMatchedSegment != isCurrentCharMatched)
+                offset = name.find(ch, offset);
+                if (offset == std::wstring_view::npos)
                 {
-                    // We reached the end of the region (matched character came after a series of unmatched or vice versa).
-                    // Conclude the segment and add it to the list.
-                    // Skip segment if it is empty (might happen when the first character of the name is matched)
-                    auto sizeToReport = currentOffset - nextOffsetToReport;
-                    if (sizeToReport > 0)
-                    {
-                        winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-                        auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, isProcessingMatchedSegment) };
-                        segments.Append(highlightedSegment);
-                        nextOffsetToReport = currentOffset;
-                    }
-                    isProcessingMatchedSegment = isCurrentCharMatched;
+                    return false;
                 }
+                offset++;
+            }
+        }
 
-                currentOffset++;
-
-                if (isCurrentCharMatched)
+        size_t runBegin = 0;
+        size_t runEnd = 0;
+        for (const auto ch : _foldedFilter)
+        {
+            const auto pos = name.find(ch, runEnd);
+            if (pos != runEnd || runBegin == runEnd)
+            {
+                if (runBegin != runEnd)
                 {
-                    // We have matched this filter character, let's move to matching the next filter char
-                    break;
+                    func(runBegin, runEnd);
                 }
+                runBegin = pos;
             }
+            runEnd = pos + 1;
         }
 
-        // Either the filter or the item name were fully processed.
-        // If we were in the middle of the matched segment - add it.
-        if (isProcessingMatchedSegment)
+        if (runBegin != runEnd)
         {
-            auto sizeToReport = currentOffset - nextOffsetToReport;
-            if (sizeToReport > 0)
+            func(runBegin, runEnd);
+        }
+
+        return true;
+    }
+
+    // Method Description:
+    // - Splits the item name into segments (groupings of matched and non matched characters)
+    //   according to _forEachMatchedRun().
+    //
+    // E.g., for filter="c l t s" and name="close all tabs after this",
+    // the segments will be "CL", "ose ", "T", "ab", "S", "after this".
+    //
+    // The segments matching the filter characters are marked as highlighted.
+    //
+    // E.g., ("CL", true) ("ose ", false), ("T", true), ("ab", false), ("S", true), ("after this", false)
+    //
+    // If not all filter characters could be matched, the entire name is returned as a single unmatched segment.
+    //
+    // Return Value:
+    // - The HighlightedText object initialized with the segments computed according to the algorithm above.
+    winrt::TerminalApp::HighlightedText FilteredCommand::_computeHighlightedName()
+    {
+        const auto segments = winrt::single_threaded_observable_vector<winrt::TerminalApp::HighlightedTextSegment>();
+        // A default constructed FilteredCommand has no item. It's displayed as an empty name.
+        const auto commandName = _Item ? _Item.Name() : winrt::hstring{};
+        const std::wstring_view name{ commandName };
+        size_t nextOffsetToReport = 0;
+
+        const auto appendSegment = [&](const size_t end, const bool highlighted) {
+            if (end > nextOffsetToReport)
             {
-                winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-                auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, true) };
-                segments.Append(highlightedSegment);
-                nextOffsetToReport = currentOffset;
+                winrt::hstring segment{ name.substr(nextOffsetToReport, end - nextOffsetToReport) };
+                segments.Append(winrt::make<HighlightedTextSegment>(segment, highlighted));
+                nextOffsetToReport = end;
             }
-        }
+        };
+
+        _forEachMatchedRun([&](const size_t begin, const size_t end) {
+            appendSegment(begin, false);
+            appendSegment(end, true);
+        });
 
         // Now create a segment for all remaining characters.
         // We will have remaining characters as long as the filter is shorter than the item name.
-        auto sizeToReport = commandName.size() - nextOffsetToReport;
-        if (sizeToReport > 0)
-        {
-            winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-            auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, false) };
-            segments.Append(highlightedSegment);
-        }
+        appendSegment(name.size(), false);
 
         return winrt::make<HighlightedText>(segments);
     }
@@ -184,35 +283,24 @@ namespace winrt::TerminalApp::implementation
     //     Controls".
     //   * "sv" would return "[ | ] Split Vertical" (by matching the **S** in
     //     "Split", then the **V** in "Vertical").
-    // Arguments:
-    // - searchText: the string of text to search for in `name`
-    // - name: the name to check
     // Return Value:
     // - the relative weight of this match
     int FilteredCommand::_computeWeight()
     {
         auto result = 0;
-        auto isNextSegmentWordBeginning = true;
 
-        for (const auto& segment : _HighlightedName.Segments())
-        {
-            const auto& segmentText = segment.TextSegment();
-            const auto segmentSize = segmentText.size();
+        _forEachMatchedRun([&](const size_t begin, const size_t end) {
+            const auto runSize = gsl::narrow_cast<int>(end - begin);
 
-            if (segment.IsHighlighted())
-            {
-                // Give extra point for each consecutive match
-                result += (segmentSize <= 1) ? segmentSize : 1 + 2 * (segmentSize - 1);
+            // Give extra point for each consecutive match
+            result += runSize <= 1 ? runSize : 1 + 2 * (runSize - 1);
 
-                // Give extra point if this segment is at the beginning of a word
-                if (isNextSegmentWordBeginning)
-                {
-                    result++;
-                }
+            // Give extra point if this run is at the beginning of a word
+            if (begin == 0 || til::at(_foldedName, begin - 1) == L' ')
+            {
+                result++;
             }
-
-            isNextSegmentWordBeginning = segmentSize > 0 && segmentText[segmentSize - 1] == L' ';
-        }
+        });
 
         return result;
     }
@@ -232,11 +320,50 @@ namespace winrt::TerminalApp::implementation
 
         if (firstWeight == secondWeight)
         {
-            std::wstring_view firstName{ first.Item().Name() };
-            std::wstring_view secondName{ second.Item().Name() };
-            return lstrcmpi(firstName.data(), secondName.data()) < 0;
+            const auto firstItem = first.Item();
+            const auto secondItem = second.Item();
+            const auto firstName = firstItem ? firstItem.Name() : winrt::hstring{};
+            const auto secondName = secondItem ? secondItem.Name() : winrt::hstring{};
+            return lstrcmpi(firstName.c_str(), secondName.c_str()) < 0;
         }
 
         return firstWeight > secondWeight;
     }
+
+    // Function Description:
+    // - Sorts the given commands in the order defined by Compare().
+    // - Compare() calls into the projected interfaces twice per comparison. This instead
+    //   fetches each command's weight and name once and then sorts those.
+    // Arguments:
+    // - commands: the commands to sort
+    void FilteredCommand::Sort(std::vector<winrt::TerminalApp::FilteredCommand>& commands)
+    {
+        struct SortKey
+        {
+            int weight;
+            winrt::hstring name;
+            winrt::TerminalApp::FilteredCommand command;
+        };
+
+        std::vector<SortKey> keys;
+        keys.reserve(commands.size());
+        for (auto& command : commands)
+        {
+            const auto self = winrt::get_self<FilteredCommand>(command);
+            keys.emplace_back(SortKey{ self->_Weight, self->_Item ? self->_Item.Name() : winrt::hstring{}, std::move(command) });
+        }
+
+        std::sort(keys.begin(), keys.end(), [](const SortKey& first, const SortKey& second) {
+            if (first.weight == second.weight)
+            {
+                return lstrcmpi(first.name.c_str(), second.name.c_str()) < 0;
+            }
+            return first.weight > second.weight;
+        });
+
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            til::at(commands, i) = std::move(til::at(keys, i).command);
+        }
+    }
 }
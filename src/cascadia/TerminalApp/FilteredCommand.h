@@ -19,19 +19,35 @@ namespace winrt::TerminalApp::implementation
         FilteredCommand() = default;
         FilteredCommand(const winrt::TerminalApp::PaletteItem& item);
 
+        winrt::hstring Filter() const noexcept;
+        void Filter(const winrt::hstring& filter);
         void UpdateFilter(const winrt::hstring& filter);
+        void UpdateFilter(const winrt::hstring& filter, const std::wstring_view& foldedFilter);
 
+        winrt::TerminalApp::HighlightedText HighlightedName();
+
+        static std::wstring FoldCase(const std::wstring_view& text);
         static int Compare(const winrt::TerminalApp::FilteredCommand& first, const winrt::TerminalApp::FilteredCommand& second);
+        static void Sort(std::vector<winrt::TerminalApp::FilteredCommand>& commands);
 
         til::property_changed_event PropertyChanged;
         WINRT_OBSERVABLE_PROPERTY(winrt::TerminalApp::PaletteItem, Item, PropertyChanged.raise, nullptr);
-        WINRT_OBSERVABLE_PROPERTY(winrt::hstring, Filter, PropertyChanged.raise);
-        WINRT_OBSERVABLE_PROPERTY(winrt::TerminalApp::HighlightedText, HighlightedName, PropertyChanged.raise);
         WINRT_OBSERVABLE_PROPERTY(int, Weight, PropertyChanged.raise);
 
     private:
+        template<typename T>
+        bool _forEachMatchedRun(T&& func) const;
+        void _invalidateHighlightedName();
         winrt::TerminalApp::HighlightedText _computeHighlightedName();
         int _computeWeight();
+
+        winrt::hstring _Filter;
+        // The case folded Item().Name() and Filter(), which is what we actually match on.
+        std::wstring _foldedName;
+        std::wstring _foldedFilter;
+        // Lazily computed by HighlightedName(), so that only items that are actually
+        // displayed pay for the allocation of their segments. nullptr if outdated.
+        winrt::TerminalApp::HighlightedText _HighlightedName{ nullptr };
         Windows::UI::Xaml::Data::INotifyPropertyChanged::PropertyChanged_revoker _itemChangedRevoker;
 
         friend class TerminalAppLocalTests::FilteredCommandTests;
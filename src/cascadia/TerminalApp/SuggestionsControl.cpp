@@ -822,15 +822,18 @@ namespace winrt::TerminalApp::implementation
         auto commandsToFilter = _commandsToFilter();
 
         {
+            const auto foldedSearchText = FilteredCommand::FoldCase(searchText);
+
             for (const auto& action : commandsToFilter)
             {
                 // Update filter for all commands
                 // This will modify the highlighting but will also lead to re-computation of weight (and consequently sorting).
                 // Pay attention that it already updates the highlighting in the UI
-                action.UpdateFilter(searchText);
+                const auto filteredCommand = winrt::get_self<FilteredCommand>(action);
+                filteredCommand->UpdateFilter(searchText, foldedSearchText);
 
                 // if there is active search we skip commands with 0 weight
-                if (searchText.empty() || action.Weight() > 0)
+                if (searchText.empty() || filteredCommand->Weight() > 0)
                 {
                     actions.push_back(action);
                 }
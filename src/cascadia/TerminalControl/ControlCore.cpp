@@ -220,6 +220,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         if (_renderer)
         {
+            _traceFrameStats();
             _renderer->TriggerTeardown();
         }
     }
@@ -1798,6 +1799,30 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         TabColorChanged.raise(*this, nullptr);
     }
 
+    // Emits the render thread's frame timing for the lifetime of this control,
+    // so that the frame pacing can be inspected in a trace once a session ends.
+    void ControlCore::_traceFrameStats() const
+    {
+        if (!TraceLoggingProviderEnabled(g_hTerminalControlProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+        {
+            return;
+        }
+
+        const auto stats = _renderer->GetFrameStats();
+        TraceLoggingWrite(
+            g_hTerminalControlProvider,
+            "FrameStats",
+            TraceLoggingDescription("The render thread's frame timing. The histogram buckets are <=1, 2, 4, 8, 16, 33, 66, 100 and >100ms."),
+            TraceLoggingUInt64(stats.framesPainted, "FramesPainted"),
+            TraceLoggingUInt64(stats.framesThrottled, "FramesThrottled"),
+            TraceLoggingInt64(stats.averagePaintTime.count(), "AveragePaintTimeUs"),
+            TraceLoggingInt64(stats.frameInterval.count(), "FrameIntervalUs"),
+            TraceLoggingUInt64Array(stats.paintTime.data(), gsl::narrow_cast<UINT16>(stats.paintTime.size()), "PaintTimeHistogram"),
+            TraceLoggingUInt64Array(stats.frameTime.data(), gsl::narrow_cast<UINT16>(stats.frameTime.size()), "FrameTimeHistogram"),
+            TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+            TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+
     void ControlCore::BlinkAttributeTick()
     {
         const auto lock = _terminal->LockForWriting();
@@ -396,6 +396,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         winrt::fire_and_forget _renderEngineSwapChainChanged(const HANDLE handle);
         void _rendererBackgroundColorChanged();
         void _rendererTabColorChanged();
+        void _traceFrameStats() const;
 #pragma endregion
 
         void _raiseReadOnlyWarning();
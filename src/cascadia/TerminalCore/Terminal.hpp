@@ -393,6 +393,8 @@ private:
 
     std::unique_ptr<TextBuffer> _mainBuffer;
     std::unique_ptr<TextBuffer> _altBuffer;
+    // The previous alt buffer, kept around so that its memory can be reused the next time we switch to the alt buffer.
+    std::unique_ptr<TextBuffer> _recycledAltBuffer;
     Microsoft::Console::Types::Viewport _mutableViewport;
     til::CoordType _scrollbackLines = 0;
     bool _detectURLs = false;
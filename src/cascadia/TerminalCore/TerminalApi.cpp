@@ -206,12 +206,15 @@ void Terminal::UseAlternateScreenBuffer(const TextAttribute& attrs)
 
     ClearSelection();
 
-    // Create a new alt buffer
+    // Create a new alt buffer. Apps like less and vim switch in and out of the
+    // alt buffer all the time, so we reuse the memory of the previous one if we can.
     _altBuffer = std::make_unique<TextBuffer>(_altBufferSize,
                                               attrs,
                                               cursorSize,
                                               true,
-                                              _mainBuffer->GetRenderer());
+                                              _mainBuffer->GetRenderer(),
+                                              _recycledAltBuffer.get());
+    _recycledAltBuffer.reset();
     _mainBuffer->SetAsActiveBuffer(false);
 
     // Copy our cursor state to the new buffer's cursor
@@ -251,8 +254,8 @@ void Terminal::UseMainScreenBuffer()
     // To make UserResize() work as if we're back in the main buffer, we first need to unset
     // _altBuffer, which is used throughout this class as an indicator via _inAltBuffer().
     //
-    // We delay destroying the alt buffer instance to get a valid altBuffer->GetCursor() reference below.
-    const auto altBuffer = std::exchange(_altBuffer, nullptr);
+    // We delay recycling the alt buffer instance to get a valid altBuffer->GetCursor() reference below.
+    auto altBuffer = std::exchange(_altBuffer, nullptr);
     if (!altBuffer)
     {
         return;
@@ -286,6 +289,10 @@ void Terminal::UseMainScreenBuffer()
         mainCursor.SetPosition(tgtCursorPos);
     }
 
+    // Hold on to the alt buffer, so its memory can be reused by the next one.
+    altBuffer->SetAsActiveBuffer(false);
+    _recycledAltBuffer = std::move(altBuffer);
+
     // update all the hyperlinks on the screen
     _updateUrlDetection();
 
@@ -894,23 +894,42 @@ Terminal::TextCopyData Terminal::RetrieveSelectedTextFromBuffer(const bool singl
     const auto& textBuffer = _activeBuffer();
 
     const auto req = TextBuffer::CopyRequest::FromConfig(textBuffer, _selection->start, _selection->end, singleLine, _blockSelection, _trimBlockSelection);
-    data.plainText = textBuffer.GetPlainText(req);
 
-    if (html || rtf)
+    if (!html && !rtf)
     {
-        const auto bgColor = _renderSettings.GetAttributeColors({}).second;
-        const auto isIntenseBold = _renderSettings.GetRenderMode(::Microsoft::Console::Render::RenderSettings::Mode::IntenseIsBold);
-        const auto fontSizePt = _fontInfo.GetUnscaledSize().height; // already in points
-        const auto& fontName = _fontInfo.GetFaceName();
+        data.plainText = textBuffer.GetPlainText(req);
+        return data;
+    }
 
-        if (html)
-        {
-            data.html = textBuffer.GenHTML(req, fontSizePt, fontName, bgColor, isIntenseBold, GetAttributeColors);
-        }
-        if (rtf)
+    const TextBuffer::CopyFormatting formatting{
+        .fontHeightPoints = _fontInfo.GetUnscaledSize().height, // already in points
+        .fontFaceName = _fontInfo.GetFaceName(),
+        .backgroundColor = _renderSettings.GetAttributeColors({}).second,
+        .isIntenseBold = _renderSettings.GetRenderMode(::Microsoft::Console::Render::RenderSettings::Mode::IntenseIsBold),
+        .html = html,
+        .rtf = rtf,
+    };
+
+    // Plain text, HTML and RTF are all generated in a single pass over the selection.
+    // If generating the formatted text fails or takes too long, we still want to copy the plain text.
+    try
+    {
+        const TextBuffer::CopyDeadline deadline{ TextBuffer::CopyFormattingTimeout };
+        auto copyData = textBuffer.GenCopyData(req, formatting, GetAttributeColors, deadline.get_token());
+        if (copyData.html.empty() && copyData.rtf.empty())
         {
-            data.rtf = textBuffer.GenRTF(req, fontSizePt, fontName, bgColor, isIntenseBold, GetAttributeColors);
+            data.plainText = textBuffer.GetPlainText(req);
+            return data;
         }
+
+        data.plainText = std::move(copyData.plainText);
+        data.html = std::move(copyData.html);
+        data.rtf = std::move(copyData.rtf);
+    }
+    catch (...)
+    {
+        LOG_CAUGHT_EXCEPTION();
+        data.plainText = textBuffer.GetPlainText(req);
     }
 
     return data;
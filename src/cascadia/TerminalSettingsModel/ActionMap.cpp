@@ -373,6 +373,17 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         }
     }
 
+    // Method Description:
+    // - Builds the key chord lookup table, once all parents were added.
+    // - The parents aren't expected to change afterwards. If they do,
+    //   this needs to be called again.
+    void ActionMap::_FinalizeInheritance()
+    {
+        std::unordered_map<uint32_t, std::optional<Model::Command>> keyChordLookup;
+        _PopulateKeyChordLookup(keyChordLookup);
+        _KeyChordLookup = std::move(keyChordLookup);
+    }
+
     com_ptr<ActionMap> ActionMap::Copy() const
     {
         auto actionMap{ make_self<ActionMap>() };
@@ -413,6 +424,12 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
             actionMap->_parents.emplace_back(parent->Copy());
         }
 
+        // The lookup table refers to our commands, not the copies.
+        if (_KeyChordLookup)
+        {
+            actionMap->_FinalizeInheritance();
+        }
+
         return actionMap;
     }
 
@@ -475,6 +492,13 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         _TryUpdateName(cmd, oldCmd, maskingCmd);
         _TryUpdateKeyChord(cmd, oldCmd, maskingCmd);
+
+        // Actions added after _FinalizeInheritance() (i.e. by the settings editor)
+        // need to show up in the lookup table right away.
+        if (_KeyChordLookup)
+        {
+            _FinalizeInheritance();
+        }
     }
 
     // Method Description:
@@ -628,7 +652,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
             const auto conflictingCmdImpl{ get_self<implementation::Command>(conflictingCmd) };
             conflictingCmdImpl->EraseKey(keys);
         }
-        else if (const auto& conflictingCmd{ GetActionByKeyChord(keys) })
+        else if (const auto& conflictingCmd{ _GetActionByKeyChordInternal(keys).value_or(nullptr) })
         {
             // Collision with ancestor: The key chord was already in use, but by an action in another layer
             //
@@ -698,7 +722,13 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         // We use the fact that the ..Internal call returns nullptr for explicitly unbound
         // key chords, and nullopt for keychord that are not bound - it allows us to distinguish
         // between unbound and lack of binding.
-        return _GetActionByKeyChordInternal(keys) == nullptr;
+        if (!_KeyChordLookup)
+        {
+            return _GetActionByKeyChordInternal(keys) == nullptr;
+        }
+
+        const auto it{ _KeyChordLookup->find(_PackKeyChord(keys)) };
+        return it != _KeyChordLookup->end() && it->second == nullptr;
     }
 
     // Method Description:
@@ -710,7 +740,13 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     // - nullptr if the key chord doesn't exist
     Model::Command ActionMap::GetActionByKeyChord(const Control::KeyChord& keys) const
     {
-        return _GetActionByKeyChordInternal(keys).value_or(nullptr);
+        if (!_KeyChordLookup)
+        {
+            return _GetActionByKeyChordInternal(keys).value_or(nullptr);
+        }
+
+        const auto it{ _KeyChordLookup->find(_PackKeyChord(keys)) };
+        return it != _KeyChordLookup->end() ? it->second.value_or(nullptr) : nullptr;
     }
 
     // Method Description:
@@ -747,6 +783,42 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         return std::nullopt;
     }
 
+    // Method Description:
+    // - Packs a key chord into an integer that compares equal exactly when
+    //   KeyChord::Equals() does. See KeyChord::Hash() for the reasoning.
+    // Arguments:
+    // - keys: the key chord to pack
+    // Return Value:
+    // - the modifiers in the upper byte, followed by either the vkey or
+    //   the scan code tagged with bit 16
+    uint32_t ActionMap::_PackKeyChord(const Control::KeyChord& keys)
+    {
+        const auto modifiers{ static_cast<uint32_t>(keys.Modifiers()) };
+        const auto vkey{ static_cast<uint32_t>(keys.Vkey()) };
+        const auto scanCode{ static_cast<uint32_t>(keys.ScanCode()) };
+        return (modifiers << 24) | (vkey ? vkey : (scanCode | 0x10000));
+    }
+
+    // Method Description:
+    // - Populates the provided map with the result _GetActionByKeyChordInternal()
+    //   would return for every key chord bound in this layer or any of our parents.
+    // - Like _GetActionByKeyChordInternal(), our own layer wins over our parents,
+    //   and earlier parents win over later ones.
+    // Arguments:
+    // - keyChordLookup: the map we're populating, keyed by _PackKeyChord()
+    void ActionMap::_PopulateKeyChordLookup(std::unordered_map<uint32_t, std::optional<Model::Command>>& keyChordLookup) const
+    {
+        for (const auto& [keys, actionID] : _KeyMap)
+        {
+            keyChordLookup.try_emplace(_PackKeyChord(keys), _GetActionByID(actionID));
+        }
+
+        for (const auto& parent : _parents)
+        {
+            parent->_PopulateKeyChordLookup(keyChordLookup);
+        }
+    }
+
     // Method Description:
     // - Retrieves the key chord for the provided action
     // Arguments:
@@ -57,7 +57,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         static SettingsLoader Default(const std::string_view& userJSON, const std::string_view& inboxJSON);
         SettingsLoader(const std::string_view& userJSON, const std::string_view& inboxJSON);
 
-        void GenerateProfiles();
+        void GenerateProfiles(const std::filesystem::path& cachePath = {});
+        void GenerateProfiles(std::span<const IDynamicProfileGenerator* const> generators, const std::filesystem::path& cachePath = {});
         void ApplyRuntimeInitialSettings();
         void MergeInboxIntoUserSettings();
         void FindFragmentsAndMergeIntoUserSettings();
@@ -67,6 +68,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         bool RemapColorSchemeForProfile(const winrt::com_ptr<winrt::Microsoft::Terminal::Settings::Model::implementation::Profile>& profile);
         bool FixupUserSettings();
 
+        static void TrimJsonCache();
+
         ParsedSettings inboxSettings;
         ParsedSettings userSettings;
         bool duplicateProfile = false;
@@ -74,7 +77,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     private:
         struct JsonSettings
         {
-            Json::Value root;
+            std::shared_ptr<const Json::Value> root;
             const Json::Value& colorSchemes;
             const Json::Value& profileDefaults;
             const Json::Value& profilesList;
@@ -89,11 +92,13 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         void _parse(const OriginTag origin, const winrt::hstring& source, const std::string_view& content, ParsedSettings& settings);
         void _parseFragment(const winrt::hstring& source, const std::string_view& content, ParsedSettings& settings);
         static JsonSettings _parseJson(const std::string_view& content);
+        static JsonSettings _parseJsonCached(const std::string_view& content);
+        static JsonSettings _splitJson(std::shared_ptr<const Json::Value> root);
         static winrt::com_ptr<implementation::Profile> _parseProfile(const OriginTag origin, const winrt::hstring& source, const Json::Value& profileJson);
         void _appendProfile(winrt::com_ptr<Profile>&& profile, const winrt::guid& guid, ParsedSettings& settings);
         void _addUserProfileParent(const winrt::com_ptr<implementation::Profile>& profile);
         void _addOrMergeUserColorScheme(const winrt::com_ptr<implementation::ColorScheme>& colorScheme);
-        void _executeGenerator(const IDynamicProfileGenerator& generator);
+        static Json::Value _readGeneratorCache(const std::filesystem::path& cachePath);
 
         std::unordered_set<std::wstring_view> _ignoredNamespaces;
         // See _getNonUserOriginProfiles().
@@ -154,6 +159,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     private:
         static const std::filesystem::path& _settingsPath();
         static const std::filesystem::path& _releaseSettingsPath();
+        static const std::filesystem::path& _generatorCachePath();
         static winrt::hstring _calculateHash(std::string_view settings, const FILETIME& lastWriteTime);
 
         winrt::com_ptr<implementation::Profile> _createNewProfile(const std::wstring_view& name) const;
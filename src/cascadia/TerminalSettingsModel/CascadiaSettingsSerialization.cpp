@@ -23,6 +23,7 @@
 
 #include "ApplicationState.h"
 #include "DefaultTerminal.h"
+#include "DynamicProfileUtils.h"
 #include "FileUtils.h"
 
 #include "ProfileEntry.h"
@@ -36,12 +37,15 @@ using namespace winrt::Microsoft::Terminal::Settings::Model::implementation;
 
 static constexpr std::wstring_view SettingsFilename{ L"settings.json" };
 static constexpr std::wstring_view DefaultsFilename{ L"defaults.json" };
+static constexpr std::wstring_view GeneratorCacheFilename{ L"generated-profiles.json" };
 
 static constexpr std::string_view ProfilesKey{ "profiles" };
 static constexpr std::string_view DefaultSettingsKey{ "defaults" };
 static constexpr std::string_view ProfilesListKey{ "list" };
 static constexpr std::string_view SchemesKey{ "schemes" };
 static constexpr std::string_view ThemesKey{ "themes" };
+static constexpr std::string_view GeneratorCacheFingerprintKey{ "fingerprint" };
+static constexpr std::string_view GeneratorCacheProfilesKey{ "profiles" };
 
 constexpr std::wstring_view systemThemeName{ L"system" };
 constexpr std::wstring_view darkThemeName{ L"dark" };
@@ -102,6 +106,18 @@ static std::filesystem::path buildPath(const std::wstring_view& lhs, const std::
     return { std::move(buffer) };
 }
 
+// Parsed defaults.json and fragment contents, keyed by their til::hash.
+// Unlike settings.json these rarely change between two settings reloads,
+// so reusing their Json::Value trees avoids reparsing them every time.
+// See SettingsLoader::_parseJsonCached() and SettingsLoader::TrimJsonCache().
+struct ParsedJsonCacheEntry
+{
+    std::string content;
+    std::shared_ptr<const Json::Value> root;
+    bool used = false;
+};
+static til::shared_mutex<std::unordered_map<size_t, ParsedJsonCacheEntry>> parsedJsonCache;
+
 void ParsedSettings::clear()
 {
     globals = {};
@@ -158,15 +174,202 @@ SettingsLoader::SettingsLoader(const std::string_view& userJSON, const std::stri
 
 // Generate dynamic profiles and add them to the list of "inbox" profiles
 // (meaning profiles specified by the application rather by the user).
-void SettingsLoader::GenerateProfiles()
+// This runs the built-in generators. See the overload below for the details.
+void SettingsLoader::GenerateProfiles(const std::filesystem::path& cachePath)
 {
-    _executeGenerator(PowershellCoreProfileGenerator{});
-    _executeGenerator(WslDistroGenerator{});
-    _executeGenerator(AzureCloudShellGenerator{});
-    _executeGenerator(VisualStudioGenerator{});
+    const PowershellCoreProfileGenerator powershellCoreGenerator;
+    const WslDistroGenerator wslDistroGenerator;
+    const AzureCloudShellGenerator azureCloudShellGenerator;
+    const VisualStudioGenerator visualStudioGenerator;
+#if TIL_FEATURE_DYNAMICSSHPROFILES_ENABLED
+    const SshHostGenerator sshHostGenerator;
+#endif
+    const IDynamicProfileGenerator* const generators[]{
+        &powershellCoreGenerator,
+        &wslDistroGenerator,
+        &azureCloudShellGenerator,
+        &visualStudioGenerator,
 #if TIL_FEATURE_DYNAMICSSHPROFILES_ENABLED
-    _executeGenerator(SshHostGenerator{});
+        &sshHostGenerator,
 #endif
+    };
+
+    GenerateProfiles(generators, cachePath);
+}
+
+// The generators are independent of each other and most of them spend their time
+// waiting on the registry, the file system or COM, so each runs on its own thread.
+// Their results are appended in the order of the given list, no matter which finishes first.
+// If a cachePath is given, a generator whose GetFingerprint() is unchanged since the
+// last load doesn't run at all. Its profiles are parsed from the cache instead.
+void SettingsLoader::GenerateProfiles(std::span<const IDynamicProfileGenerator* const> generators, const std::filesystem::path& cachePath)
+{
+    struct GeneratorResult
+    {
+        const IDynamicProfileGenerator* generator = nullptr;
+        std::vector<winrt::com_ptr<Profile>> profiles;
+        // Empty if the result can't be cached.
+        std::string fingerprint;
+        bool cached = false;
+    };
+
+    // The cache is only valid for the binary that wrote it, because the generators
+    // may change between releases, and for the UI language, because some names are localized.
+    Json::Value cache;
+    size_t cacheSeed = 0;
+    auto useCache = !cachePath.empty();
+    if (useCache)
+    {
+        try
+        {
+            til::hasher hasher;
+            hasher.write(GetUserDefaultUILanguage());
+            HashPathAttributes(hasher, wil::GetModuleFileNameW<std::wstring>(wil::GetModuleInstanceHandle()).c_str());
+            cacheSeed = hasher.finalize();
+            cache = _readGeneratorCache(cachePath);
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            useCache = false;
+        }
+    }
+
+    const auto generate = [&](GeneratorResult& result) noexcept {
+        const auto& generator = *result.generator;
+        const auto generatorNamespace = generator.GetNamespace();
+
+        if (useCache)
+        {
+            try
+            {
+                if (const auto fingerprint = generator.GetFingerprint())
+                {
+                    result.fingerprint = fmt::format("{:016x}", til::hasher{ cacheSeed }.write(*fingerprint).finalize());
+
+                    // NOTE: Only the const overloads of Json::Value are safe to call concurrently.
+                    const auto& entry = std::as_const(cache)[til::u16u8(generatorNamespace)];
+                    if (entry.isObject() && entry[JsonKey(GeneratorCacheFingerprintKey)] == result.fingerprint)
+                    {
+                        const winrt::hstring source{ generatorNamespace };
+                        for (const auto& profileJson : entry[JsonKey(GeneratorCacheProfilesKey)])
+                        {
+                            result.profiles.emplace_back(_parseProfile(OriginTag::Generated, source, profileJson));
+                        }
+                        result.cached = true;
+                        return;
+                    }
+                }
+            }
+            catch (...)
+            {
+                LOG_CAUGHT_EXCEPTION();
+                result.profiles.clear();
+                result.fingerprint.clear();
+            }
+        }
+
+        try
+        {
+            generator.GenerateProfiles(result.profiles);
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION_MSG("Dynamic Profile Namespace: \"%.*s\"", gsl::narrow<int>(generatorNamespace.size()), generatorNamespace.data());
+            // Keep whatever the generator produced before failing, but don't cache it.
+            result.fingerprint.clear();
+        }
+    };
+
+    // results must not reallocate while the threads hold references into it.
+    std::vector<GeneratorResult> results;
+    std::vector<std::thread> threads;
+    results.reserve(generators.size());
+    threads.reserve(generators.size());
+
+    for (const auto generator : generators)
+    {
+        if (_ignoredNamespaces.count(generator->GetNamespace()))
+        {
+            continue;
+        }
+
+        auto& result = results.emplace_back();
+        result.generator = generator;
+
+        try
+        {
+            threads.emplace_back([&generate, &result]() {
+                try
+                {
+                    // VisualStudioGenerator uses COM and the thread starts out without an apartment.
+                    const auto coInit = wil::CoInitializeEx(COINIT_MULTITHREADED);
+                    generate(result);
+                }
+                CATCH_LOG()
+            });
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            generate(result);
+        }
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    Json::Value newCache{ Json::objectValue };
+    auto cacheChanged = false;
+
+    for (auto& result : results)
+    {
+        const auto generatorNamespace = result.generator->GetNamespace();
+        const winrt::hstring source{ generatorNamespace };
+
+        // We're going to give the generated profiles default attributes.
+        // By setting the Origin/Source/etc. here, we deduplicate some code and ensure they aren't missing accidentally.
+        for (const auto& profile : result.profiles)
+        {
+            profile->Origin(OriginTag::Generated);
+            profile->Source(source);
+        }
+
+        if (!result.fingerprint.empty())
+        {
+            const auto key = til::u16u8(generatorNamespace);
+            if (result.cached)
+            {
+                newCache[key] = std::as_const(cache)[key];
+            }
+            else
+            {
+                auto& entry = newCache[key];
+                entry[JsonKey(GeneratorCacheFingerprintKey)] = result.fingerprint;
+                auto& profilesJson = entry[JsonKey(GeneratorCacheProfilesKey)] = Json::Value{ Json::arrayValue };
+                for (const auto& profile : result.profiles)
+                {
+                    profilesJson.append(profile->ToJson());
+                }
+                cacheChanged = true;
+            }
+        }
+
+        inboxSettings.profiles.insert(inboxSettings.profiles.end(), std::make_move_iterator(result.profiles.begin()), std::make_move_iterator(result.profiles.end()));
+    }
+
+    if (useCache && cacheChanged)
+    {
+        try
+        {
+            Json::StreamWriterBuilder wbuilder;
+            wbuilder.settings_["indentation"] = "";
+            WriteUTF8FileAtomic(cachePath, Json::writeString(wbuilder, newCache));
+        }
+        CATCH_LOG();
+    }
 }
 
 // A new settings.json gets a special treatment:
@@ -345,7 +548,7 @@ void SettingsLoader::FinalizeLayering()
     if (userSettings.globals->EnableColorSelection())
     {
         const auto json = _parseJson(LoadStringResource(IDR_ENABLE_COLOR_SELECTION));
-        const auto globals = GlobalAppSettings::FromJson(json.root, OriginTag::InBox);
+        const auto globals = GlobalAppSettings::FromJson(*json.root, OriginTag::InBox);
         userSettings.globals->AddLeastImportantParent(globals);
     }
 
@@ -606,12 +809,13 @@ std::span<const winrt::com_ptr<Profile>> SettingsLoader::_getNonUserOriginProfil
 // This function is to be used for user settings files.
 void SettingsLoader::_parse(const OriginTag origin, const winrt::hstring& source, const std::string_view& content, ParsedSettings& settings)
 {
-    const auto json = _parseJson(content);
+    // The inbox settings are the same for every load. The user's aren't.
+    const auto json = origin == OriginTag::InBox ? _parseJsonCached(content) : _parseJson(content);
 
     settings.clear();
 
     {
-        settings.globals = GlobalAppSettings::FromJson(json.root, origin);
+        settings.globals = GlobalAppSettings::FromJson(*json.root, origin);
 
         for (const auto& schemeJson : json.colorSchemes)
         {
@@ -673,7 +877,7 @@ void SettingsLoader::_parse(const OriginTag origin, const winrt::hstring& source
 // schemes and profiles. Additionally this function supports profiles which specify an "updates" key.
 void SettingsLoader::_parseFragment(const winrt::hstring& source, const std::string_view& content, ParsedSettings& settings)
 {
-    auto json = _parseJson(content);
+    const auto json = _parseJsonCached(content);
 
     settings.clear();
 
@@ -699,7 +903,7 @@ void SettingsLoader::_parseFragment(const winrt::hstring& source, const std::str
         // Parse out actions from the fragment. Manually opt-out of keybinding
         // parsing - fragments shouldn't be allowed to bind actions to keys
         // directly. We may want to revisit circa GH#2205
-        settings.globals->LayerActionsFrom(json.root, OriginTag::Fragment, false);
+        settings.globals->LayerActionsFrom(*json.root, OriginTag::Fragment, false);
     }
 
     {
@@ -757,15 +961,54 @@ void SettingsLoader::_parseFragment(const winrt::hstring& source, const std::str
 
 SettingsLoader::JsonSettings SettingsLoader::_parseJson(const std::string_view& content)
 {
-    auto root = content.empty() ? Json::Value{ Json::ValueType::objectValue } : _parseJSON(content);
-    const auto& colorSchemes = _getJSONValue(root, SchemesKey);
-    const auto& themes = _getJSONValue(root, ThemesKey);
-    const auto& profilesObject = _getJSONValue(root, ProfilesKey);
+    auto root = std::make_shared<const Json::Value>(content.empty() ? Json::Value{ Json::ValueType::objectValue } : _parseJSON(content));
+    return _splitJson(std::move(root));
+}
+
+// Like _parseJson, but returns the same (immutable) Json::Value as the last time
+// it was called with identical content. Used for defaults.json and fragments.
+SettingsLoader::JsonSettings SettingsLoader::_parseJsonCached(const std::string_view& content)
+{
+    const auto hash = til::hash(content);
+
+    {
+        const auto cache = parsedJsonCache.lock();
+        if (const auto it = cache->find(hash); it != cache->end() && it->second.content == content)
+        {
+            it->second.used = true;
+            return _splitJson(it->second.root);
+        }
+    }
+
+    // Parse outside of the lock. If another thread parsed the same content
+    // in the meantime, we'll simply overwrite its identical entry.
+    auto json = _parseJson(content);
+
+    const auto cache = parsedJsonCache.lock();
+    cache->insert_or_assign(hash, ParsedJsonCacheEntry{ std::string{ content }, json.root, true });
+    return json;
+}
+
+SettingsLoader::JsonSettings SettingsLoader::_splitJson(std::shared_ptr<const Json::Value> root)
+{
+    const auto& colorSchemes = _getJSONValue(*root, SchemesKey);
+    const auto& themes = _getJSONValue(*root, ThemesKey);
+    const auto& profilesObject = _getJSONValue(*root, ProfilesKey);
     const auto& profileDefaults = _getJSONValue(profilesObject, DefaultSettingsKey);
     const auto& profilesList = profilesObject.isArray() ? profilesObject : _getJSONValue(profilesObject, ProfilesListKey);
     return JsonSettings{ std::move(root), colorSchemes, profileDefaults, profilesList, themes };
 }
 
+// Drops the parsed JSON of files that weren't used since the last call to this function,
+// like fragments that have since been modified or uninstalled. Called after every LoadAll().
+void SettingsLoader::TrimJsonCache()
+{
+    const auto cache = parsedJsonCache.lock();
+    std::erase_if(*cache, [](auto& pair) {
+        return !std::exchange(pair.second.used, false);
+    });
+}
+
 // Just a common helper function between _parse and _parseFragment.
 // Parses a profile and ensures it has a Guid if possible.
 winrt::com_ptr<Profile> SettingsLoader::_parseProfile(const OriginTag origin, const winrt::hstring& source, const Json::Value& profileJson)
@@ -883,36 +1126,25 @@ void SettingsLoader::_addOrMergeUserColorScheme(const winrt::com_ptr<implementat
     }
 }
 
-// As the name implies it executes a generator.
-// Generated profiles are added to .inboxSettings. Used by GenerateProfiles().
-void SettingsLoader::_executeGenerator(const IDynamicProfileGenerator& generator)
+// Reads the file written by GenerateProfiles(), which maps generator namespaces to
+// {"fingerprint": "...", "profiles": [...]}. It's a pure cache, so if it's missing
+// or malformed we simply return an empty object and the generators run as usual.
+Json::Value SettingsLoader::_readGeneratorCache(const std::filesystem::path& cachePath)
 {
-    const auto generatorNamespace = generator.GetNamespace();
-    if (_ignoredNamespaces.count(generatorNamespace))
+    const auto content = ReadUTF8FileIfExists(cachePath).value_or(std::string{});
+    if (!content.empty())
     {
-        return;
-    }
-
-    const auto previousSize = inboxSettings.profiles.size();
-
-    try
-    {
-        generator.GenerateProfiles(inboxSettings.profiles);
-    }
-    CATCH_LOG_MSG("Dynamic Profile Namespace: \"%.*s\"", gsl::narrow<int>(generatorNamespace.size()), generatorNamespace.data())
-
-    // If the generator produced some profiles we're going to give them default attributes.
-    // By setting the Origin/Source/etc. here, we deduplicate some code and ensure they aren't missing accidentally.
-    if (inboxSettings.profiles.size() > previousSize)
-    {
-        const winrt::hstring source{ generatorNamespace };
-
-        for (const auto& profile : std::span(inboxSettings.profiles).subspan(previousSize))
+        try
         {
-            profile->Origin(OriginTag::Generated);
-            profile->Source(source);
+            auto root = _parseJSON(content);
+            if (root.isObject())
+            {
+                return root;
+            }
         }
+        CATCH_LOG();
     }
+    return Json::Value{ Json::objectValue };
 }
 
 // Method Description:
@@ -974,7 +1206,8 @@ try
 
     // Generate dynamic profiles and add them as parents of user profiles.
     // That way the user profiles will get appropriate defaults from the generators (like icons and such).
-    loader.GenerateProfiles();
+    // The cache contains commandlines and is writable by unelevated instances, so elevated ones don't use it.
+    loader.GenerateProfiles(::Microsoft::Console::Utils::IsRunningElevated() ? std::filesystem::path{} : _generatorCachePath());
 
     // ApplyRuntimeInitialSettings depends on generated profiles.
     // --> ApplyRuntimeInitialSettings must be called after GenerateProfiles.
@@ -1019,6 +1252,7 @@ try
         settings->_hash = _calculateHash(settingsString, lastWriteTime);
     }
 
+    SettingsLoader::TrimJsonCache();
     settings->_researchOnLoad();
 
     return *settings;
@@ -1235,6 +1469,18 @@ const std::filesystem::path& CascadiaSettings::_releaseSettingsPath()
     return path;
 }
 
+// Method Description:
+// - Returns the path of the file caching the dynamic profile generator results.
+// Arguments:
+// - <none>
+// Return Value:
+// - Path to the generator cache
+const std::filesystem::path& CascadiaSettings::_generatorCachePath()
+{
+    static const auto path = GetBaseSettingsPath() / GeneratorCacheFilename;
+    return path;
+}
+
 // Returns a has (approximately) uniquely identifying the settings.json contents on disk.
 winrt::hstring CascadiaSettings::_calculateHash(std::string_view settings, const FILETIME& lastWriteTime)
 {
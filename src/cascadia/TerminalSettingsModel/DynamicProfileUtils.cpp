@@ -28,3 +28,25 @@ winrt::com_ptr<winrt::Microsoft::Terminal::Settings::Model::implementation::Prof
     profile->Icon(winrt::hstring{ iconPath });
     return profile;
 }
+
+// Mixes the attributes, size and creation/modification time of the given file or
+// directory into the hasher. Environment variables in the path are expanded.
+// Paths that don't exist are hashed as well, so that creating them changes the result.
+// Used by IDynamicProfileGenerator::GetFingerprint() implementations.
+void HashPathAttributes(til::hasher& hasher, const wchar_t* path)
+{
+    const auto expandedPath = wil::ExpandEnvironmentStringsW<std::wstring>(path);
+
+    WIN32_FILE_ATTRIBUTE_DATA data{};
+    if (!GetFileAttributesExW(expandedPath.c_str(), GetFileExInfoStandard, &data))
+    {
+        data = {};
+    }
+
+    // The last access time is skipped on purpose: Generating profiles updates it.
+    hasher.write(data.dwFileAttributes);
+    hasher.write(data.ftCreationTime);
+    hasher.write(data.ftLastWriteTime);
+    hasher.write(data.nFileSizeHigh);
+    hasher.write(data.nFileSizeLow);
+}
@@ -16,6 +16,8 @@ Author(s):
 
 #include "Profile.h"
 
+#include <til/hash.h>
+
 // !!! LOAD-BEARING
 // If you change or delete this GUID, all dynamic profiles
 // will become disconnected from user settings.
@@ -24,3 +26,4 @@ Author(s):
 inline constexpr GUID TERMINAL_PROFILE_NAMESPACE_GUID = { 0x2bde4a90, 0xd05f, 0x401c, { 0x94, 0x92, 0xe4, 0x8, 0x84, 0xea, 0xd1, 0xd8 } };
 
 winrt::com_ptr<winrt::Microsoft::Terminal::Settings::Model::implementation::Profile> CreateDynamicProfile(const std::wstring_view& name);
+void HashPathAttributes(til::hasher& hasher, const wchar_t* path);
@@ -45,6 +45,8 @@ void GlobalAppSettings::_FinalizeInheritance()
             }
         }
     }
+
+    _actionMap->_FinalizeInheritance();
 }
 
 winrt::com_ptr<GlobalAppSettings> GlobalAppSettings::Copy() const
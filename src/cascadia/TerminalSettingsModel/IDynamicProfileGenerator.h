@@ -31,5 +31,14 @@ namespace winrt::Microsoft::Terminal::Settings::Model
         virtual ~IDynamicProfileGenerator() = default;
         virtual std::wstring_view GetNamespace() const noexcept = 0;
         virtual void GenerateProfiles(std::vector<winrt::com_ptr<implementation::Profile>>& profiles) const = 0;
+
+        // Returns a value that's cheap to compute and changes whenever the inputs of
+        // GenerateProfiles() change (registry keys, files, etc.). If it didn't change
+        // since the last settings load, the previously generated profiles are reused.
+        // Generators that can't provide one return std::nullopt and always run.
+        virtual std::optional<size_t> GetFingerprint() const
+        {
+            return std::nullopt;
+        }
     };
 };
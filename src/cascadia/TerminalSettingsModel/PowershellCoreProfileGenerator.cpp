@@ -338,6 +338,60 @@ void PowershellCoreProfileGenerator::GenerateProfiles(std::vector<winrt::com_ptr
     }
 }
 
+// Function Description:
+// - Hashes the versioned subdirectories of a traditional layout directory and the
+//   pwsh.exe inside each of them. The latter is needed, because updating an existing
+//   installation replaces pwsh.exe without touching the attributes of the directories.
+// Arguments:
+// - hasher: the hasher to write into
+// - directory: the directory that _accumulateTraditionalLayoutPowerShellInstancesInDirectory() searches
+static void _hashTraditionalLayoutPowerShellInstancesInDirectory(til::hasher& hasher, std::wstring_view directory)
+{
+    HashPathAttributes(hasher, directory.data());
+
+    const std::filesystem::path root{ wil::ExpandEnvironmentStringsW<std::wstring>(directory.data()) };
+    std::error_code ec;
+    for (const auto& versionedDir : std::filesystem::directory_iterator(root, ec))
+    {
+        const auto versionedPath = versionedDir.path();
+        const auto executable = versionedPath / PWSH_EXE;
+        hasher.write(versionedPath.native());
+        HashPathAttributes(hasher, versionedPath.c_str());
+        HashPathAttributes(hasher, executable.c_str());
+    }
+}
+
+// Method Description:
+// - Hashes the directories and executables that _collectPowerShellInstances() looks into.
+//   Installing or removing a version adds or removes a versioned subdirectory,
+//   updating it in place replaces its pwsh.exe, and store updates recreate the
+//   package's app execution alias.
+// Arguments:
+// - <none>
+// Return Value:
+// - a fingerprint of the installed PowerShell instances.
+std::optional<size_t> PowershellCoreProfileGenerator::GetFingerprint() const
+{
+    static constexpr std::wstring_view appExecAliasPath{ L"%LOCALAPPDATA%\\Microsoft\\WindowsApps\\" };
+
+    til::hasher hasher;
+    _hashTraditionalLayoutPowerShellInstancesInDirectory(hasher, L"%ProgramFiles%\\PowerShell");
+    _hashTraditionalLayoutPowerShellInstancesInDirectory(hasher, L"%ProgramFiles(x86)%\\PowerShell");
+    _hashTraditionalLayoutPowerShellInstancesInDirectory(hasher, L"%ProgramFiles(Arm)%\\PowerShell");
+    for (const auto& packageFamilyName : { POWERSHELL_PREVIEW_PFN, POWERSHELL_PFN })
+    {
+        std::wstring path{ appExecAliasPath };
+        path.append(packageFamilyName);
+        HashPathAttributes(hasher, path.c_str());
+        path.push_back(L'\\');
+        path.append(PWSH_EXE);
+        HashPathAttributes(hasher, path.c_str());
+    }
+    HashPathAttributes(hasher, L"%USERPROFILE%\\.dotnet\\tools\\pwsh.exe");
+    HashPathAttributes(hasher, L"%USERPROFILE%\\scoop\\shims\\pwsh.exe");
+    return hasher.finalize();
+}
+
 // Function Description:
 // - Returns the thing it's named for.
 // Return value:
@@ -27,5 +27,6 @@ namespace winrt::Microsoft::Terminal::Settings::Model
 
         std::wstring_view GetNamespace() const noexcept override;
         void GenerateProfiles(std::vector<winrt::com_ptr<implementation::Profile>>& profiles) const override;
+        std::optional<size_t> GetFingerprint() const override;
     };
 };
@@ -159,3 +159,19 @@ void SshHostGenerator::GenerateProfiles(std::vector<winrt::com_ptr<implementatio
         }
     }
 }
+
+// Method Description:
+// - Hashes the locations of ssh.exe and the config files GenerateProfiles() parses.
+// Arguments:
+// - <none>
+// Return Value:
+// - a fingerprint of the OpenSSH installation and its configuration.
+std::optional<size_t> SshHostGenerator::GetFingerprint() const
+{
+    til::hasher hasher;
+    for (const auto& path : { SSH_EXE_PATH1, SSH_EXE_PATH2, SSH_EXE_PATH3, SSH_SYSTEM_CONFIG_PATH, SSH_USER_CONFIG_PATH })
+    {
+        HashPathAttributes(hasher, path.data());
+    }
+    return hasher.finalize();
+}
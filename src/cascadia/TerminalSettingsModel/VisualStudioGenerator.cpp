@@ -30,3 +30,25 @@ void VisualStudioGenerator::GenerateProfiles(std::vector<winrt::com_ptr<implemen
         hidden = true;
     }
 }
+
+// The Visual Studio installer keeps a state.json for each instance in this directory.
+// It's rewritten whenever an instance is installed, modified or updated.
+std::optional<size_t> VisualStudioGenerator::GetFingerprint() const
+{
+    const std::filesystem::path instancesPath{ wil::ExpandEnvironmentStringsW<std::wstring>(L"%ProgramData%\\Microsoft\\VisualStudio\\Packages\\_Instances") };
+    if (!std::filesystem::is_directory(instancesPath))
+    {
+        // The package cache may have been relocated, in which case we don't know what to look at.
+        return std::nullopt;
+    }
+
+    til::hasher hasher;
+    HashPathAttributes(hasher, instancesPath.c_str());
+    for (const auto& instance : std::filesystem::directory_iterator(instancesPath))
+    {
+        const auto statePath = instance.path() / L"state.json";
+        hasher.write(instance.path().filename().native());
+        HashPathAttributes(hasher, statePath.c_str());
+    }
+    return hasher.finalize();
+}
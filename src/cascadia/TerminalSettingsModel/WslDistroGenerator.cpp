@@ -235,3 +235,38 @@ void WslDistroGenerator::GenerateProfiles(std::vector<winrt::com_ptr<implementat
         }
     }
 }
+
+// Method Description:
+// - Hashes the last write times of the Lxss key and its distro subkeys.
+//   Registering or unregistering a distro modifies the former,
+//   while renaming one only modifies its own subkey.
+// Arguments:
+// - <none>
+// Return Value:
+// - a fingerprint of the installed WSL distros.
+std::optional<size_t> WslDistroGenerator::GetFingerprint() const
+{
+    til::hasher hasher;
+
+    if (const auto wslRootKey{ openWslRegKey() })
+    {
+        DWORD subKeys = 0;
+        FILETIME lastWriteTime{};
+        THROW_IF_WIN32_ERROR(RegQueryInfoKeyW(wslRootKey.get(), nullptr, nullptr, nullptr, &subKeys, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &lastWriteTime));
+        hasher.write(subKeys);
+        hasher.write(lastWriteTime);
+
+        // Registry key names are limited to 255 characters.
+        std::array<wchar_t, 256> name;
+        for (DWORD i = 0; i < subKeys; ++i)
+        {
+            auto length = gsl::narrow_cast<DWORD>(name.size());
+            if (RegEnumKeyExW(wslRootKey.get(), i, name.data(), &length, nullptr, nullptr, nullptr, &lastWriteTime) == ERROR_SUCCESS)
+            {
+                hasher.write(lastWriteTime);
+            }
+        }
+    }
+
+    return hasher.finalize();
+}
@@ -25,5 +25,6 @@ namespace winrt::Microsoft::Terminal::Settings::Model
     public:
         std::wstring_view GetNamespace() const noexcept override;
         void GenerateProfiles(std::vector<winrt::com_ptr<implementation::Profile>>& profiles) const override;
+        std::optional<size_t> GetFingerprint() const override;
     };
 };
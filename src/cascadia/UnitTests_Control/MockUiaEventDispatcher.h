@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// Records the events a UiaEngine fires, so that tests can inspect them.
+
+#pragma once
+
+#include "../../types/IUiaEventDispatcher.h"
+
+namespace ControlUnitTests
+{
+    class MockUiaEventDispatcher final : public Microsoft::Console::Types::IUiaEventDispatcher
+    {
+    public:
+        void SignalSelectionChanged() override { selectionChanged++; }
+        void SignalTextChanged() override { textChanged++; }
+        void SignalCursorChanged() override { cursorChanged++; }
+        void NotifyNewOutput(std::wstring_view newOutput) override { newOutputs.emplace_back(newOutput); }
+
+        size_t selectionChanged = 0;
+        size_t textChanged = 0;
+        size_t cursorChanged = 0;
+        std::vector<std::wstring> newOutputs;
+    };
+}
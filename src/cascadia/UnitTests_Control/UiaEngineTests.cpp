@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "../../renderer/uia/UiaRenderer.hpp"
+#include "MockUiaEventDispatcher.h"
+
+using namespace Microsoft::Console::Render;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace WEX::Common;
+
+namespace ControlUnitTests
+{
+    class UiaEngineTests
+    {
+        TEST_CLASS(UiaEngineTests);
+
+        TEST_METHOD(AnnouncesEveryNotification);
+        TEST_METHOD(AnnouncesNothingWhileDisabled);
+        TEST_METHOD(SplitsOutputAtLineEnds);
+        TEST_METHOD(SplitsLongLines);
+        TEST_METHOD(TrimsOutputToViewport);
+
+        // Drives the engine through a frame the same way the Renderer does.
+        static void _paintFrame(UiaEngine& engine)
+        {
+            if (engine.StartPaint() == S_OK)
+            {
+                VERIFY_SUCCEEDED(engine.EndPaint());
+                VERIFY_SUCCEEDED(engine.Present());
+            }
+        }
+
+        static std::wstring _join(const std::vector<std::wstring>& outputs)
+        {
+            std::wstring joined;
+            for (const auto& output : outputs)
+            {
+                joined.append(output);
+            }
+            return joined;
+        }
+    };
+
+    void UiaEngineTests::AnnouncesEveryNotification()
+    {
+        MockUiaEventDispatcher dispatcher;
+        UiaEngine engine{ &dispatcher };
+
+        Log::Comment(L"Identical lines (e.g. from `yes`) must each be announced.");
+        VERIFY_SUCCEEDED(engine.NotifyNewText(L"y"));
+        VERIFY_SUCCEEDED(engine.NotifyNewText(L"y"));
+        VERIFY_SUCCEEDED(engine.NotifyNewText(L"."));
+        VERIFY_SUCCEEDED(engine.NotifyNewText(L"."));
+        _paintFrame(engine);
+
+        VERIFY_ARE_EQUAL(1u, dispatcher.newOutputs.size());
+        VERIFY_ARE_EQUAL(L"y\ny\n.\n.\n", std::wstring_view{ dispatcher.newOutputs[0] });
+        VERIFY_ARE_EQUAL(1u, dispatcher.textChanged);
+
+        Log::Comment(L"They're merged into one batch, but nothing is dropped.");
+        VERIFY_ARE_EQUAL(3ull, engine.GetOutputNotificationStats().mergedNotifications);
+        VERIFY_ARE_EQUAL(0ull, engine.GetOutputNotificationStats().droppedCharacters);
+
+        Log::Comment(L"The next frame starts out empty.");
+        VERIFY_SUCCEEDED(engine.NotifyNewText(L"y"));
+        _paintFrame(engine);
+
+        VERIFY_ARE_EQUAL(2u, dispatcher.newOutputs.size());
+        VERIFY_ARE_EQUAL(L"y\n", std::wstring_view{ dispatcher.newOutputs[1] });
+        VERIFY_ARE_EQUAL(3ull, engine.GetOutputNotificationStats().mergedNotifications);
+    }
+
+    void UiaEngineTests::AnnouncesNothingWhileDisabled()
+    {
+        MockUiaEventDispatcher dispatcher;
+        UiaEngine engine{ &dispatcher };
+
+        VERIFY_SUCCEEDED(engine.NotifyNewText(L"foo"));
+        VERIFY_SUCCEEDED(engine.Disable());
+        VERIFY_SUCCEEDED(engine.NotifyNewText(L"bar"));
+        VERIFY_SUCCEEDED(engine.Enable());
+        _paintFrame(engine);
+
+        VERIFY_ARE_EQUAL(0u, dispatcher.newOutputs.size());
+    }
+
+    void UiaEngineTests::SplitsOutputAtLineEnds()
+    {
+        MockUiaEventDispatcher dispatcher;
+        UiaEngine engine{ &dispatcher };
+
+        // 5 lines of 301 characters each (including the newline). The first chunk
+        // can only hold 3 of them without exceeding the speech API's 1000 character limit.
+        const std::wstring line(300, L'x');
+        for (auto i = 0; i < 5; ++i)
+        {
+            VERIFY_SUCCEEDED(engine.NotifyNewText(line));
+        }
+        _paintFrame(engine);
+
+        VERIFY_ARE_EQUAL(2u, dispatcher.newOutputs.size());
+        VERIFY_ARE_EQUAL(903u, dispatcher.newOutputs[0].size());
+        VERIFY_ARE_EQUAL(602u, dispatcher.newOutputs[1].size());
+        VERIFY_ARE_EQUAL(L'\n', dispatcher.newOutputs[0].back());
+
+        std::wstring expected;
+        for (auto i = 0; i < 5; ++i)
+        {
+            expected.append(line);
+            expected.push_back(L'\n');
+        }
+        VERIFY_ARE_EQUAL(expected, _join(dispatcher.newOutputs));
+    }
+
+    void UiaEngineTests::SplitsLongLines()
+    {
+        MockUiaEventDispatcher dispatcher;
+        UiaEngine engine{ &dispatcher };
+
+        // Without a line break within the first 1000 characters we have to split mid-line.
+        const std::wstring line(2500, L'x');
+        VERIFY_SUCCEEDED(engine.NotifyNewText(line));
+        _paintFrame(engine);
+
+        VERIFY_ARE_EQUAL(3u, dispatcher.newOutputs.size());
+        VERIFY_ARE_EQUAL(1000u, dispatcher.newOutputs[0].size());
+        VERIFY_ARE_EQUAL(1000u, dispatcher.newOutputs[1].size());
+        VERIFY_ARE_EQUAL(501u, dispatcher.newOutputs[2].size());
+        VERIFY_ARE_EQUAL(line + L'\n', _join(dispatcher.newOutputs));
+    }
+
+    void UiaEngineTests::TrimsOutputToViewport()
+    {
+        MockUiaEventDispatcher dispatcher;
+        UiaEngine engine{ &dispatcher };
+
+        // A 120x50 viewport can show (120 + 1) * 50 = 6050 characters of output, including newlines.
+        VERIFY_SUCCEEDED(engine.UpdateViewport({ 0, 0, 119, 49 }));
+
+        // 200 lines of 100 characters each (including the newline). This is enough
+        // to make NotifyNewText() trim while we're still receiving output, too.
+        std::vector<std::wstring> lines;
+        for (auto i = 0; i < 200; ++i)
+        {
+            auto& line = lines.emplace_back(fmt::format(L"{:03}", i));
+            line.resize(99, L'x');
+            VERIFY_SUCCEEDED(engine.NotifyNewText(line));
+        }
+        _paintFrame(engine);
+
+        Log::Comment(L"Only the last 60 complete lines fit into the limit and they start with a whole line.");
+        std::wstring expected;
+        for (auto i = 140; i < 200; ++i)
+        {
+            expected.append(lines[i]);
+            expected.push_back(L'\n');
+        }
+        VERIFY_ARE_EQUAL(expected, _join(dispatcher.newOutputs));
+
+        Log::Comment(L"Everything but the first notification was merged and the first 140 lines were dropped.");
+        VERIFY_ARE_EQUAL(199ull, engine.GetOutputNotificationStats().mergedNotifications);
+        VERIFY_ARE_EQUAL(14000ull, engine.GetOutputNotificationStats().droppedCharacters);
+    }
+}
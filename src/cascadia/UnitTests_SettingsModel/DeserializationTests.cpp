@@ -59,6 +59,7 @@ namespace SettingsModelUnitTests
         TEST_METHOD(TestValidDefaults);
         TEST_METHOD(TestInheritedCommand);
         TEST_METHOD(LoadFragmentsWithMultipleUpdates);
+        TEST_METHOD(ReloadCachedFragment);
 
         TEST_METHOD(FragmentActionSimple);
         TEST_METHOD(FragmentActionNoKeys);
@@ -2042,6 +2043,47 @@ namespace SettingsModelUnitTests
         VERIFY_ARE_EQUAL(L"NewName", loader.userSettings.profiles[0]->Name());
     }
 
+    // The inbox settings and fragments are parsed once and their Json::Value
+    // is reused across loads. This ensures that the second load, which hits
+    // that cache, still results in its own, independent set of profiles.
+    void DeserializationTests::ReloadCachedFragment()
+    {
+        static constexpr std::wstring_view fragmentSource{ L"fragment" };
+        static constexpr std::string_view fragmentJson{ R"({
+            "profiles": [
+                {
+                    "updates": "{61c54bbd-c2c6-5271-96e7-009a87ff44bf}",
+                    "name": "NewName"
+                },
+                {
+                    "guid": "{6239a42c-0000-49a3-80bd-e8fdd045185c}",
+                    "commandline": "cmd.exe"
+                }
+            ]
+        })" };
+
+        const auto load = [&]() {
+            implementation::SettingsLoader loader{ std::string_view{}, implementation::LoadStringResource(IDR_DEFAULTS) };
+            loader.MergeInboxIntoUserSettings();
+            loader.MergeFragmentIntoUserSettings(winrt::hstring{ fragmentSource }, fragmentJson);
+            loader.FinalizeLayering();
+            return loader;
+        };
+
+        const auto first = load();
+        const auto second = load();
+
+        VERIFY_ARE_EQUAL(3u, first.userSettings.profiles.size());
+        VERIFY_ARE_EQUAL(3u, second.userSettings.profiles.size());
+        VERIFY_ARE_EQUAL(L"NewName", second.userSettings.profiles[0]->Name());
+        VERIFY_ARE_EQUAL(L"cmd.exe", second.userSettings.profiles[2]->Commandline());
+
+        // Modifying one load must not affect the other.
+        first.userSettings.profiles[2]->Commandline(L"pwsh.exe");
+        VERIFY_ARE_EQUAL(L"cmd.exe", second.userSettings.profiles[2]->Commandline());
+        VERIFY_ARE_NOT_EQUAL(first.userSettings.profiles[2].get(), second.userSettings.profiles[2].get());
+    }
+
     void DeserializationTests::FragmentActionSimple()
     {
         static constexpr std::wstring_view fragmentSource{ L"fragment" };
@@ -0,0 +1,192 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+
+#include "../TerminalSettingsModel/CascadiaSettings.h"
+#include "../TerminalSettingsModel/DynamicProfileUtils.h"
+#include "../TerminalSettingsModel/IDynamicProfileGenerator.h"
+#include "../TerminalSettingsModel/resource.h"
+#include "JsonTestClass.h"
+
+using namespace Microsoft::Console;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace WEX::Common;
+using namespace winrt::Microsoft::Terminal::Settings::Model;
+
+namespace
+{
+    // A generator that returns a fixed list of profile names and counts how often it ran.
+    struct MockProfileGenerator final : IDynamicProfileGenerator
+    {
+        MockProfileGenerator(std::wstring_view generatorNamespace, std::vector<std::wstring> profileNames) :
+            generatorNamespace{ generatorNamespace },
+            profileNames{ std::move(profileNames) }
+        {
+        }
+
+        std::wstring_view GetNamespace() const noexcept override
+        {
+            return generatorNamespace;
+        }
+
+        void GenerateProfiles(std::vector<winrt::com_ptr<implementation::Profile>>& profiles) const override
+        {
+            std::this_thread::sleep_for(delay);
+            for (const auto& name : profileNames)
+            {
+                profiles.emplace_back(CreateDynamicProfile(name));
+            }
+            generateCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::optional<size_t> GetFingerprint() const override
+        {
+            return fingerprint;
+        }
+
+        std::wstring generatorNamespace;
+        std::vector<std::wstring> profileNames;
+        std::optional<size_t> fingerprint;
+        std::chrono::milliseconds delay{ 0 };
+        mutable std::atomic<int> generateCount{ 0 };
+    };
+}
+
+namespace SettingsModelUnitTests
+{
+    class DynamicProfileTests : public JsonTestClass
+    {
+        TEST_CLASS(DynamicProfileTests);
+
+        TEST_METHOD_SETUP(MethodSetup);
+        TEST_METHOD_CLEANUP(MethodCleanup);
+
+        TEST_METHOD(CacheRoundTrip);
+        TEST_METHOD(CacheInvalidatedByFingerprint);
+        TEST_METHOD(UncacheableGeneratorAlwaysRuns);
+        TEST_METHOD(DeterministicProfileOrder);
+
+    private:
+        // Runs the given generators with a fresh loader and verifies the names of the
+        // generated profiles, prefixed with their source and separated by ", ".
+        void _verifyGenerated(std::wstring_view expected, std::initializer_list<const IDynamicProfileGenerator*> generators, const std::filesystem::path& cachePath);
+
+        std::filesystem::path _cachePath;
+    };
+
+    bool DynamicProfileTests::MethodSetup()
+    {
+        _cachePath = std::filesystem::temp_directory_path() / L"DynamicProfileTests.json";
+        std::error_code ec;
+        std::filesystem::remove(_cachePath, ec);
+        return true;
+    }
+
+    bool DynamicProfileTests::MethodCleanup()
+    {
+        std::error_code ec;
+        std::filesystem::remove(_cachePath, ec);
+        return true;
+    }
+
+    void DynamicProfileTests::_verifyGenerated(std::wstring_view expected, std::initializer_list<const IDynamicProfileGenerator*> generators, const std::filesystem::path& cachePath)
+    {
+        implementation::SettingsLoader loader{ std::string_view{}, implementation::LoadStringResource(IDR_DEFAULTS) };
+        const auto inboxProfileCount = loader.inboxSettings.profiles.size();
+        loader.GenerateProfiles(std::span{ generators.begin(), generators.end() }, cachePath);
+
+        std::wstring names;
+        for (auto it = loader.inboxSettings.profiles.begin() + inboxProfileCount; it != loader.inboxSettings.profiles.end(); ++it)
+        {
+            const auto& profile = *it;
+            VERIFY_IS_TRUE(profile->Origin() == OriginTag::Generated);
+            if (!names.empty())
+            {
+                names.append(L", ");
+            }
+            names.append(profile->Source());
+            names.push_back(L'/');
+            names.append(profile->Name());
+        }
+        VERIFY_ARE_EQUAL(expected, std::wstring_view{ names });
+    }
+
+    void DynamicProfileTests::CacheRoundTrip()
+    {
+        MockProfileGenerator generator{ L"Test.Generator", { L"one", L"two" } };
+        generator.fingerprint = 1;
+
+        static constexpr std::wstring_view expected{ L"Test.Generator/one, Test.Generator/two" };
+
+        Log::Comment(L"The first load runs the generator and writes the cache.");
+        _verifyGenerated(expected, { &generator }, _cachePath);
+        VERIFY_ARE_EQUAL(1, generator.generateCount.load());
+        VERIFY_IS_TRUE(std::filesystem::exists(_cachePath));
+
+        Log::Comment(L"The second load reads the same profiles from the cache instead.");
+        _verifyGenerated(expected, { &generator }, _cachePath);
+        VERIFY_ARE_EQUAL(1, generator.generateCount.load());
+
+        Log::Comment(L"Without a cache path the generator always runs.");
+        _verifyGenerated(expected, { &generator }, {});
+        VERIFY_ARE_EQUAL(2, generator.generateCount.load());
+    }
+
+    void DynamicProfileTests::CacheInvalidatedByFingerprint()
+    {
+        MockProfileGenerator generator{ L"Test.Generator", { L"one" } };
+        generator.fingerprint = 1;
+
+        _verifyGenerated(L"Test.Generator/one", { &generator }, _cachePath);
+        VERIFY_ARE_EQUAL(1, generator.generateCount.load());
+
+        Log::Comment(L"A changed fingerprint must not return the stale profiles.");
+        generator.fingerprint = 2;
+        generator.profileNames = { L"two" };
+        _verifyGenerated(L"Test.Generator/two", { &generator }, _cachePath);
+        VERIFY_ARE_EQUAL(2, generator.generateCount.load());
+
+        Log::Comment(L"The cache now holds the new profiles.");
+        _verifyGenerated(L"Test.Generator/two", { &generator }, _cachePath);
+        VERIFY_ARE_EQUAL(2, generator.generateCount.load());
+    }
+
+    void DynamicProfileTests::UncacheableGeneratorAlwaysRuns()
+    {
+        MockProfileGenerator cacheable{ L"Test.Cacheable", { L"one" } };
+        cacheable.fingerprint = 1;
+        MockProfileGenerator uncacheable{ L"Test.Uncacheable", { L"two" } };
+
+        static constexpr std::wstring_view expected{ L"Test.Cacheable/one, Test.Uncacheable/two" };
+
+        _verifyGenerated(expected, { &cacheable, &uncacheable }, _cachePath);
+        _verifyGenerated(expected, { &cacheable, &uncacheable }, _cachePath);
+        VERIFY_ARE_EQUAL(1, cacheable.generateCount.load());
+        VERIFY_ARE_EQUAL(2, uncacheable.generateCount.load());
+    }
+
+    void DynamicProfileTests::DeterministicProfileOrder()
+    {
+        // The first generator finishes last, but its profiles must still come first.
+        MockProfileGenerator slow{ L"Test.Slow", { L"a", L"b" } };
+        slow.delay = std::chrono::milliseconds{ 100 };
+        MockProfileGenerator fast{ L"Test.Fast", { L"c", L"d" } };
+        fast.fingerprint = 1;
+        MockProfileGenerator medium{ L"Test.Medium", { L"e" } };
+        medium.delay = std::chrono::milliseconds{ 50 };
+        medium.fingerprint = 1;
+
+        static constexpr std::wstring_view expected{ L"Test.Slow/a, Test.Slow/b, Test.Fast/c, Test.Fast/d, Test.Medium/e" };
+
+        Log::Comment(L"Freshly generated profiles are appended in generator order.");
+        _verifyGenerated(expected, { &slow, &fast, &medium }, _cachePath);
+
+        Log::Comment(L"The same is true if some of them come from the cache.");
+        _verifyGenerated(expected, { &slow, &fast, &medium }, _cachePath);
+        VERIFY_ARE_EQUAL(2, slow.generateCount.load());
+        VERIFY_ARE_EQUAL(1, fast.generateCount.load());
+        VERIFY_ARE_EQUAL(1, medium.generateCount.load());
+    }
+}
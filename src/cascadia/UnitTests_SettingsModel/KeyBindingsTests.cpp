@@ -6,6 +6,7 @@
 #include "../TerminalSettingsModel/ColorScheme.h"
 #include "../TerminalSettingsModel/CascadiaSettings.h"
 #include "../TerminalSettingsModel/ActionMap.h"
+#include "../TerminalSettingsModel/resource.h"
 #include "JsonTestClass.h"
 #include "TestUtils.h"
 
@@ -40,6 +41,9 @@ namespace SettingsModelUnitTests
         TEST_METHOD(TestMoveTabArgs);
         TEST_METHOD(TestGetKeyBindingForAction);
         TEST_METHOD(KeybindingsWithoutVkey);
+        TEST_METHOD(LookupAcrossParents);
+        TEST_METHOD(LookupTableBuiltOnLoad);
+        TEST_METHOD(LookupTablePerformance);
     };
 
     void KeyBindingsTests::KeyChords()
@@ -815,4 +819,151 @@ namespace SettingsModelUnitTests
         const auto action = actionMap->GetActionByKeyChord({ VirtualKeyModifiers::Shift, 0, 255 });
         VERIFY_IS_NOT_NULL(action);
     }
+
+    void KeyBindingsTests::LookupAcrossParents()
+    {
+        Log::Comment(L"Key chord lookups should see every layer, both before and after the lookup table was built, and notice changes made afterwards.");
+
+        const auto parentJson = VerifyParseSucceeded(R"([ { "command": "copy", "keys": "ctrl+c" }, { "command": "paste", "keys": "ctrl+v" } ])");
+        const auto childJson = VerifyParseSucceeded(R"([ { "command": "unbound", "keys": "ctrl+v" } ])");
+
+        const auto parent = winrt::make_self<implementation::ActionMap>();
+        parent->LayerJson(parentJson, OriginTag::None);
+
+        const auto child = winrt::make_self<implementation::ActionMap>();
+        child->AddLeastImportantParent(parent);
+        child->LayerJson(childJson, OriginTag::None);
+
+        const KeyChord ctrlC{ VirtualKeyModifiers::Control, static_cast<int32_t>('C'), 0 };
+        const KeyChord ctrlV{ VirtualKeyModifiers::Control, static_cast<int32_t>('V'), 0 };
+        const KeyChord ctrlX{ VirtualKeyModifiers::Control, static_cast<int32_t>('X'), 0 };
+
+        const auto verifyInitialBindings = [&]() {
+            VERIFY_IS_NOT_NULL(child->GetActionByKeyChord(ctrlC));
+            VERIFY_IS_NULL(child->GetActionByKeyChord(ctrlV));
+            VERIFY_IS_TRUE(child->IsKeyChordExplicitlyUnbound(ctrlV));
+            VERIFY_IS_NULL(child->GetActionByKeyChord(ctrlX));
+            VERIFY_IS_FALSE(child->IsKeyChordExplicitlyUnbound(ctrlX));
+        };
+
+        VERIFY_IS_FALSE(child->_KeyChordLookup.has_value());
+        verifyInitialBindings();
+
+        child->_FinalizeInheritance();
+        VERIFY_IS_TRUE(child->_KeyChordLookup.has_value());
+        verifyInitialBindings();
+
+        Log::Comment(L"A copy has its own lookup table, which refers to the copied commands.");
+        const auto copy = child->Copy();
+        VERIFY_IS_TRUE(copy->_KeyChordLookup.has_value());
+        VERIFY_IS_NOT_NULL(copy->GetActionByKeyChord(ctrlC));
+        VERIFY_IS_FALSE(copy->GetActionByKeyChord(ctrlC) == child->GetActionByKeyChord(ctrlC));
+
+        child->RegisterKeyBinding(ctrlX, parent->GetActionByKeyChord(ctrlC).ActionAndArgs());
+        child->DeleteKeyBinding(ctrlC);
+
+        VERIFY_IS_NULL(child->GetActionByKeyChord(ctrlC));
+        VERIFY_IS_TRUE(child->IsKeyChordExplicitlyUnbound(ctrlC));
+        VERIFY_IS_NOT_NULL(child->GetActionByKeyChord(ctrlX));
+        VERIFY_IS_NOT_NULL(parent->GetActionByKeyChord(ctrlC));
+        VERIFY_IS_NOT_NULL(copy->GetActionByKeyChord(ctrlC));
+    }
+
+    void KeyBindingsTests::LookupTableBuiltOnLoad()
+    {
+        Log::Comment(L"Loading the settings builds the lookup table once all layers are known, so that lookups never modify the ActionMap.");
+
+        static constexpr std::string_view userSettings{ R"({
+            "actions": [ { "command": "unbound", "keys": "ctrl+shift+w" } ]
+        })" };
+
+        const auto settings = winrt::make_self<implementation::CascadiaSettings>(userSettings, implementation::LoadStringResource(IDR_DEFAULTS));
+        const auto actionMap = winrt::get_self<implementation::ActionMap>(settings->GlobalSettings().ActionMap());
+        VERIFY_IS_TRUE(actionMap->_KeyChordLookup.has_value());
+
+        const KeyChord ctrlShiftT{ VirtualKeyModifiers::Control | VirtualKeyModifiers::Shift, static_cast<int32_t>('T'), 0 };
+        const KeyChord ctrlShiftW{ VirtualKeyModifiers::Control | VirtualKeyModifiers::Shift, static_cast<int32_t>('W'), 0 };
+
+        const auto lookupBefore = *actionMap->_KeyChordLookup;
+        VERIFY_IS_NOT_NULL(actionMap->GetActionByKeyChord(ctrlShiftT));
+        VERIFY_IS_TRUE(actionMap->IsKeyChordExplicitlyUnbound(ctrlShiftW));
+        VERIFY_ARE_EQUAL(lookupBefore.size(), actionMap->_KeyChordLookup->size());
+    }
+
+    void KeyBindingsTests::LookupTablePerformance()
+    {
+        Log::Comment(L"Compares key chord lookups through the lookup table with walking the layers, using the default settings.");
+
+        static constexpr std::string_view userSettings{ R"({
+            "actions": [
+                { "command": "unbound", "keys": "ctrl+shift+w" },
+                { "command": "copy", "keys": "ctrl+shift+y" },
+                { "command": "paste", "keys": "ctrl+shift+z" }
+            ]
+        })" };
+
+        const auto settings = winrt::make_self<implementation::CascadiaSettings>(userSettings, implementation::LoadStringResource(IDR_DEFAULTS));
+        const auto actionMap = winrt::get_self<implementation::ActionMap>(settings->GlobalSettings().ActionMap());
+        VERIFY_IS_TRUE(actionMap->_KeyChordLookup.has_value());
+
+        // Every combination of modifiers with letters, digits and function keys.
+        // Most of them aren't bound, which is the common case when typing.
+        std::vector<KeyChord> chords;
+        for (uint32_t modifiers = 0; modifiers < 16; ++modifiers)
+        {
+            const auto mods = static_cast<VirtualKeyModifiers>(modifiers);
+            for (int32_t vkey = '0'; vkey <= '9'; ++vkey)
+            {
+                chords.emplace_back(mods, vkey, 0);
+            }
+            for (int32_t vkey = 'A'; vkey <= 'Z'; ++vkey)
+            {
+                chords.emplace_back(mods, vkey, 0);
+            }
+            for (int32_t vkey = VK_F1; vkey <= VK_F12; ++vkey)
+            {
+                chords.emplace_back(mods, vkey, 0);
+            }
+        }
+
+        size_t mismatches = 0;
+        for (const auto& keys : chords)
+        {
+            if (actionMap->GetActionByKeyChord(keys) != actionMap->_GetActionByKeyChordInternal(keys).value_or(nullptr))
+            {
+                Log::Error(NoThrowString().Format(L"Lookups disagree for %s", KeyChordSerialization::ToString(keys).c_str()));
+                ++mismatches;
+            }
+        }
+        VERIFY_ARE_EQUAL(0u, mismatches);
+
+        static constexpr size_t rounds = 100;
+        const auto measure = [&](auto&& lookup) {
+            size_t bound = 0;
+            const auto beg = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < rounds; ++i)
+            {
+                for (const auto& keys : chords)
+                {
+                    bound += lookup(keys) != nullptr;
+                }
+            }
+            const auto end = std::chrono::steady_clock::now();
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - beg).count();
+            return std::pair{ static_cast<double>(ns) / static_cast<double>(rounds * chords.size()), bound };
+        };
+
+        const auto [packed, packedBound] = measure([&](const KeyChord& keys) {
+            return actionMap->GetActionByKeyChord(keys);
+        });
+        const auto [layered, layeredBound] = measure([&](const KeyChord& keys) {
+            return actionMap->_GetActionByKeyChordInternal(keys).value_or(nullptr);
+        });
+        VERIFY_ARE_EQUAL(packedBound, layeredBound);
+
+        // Timings vary too much between machines to be verified. They're only logged for comparison.
+        Log::Comment(NoThrowString().Format(L"%zu key chords, %zu bound, %zu rounds", chords.size(), packedBound / rounds, rounds));
+        Log::Comment(NoThrowString().Format(L"lookup table: %.1f ns per lookup", packed));
+        Log::Comment(NoThrowString().Format(L"layer walk:   %.1f ns per lookup", layered));
+    }
 }
@@ -41,6 +41,8 @@ namespace TerminalCoreUnitTests
 
         TEST_METHOD(SetTaskbarProgress);
         TEST_METHOD(SetWorkingDirectory);
+
+        TEST_METHOD(AlternateBufferIsRecycled);
     };
 };
 
@@ -476,3 +478,30 @@ void TerminalCoreUnitTests::TerminalApiTest::SetWorkingDirectory()
     stateMachine.ProcessString(L"\x1b]9;9;D:\\中文\x1b\\");
     VERIFY_ARE_EQUAL(term.GetWorkingDirectory(), L"D:\\中文");
 }
+
+void TerminalApiTest::AlternateBufferIsRecycled()
+{
+    Terminal term{ Terminal::TestDummyMarker{} };
+    DummyRenderer renderer{ &term };
+    term.Create({ 100, 100 }, 0, renderer);
+
+    auto& stateMachine = *(term._stateMachine);
+
+    Log::Comment(L"Write some content into the alt buffer");
+    stateMachine.ProcessString(L"\x1b[?1049h");
+    stateMachine.ProcessString(L"\x1b[2;5HAlternate\x1b#6");
+    const auto firstAltRow = &term._altBuffer->GetRowByOffset(1);
+    VERIFY_ARE_NOT_EQUAL(std::wstring_view::npos, firstAltRow->GetText().find_first_not_of(L' '));
+
+    Log::Comment(L"The alt buffer is kept for reuse when switching back to the main buffer");
+    stateMachine.ProcessString(L"\x1b[?1049l");
+    VERIFY_IS_NOT_NULL(term._recycledAltBuffer.get());
+
+    Log::Comment(L"The next alt buffer reuses its memory, but starts out blank");
+    stateMachine.ProcessString(L"\x1b[?1049h");
+    VERIFY_IS_NULL(term._recycledAltBuffer.get());
+    const auto& secondAltRow = term._altBuffer->GetRowByOffset(1);
+    VERIFY_IS_TRUE(firstAltRow == &secondAltRow);
+    VERIFY_ARE_EQUAL(std::wstring_view::npos, secondAltRow.GetText().find_first_not_of(L' '));
+    VERIFY_IS_TRUE(secondAltRow.GetLineRendition() == LineRendition::SingleWidth);
+}
@@ -463,6 +463,48 @@ CATCH_RETURN();
     return result;
 }
 
+// Routine Description:
+// - Converts a horizontal slice of a ROW into CHAR_INFOs.
+// - The legacy attributes are computed once per attribute run instead of once per cell.
+// Arguments:
+// - row - The row to read from
+// - columnBegin - The first column to read
+// - target - The CHAR_INFOs to fill. Its size determines the number of columns read.
+// Return Value:
+// - <none>
+static void _ReadCharInfoRow(const ROW& row, const til::CoordType columnBegin, const std::span<CHAR_INFO> target)
+{
+    const auto columnEnd = columnBegin + gsl::narrow_cast<til::CoordType>(target.size());
+    auto out = target.begin();
+    til::CoordType runBeg = 0;
+
+    for (const auto& run : row.Attributes().runs())
+    {
+        const auto runEnd = runBeg + til::CoordType{ run.length };
+        const auto beg = std::max(runBeg, columnBegin);
+        const auto end = std::min(runEnd, columnEnd);
+
+        if (beg < end)
+        {
+            const auto legacyAttributes = run.value.GetLegacyAttributes();
+
+            for (auto col = beg; col < end; ++col, ++out)
+            {
+                // CHAR_INFO holds a single UCS-2 character. Grapheme clusters that
+                // don't fit (e.g. "e" + U+0301) are returned as U+FFFD instead.
+                out->Char.UnicodeChar = Utf16ToUcs2(row.GlyphAt(col));
+                out->Attributes = legacyAttributes | GeneratePublicApiAttributeFormat(row.DbcsAttrAt(col));
+            }
+        }
+
+        if (runEnd >= columnEnd)
+        {
+            break;
+        }
+        runBeg = runEnd;
+    }
+}
+
 [[nodiscard]] static HRESULT _ReadConsoleOutputWImplHelper(const SCREEN_INFORMATION& context,
                                                            std::span<CHAR_INFO> targetBuffer,
                                                            const Microsoft::Console::Types::Viewport& requestRectangle,
@@ -470,7 +512,6 @@ CATCH_RETURN();
 {
     try
     {
-        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         const auto& storageBuffer = context.GetActiveBuffer().GetTextBuffer();
         const auto storageSize = storageBuffer.GetSize().Dimensions();
 
@@ -507,41 +548,22 @@ CATCH_RETURN();
 
         // We will start reading the buffer at the point of the top left corner (origin) of the (potentially adjusted) request
         const auto sourcePoint = clippedRequestRectangle.Origin();
+        const auto clippedSize = clippedRequestRectangle.Dimensions();
 
-        // Get an iterator to the beginning of the return buffer
-        // We might have to seek this forward or skip around if we clipped the request.
-        auto targetIter = targetBuffer.begin();
-        til::point targetPos;
-        const auto targetLimit = Viewport::FromDimensions(targetPoint, clippedRequestRectangle.Dimensions());
-
-        // Get an iterator to the beginning of the request inside the screen buffer
-        // This should walk exactly along every cell of the clipped request.
-        auto sourceIter = storageBuffer.GetCellDataAt(sourcePoint, clippedRequestRectangle);
-
-        // Walk through every cell of the target, advancing the buffer.
-        // Validate that we always still have a valid iterator to the backing store,
-        // that we always are writing inside the user's buffer (before the end)
-        // and we're always targeting the user's buffer inside its original bounds.
-        while (sourceIter && targetIter < targetBuffer.end())
+        // Copy the clipped request one row at a time into the corresponding (potentially offset) slice of
+        // the user's buffer. The user's buffer might be smaller than the request, so we stop once we run out of it.
+        if (clippedSize.width > 0)
         {
-            // If the point we're trying to write is inside the limited buffer write zone...
-            if (targetLimit.IsInBounds(targetPos))
+            for (til::CoordType y = 0; y < clippedSize.height; ++y)
             {
-                // Copy the data into position...
-                *targetIter = gci.AsCharInfo(*sourceIter);
-                // ... and advance the read iterator.
-                ++sourceIter;
-            }
-
-            // Always advance the write iterator, we might have skipped it due to clipping.
-            ++targetIter;
+                const auto targetOffset = static_cast<size_t>(targetPoint.y + y) * targetSize.width + targetPoint.x;
+                if (targetOffset >= targetBuffer.size())
+                {
+                    break;
+                }
 
-            // Increment the target
-            targetPos.x++;
-            if (targetPos.x >= targetSize.width)
-            {
-                targetPos.x = 0;
-                targetPos.y++;
+                const auto targetCount = std::min<size_t>(clippedSize.width, targetBuffer.size() - targetOffset);
+                _ReadCharInfoRow(storageBuffer.GetRowByOffset(sourcePoint.y + y), sourcePoint.x, targetBuffer.subspan(targetOffset, targetCount));
             }
         }
 
@@ -599,6 +621,50 @@ CATCH_RETURN();
     CATCH_RETURN();
 }
 
+// Routine Description:
+// - Writes a horizontal slice of CHAR_INFOs into a ROW as a single run of text,
+//   followed by one ReplaceAttributes() call per run of identical attributes.
+// - This only works if none of the CHAR_INFOs are marked as the leading or trailing half of a wide glyph,
+//   which is the common case for full-screen applications. Everything else needs to go through the
+//   OutputCellIterator, which knows how to deal with wide glyphs that are cut off by the request.
+// Arguments:
+// - row - The row to write into
+// - columnBegin - The first column to write
+// - charInfos - The cells to write
+// - text - Scratch buffer for the text of the row, reused across calls
+// Return Value:
+// - true if the row was written, false if the caller has to fall back to the OutputCellIterator.
+[[nodiscard]] static bool _WriteNarrowCharInfoRow(ROW& row, const til::CoordType columnBegin, const std::span<const CHAR_INFO> charInfos, std::wstring& text)
+{
+    text.clear();
+
+    auto col = columnBegin;
+    auto runBeg = columnBegin;
+    auto runAttributes = charInfos.front().Attributes;
+
+    for (const auto& ci : charInfos)
+    {
+        if (WI_IsAnyFlagSet(ci.Attributes, COMMON_LVB_SBCSDBCS))
+        {
+            return false;
+        }
+
+        if (ci.Attributes != runAttributes)
+        {
+            row.ReplaceAttributes(runBeg, col, TextAttribute{ runAttributes });
+            runBeg = col;
+            runAttributes = ci.Attributes;
+        }
+
+        text.push_back(ci.Char.UnicodeChar);
+        ++col;
+    }
+
+    row.ReplaceAttributes(runBeg, col, TextAttribute{ runAttributes });
+    row.ReplaceNarrowCharacters(columnBegin, text);
+    return true;
+}
+
 [[nodiscard]] static HRESULT _WriteConsoleOutputWImplHelper(SCREEN_INFORMATION& context,
                                                             std::span<CHAR_INFO> buffer,
                                                             const Viewport& requestRectangle,
@@ -668,6 +734,11 @@ CATCH_RETURN();
 
         const auto writeRectangle = Viewport::FromInclusive(writeRegion);
 
+        auto& textBuffer = storageBuffer.GetTextBuffer();
+        std::wstring text;
+        text.reserve(gsl::narrow_cast<size_t>(writeRectangle.Width()));
+        auto wroteNarrowRows = false;
+
         auto target = writeRectangle.Origin();
 
         // For every row in the request, create a view into the clamped portion of just the one line to write.
@@ -686,11 +757,23 @@ CATCH_RETURN();
             // Convert to a CHAR_INFO view to fit into the iterator
             const auto charInfos = std::span<const CHAR_INFO>(subspan.data(), subspan.size());
 
+            if (_WriteNarrowCharInfoRow(textBuffer.GetMutableRowByOffset(target.y), target.x, charInfos, text))
+            {
+                wroteNarrowRows = true;
+                continue;
+            }
+
             // Make the iterator and write to the target position.
             OutputCellIterator it(charInfos);
             storageBuffer.Write(it, target);
         }
 
+        // Rows written by _WriteNarrowCharInfoRow bypassed TextBuffer::WriteLine, which usually takes care of this.
+        if (wroteNarrowRows)
+        {
+            textBuffer.TriggerRedraw(writeRectangle);
+        }
+
         // Since we've managed to write part of the request, return the clamped part that we actually used.
         writtenRectangle = writeRectangle;
 
@@ -166,6 +166,7 @@ class DbcsTests
     END_TEST_METHOD()
 
     TEST_METHOD(TestNarrowSurrogate);
+    TEST_METHOD(TestCombiningCluster);
 };
 
 bool DbcsTests::DbcsTestSetup()
@@ -2200,3 +2201,29 @@ void DbcsTests::TestNarrowSurrogate()
     VERIFY_WIN32_BOOL_SUCCEEDED(ReadConsoleOutputCharacterW(out, &buf[0], ARRAYSIZE(buf), {}, &read));
     VERIFY_ARE_EQUAL(std::wstring_view(L"a\U0000FFFDb"), std::wstring_view(&buf[0], read));
 }
+
+// Text written with WriteConsoleW is stored as grapheme clusters, one per cell. "e" followed by
+// U+0301 COMBINING ACUTE ACCENT thus occupies a single cell which can't be represented by a single
+// wchar_t. Just like with surrogate pairs above, the read APIs return U+FFFD for such cells.
+void DbcsTests::TestCombiningCluster()
+{
+    const auto out = GetStdHandle(STD_OUTPUT_HANDLE);
+    CONSOLE_SCREEN_BUFFER_INFO csbi{};
+    wchar_t buf[3];
+    DWORD read;
+
+    VERIFY_WIN32_BOOL_SUCCEEDED(SetConsoleCursorPosition(out, {}));
+    VERIFY_WIN32_BOOL_SUCCEEDED(WriteConsoleW(out, L"ae\x0301b", 4, &read, nullptr));
+    VERIFY_WIN32_BOOL_SUCCEEDED(GetConsoleScreenBufferInfo(out, &csbi));
+    VERIFY_ARE_EQUAL(3, csbi.dwCursorPosition.X);
+
+    VERIFY_WIN32_BOOL_SUCCEEDED(ReadConsoleOutputCharacterW(out, &buf[0], ARRAYSIZE(buf), {}, &read));
+    VERIFY_ARE_EQUAL(std::wstring_view(L"a\U0000FFFDb"), std::wstring_view(&buf[0], read));
+
+    CHAR_INFO cells[3]{};
+    SMALL_RECT region{ 0, 0, 2, 0 };
+    VERIFY_WIN32_BOOL_SUCCEEDED(ReadConsoleOutputW(out, &cells[0], { 3, 1 }, {}, &region));
+    VERIFY_ARE_EQUAL(L'a', cells[0].Char.UnicodeChar);
+    VERIFY_ARE_EQUAL(L'\xFFFD', cells[1].Char.UnicodeChar);
+    VERIFY_ARE_EQUAL(L'b', cells[2].Char.UnicodeChar);
+}
@@ -222,6 +222,9 @@ std::wstring ReadOutputStringW(const SCREEN_INFORMATION& screenInfo,
             // Otherwise, add anything that isn't a trailing cell. (Trailings are duplicate copies of the leading.)
             if (it->DbcsAttr() != DbcsAttribute::Trailing)
             {
+                // Cells hold entire grapheme clusters (surrogate pairs, but also combining marks and emoji
+                // sequences). This API is UCS-2 based and callers expect one wchar_t per cell,
+                // so cells that don't fit into one are returned as U+FFFD. See DbcsTests::TestCombiningCluster.
                 auto chars = it->Chars();
                 if (chars.size() > 1)
                 {
@@ -28,6 +28,30 @@ constexpr int integerLog10(uint32_t v)
                                0;
 }
 
+// Returns the closest grapheme cluster boundary at or before the given offset.
+static size_t graphemeBoundaryBefore(const std::wstring_view& text, size_t offset) noexcept
+{
+    offset = std::min(offset, text.size());
+    if (offset == 0)
+    {
+        return 0;
+    }
+    const auto beg = TextBuffer::GraphemePrev(text, offset);
+    return TextBuffer::GraphemeNext(text, beg) <= offset ? offset : beg;
+}
+
+// Returns the closest grapheme cluster boundary at or after the given offset.
+static size_t graphemeBoundaryAfter(const std::wstring_view& text, size_t offset) noexcept
+{
+    offset = std::min(offset, text.size());
+    if (offset == 0)
+    {
+        return 0;
+    }
+    const auto end = TextBuffer::GraphemeNext(text, TextBuffer::GraphemePrev(text, offset));
+    return std::max(end, offset);
+}
+
 const std::wstring& COOKED_READ_DATA::BufferState::Get() const noexcept
 {
     return _buffer;
@@ -42,6 +66,9 @@ void COOKED_READ_DATA::BufferState::Replace(size_t offset, size_t remove, const
     _buffer.replace(offset, remove, input, count);
     _cursor = offset + count;
     _dirtyBeg = std::min(_dirtyBeg, offset);
+    // A checkpoint at `offset` is invalid too, because the new text
+    // may extend the preceding grapheme cluster (e.g. a combining mark).
+    _invalidateCheckpoints(offset);
 }
 
 void COOKED_READ_DATA::BufferState::Replace(const std::wstring_view& str)
@@ -49,6 +76,7 @@ void COOKED_READ_DATA::BufferState::Replace(const std::wstring_view& str)
     _buffer.assign(str);
     _cursor = _buffer.size();
     _dirtyBeg = 0;
+    _checkpoints.clear();
 }
 
 size_t COOKED_READ_DATA::BufferState::GetCursorPosition() const noexcept
@@ -72,6 +100,7 @@ bool COOKED_READ_DATA::BufferState::IsClean() const noexcept
 void COOKED_READ_DATA::BufferState::MarkEverythingDirty() noexcept
 {
     _dirtyBeg = 0;
+    _checkpoints.clear();
 }
 
 void COOKED_READ_DATA::BufferState::MarkAsClean() noexcept
@@ -79,31 +108,47 @@ void COOKED_READ_DATA::BufferState::MarkAsClean() noexcept
     _dirtyBeg = npos;
 }
 
-std::wstring_view COOKED_READ_DATA::BufferState::GetUnmodifiedTextBeforeCursor() const noexcept
+size_t COOKED_READ_DATA::BufferState::GetDirtyBeg() const noexcept
 {
-    return _slice(0, std::min(_dirtyBeg, _cursor));
+    return _dirtyBeg;
 }
 
-std::wstring_view COOKED_READ_DATA::BufferState::GetUnmodifiedTextAfterCursor() const noexcept
+std::wstring_view COOKED_READ_DATA::BufferState::Slice(size_t from, size_t to) const noexcept
 {
-    return _slice(_cursor, _dirtyBeg);
+    to = std::min(to, _buffer.size());
+    from = std::min(from, to);
+    return std::wstring_view{ _buffer.data() + from, to - from };
 }
 
-std::wstring_view COOKED_READ_DATA::BufferState::GetModifiedTextBeforeCursor() const noexcept
+// Returns the closest checkpoint at or before the given offset.
+// The start of the prompt serves as an implicit checkpoint at offset 0.
+COOKED_READ_DATA::BufferState::Checkpoint COOKED_READ_DATA::BufferState::GetCheckpoint(size_t offset) const noexcept
 {
-    return _slice(_dirtyBeg, _cursor);
+    const auto it = std::upper_bound(_checkpoints.begin(), _checkpoints.end(), offset, [](size_t off, const Checkpoint& cp) {
+        return off < cp.offset;
+    });
+    return it == _checkpoints.begin() ? Checkpoint{} : *(it - 1);
 }
 
-std::wstring_view COOKED_READ_DATA::BufferState::GetModifiedTextAfterCursor() const noexcept
+// Checkpoints must be added in increasing order, which _flushBuffer() naturally does.
+void COOKED_READ_DATA::BufferState::AddCheckpoint(size_t offset, ptrdiff_t distance)
 {
-    return _slice(std::max(_dirtyBeg, _cursor), npos);
+    if (!_checkpoints.empty() && _checkpoints.back().offset >= offset)
+    {
+        _invalidateCheckpoints(offset);
+    }
+    _checkpoints.emplace_back(Checkpoint{ offset, distance });
 }
 
-std::wstring_view COOKED_READ_DATA::BufferState::_slice(size_t from, size_t to) const noexcept
+// Removes all checkpoints at or past the given offset, because the text following it has changed.
+// Whether a checkpoint sits on a grapheme cluster boundary depends on the text right after it,
+// which is why a checkpoint exactly at the offset has to go as well.
+void COOKED_READ_DATA::BufferState::_invalidateCheckpoints(size_t offset) noexcept
 {
-    to = std::min(to, _buffer.size());
-    from = std::min(from, to);
-    return std::wstring_view{ _buffer.data() + from, to - from };
+    while (!_checkpoints.empty() && _checkpoints.back().offset >= offset)
+    {
+        _checkpoints.pop_back();
+    }
 }
 
 // Routine Description:
@@ -815,39 +860,52 @@ void COOKED_READ_DATA::_flushBuffer()
     // * `_buffer._cursor`: Text before the `_buffer._cursor` index must be accumulated
     //   into `distanceBeforeCursor` and the other half into `distanceAfterCursor`.
     //   This helps us figure out where the cursor is positioned on the screen.
-    // * `_buffer._dirtyBeg`: Text before `_buffer._dirtyBeg` must be written with SuppressMSAA
-    //   and the other half without. Any text before `_buffer._dirtyBeg` is considered unchanged,
-    //   and this split prevents us from announcing text that hasn't actually changed
-    //   to accessibility tools via MSAA (or UIA, but UIA is robust against this anyways).
+    // * `_buffer._dirtyBeg`: Text before `_buffer._dirtyBeg` is considered unchanged and only
+    //   needs to be measured, while the other half needs to be written. This split prevents us from
+    //   announcing text that hasn't actually changed to accessibility tools via MSAA (or UIA,
+    //   but UIA is robust against this anyways).
+    //
+    // Measuring the unchanged text is accelerated by the checkpoints we record while writing.
+    // Without them, typing at the end of a multi-thousand character line would re-measure the
+    // entire line on every keystroke, even though only the last few characters changed.
     //
-    // This results in 2*2 = 4 writes of which always at least one of the middle two is empty,
-    // depending on whether _buffer._cursor > _buffer._dirtyBeg or _buffer._cursor < _buffer._dirtyBeg.
-    // slice() returns an empty string-view when `from` index is greater than the `to` index.
+    // Both indices are moved to the nearest grapheme cluster boundary, since writing half a cluster
+    // (e.g. a combining mark typed after an "e") would put each half into a separate cell.
+    const auto& text = _buffer.Get();
+    const auto size = text.size();
+    const auto cursor = graphemeBoundaryAfter(text, _buffer.GetCursorPosition());
+    const auto dirtyBeg = graphemeBoundaryBefore(text, _buffer.GetDirtyBeg());
 
     ptrdiff_t distanceBeforeCursor = 0;
-    ptrdiff_t distanceAfterCursor = 0;
+    ptrdiff_t dirtyBegDistance = 0;
+    if (dirtyBeg <= cursor)
+    {
+        dirtyBegDistance = _measureTo(dirtyBeg, {});
+    }
+    else
     {
-        // _distanceCursor might be larger than the entire viewport (= a really long input line).
-        // _offsetCursorPosition() with such an offset will end up clamping the cursor position to (0,0).
-        // To make this implementation behave a little bit more consistent in this case without
-        // writing a more thorough and complex readline implementation, we pass _measureChars()
-        // the relative "distance" to the current actual cursor position. That way _measureChars()
-        // can still figure out what the logical cursor position is, when it handles tabs, etc.
-        auto dirtyBegDistance = -_distanceCursor;
-
-        distanceBeforeCursor = _measureChars(_buffer.GetUnmodifiedTextBeforeCursor(), dirtyBegDistance);
-        dirtyBegDistance += distanceBeforeCursor;
-        distanceAfterCursor = _measureChars(_buffer.GetUnmodifiedTextAfterCursor(), dirtyBegDistance);
-        dirtyBegDistance += distanceAfterCursor;
-
-        _offsetCursorPosition(dirtyBegDistance);
+        distanceBeforeCursor = _measureTo(cursor, {});
+        dirtyBegDistance = _measureTo(dirtyBeg, { cursor, distanceBeforeCursor });
     }
 
+    // _distanceCursor might be larger than the entire viewport (= a really long input line).
+    // _offsetCursorPosition() with such an offset will end up clamping the cursor position to (0,0).
+    // This is why we move relative to the current actual cursor position.
+    _offsetCursorPosition(dirtyBegDistance - _distanceCursor);
+
     // Now we can finally write the parts of _buffer that have actually changed (or moved).
-    distanceBeforeCursor += _writeChars(_buffer.GetModifiedTextBeforeCursor());
-    distanceAfterCursor += _writeChars(_buffer.GetModifiedTextAfterCursor());
+    ptrdiff_t distanceEnd = 0;
+    if (dirtyBeg <= cursor)
+    {
+        distanceBeforeCursor = _writeCharsWithCheckpoints(dirtyBeg, cursor, dirtyBegDistance);
+        distanceEnd = _writeCharsWithCheckpoints(cursor, size, distanceBeforeCursor);
+    }
+    else
+    {
+        distanceEnd = _writeCharsWithCheckpoints(dirtyBeg, size, dirtyBegDistance);
+    }
 
-    const auto distanceEnd = distanceBeforeCursor + distanceAfterCursor;
+    const auto distanceAfterCursor = distanceEnd - distanceBeforeCursor;
     const auto eraseDistance = std::max<ptrdiff_t>(0, _distanceEnd - distanceEnd);
 
     // If the contents of _buffer became shorter we'll have to erase the previously printed contents.
@@ -860,6 +918,54 @@ void COOKED_READ_DATA::_flushBuffer()
     _distanceEnd = distanceEnd;
 }
 
+// Returns the distance in columns between the start of the prompt and the given offset into _buffer.
+// The offset must not be past the first dirty offset, since we only measure text that has previously been written.
+// `known` is an already measured position, which is used as the starting point if it's closer than any checkpoint.
+ptrdiff_t COOKED_READ_DATA::_measureTo(size_t offset, BufferState::Checkpoint known) const
+{
+    auto start = _buffer.GetCheckpoint(offset);
+    if (known.offset <= offset && known.offset > start.offset)
+    {
+        start = known;
+    }
+
+    // _measureChars() is given the position relative to the actual cursor position,
+    // so that it can figure out the logical column when it handles tabs, etc.
+    return start.distance + _measureChars(_buffer.Slice(start.offset, offset), start.distance - _distanceCursor);
+}
+
+// Writes the contents of _buffer between `beg` and `end` and returns the distance in columns between the start
+// of the prompt and `end`. `distance` is the distance at `beg`. While doing so, it records a checkpoint roughly
+// every CheckpointInterval many code units, which allows future calls to _measureTo() to skip most of the text.
+ptrdiff_t COOKED_READ_DATA::_writeCharsWithCheckpoints(size_t beg, size_t end, ptrdiff_t distance)
+{
+    const auto& text = _buffer.Get();
+    end = std::min(end, text.size());
+
+    while (beg < end)
+    {
+        auto next = (beg / CheckpointInterval + 1) * CheckpointInterval;
+        // Splitting a grapheme cluster would write its halves into separate cells.
+        // It would also record a checkpoint that _measureTo() can't start measuring from.
+        if (next < end)
+        {
+            next = graphemeBoundaryAfter(text, next);
+        }
+        next = std::min(next, end);
+
+        distance += _writeChars(_buffer.Slice(beg, next));
+        beg = next;
+
+        // There's no need for a checkpoint at the end of the buffer, since there's nothing to measure past it.
+        if (beg < text.size())
+        {
+            _buffer.AddCheckpoint(beg, distance);
+        }
+    }
+
+    return distance;
+}
+
 // This is just a small helper to fill the next N cells starting at the current cursor position with whitespace.
 void COOKED_READ_DATA::_erase(ptrdiff_t distance) const
 {
@@ -53,6 +53,17 @@ private:
     // underlying _buffer is being modified by COOKED_READ_DATA.
     struct BufferState
     {
+        // A checkpoint records the distance in columns between the start of the prompt and
+        // the given offset into _buffer, as it was when the buffer was last flushed.
+        // Since the layout of a piece of text only depends on the text preceding it,
+        // checkpoints before _dirtyBeg remain valid until the buffer is modified.
+        // They're always placed on grapheme cluster boundaries.
+        struct Checkpoint
+        {
+            size_t offset = 0;
+            ptrdiff_t distance = 0;
+        };
+
         const std::wstring& Get() const noexcept;
         std::wstring Extract() noexcept
         {
@@ -68,19 +79,26 @@ private:
         void MarkEverythingDirty() noexcept;
         void MarkAsClean() noexcept;
 
-        std::wstring_view GetUnmodifiedTextBeforeCursor() const noexcept;
-        std::wstring_view GetUnmodifiedTextAfterCursor() const noexcept;
-        std::wstring_view GetModifiedTextBeforeCursor() const noexcept;
-        std::wstring_view GetModifiedTextAfterCursor() const noexcept;
+        size_t GetDirtyBeg() const noexcept;
+        std::wstring_view Slice(size_t from, size_t to) const noexcept;
+
+        Checkpoint GetCheckpoint(size_t offset) const noexcept;
+        void AddCheckpoint(size_t offset, ptrdiff_t distance);
 
     private:
-        std::wstring_view _slice(size_t from, size_t to) const noexcept;
+        void _invalidateCheckpoints(size_t offset) noexcept;
 
         std::wstring _buffer;
         size_t _dirtyBeg = npos;
         size_t _cursor = 0;
+        // Sorted by offset. See Checkpoint.
+        std::vector<Checkpoint> _checkpoints;
     };
 
+    // The approximate distance in code units between two BufferState checkpoints.
+    // This bounds the amount of text _flushBuffer() needs to measure per keystroke.
+    static constexpr size_t CheckpointInterval = 256;
+
     enum class PopupKind
     {
         // Copies text from the previous command between the current cursor position and the first instance
@@ -152,6 +170,8 @@ private:
     void _handlePostCharInputLoop(bool isUnicode, size_t& numBytes, ULONG& controlKeyState);
     void _transitionState(State state) noexcept;
     void _flushBuffer();
+    ptrdiff_t _measureTo(size_t offset, BufferState::Checkpoint known) const;
+    ptrdiff_t _writeCharsWithCheckpoints(size_t beg, size_t end, ptrdiff_t distance);
     void _erase(ptrdiff_t distance) const;
     ptrdiff_t _measureChars(const std::wstring_view& text, ptrdiff_t cursorOffset) const;
     ptrdiff_t _writeChars(const std::wstring_view& text) const;
@@ -592,6 +592,79 @@ class ApiRoutinesTests
         }
     }
 
+    TEST_METHOD(ApiWriteReadConsoleOutputW)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& si = gci.GetActiveOutputBuffer();
+
+        si.GetTextBuffer().ResizeTraditional({ 8, 3 });
+
+        gci.LockConsole();
+        auto Unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+        static constexpr til::CoordType width = 8;
+        static constexpr til::CoordType height = 3;
+
+        Log::Comment(L"Write a rectangle consisting of narrow cells with multiple attribute runs per row.");
+        std::vector<CHAR_INFO> payload(width * height);
+        for (til::CoordType y = 0; y < height; ++y)
+        {
+            for (til::CoordType x = 0; x < width; ++x)
+            {
+                auto& ci = payload[y * width + x];
+                // The last row uses box drawing characters, which are narrow but not ASCII.
+                ci.Char.UnicodeChar = y == 2 ? gsl::narrow_cast<wchar_t>(L'\x2500' + x) : gsl::narrow_cast<wchar_t>(L'a' + y * width + x);
+                ci.Attributes = x < 3 ? FOREGROUND_RED : (x < 6 ? FOREGROUND_GREEN | BACKGROUND_BLUE : FOREGROUND_INTENSITY);
+            }
+        }
+
+        auto written = Viewport::Empty();
+        VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleOutputWImpl(si, payload, Viewport::FromDimensions({ 0, 0 }, { width, height }), written));
+        VERIFY_IS_TRUE(Viewport::FromDimensions({ 0, 0 }, { width, height }) == written);
+
+        Log::Comment(L"Read it back and confirm every cell.");
+        std::vector<CHAR_INFO> readBack(width * height);
+        auto read = Viewport::Empty();
+        VERIFY_SUCCEEDED(_pApiRoutines->ReadConsoleOutputWImpl(si, readBack, Viewport::FromDimensions({ 0, 0 }, { width, height }), read));
+        VERIFY_IS_TRUE(Viewport::FromDimensions({ 0, 0 }, { width, height }) == read);
+        for (size_t i = 0; i < payload.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(payload[i], readBack[i]);
+        }
+
+        Log::Comment(L"Read a request that hangs off the top-left corner of the buffer.");
+        CHAR_INFO sentinel{};
+        sentinel.Char.UnicodeChar = L'#';
+        std::vector<CHAR_INFO> clipped(4 * 2, sentinel);
+        VERIFY_SUCCEEDED(_pApiRoutines->ReadConsoleOutputWImpl(si, clipped, Viewport::FromDimensions({ -1, -1 }, { 4, 2 }), read));
+        VERIFY_IS_TRUE(Viewport::FromDimensions({ 0, 0 }, { 3, 1 }) == read);
+        for (til::CoordType x = 0; x < 4; ++x)
+        {
+            VERIFY_ARE_EQUAL(sentinel, clipped[x]);
+        }
+        VERIFY_ARE_EQUAL(sentinel, clipped[4]);
+        for (til::CoordType x = 0; x < 3; ++x)
+        {
+            VERIFY_ARE_EQUAL(payload[x], clipped[5 + x]);
+        }
+
+        Log::Comment(L"Partially overwrite the first row, starting in the middle of an attribute run.");
+        std::vector<CHAR_INFO> patch(2);
+        patch[0].Char.UnicodeChar = L'X';
+        patch[0].Attributes = BACKGROUND_RED;
+        patch[1].Char.UnicodeChar = L'Y';
+        patch[1].Attributes = BACKGROUND_RED;
+        VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleOutputWImpl(si, patch, Viewport::FromDimensions({ 2, 0 }, { 2, 1 }), written));
+        payload[2] = patch[0];
+        payload[3] = patch[1];
+
+        VERIFY_SUCCEEDED(_pApiRoutines->ReadConsoleOutputWImpl(si, readBack, Viewport::FromDimensions({ 0, 0 }, { width, height }), read));
+        for (size_t i = 0; i < payload.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(payload[i], readBack[i]);
+        }
+    }
+
     TEST_METHOD(ApiScrollConsoleScreenBufferW)
     {
         BEGIN_TEST_METHOD_PROPERTIES()
@@ -28,6 +28,1035 @@ static const std::vector<std::tuple<unsigned int, std::wstring, CodepointWidth>>
     { 0x1F51C, L"\xD83D\xDD1C", CodepointWidth::Wide } // U+1F51C SOON
 };
 
+static std::wstring repeat(const std::wstring_view str, const size_t count)
+{
+    std::wstring result;
+    for (size_t i = 0; i < count; ++i)
+    {
+        result.append(str);
+    }
+    return result;
+}
+
+// utf16 encoded grapheme cluster and its width
+static const std::vector<std::pair<std::wstring, int>> graphemeWidthData = {
+    { L"a", 1 },
+    { L"e\x301", 1 }, // U+0301 combining acute accent
+    { L"\x1100\x1161\x11A8", 2 }, // hangul L V T
+    { L"\xD83D\xDC4D\xD83C\xDFFD", 2 }, // U+1F44D thumbs up, U+1F3FD emoji modifier
+    { L"\xD83D\xDC68\x200D\xD83D\xDC69\x200D\xD83D\xDC67", 2 }, // family ZWJ sequence
+    { L"\xD83C\xDDE9\xD83C\xDDEA", 2 }, // flag
+    { L"\x2764", 1 }, // U+2764 heavy black heart
+    { L"\x2764\xFE0F", 2 }, // VS16 requests emoji presentation
+    { L"\xD83D", 1 }, // unpaired surrogate
+};
+
+// The grapheme clusters a test case in GraphemeBreakTest.txt consists of.
+struct GraphemeBreakTest
+{
+    const wchar_t* graphemes[4];
+};
+
+// Test cases from GraphemeBreakTest-16.0.0.txt, except for the ones containing U+094D DEVANAGARI SIGN VIRAMA.
+// Those test rule GB9c, which is new in Unicode 15.1, while s_graphemeBreakTable is still at Unicode 15.0.
+// None of the other codepoints in the test data changed their Grapheme_Cluster_Break property since 15.0.
+// Regenerate with .\tools\Generate-GraphemeBreakTests.ps1 -ExcludeCodepoints 094D.
+static constexpr GraphemeBreakTest graphemeBreakTests[] = {
+    { L"\x0020", L"\x0020" },
+    { L"\x0020\x0308", L"\x0020" },
+    { L"\x0020", L"\x000D" },
+    { L"\x0020\x0308", L"\x000D" },
+    { L"\x0020", L"\x000A" },
+    { L"\x0020\x0308", L"\x000A" },
+    { L"\x0020", L"\x0001" },
+    { L"\x0020\x0308", L"\x0001" },
+    { L"\x0020\x200C" },
+    { L"\x0020\x0308\x200C" },
+    { L"\x0020", L"\xD83C\xDDE6" },
+    { L"\x0020\x0308", L"\xD83C\xDDE6" },
+    { L"\x0020", L"\x0600" },
+    { L"\x0020\x0308", L"\x0600" },
+    { L"\x0020", L"\x1100" },
+    { L"\x0020\x0308", L"\x1100" },
+    { L"\x0020", L"\x1160" },
+    { L"\x0020\x0308", L"\x1160" },
+    { L"\x0020", L"\x11A8" },
+    { L"\x0020\x0308", L"\x11A8" },
+    { L"\x0020", L"\xAC00" },
+    { L"\x0020\x0308", L"\xAC00" },
+    { L"\x0020", L"\xAC01" },
+    { L"\x0020\x0308", L"\xAC01" },
+    { L"\x0020", L"\x0904" },
+    { L"\x0020\x0308", L"\x0904" },
+    { L"\x0020", L"\x0D4E" },
+    { L"\x0020\x0308", L"\x0D4E" },
+    { L"\x0020", L"\x0915" },
+    { L"\x0020\x0308", L"\x0915" },
+    { L"\x0020", L"\x231A" },
+    { L"\x0020\x0308", L"\x231A" },
+    { L"\x0020\x0300" },
+    { L"\x0020\x0308\x0300" },
+    { L"\x0020\x0900" },
+    { L"\x0020\x0308\x0900" },
+    { L"\x0020\x200D" },
+    { L"\x0020\x0308\x200D" },
+    { L"\x0020", L"\x0378" },
+    { L"\x0020\x0308", L"\x0378" },
+    { L"\x000D", L"\x0020" },
+    { L"\x000D", L"\x0308", L"\x0020" },
+    { L"\x000D", L"\x000D" },
+    { L"\x000D", L"\x0308", L"\x000D" },
+    { L"\x000D\x000A" },
+    { L"\x000D", L"\x0308", L"\x000A" },
+    { L"\x000D", L"\x0001" },
+    { L"\x000D", L"\x0308", L"\x0001" },
+    { L"\x000D", L"\x200C" },
+    { L"\x000D", L"\x0308\x200C" },
+    { L"\x000D", L"\xD83C\xDDE6" },
+    { L"\x000D", L"\x0308", L"\xD83C\xDDE6" },
+    { L"\x000D", L"\x0600" },
+    { L"\x000D", L"\x0308", L"\x0600" },
+    { L"\x000D", L"\x0A03" },
+    { L"\x000D", L"\x1100" },
+    { L"\x000D", L"\x0308", L"\x1100" },
+    { L"\x000D", L"\x1160" },
+    { L"\x000D", L"\x0308", L"\x1160" },
+    { L"\x000D", L"\x11A8" },
+    { L"\x000D", L"\x0308", L"\x11A8" },
+    { L"\x000D", L"\xAC00" },
+    { L"\x000D", L"\x0308", L"\xAC00" },
+    { L"\x000D", L"\xAC01" },
+    { L"\x000D", L"\x0308", L"\xAC01" },
+    { L"\x000D", L"\x0903" },
+    { L"\x000D", L"\x0904" },
+    { L"\x000D", L"\x0308", L"\x0904" },
+    { L"\x000D", L"\x0D4E" },
+    { L"\x000D", L"\x0308", L"\x0D4E" },
+    { L"\x000D", L"\x0915" },
+    { L"\x000D", L"\x0308", L"\x0915" },
+    { L"\x000D", L"\x231A" },
+    { L"\x000D", L"\x0308", L"\x231A" },
+    { L"\x000D", L"\x0300" },
+    { L"\x000D", L"\x0308\x0300" },
+    { L"\x000D", L"\x0900" },
+    { L"\x000D", L"\x0308\x0900" },
+    { L"\x000D", L"\x200D" },
+    { L"\x000D", L"\x0308\x200D" },
+    { L"\x000D", L"\x0378" },
+    { L"\x000D", L"\x0308", L"\x0378" },
+    { L"\x000A", L"\x0020" },
+    { L"\x000A", L"\x0308", L"\x0020" },
+    { L"\x000A", L"\x000D" },
+    { L"\x000A", L"\x0308", L"\x000D" },
+    { L"\x000A", L"\x000A" },
+    { L"\x000A", L"\x0308", L"\x000A" },
+    { L"\x000A", L"\x0001" },
+    { L"\x000A", L"\x0308", L"\x0001" },
+    { L"\x000A", L"\x200C" },
+    { L"\x000A", L"\x0308\x200C" },
+    { L"\x000A", L"\xD83C\xDDE6" },
+    { L"\x000A", L"\x0308", L"\xD83C\xDDE6" },
+    { L"\x000A", L"\x0600" },
+    { L"\x000A", L"\x0308", L"\x0600" },
+    { L"\x000A", L"\x0A03" },
+    { L"\x000A", L"\x1100" },
+    { L"\x000A", L"\x0308", L"\x1100" },
+    { L"\x000A", L"\x1160" },
+    { L"\x000A", L"\x0308", L"\x1160" },
+    { L"\x000A", L"\x11A8" },
+    { L"\x000A", L"\x0308", L"\x11A8" },
+    { L"\x000A", L"\xAC00" },
+    { L"\x000A", L"\x0308", L"\xAC00" },
+    { L"\x000A", L"\xAC01" },
+    { L"\x000A", L"\x0308", L"\xAC01" },
+    { L"\x000A", L"\x0903" },
+    { L"\x000A", L"\x0904" },
+    { L"\x000A", L"\x0308", L"\x0904" },
+    { L"\x000A", L"\x0D4E" },
+    { L"\x000A", L"\x0308", L"\x0D4E" },
+    { L"\x000A", L"\x0915" },
+    { L"\x000A", L"\x0308", L"\x0915" },
+    { L"\x000A", L"\x231A" },
+    { L"\x000A", L"\x0308", L"\x231A" },
+    { L"\x000A", L"\x0300" },
+    { L"\x000A", L"\x0308\x0300" },
+    { L"\x000A", L"\x0900" },
+    { L"\x000A", L"\x0308\x0900" },
+    { L"\x000A", L"\x200D" },
+    { L"\x000A", L"\x0308\x200D" },
+    { L"\x000A", L"\x0378" },
+    { L"\x000A", L"\x0308", L"\x0378" },
+    { L"\x0001", L"\x0020" },
+    { L"\x0001", L"\x0308", L"\x0020" },
+    { L"\x0001", L"\x000D" },
+    { L"\x0001", L"\x0308", L"\x000D" },
+    { L"\x0001", L"\x000A" },
+    { L"\x0001", L"\x0308", L"\x000A" },
+    { L"\x0001", L"\x0001" },
+    { L"\x0001", L"\x0308", L"\x0001" },
+    { L"\x0001", L"\x200C" },
+    { L"\x0001", L"\x0308\x200C" },
+    { L"\x0001", L"\xD83C\xDDE6" },
+    { L"\x0001", L"\x0308", L"\xD83C\xDDE6" },
+    { L"\x0001", L"\x0600" },
+    { L"\x0001", L"\x0308", L"\x0600" },
+    { L"\x0001", L"\x0A03" },
+    { L"\x0001", L"\x1100" },
+    { L"\x0001", L"\x0308", L"\x1100" },
+    { L"\x0001", L"\x1160" },
+    { L"\x0001", L"\x0308", L"\x1160" },
+    { L"\x0001", L"\x11A8" },
+    { L"\x0001", L"\x0308", L"\x11A8" },
+    { L"\x0001", L"\xAC00" },
+    { L"\x0001", L"\x0308", L"\xAC00" },
+    { L"\x0001", L"\xAC01" },
+    { L"\x0001", L"\x0308", L"\xAC01" },
+    { L"\x0001", L"\x0903" },
+    { L"\x0001", L"\x0904" },
+    { L"\x0001", L"\x0308", L"\x0904" },
+    { L"\x0001", L"\x0D4E" },
+    { L"\x0001", L"\x0308", L"\x0D4E" },
+    { L"\x0001", L"\x0915" },
+    { L"\x0001", L"\x0308", L"\x0915" },
+    { L"\x0001", L"\x231A" },
+    { L"\x0001", L"\x0308", L"\x231A" },
+    { L"\x0001", L"\x0300" },
+    { L"\x0001", L"\x0308\x0300" },
+    { L"\x0001", L"\x0900" },
+    { L"\x0001", L"\x0308\x0900" },
+    { L"\x0001", L"\x200D" },
+    { L"\x0001", L"\x0308\x200D" },
+    { L"\x0001", L"\x0378" },
+    { L"\x0001", L"\x0308", L"\x0378" },
+    { L"\x200C", L"\x0020" },
+    { L"\x200C\x0308", L"\x0020" },
+    { L"\x200C", L"\x000D" },
+    { L"\x200C\x0308", L"\x000D" },
+    { L"\x200C", L"\x000A" },
+    { L"\x200C\x0308", L"\x000A" },
+    { L"\x200C", L"\x0001" },
+    { L"\x200C\x0308", L"\x0001" },
+    { L"\x200C\x200C" },
+    { L"\x200C\x0308\x200C" },
+    { L"\x200C", L"\xD83C\xDDE6" },
+    { L"\x200C\x0308", L"\xD83C\xDDE6" },
+    { L"\x200C", L"\x0600" },
+    { L"\x200C\x0308", L"\x0600" },
+    { L"\x200C", L"\x1100" },
+    { L"\x200C\x0308", L"\x1100" },
+    { L"\x200C", L"\x1160" },
+    { L"\x200C\x0308", L"\x1160" },
+    { L"\x200C", L"\x11A8" },
+    { L"\x200C\x0308", L"\x11A8" },
+    { L"\x200C", L"\xAC00" },
+    { L"\x200C\x0308", L"\xAC00" },
+    { L"\x200C", L"\xAC01" },
+    { L"\x200C\x0308", L"\xAC01" },
+    { L"\x200C", L"\x0904" },
+    { L"\x200C\x0308", L"\x0904" },
+    { L"\x200C", L"\x0D4E" },
+    { L"\x200C\x0308", L"\x0D4E" },
+    { L"\x200C", L"\x0915" },
+    { L"\x200C\x0308", L"\x0915" },
+    { L"\x200C", L"\x231A" },
+    { L"\x200C\x0308", L"\x231A" },
+    { L"\x200C\x0300" },
+    { L"\x200C\x0308\x0300" },
+    { L"\x200C\x0900" },
+    { L"\x200C\x0308\x0900" },
+    { L"\x200C\x200D" },
+    { L"\x200C\x0308\x200D" },
+    { L"\x200C", L"\x0378" },
+    { L"\x200C\x0308", L"\x0378" },
+    { L"\xD83C\xDDE6", L"\x0020" },
+    { L"\xD83C\xDDE6\x0308", L"\x0020" },
+    { L"\xD83C\xDDE6", L"\x000D" },
+    { L"\xD83C\xDDE6\x0308", L"\x000D" },
+    { L"\xD83C\xDDE6", L"\x000A" },
+    { L"\xD83C\xDDE6\x0308", L"\x000A" },
+    { L"\xD83C\xDDE6", L"\x0001" },
+    { L"\xD83C\xDDE6\x0308", L"\x0001" },
+    { L"\xD83C\xDDE6\x200C" },
+    { L"\xD83C\xDDE6\x0308\x200C" },
+    { L"\xD83C\xDDE6\xD83C\xDDE6" },
+    { L"\xD83C\xDDE6\x0308", L"\xD83C\xDDE6" },
+    { L"\xD83C\xDDE6", L"\x0600" },
+    { L"\xD83C\xDDE6\x0308", L"\x0600" },
+    { L"\xD83C\xDDE6", L"\x1100" },
+    { L"\xD83C\xDDE6\x0308", L"\x1100" },
+    { L"\xD83C\xDDE6", L"\x1160" },
+    { L"\xD83C\xDDE6\x0308", L"\x1160" },
+    { L"\xD83C\xDDE6", L"\x11A8" },
+    { L"\xD83C\xDDE6\x0308", L"\x11A8" },
+    { L"\xD83C\xDDE6", L"\xAC00" },
+    { L"\xD83C\xDDE6\x0308", L"\xAC00" },
+    { L"\xD83C\xDDE6", L"\xAC01" },
+    { L"\xD83C\xDDE6\x0308", L"\xAC01" },
+    { L"\xD83C\xDDE6", L"\x0904" },
+    { L"\xD83C\xDDE6\x0308", L"\x0904" },
+    { L"\xD83C\xDDE6", L"\x0D4E" },
+    { L"\xD83C\xDDE6\x0308", L"\x0D4E" },
+    { L"\xD83C\xDDE6", L"\x0915" },
+    { L"\xD83C\xDDE6\x0308", L"\x0915" },
+    { L"\xD83C\xDDE6", L"\x231A" },
+    { L"\xD83C\xDDE6\x0308", L"\x231A" },
+    { L"\xD83C\xDDE6\x0300" },
+    { L"\xD83C\xDDE6\x0308\x0300" },
+    { L"\xD83C\xDDE6\x0900" },
+    { L"\xD83C\xDDE6\x0308\x0900" },
+    { L"\xD83C\xDDE6\x200D" },
+    { L"\xD83C\xDDE6\x0308\x200D" },
+    { L"\xD83C\xDDE6", L"\x0378" },
+    { L"\xD83C\xDDE6\x0308", L"\x0378" },
+    { L"\x0600\x0308", L"\x0020" },
+    { L"\x0600", L"\x000D" },
+    { L"\x0600\x0308", L"\x000D" },
+    { L"\x0600", L"\x000A" },
+    { L"\x0600\x0308", L"\x000A" },
+    { L"\x0600", L"\x0001" },
+    { L"\x0600\x0308", L"\x0001" },
+    { L"\x0600\x200C" },
+    { L"\x0600\x0308\x200C" },
+    { L"\x0600\x0308", L"\xD83C\xDDE6" },
+    { L"\x0600\x0308", L"\x0600" },
+    { L"\x0600\x0308", L"\x1100" },
+    { L"\x0600\x0308", L"\x1160" },
+    { L"\x0600\x0308", L"\x11A8" },
+    { L"\x0600\x0308", L"\xAC00" },
+    { L"\x0600\x0308", L"\xAC01" },
+    { L"\x0600\x0308", L"\x0904" },
+    { L"\x0600\x0308", L"\x0D4E" },
+    { L"\x0600\x0308", L"\x0915" },
+    { L"\x0600\x0308", L"\x231A" },
+    { L"\x0600\x0300" },
+    { L"\x0600\x0308\x0300" },
+    { L"\x0600\x0900" },
+    { L"\x0600\x0308\x0900" },
+    { L"\x0600\x200D" },
+    { L"\x0600\x0308\x200D" },
+    { L"\x0600\x0308", L"\x0378" },
+    { L"\x0A03", L"\x0020" },
+    { L"\x0A03\x0308", L"\x0020" },
+    { L"\x0A03", L"\x000D" },
+    { L"\x0A03\x0308", L"\x000D" },
+    { L"\x0A03", L"\x000A" },
+    { L"\x0A03\x0308", L"\x000A" },
+    { L"\x0A03", L"\x0001" },
+    { L"\x0A03\x0308", L"\x0001" },
+    { L"\x0A03\x200C" },
+    { L"\x0A03\x0308\x200C" },
+    { L"\x0A03", L"\xD83C\xDDE6" },
+    { L"\x0A03\x0308", L"\xD83C\xDDE6" },
+    { L"\x0A03", L"\x0600" },
+    { L"\x0A03\x0308", L"\x0600" },
+    { L"\x0A03", L"\x1100" },
+    { L"\x0A03\x0308", L"\x1100" },
+    { L"\x0A03", L"\x1160" },
+    { L"\x0A03\x0308", L"\x1160" },
+    { L"\x0A03", L"\x11A8" },
+    { L"\x0A03\x0308", L"\x11A8" },
+    { L"\x0A03", L"\xAC00" },
+    { L"\x0A03\x0308", L"\xAC00" },
+    { L"\x0A03", L"\xAC01" },
+    { L"\x0A03\x0308", L"\xAC01" },
+    { L"\x0A03", L"\x0904" },
+    { L"\x0A03\x0308", L"\x0904" },
+    { L"\x0A03", L"\x0D4E" },
+    { L"\x0A03\x0308", L"\x0D4E" },
+    { L"\x0A03", L"\x0915" },
+    { L"\x0A03\x0308", L"\x0915" },
+    { L"\x0A03", L"\x231A" },
+    { L"\x0A03\x0308", L"\x231A" },
+    { L"\x0A03\x0300" },
+    { L"\x0A03\x0308\x0300" },
+    { L"\x0A03\x0900" },
+    { L"\x0A03\x0308\x0900" },
+    { L"\x0A03\x200D" },
+    { L"\x0A03\x0308\x200D" },
+    { L"\x0A03", L"\x0378" },
+    { L"\x0A03\x0308", L"\x0378" },
+    { L"\x1100", L"\x0020" },
+    { L"\x1100\x0308", L"\x0020" },
+    { L"\x1100", L"\x000D" },
+    { L"\x1100\x0308", L"\x000D" },
+    { L"\x1100", L"\x000A" },
+    { L"\x1100\x0308", L"\x000A" },
+    { L"\x1100", L"\x0001" },
+    { L"\x1100\x0308", L"\x0001" },
+    { L"\x1100\x200C" },
+    { L"\x1100\x0308\x200C" },
+    { L"\x1100", L"\xD83C\xDDE6" },
+    { L"\x1100\x0308", L"\xD83C\xDDE6" },
+    { L"\x1100", L"\x0600" },
+    { L"\x1100\x0308", L"\x0600" },
+    { L"\x1100\x1100" },
+    { L"\x1100\x0308", L"\x1100" },
+    { L"\x1100\x1160" },
+    { L"\x1100\x0308", L"\x1160" },
+    { L"\x1100", L"\x11A8" },
+    { L"\x1100\x0308", L"\x11A8" },
+    { L"\x1100\xAC00" },
+    { L"\x1100\x0308", L"\xAC00" },
+    { L"\x1100\xAC01" },
+    { L"\x1100\x0308", L"\xAC01" },
+    { L"\x1100", L"\x0904" },
+    { L"\x1100\x0308", L"\x0904" },
+    { L"\x1100", L"\x0D4E" },
+    { L"\x1100\x0308", L"\x0D4E" },
+    { L"\x1100", L"\x0915" },
+    { L"\x1100\x0308", L"\x0915" },
+    { L"\x1100", L"\x231A" },
+    { L"\x1100\x0308", L"\x231A" },
+    { L"\x1100\x0300" },
+    { L"\x1100\x0308\x0300" },
+    { L"\x1100\x0900" },
+    { L"\x1100\x0308\x0900" },
+    { L"\x1100\x200D" },
+    { L"\x1100\x0308\x200D" },
+    { L"\x1100", L"\x0378" },
+    { L"\x1100\x0308", L"\x0378" },
+    { L"\x1160", L"\x0020" },
+    { L"\x1160\x0308", L"\x0020" },
+    { L"\x1160", L"\x000D" },
+    { L"\x1160\x0308", L"\x000D" },
+    { L"\x1160", L"\x000A" },
+    { L"\x1160\x0308", L"\x000A" },
+    { L"\x1160", L"\x0001" },
+    { L"\x1160\x0308", L"\x0001" },
+    { L"\x1160\x200C" },
+    { L"\x1160\x0308\x200C" },
+    { L"\x1160", L"\xD83C\xDDE6" },
+    { L"\x1160\x0308", L"\xD83C\xDDE6" },
+    { L"\x1160", L"\x0600" },
+    { L"\x1160\x0308", L"\x0600" },
+    { L"\x1160", L"\x1100" },
+    { L"\x1160\x0308", L"\x1100" },
+    { L"\x1160\x1160" },
+    { L"\x1160\x0308", L"\x1160" },
+    { L"\x1160\x11A8" },
+    { L"\x1160\x0308", L"\x11A8" },
+    { L"\x1160", L"\xAC00" },
+    { L"\x1160\x0308", L"\xAC00" },
+    { L"\x1160", L"\xAC01" },
+    { L"\x1160\x0308", L"\xAC01" },
+    { L"\x1160", L"\x0904" },
+    { L"\x1160\x0308", L"\x0904" },
+    { L"\x1160", L"\x0D4E" },
+    { L"\x1160\x0308", L"\x0D4E" },
+    { L"\x1160", L"\x0915" },
+    { L"\x1160\x0308", L"\x0915" },
+    { L"\x1160", L"\x231A" },
+    { L"\x1160\x0308", L"\x231A" },
+    { L"\x1160\x0300" },
+    { L"\x1160\x0308\x0300" },
+    { L"\x1160\x0900" },
+    { L"\x1160\x0308\x0900" },
+    { L"\x1160\x200D" },
+    { L"\x1160\x0308\x200D" },
+    { L"\x1160", L"\x0378" },
+    { L"\x1160\x0308", L"\x0378" },
+    { L"\x11A8", L"\x0020" },
+    { L"\x11A8\x0308", L"\x0020" },
+    { L"\x11A8", L"\x000D" },
+    { L"\x11A8\x0308", L"\x000D" },
+    { L"\x11A8", L"\x000A" },
+    { L"\x11A8\x0308", L"\x000A" },
+    { L"\x11A8", L"\x0001" },
+    { L"\x11A8\x0308", L"\x0001" },
+    { L"\x11A8\x200C" },
+    { L"\x11A8\x0308\x200C" },
+    { L"\x11A8", L"\xD83C\xDDE6" },
+    { L"\x11A8\x0308", L"\xD83C\xDDE6" },
+    { L"\x11A8", L"\x0600" },
+    { L"\x11A8\x0308", L"\x0600" },
+    { L"\x11A8", L"\x1100" },
+    { L"\x11A8\x0308", L"\x1100" },
+    { L"\x11A8", L"\x1160" },
+    { L"\x11A8\x0308", L"\x1160" },
+    { L"\x11A8\x11A8" },
+    { L"\x11A8\x0308", L"\x11A8" },
+    { L"\x11A8", L"\xAC00" },
+    { L"\x11A8\x0308", L"\xAC00" },
+    { L"\x11A8", L"\xAC01" },
+    { L"\x11A8\x0308", L"\xAC01" },
+    { L"\x11A8", L"\x0904" },
+    { L"\x11A8\x0308", L"\x0904" },
+    { L"\x11A8", L"\x0D4E" },
+    { L"\x11A8\x0308", L"\x0D4E" },
+    { L"\x11A8", L"\x0915" },
+    { L"\x11A8\x0308", L"\x0915" },
+    { L"\x11A8", L"\x231A" },
+    { L"\x11A8\x0308", L"\x231A" },
+    { L"\x11A8\x0300" },
+    { L"\x11A8\x0308\x0300" },
+    { L"\x11A8\x0900" },
+    { L"\x11A8\x0308\x0900" },
+    { L"\x11A8\x200D" },
+    { L"\x11A8\x0308\x200D" },
+    { L"\x11A8", L"\x0378" },
+    { L"\x11A8\x0308", L"\x0378" },
+    { L"\xAC00", L"\x0020" },
+    { L"\xAC00\x0308", L"\x0020" },
+    { L"\xAC00", L"\x000D" },
+    { L"\xAC00\x0308", L"\x000D" },
+    { L"\xAC00", L"\x000A" },
+    { L"\xAC00\x0308", L"\x000A" },
+    { L"\xAC00", L"\x0001" },
+    { L"\xAC00\x0308", L"\x0001" },
+    { L"\xAC00\x200C" },
+    { L"\xAC00\x0308\x200C" },
+    { L"\xAC00", L"\xD83C\xDDE6" },
+    { L"\xAC00\x0308", L"\xD83C\xDDE6" },
+    { L"\xAC00", L"\x0600" },
+    { L"\xAC00\x0308", L"\x0600" },
+    { L"\xAC00", L"\x1100" },
+    { L"\xAC00\x0308", L"\x1100" },
+    { L"\xAC00\x1160" },
+    { L"\xAC00\x0308", L"\x1160" },
+    { L"\xAC00\x11A8" },
+    { L"\xAC00\x0308", L"\x11A8" },
+    { L"\xAC00", L"\xAC00" },
+    { L"\xAC00\x0308", L"\xAC00" },
+    { L"\xAC00", L"\xAC01" },
+    { L"\xAC00\x0308", L"\xAC01" },
+    { L"\xAC00", L"\x0904" },
+    { L"\xAC00\x0308", L"\x0904" },
+    { L"\xAC00", L"\x0D4E" },
+    { L"\xAC00\x0308", L"\x0D4E" },
+    { L"\xAC00", L"\x0915" },
+    { L"\xAC00\x0308", L"\x0915" },
+    { L"\xAC00", L"\x231A" },
+    { L"\xAC00\x0308", L"\x231A" },
+    { L"\xAC00\x0300" },
+    { L"\xAC00\x0308\x0300" },
+    { L"\xAC00\x0900" },
+    { L"\xAC00\x0308\x0900" },
+    { L"\xAC00\x200D" },
+    { L"\xAC00\x0308\x200D" },
+    { L"\xAC00", L"\x0378" },
+    { L"\xAC00\x0308", L"\x0378" },
+    { L"\xAC01", L"\x0020" },
+    { L"\xAC01\x0308", L"\x0020" },
+    { L"\xAC01", L"\x000D" },
+    { L"\xAC01\x0308", L"\x000D" },
+    { L"\xAC01", L"\x000A" },
+    { L"\xAC01\x0308", L"\x000A" },
+    { L"\xAC01", L"\x0001" },
+    { L"\xAC01\x0308", L"\x0001" },
+    { L"\xAC01\x200C" },
+    { L"\xAC01\x0308\x200C" },
+    { L"\xAC01", L"\xD83C\xDDE6" },
+    { L"\xAC01\x0308", L"\xD83C\xDDE6" },
+    { L"\xAC01", L"\x0600" },
+    { L"\xAC01\x0308", L"\x0600" },
+    { L"\xAC01", L"\x1100" },
+    { L"\xAC01\x0308", L"\x1100" },
+    { L"\xAC01", L"\x1160" },
+    { L"\xAC01\x0308", L"\x1160" },
+    { L"\xAC01\x11A8" },
+    { L"\xAC01\x0308", L"\x11A8" },
+    { L"\xAC01", L"\xAC00" },
+    { L"\xAC01\x0308", L"\xAC00" },
+    { L"\xAC01", L"\xAC01" },
+    { L"\xAC01\x0308", L"\xAC01" },
+    { L"\xAC01", L"\x0904" },
+    { L"\xAC01\x0308", L"\x0904" },
+    { L"\xAC01", L"\x0D4E" },
+    { L"\xAC01\x0308", L"\x0D4E" },
+    { L"\xAC01", L"\x0915" },
+    { L"\xAC01\x0308", L"\x0915" },
+    { L"\xAC01", L"\x231A" },
+    { L"\xAC01\x0308", L"\x231A" },
+    { L"\xAC01\x0300" },
+    { L"\xAC01\x0308\x0300" },
+    { L"\xAC01\x0900" },
+    { L"\xAC01\x0308\x0900" },
+    { L"\xAC01\x200D" },
+    { L"\xAC01\x0308\x200D" },
+    { L"\xAC01", L"\x0378" },
+    { L"\xAC01\x0308", L"\x0378" },
+    { L"\x0903", L"\x0020" },
+    { L"\x0903\x0308", L"\x0020" },
+    { L"\x0903", L"\x000D" },
+    { L"\x0903\x0308", L"\x000D" },
+    { L"\x0903", L"\x000A" },
+    { L"\x0903\x0308", L"\x000A" },
+    { L"\x0903", L"\x0001" },
+    { L"\x0903\x0308", L"\x0001" },
+    { L"\x0903\x200C" },
+    { L"\x0903\x0308\x200C" },
+    { L"\x0903", L"\xD83C\xDDE6" },
+    { L"\x0903\x0308", L"\xD83C\xDDE6" },
+    { L"\x0903", L"\x0600" },
+    { L"\x0903\x0308", L"\x0600" },
+    { L"\x0903", L"\x1100" },
+    { L"\x0903\x0308", L"\x1100" },
+    { L"\x0903", L"\x1160" },
+    { L"\x0903\x0308", L"\x1160" },
+    { L"\x0903", L"\x11A8" },
+    { L"\x0903\x0308", L"\x11A8" },
+    { L"\x0903", L"\xAC00" },
+    { L"\x0903\x0308", L"\xAC00" },
+    { L"\x0903", L"\xAC01" },
+    { L"\x0903\x0308", L"\xAC01" },
+    { L"\x0903", L"\x0904" },
+    { L"\x0903\x0308", L"\x0904" },
+    { L"\x0903", L"\x0D4E" },
+    { L"\x0903\x0308", L"\x0D4E" },
+    { L"\x0903", L"\x0915" },
+    { L"\x0903\x0308", L"\x0915" },
+    { L"\x0903", L"\x231A" },
+    { L"\x0903\x0308", L"\x231A" },
+    { L"\x0903\x0300" },
+    { L"\x0903\x0308\x0300" },
+    { L"\x0903\x0900" },
+    { L"\x0903\x0308\x0900" },
+    { L"\x0903\x200D" },
+    { L"\x0903\x0308\x200D" },
+    { L"\x0903", L"\x0378" },
+    { L"\x0903\x0308", L"\x0378" },
+    { L"\x0904", L"\x0020" },
+    { L"\x0904\x0308", L"\x0020" },
+    { L"\x0904", L"\x000D" },
+    { L"\x0904\x0308", L"\x000D" },
+    { L"\x0904", L"\x000A" },
+    { L"\x0904\x0308", L"\x000A" },
+    { L"\x0904", L"\x0001" },
+    { L"\x0904\x0308", L"\x0001" },
+    { L"\x0904\x200C" },
+    { L"\x0904\x0308\x200C" },
+    { L"\x0904", L"\xD83C\xDDE6" },
+    { L"\x0904\x0308", L"\xD83C\xDDE6" },
+    { L"\x0904", L"\x0600" },
+    { L"\x0904\x0308", L"\x0600" },
+    { L"\x0904", L"\x1100" },
+    { L"\x0904\x0308", L"\x1100" },
+    { L"\x0904", L"\x1160" },
+    { L"\x0904\x0308", L"\x1160" },
+    { L"\x0904", L"\x11A8" },
+    { L"\x0904\x0308", L"\x11A8" },
+    { L"\x0904", L"\xAC00" },
+    { L"\x0904\x0308", L"\xAC00" },
+    { L"\x0904", L"\xAC01" },
+    { L"\x0904\x0308", L"\xAC01" },
+    { L"\x0904", L"\x0904" },
+    { L"\x0904\x0308", L"\x0904" },
+    { L"\x0904", L"\x0D4E" },
+    { L"\x0904\x0308", L"\x0D4E" },
+    { L"\x0904", L"\x0915" },
+    { L"\x0904\x0308", L"\x0915" },
+    { L"\x0904", L"\x231A" },
+    { L"\x0904\x0308", L"\x231A" },
+    { L"\x0904\x0300" },
+    { L"\x0904\x0308\x0300" },
+    { L"\x0904\x0900" },
+    { L"\x0904\x0308\x0900" },
+    { L"\x0904\x200D" },
+    { L"\x0904\x0308\x200D" },
+    { L"\x0904", L"\x0378" },
+    { L"\x0904\x0308", L"\x0378" },
+    { L"\x0D4E\x0308", L"\x0020" },
+    { L"\x0D4E", L"\x000D" },
+    { L"\x0D4E\x0308", L"\x000D" },
+    { L"\x0D4E", L"\x000A" },
+    { L"\x0D4E\x0308", L"\x000A" },
+    { L"\x0D4E", L"\x0001" },
+    { L"\x0D4E\x0308", L"\x0001" },
+    { L"\x0D4E\x200C" },
+    { L"\x0D4E\x0308\x200C" },
+    { L"\x0D4E\x0308", L"\xD83C\xDDE6" },
+    { L"\x0D4E\x0308", L"\x0600" },
+    { L"\x0D4E\x0308", L"\x1100" },
+    { L"\x0D4E\x0308", L"\x1160" },
+    { L"\x0D4E\x0308", L"\x11A8" },
+    { L"\x0D4E\x0308", L"\xAC00" },
+    { L"\x0D4E\x0308", L"\xAC01" },
+    { L"\x0D4E\x0308", L"\x0904" },
+    { L"\x0D4E\x0308", L"\x0D4E" },
+    { L"\x0D4E\x0308", L"\x0915" },
+    { L"\x0D4E\x0308", L"\x231A" },
+    { L"\x0D4E\x0300" },
+    { L"\x0D4E\x0308\x0300" },
+    { L"\x0D4E\x0900" },
+    { L"\x0D4E\x0308\x0900" },
+    { L"\x0D4E\x200D" },
+    { L"\x0D4E\x0308\x200D" },
+    { L"\x0D4E\x0308", L"\x0378" },
+    { L"\x0915", L"\x0020" },
+    { L"\x0915\x0308", L"\x0020" },
+    { L"\x0915", L"\x000D" },
+    { L"\x0915\x0308", L"\x000D" },
+    { L"\x0915", L"\x000A" },
+    { L"\x0915\x0308", L"\x000A" },
+    { L"\x0915", L"\x0001" },
+    { L"\x0915\x0308", L"\x0001" },
+    { L"\x0915\x200C" },
+    { L"\x0915\x0308\x200C" },
+    { L"\x0915", L"\xD83C\xDDE6" },
+    { L"\x0915\x0308", L"\xD83C\xDDE6" },
+    { L"\x0915", L"\x0600" },
+    { L"\x0915\x0308", L"\x0600" },
+    { L"\x0915", L"\x1100" },
+    { L"\x0915\x0308", L"\x1100" },
+    { L"\x0915", L"\x1160" },
+    { L"\x0915\x0308", L"\x1160" },
+    { L"\x0915", L"\x11A8" },
+    { L"\x0915\x0308", L"\x11A8" },
+    { L"\x0915", L"\xAC00" },
+    { L"\x0915\x0308", L"\xAC00" },
+    { L"\x0915", L"\xAC01" },
+    { L"\x0915\x0308", L"\xAC01" },
+    { L"\x0915", L"\x0904" },
+    { L"\x0915\x0308", L"\x0904" },
+    { L"\x0915", L"\x0D4E" },
+    { L"\x0915\x0308", L"\x0D4E" },
+    { L"\x0915", L"\x0915" },
+    { L"\x0915\x0308", L"\x0915" },
+    { L"\x0915", L"\x231A" },
+    { L"\x0915\x0308", L"\x231A" },
+    { L"\x0915\x0300" },
+    { L"\x0915\x0308\x0300" },
+    { L"\x0915\x0900" },
+    { L"\x0915\x0308\x0900" },
+    { L"\x0915\x200D" },
+    { L"\x0915\x0308\x200D" },
+    { L"\x0915", L"\x0378" },
+    { L"\x0915\x0308", L"\x0378" },
+    { L"\x231A", L"\x0020" },
+    { L"\x231A\x0308", L"\x0020" },
+    { L"\x231A", L"\x000D" },
+    { L"\x231A\x0308", L"\x000D" },
+    { L"\x231A", L"\x000A" },
+    { L"\x231A\x0308", L"\x000A" },
+    { L"\x231A", L"\x0001" },
+    { L"\x231A\x0308", L"\x0001" },
+    { L"\x231A\x200C" },
+    { L"\x231A\x0308\x200C" },
+    { L"\x231A", L"\xD83C\xDDE6" },
+    { L"\x231A\x0308", L"\xD83C\xDDE6" },
+    { L"\x231A", L"\x0600" },
+    { L"\x231A\x0308", L"\x0600" },
+    { L"\x231A", L"\x1100" },
+    { L"\x231A\x0308", L"\x1100" },
+    { L"\x231A", L"\x1160" },
+    { L"\x231A\x0308", L"\x1160" },
+    { L"\x231A", L"\x11A8" },
+    { L"\x231A\x0308", L"\x11A8" },
+    { L"\x231A", L"\xAC00" },
+    { L"\x231A\x0308", L"\xAC00" },
+    { L"\x231A", L"\xAC01" },
+    { L"\x231A\x0308", L"\xAC01" },
+    { L"\x231A", L"\x0904" },
+    { L"\x231A\x0308", L"\x0904" },
+    { L"\x231A", L"\x0D4E" },
+    { L"\x231A\x0308", L"\x0D4E" },
+    { L"\x231A", L"\x0915" },
+    { L"\x231A\x0308", L"\x0915" },
+    { L"\x231A", L"\x231A" },
+    { L"\x231A\x0308", L"\x231A" },
+    { L"\x231A\x0300" },
+    { L"\x231A\x0308\x0300" },
+    { L"\x231A\x0900" },
+    { L"\x231A\x0308\x0900" },
+    { L"\x231A\x200D" },
+    { L"\x231A\x0308\x200D" },
+    { L"\x231A", L"\x0378" },
+    { L"\x231A\x0308", L"\x0378" },
+    { L"\x0300", L"\x0020" },
+    { L"\x0300\x0308", L"\x0020" },
+    { L"\x0300", L"\x000D" },
+    { L"\x0300\x0308", L"\x000D" },
+    { L"\x0300", L"\x000A" },
+    { L"\x0300\x0308", L"\x000A" },
+    { L"\x0300", L"\x0001" },
+    { L"\x0300\x0308", L"\x0001" },
+    { L"\x0300\x200C" },
+    { L"\x0300\x0308\x200C" },
+    { L"\x0300", L"\xD83C\xDDE6" },
+    { L"\x0300\x0308", L"\xD83C\xDDE6" },
+    { L"\x0300", L"\x0600" },
+    { L"\x0300\x0308", L"\x0600" },
+    { L"\x0300", L"\x1100" },
+    { L"\x0300\x0308", L"\x1100" },
+    { L"\x0300", L"\x1160" },
+    { L"\x0300\x0308", L"\x1160" },
+    { L"\x0300", L"\x11A8" },
+    { L"\x0300\x0308", L"\x11A8" },
+    { L"\x0300", L"\xAC00" },
+    { L"\x0300\x0308", L"\xAC00" },
+    { L"\x0300", L"\xAC01" },
+    { L"\x0300\x0308", L"\xAC01" },
+    { L"\x0300", L"\x0904" },
+    { L"\x0300\x0308", L"\x0904" },
+    { L"\x0300", L"\x0D4E" },
+    { L"\x0300\x0308", L"\x0D4E" },
+    { L"\x0300", L"\x0915" },
+    { L"\x0300\x0308", L"\x0915" },
+    { L"\x0300", L"\x231A" },
+    { L"\x0300\x0308", L"\x231A" },
+    { L"\x0300\x0300" },
+    { L"\x0300\x0308\x0300" },
+    { L"\x0300\x0900" },
+    { L"\x0300\x0308\x0900" },
+    { L"\x0300\x200D" },
+    { L"\x0300\x0308\x200D" },
+    { L"\x0300", L"\x0378" },
+    { L"\x0300\x0308", L"\x0378" },
+    { L"\x0900", L"\x0020" },
+    { L"\x0900\x0308", L"\x0020" },
+    { L"\x0900", L"\x000D" },
+    { L"\x0900\x0308", L"\x000D" },
+    { L"\x0900", L"\x000A" },
+    { L"\x0900\x0308", L"\x000A" },
+    { L"\x0900", L"\x0001" },
+    { L"\x0900\x0308", L"\x0001" },
+    { L"\x0900\x200C" },
+    { L"\x0900\x0308\x200C" },
+    { L"\x0900", L"\xD83C\xDDE6" },
+    { L"\x0900\x0308", L"\xD83C\xDDE6" },
+    { L"\x0900", L"\x0600" },
+    { L"\x0900\x0308", L"\x0600" },
+    { L"\x0900", L"\x1100" },
+    { L"\x0900\x0308", L"\x1100" },
+    { L"\x0900", L"\x1160" },
+    { L"\x0900\x0308", L"\x1160" },
+    { L"\x0900", L"\x11A8" },
+    { L"\x0900\x0308", L"\x11A8" },
+    { L"\x0900", L"\xAC00" },
+    { L"\x0900\x0308", L"\xAC00" },
+    { L"\x0900", L"\xAC01" },
+    { L"\x0900\x0308", L"\xAC01" },
+    { L"\x0900", L"\x0904" },
+    { L"\x0900\x0308", L"\x0904" },
+    { L"\x0900", L"\x0D4E" },
+    { L"\x0900\x0308", L"\x0D4E" },
+    { L"\x0900", L"\x0915" },
+    { L"\x0900\x0308", L"\x0915" },
+    { L"\x0900", L"\x231A" },
+    { L"\x0900\x0308", L"\x231A" },
+    { L"\x0900\x0300" },
+    { L"\x0900\x0308\x0300" },
+    { L"\x0900\x0900" },
+    { L"\x0900\x0308\x0900" },
+    { L"\x0900\x200D" },
+    { L"\x0900\x0308\x200D" },
+    { L"\x0900", L"\x0378" },
+    { L"\x0900\x0308", L"\x0378" },
+    { L"\x200D", L"\x0020" },
+    { L"\x200D\x0308", L"\x0020" },
+    { L"\x200D", L"\x000D" },
+    { L"\x200D\x0308", L"\x000D" },
+    { L"\x200D", L"\x000A" },
+    { L"\x200D\x0308", L"\x000A" },
+    { L"\x200D", L"\x0001" },
+    { L"\x200D\x0308", L"\x0001" },
+    { L"\x200D\x200C" },
+    { L"\x200D\x0308\x200C" },
+    { L"\x200D", L"\xD83C\xDDE6" },
+    { L"\x200D\x0308", L"\xD83C\xDDE6" },
+    { L"\x200D", L"\x0600" },
+    { L"\x200D\x0308", L"\x0600" },
+    { L"\x200D", L"\x1100" },
+    { L"\x200D\x0308", L"\x1100" },
+    { L"\x200D", L"\x1160" },
+    { L"\x200D\x0308", L"\x1160" },
+    { L"\x200D", L"\x11A8" },
+    { L"\x200D\x0308", L"\x11A8" },
+    { L"\x200D", L"\xAC00" },
+    { L"\x200D\x0308", L"\xAC00" },
+    { L"\x200D", L"\xAC01" },
+    { L"\x200D\x0308", L"\xAC01" },
+    { L"\x200D", L"\x0904" },
+    { L"\x200D\x0308", L"\x0904" },
+    { L"\x200D", L"\x0D4E" },
+    { L"\x200D\x0308", L"\x0D4E" },
+    { L"\x200D", L"\x0915" },
+    { L"\x200D\x0308", L"\x0915" },
+    { L"\x200D", L"\x231A" },
+    { L"\x200D\x0308", L"\x231A" },
+    { L"\x200D\x0300" },
+    { L"\x200D\x0308\x0300" },
+    { L"\x200D\x0900" },
+    { L"\x200D\x0308\x0900" },
+    { L"\x200D\x200D" },
+    { L"\x200D\x0308\x200D" },
+    { L"\x200D", L"\x0378" },
+    { L"\x200D\x0308", L"\x0378" },
+    { L"\x0378", L"\x0020" },
+    { L"\x0378\x0308", L"\x0020" },
+    { L"\x0378", L"\x000D" },
+    { L"\x0378\x0308", L"\x000D" },
+    { L"\x0378", L"\x000A" },
+    { L"\x0378\x0308", L"\x000A" },
+    { L"\x0378", L"\x0001" },
+    { L"\x0378\x0308", L"\x0001" },
+    { L"\x0378\x200C" },
+    { L"\x0378\x0308\x200C" },
+    { L"\x0378", L"\xD83C\xDDE6" },
+    { L"\x0378\x0308", L"\xD83C\xDDE6" },
+    { L"\x0378", L"\x0600" },
+    { L"\x0378\x0308", L"\x0600" },
+    { L"\x0378", L"\x1100" },
+    { L"\x0378\x0308", L"\x1100" },
+    { L"\x0378", L"\x1160" },
+    { L"\x0378\x0308", L"\x1160" },
+    { L"\x0378", L"\x11A8" },
+    { L"\x0378\x0308", L"\x11A8" },
+    { L"\x0378", L"\xAC00" },
+    { L"\x0378\x0308", L"\xAC00" },
+    { L"\x0378", L"\xAC01" },
+    { L"\x0378\x0308", L"\xAC01" },
+    { L"\x0378", L"\x0904" },
+    { L"\x0378\x0308", L"\x0904" },
+    { L"\x0378", L"\x0D4E" },
+    { L"\x0378\x0308", L"\x0D4E" },
+    { L"\x0378", L"\x0915" },
+    { L"\x0378\x0308", L"\x0915" },
+    { L"\x0378", L"\x231A" },
+    { L"\x0378\x0308", L"\x231A" },
+    { L"\x0378\x0300" },
+    { L"\x0378\x0308\x0300" },
+    { L"\x0378\x0900" },
+    { L"\x0378\x0308\x0900" },
+    { L"\x0378\x200D" },
+    { L"\x0378\x0308\x200D" },
+    { L"\x0378", L"\x0378" },
+    { L"\x0378\x0308", L"\x0378" },
+    { L"\x000D\x000A", L"\x0061", L"\x000A", L"\x0308" },
+    { L"\x0061\x0308" },
+    { L"\x0020\x200D", L"\x0646" },
+    { L"\x0646\x200D", L"\x0020" },
+    { L"\x1100\x1100" },
+    { L"\xAC00\x11A8", L"\x1100" },
+    { L"\xAC01\x11A8", L"\x1100" },
+    { L"\xD83C\xDDE6\xD83C\xDDE7", L"\xD83C\xDDE8", L"\x0062" },
+    { L"\x0061", L"\xD83C\xDDE6\xD83C\xDDE7", L"\xD83C\xDDE8", L"\x0062" },
+    { L"\x0061", L"\xD83C\xDDE6\xD83C\xDDE7\x200D", L"\xD83C\xDDE8", L"\x0062" },
+    { L"\x0061", L"\xD83C\xDDE6\x200D", L"\xD83C\xDDE7\xD83C\xDDE8", L"\x0062" },
+    { L"\x0061", L"\xD83C\xDDE6\xD83C\xDDE7", L"\xD83C\xDDE8\xD83C\xDDE9", L"\x0062" },
+    { L"\x0061\x200D" },
+    { L"\x0061\x0308", L"\x0062" },
+    { L"\xD83D\xDC76\xD83C\xDFFF", L"\xD83D\xDC76" },
+    { L"\x0061\xD83C\xDFFF", L"\xD83D\xDC76" },
+    { L"\x0061\xD83C\xDFFF", L"\xD83D\xDC76\x200D\xD83D\xDED1" },
+    { L"\xD83D\xDC76\xD83C\xDFFF\x0308\x200D\xD83D\xDC76\xD83C\xDFFF" },
+    { L"\xD83D\xDED1\x200D\xD83D\xDED1" },
+    { L"\x0061\x200D", L"\xD83D\xDED1" },
+    { L"\x2701\x200D\x2701" },
+    { L"\x0061\x200D", L"\x2701" },
+    { L"\x0915", L"\x0924" },
+    { L"\x0020\x0A03" },
+    { L"\x0020\x0308\x0A03" },
+    { L"\x0020\x0903" },
+    { L"\x0020\x0308\x0903" },
+    { L"\x000D", L"\x0308\x0A03" },
+    { L"\x000D", L"\x0308\x0903" },
+    { L"\x000A", L"\x0308\x0A03" },
+    { L"\x000A", L"\x0308\x0903" },
+    { L"\x0001", L"\x0308\x0A03" },
+    { L"\x0001", L"\x0308\x0903" },
+    { L"\x200C\x0A03" },
+    { L"\x200C\x0308\x0A03" },
+    { L"\x200C\x0903" },
+    { L"\x200C\x0308\x0903" },
+    { L"\xD83C\xDDE6\x0A03" },
+    { L"\xD83C\xDDE6\x0308\x0A03" },
+    { L"\xD83C\xDDE6\x0903" },
+    { L"\xD83C\xDDE6\x0308\x0903" },
+    { L"\x0600\x0020" },
+    { L"\x0600\xD83C\xDDE6" },
+    { L"\x0600\x0600" },
+    { L"\x0600\x0A03" },
+    { L"\x0600\x0308\x0A03" },
+    { L"\x0600\x1100" },
+    { L"\x0600\x1160" },
+    { L"\x0600\x11A8" },
+    { L"\x0600\xAC00" },
+    { L"\x0600\xAC01" },
+    { L"\x0600\x0903" },
+    { L"\x0600\x0308\x0903" },
+    { L"\x0600\x0904" },
+    { L"\x0600\x0D4E" },
+    { L"\x0600\x0915" },
+    { L"\x0600\x231A" },
+    { L"\x0600\x0378" },
+    { L"\x0A03\x0A03" },
+    { L"\x0A03\x0308\x0A03" },
+    { L"\x0A03\x0903" },
+    { L"\x0A03\x0308\x0903" },
+    { L"\x1100\x0A03" },
+    { L"\x1100\x0308\x0A03" },
+    { L"\x1100\x0903" },
+    { L"\x1100\x0308\x0903" },
+    { L"\x1160\x0A03" },
+    { L"\x1160\x0308\x0A03" },
+    { L"\x1160\x0903" },
+    { L"\x1160\x0308\x0903" },
+    { L"\x11A8\x0A03" },
+    { L"\x11A8\x0308\x0A03" },
+    { L"\x11A8\x0903" },
+    { L"\x11A8\x0308\x0903" },
+    { L"\xAC00\x0A03" },
+    { L"\xAC00\x0308\x0A03" },
+    { L"\xAC00\x0903" },
+    { L"\xAC00\x0308\x0903" },
+    { L"\xAC01\x0A03" },
+    { L"\xAC01\x0308\x0A03" },
+    { L"\xAC01\x0903" },
+    { L"\xAC01\x0308\x0903" },
+    { L"\x0903\x0A03" },
+    { L"\x0903\x0308\x0A03" },
+    { L"\x0903\x0903" },
+    { L"\x0903\x0308\x0903" },
+    { L"\x0904\x0A03" },
+    { L"\x0904\x0308\x0A03" },
+    { L"\x0904\x0903" },
+    { L"\x0904\x0308\x0903" },
+    { L"\x0D4E\x0020" },
+    { L"\x0D4E\xD83C\xDDE6" },
+    { L"\x0D4E\x0600" },
+    { L"\x0D4E\x0A03" },
+    { L"\x0D4E\x0308\x0A03" },
+    { L"\x0D4E\x1100" },
+    { L"\x0D4E\x1160" },
+    { L"\x0D4E\x11A8" },
+    { L"\x0D4E\xAC00" },
+    { L"\x0D4E\xAC01" },
+    { L"\x0D4E\x0903" },
+    { L"\x0D4E\x0308\x0903" },
+    { L"\x0D4E\x0904" },
+    { L"\x0D4E\x0D4E" },
+    { L"\x0D4E\x0915" },
+    { L"\x0D4E\x231A" },
+    { L"\x0D4E\x0378" },
+    { L"\x0915\x0A03" },
+    { L"\x0915\x0308\x0A03" },
+    { L"\x0915\x0903" },
+    { L"\x0915\x0308\x0903" },
+    { L"\x231A\x0A03" },
+    { L"\x231A\x0308\x0A03" },
+    { L"\x231A\x0903" },
+    { L"\x231A\x0308\x0903" },
+    { L"\x0300\x0A03" },
+    { L"\x0300\x0308\x0A03" },
+    { L"\x0300\x0903" },
+    { L"\x0300\x0308\x0903" },
+    { L"\x0900\x0A03" },
+    { L"\x0900\x0308\x0A03" },
+    { L"\x0900\x0903" },
+    { L"\x0900\x0308\x0903" },
+    { L"\x200D\x0A03" },
+    { L"\x200D\x0308\x0A03" },
+    { L"\x200D\x0903" },
+    { L"\x200D\x0308\x0903" },
+    { L"\x0378\x0A03" },
+    { L"\x0378\x0308\x0A03" },
+    { L"\x0378\x0903" },
+    { L"\x0378\x0308\x0903" },
+    { L"\x0061\x0903", L"\x0062" },
+    { L"\x0061", L"\x0600\x0062" },
+};
+
 class CodepointWidthDetectorTests
 {
     TEST_CLASS(CodepointWidthDetectorTests);
@@ -50,6 +1079,117 @@ class CodepointWidthDetectorTests
         }
     }
 
+    TEST_METHOD(CanSegmentGraphemes)
+    {
+        CodepointWidthDetector widthDetector;
+        std::wstring text;
+        std::vector<size_t> expected;
+        std::vector<size_t> forward;
+        std::vector<size_t> backward;
+        size_t failures = 0;
+
+        // There are about a thousand test cases. Only the failing ones are logged.
+        for (const auto& test : graphemeBreakTests)
+        {
+            text.clear();
+            expected.assign(1, 0);
+            for (const auto grapheme : test.graphemes)
+            {
+                if (!grapheme)
+                {
+                    break;
+                }
+                text.append(grapheme);
+                expected.emplace_back(text.size());
+            }
+
+            forward.assign(1, 0);
+            for (size_t offset = 0; offset < text.size();)
+            {
+                offset = widthDetector.GraphemeNext(text, offset, nullptr);
+                forward.emplace_back(offset);
+            }
+
+            backward.assign(1, text.size());
+            for (auto offset = text.size(); offset > 0;)
+            {
+                offset = widthDetector.GraphemePrev(text, offset, nullptr);
+                backward.emplace_back(offset);
+            }
+            std::reverse(backward.begin(), backward.end());
+
+            if (forward != expected || backward != expected)
+            {
+                std::wstring codeUnits;
+                for (const auto ch : text)
+                {
+                    codeUnits.append(fmt::format(L"{:04X} ", static_cast<uint16_t>(ch)));
+                }
+                Log::Error(WEX::Common::NoThrowString().Format(L"Wrong grapheme boundaries in: %s", codeUnits.c_str()));
+                ++failures;
+            }
+        }
+
+        VERIFY_ARE_EQUAL(0u, failures);
+        VERIFY_ARE_EQUAL(0u, widthDetector.GraphemeNext(L"", 0, nullptr));
+        VERIFY_ARE_EQUAL(0u, widthDetector.GraphemePrev(L"", 0, nullptr));
+    }
+
+    TEST_METHOD(CanMeasureGraphemes)
+    {
+        CodepointWidthDetector widthDetector;
+        for (const auto& [text, width] : graphemeWidthData)
+        {
+            auto actualWidth = 0;
+            VERIFY_ARE_EQUAL(text.size(), widthDetector.GraphemeNext(text, 0, &actualWidth));
+            VERIFY_ARE_EQUAL(width, actualWidth);
+
+            actualWidth = 0;
+            VERIFY_ARE_EQUAL(0u, widthDetector.GraphemePrev(text, text.size(), &actualWidth));
+            VERIFY_ARE_EQUAL(width, actualWidth);
+        }
+    }
+
+    TEST_METHOD(CapsClusterLength)
+    {
+        static_assert(CodepointWidthDetector::MaxGraphemeClusterLength == 32);
+        CodepointWidthDetector widthDetector;
+
+        // U+0301 combining acute accent
+        const auto accents = L"e" + repeat(L"\x301", 40);
+        VERIFY_ARE_EQUAL(32u, widthDetector.GraphemeNext(accents, 0, nullptr));
+        VERIFY_ARE_EQUAL(41u, widthDetector.GraphemeNext(accents, 32, nullptr));
+
+        Log::Comment(L"GraphemePrev can't see where the run started, because it looks back at most 32 code units.");
+        VERIFY_ARE_EQUAL(9u, widthDetector.GraphemePrev(accents, 41, nullptr));
+        VERIFY_ARE_EQUAL(0u, widthDetector.GraphemePrev(accents, 32, nullptr));
+
+        Log::Comment(L"The cap never splits surrogate pairs (U+1D167 combining tremolo-1).");
+        const auto tremolos = L"a" + repeat(L"\xD834\xDD67", 20);
+        VERIFY_ARE_EQUAL(31u, widthDetector.GraphemeNext(tremolos, 0, nullptr));
+        VERIFY_ARE_EQUAL(41u, widthDetector.GraphemeNext(tremolos, 31, nullptr));
+        VERIFY_ARE_EQUAL(9u, widthDetector.GraphemePrev(tremolos, 41, nullptr));
+        VERIFY_ARE_EQUAL(0u, widthDetector.GraphemePrev(tremolos, 31, nullptr));
+
+        Log::Comment(L"Regional indicators are paired up from the start of their run, however long it is.");
+        const auto flags = repeat(L"\xD83C\xDDE9", 17);
+        VERIFY_ARE_EQUAL(34u, widthDetector.GraphemeNext(flags, 32, nullptr));
+        VERIFY_ARE_EQUAL(32u, widthDetector.GraphemePrev(flags, 34, nullptr));
+        VERIFY_ARE_EQUAL(28u, widthDetector.GraphemePrev(flags, 32, nullptr));
+
+        Log::Comment(L"Stepping back over a long run of combining marks moves 32 code units at a time.");
+        const auto marks = L"e" + repeat(L"\x301", 100000);
+        auto offset = marks.size();
+        size_t steps = 0;
+        while (offset > 0 && steps < marks.size())
+        {
+            offset = widthDetector.GraphemePrev(marks, offset, nullptr);
+            ++steps;
+        }
+        VERIFY_ARE_EQUAL(0u, offset);
+        VERIFY_ARE_EQUAL((marks.size() + 31) / 32, steps);
+    }
+
     static bool FallbackMethod(const std::wstring_view glyph)
     {
         if (glyph.size() < 1)
@@ -0,0 +1,267 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "CommonState.hpp"
+
+#include "readDataCooked.hpp"
+#include "../../types/inc/IInputEvent.hpp"
+#include "../interactivity/inc/ServiceLocator.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using Microsoft::Console::Interactivity::ServiceLocator;
+
+// COOKED_READ_DATA records a checkpoint of the prompt layout roughly every 256 code units it writes,
+// so that typing into a long line doesn't need to re-measure the entire line on every keystroke.
+// These tests make sure that the cursor position and the text on the screen are
+// the same as if the line had been measured from its start, like it used to be.
+class CookedReadTests
+{
+    TEST_CLASS(CookedReadTests);
+
+    std::unique_ptr<CommonState> m_state;
+
+    TEST_METHOD_SETUP(MethodSetup)
+    {
+        m_state = std::make_unique<CommonState>();
+        m_state->PrepareGlobalFont();
+        m_state->PrepareGlobalInputBuffer();
+        m_state->PrepareGlobalScreenBuffer();
+        m_state->PrepareReadHandle();
+        m_state->PrepareCookedReadData();
+        return true;
+    }
+
+    TEST_METHOD_CLEANUP(MethodCleanup)
+    {
+        m_state->CleanupCookedReadData();
+        m_state->CleanupReadHandle();
+        m_state->CleanupGlobalScreenBuffer();
+        m_state->CleanupGlobalInputBuffer();
+        m_state->CleanupGlobalFont();
+        m_state.reset();
+        return true;
+    }
+
+    TEST_METHOD(TypesLongLine);
+    TEST_METHOD(TypesLongLineWithWideGlyphs);
+    TEST_METHOD(EditsMiddleOfLine);
+    TEST_METHOD(DeletesAcrossCheckpoint);
+    TEST_METHOD(BackspacesAcrossCheckpoint);
+
+    static COOKED_READ_DATA& _cookedRead()
+    {
+        return ServiceLocator::LocateGlobals().getConsoleInformation().CookedReadData();
+    }
+
+    static const TextBuffer& _textBuffer()
+    {
+        return ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetTextBuffer();
+    }
+
+    // Processes the given input the same way the wait queue would once it arrives.
+    static void _type(const std::wstring_view& text)
+    {
+        ServiceLocator::LocateGlobals().getConsoleInformation().pInputBuffer->WriteString(text);
+        _read();
+    }
+
+    static void _pressKey(const uint16_t vkey, const size_t count = 1)
+    {
+        const auto event = SynthesizeKeyEvent(true, 1, vkey, 0, 0, 0);
+        const std::vector<INPUT_RECORD> events(count, event);
+        ServiceLocator::LocateGlobals().getConsoleInformation().pInputBuffer->Write(events);
+        _read();
+    }
+
+    static void _read()
+    {
+        size_t numBytes = 0;
+        ULONG controlKeyState = 0;
+        VERIFY_IS_FALSE(_cookedRead().Read(true, numBytes, controlKeyState));
+    }
+
+    // Returns the first `rows` rows of the text buffer and the cursor position.
+    static std::pair<std::vector<std::wstring>, til::point> _snapshot(const til::CoordType rows)
+    {
+        const auto& textBuffer = _textBuffer();
+        std::vector<std::wstring> text;
+        for (til::CoordType y = 0; y < rows; ++y)
+        {
+            text.emplace_back(textBuffer.GetRowByOffset(y).GetText());
+        }
+        return { std::move(text), textBuffer.GetCursor().GetPosition() };
+    }
+
+    // Verifies that the screen contents of an ASCII-only prompt starting at (0,0) match `text`
+    // and that the cursor is `cursor` code units into it.
+    static void _verifyAsciiPrompt(const std::wstring_view& text, const size_t cursor)
+    {
+        const auto width = gsl::narrow_cast<size_t>(_textBuffer().GetSize().Width());
+        const auto rows = gsl::narrow_cast<til::CoordType>(text.size() / width + 2);
+        const auto [actualText, actualCursor] = _snapshot(rows);
+
+        for (til::CoordType y = 0; y < rows; ++y)
+        {
+            std::wstring expected{ text.substr(std::min(text.size(), gsl::narrow_cast<size_t>(y) * width), width) };
+            expected.resize(width, L' ');
+            VERIFY_ARE_EQUAL(expected, actualText[y]);
+        }
+
+        const til::point expectedCursor{ gsl::narrow_cast<til::CoordType>(cursor % width), gsl::narrow_cast<til::CoordType>(cursor / width) };
+        VERIFY_ARE_EQUAL(expectedCursor, actualCursor);
+    }
+
+    // Redraws the prompt from scratch, which measures everything from the start of the prompt
+    // without the help of any checkpoints, and verifies that this doesn't change anything.
+    static void _verifyMatchesFullRedraw(const til::CoordType rows)
+    {
+        const auto before = _snapshot(rows);
+        _cookedRead().EraseBeforeResize();
+        _cookedRead().RedrawAfterResize();
+        const auto after = _snapshot(rows);
+
+        for (til::CoordType y = 0; y < rows; ++y)
+        {
+            VERIFY_ARE_EQUAL(after.first[y], before.first[y]);
+        }
+        VERIFY_ARE_EQUAL(after.second, before.second);
+    }
+
+    static std::wstring _asciiText(const size_t length)
+    {
+        std::wstring text;
+        for (size_t i = 0; i < length; ++i)
+        {
+            text.push_back(static_cast<wchar_t>(L'a' + i % 26));
+        }
+        return text;
+    }
+};
+
+void CookedReadTests::TypesLongLine()
+{
+    const auto text = _asciiText(600);
+
+    Log::Comment(L"Typing past the first checkpoint in one go.");
+    _type(std::wstring_view{ text }.substr(0, 300));
+    _verifyAsciiPrompt(std::wstring_view{ text }.substr(0, 300), 300);
+
+    Log::Comment(L"Typing one character at a time, measuring from the checkpoints.");
+    for (size_t i = 300; i < 320; ++i)
+    {
+        _type(std::wstring_view{ text }.substr(i, 1));
+    }
+    _verifyAsciiPrompt(std::wstring_view{ text }.substr(0, 320), 320);
+
+    Log::Comment(L"Typing past the next checkpoint.");
+    _type(std::wstring_view{ text }.substr(320));
+    _verifyAsciiPrompt(text, 600);
+    _verifyMatchesFullRedraw(10);
+}
+
+void CookedReadTests::TypesLongLineWithWideGlyphs()
+{
+    // Wide glyphs that don't fit at the end of a row are wrapped to the next one,
+    // so the column count can't be derived from the number of code units.
+    std::wstring text;
+    for (size_t i = 0; i < 300; ++i)
+    {
+        text.push_back(i % 3 ? L'\x3042' : L'a'); // U+3042 hiragana a
+    }
+
+    _type(std::wstring_view{ text }.substr(0, 250));
+    _verifyMatchesFullRedraw(10);
+
+    for (size_t i = 250; i < 270; ++i)
+    {
+        _type(std::wstring_view{ text }.substr(i, 1));
+    }
+    _verifyMatchesFullRedraw(10);
+
+    _type(std::wstring_view{ text }.substr(270));
+    _verifyMatchesFullRedraw(10);
+
+    // A U+0301 combining acute accent typed near the first checkpoint must join the preceding cluster.
+    _pressKey(VK_HOME);
+    _pressKey(VK_RIGHT, 256);
+    _type(L"\x301");
+    _verifyMatchesFullRedraw(10);
+}
+
+void CookedReadTests::EditsMiddleOfLine()
+{
+    auto text = _asciiText(600);
+    _type(text);
+
+    Log::Comment(L"Inserting text in the middle of the line, past the first checkpoint.");
+    _pressKey(VK_HOME);
+    _pressKey(VK_RIGHT, 400);
+    _type(L"XYZ");
+    text.insert(400, L"XYZ");
+    _verifyAsciiPrompt(text, 403);
+
+    Log::Comment(L"Inserting text before the first checkpoint moves all of them.");
+    _pressKey(VK_LEFT, 300);
+    _type(L"12");
+    text.insert(103, L"12");
+    _verifyAsciiPrompt(text, 105);
+
+    Log::Comment(L"Overwriting text right at a checkpoint.");
+    _cookedRead().SetInsertMode(false);
+    _pressKey(VK_HOME);
+    _pressKey(VK_RIGHT, 255);
+    _type(L"--");
+    text.replace(255, 2, L"--");
+    _verifyAsciiPrompt(text, 257);
+
+    Log::Comment(L"Inserting a wide glyph shifts the rest of the line by an extra column.");
+    _cookedRead().SetInsertMode(true);
+    _type(L"\x3042");
+    _verifyMatchesFullRedraw(10);
+}
+
+void CookedReadTests::DeletesAcrossCheckpoint()
+{
+    auto text = _asciiText(600);
+    _type(text);
+
+    Log::Comment(L"Deleting 20 characters after the cursor, across the checkpoint near offset 256.");
+    _pressKey(VK_HOME);
+    _pressKey(VK_RIGHT, 250);
+    _pressKey(VK_DELETE, 20);
+    text.erase(250, 20);
+    _verifyAsciiPrompt(text, 250);
+
+    Log::Comment(L"Deleting up to the end of the line.");
+    _pressKey(VK_END);
+    _pressKey(VK_LEFT, 100);
+    _pressKey(VK_DELETE, 100);
+    text.erase(text.size() - 100);
+    _verifyAsciiPrompt(text, text.size());
+    _verifyMatchesFullRedraw(10);
+}
+
+void CookedReadTests::BackspacesAcrossCheckpoint()
+{
+    auto text = _asciiText(600);
+    _type(text);
+
+    Log::Comment(L"Erasing 10 characters before the cursor, across the checkpoint near offset 256.");
+    _pressKey(VK_HOME);
+    _pressKey(VK_RIGHT, 260);
+    _type(std::wstring(10, UNICODE_BACKSPACE));
+    text.erase(250, 10);
+    _verifyAsciiPrompt(text, 250);
+
+    Log::Comment(L"Typing again where the checkpoint used to be.");
+    _type(L"0123456789");
+    text.insert(250, L"0123456789");
+    _verifyAsciiPrompt(text, 260);
+    _verifyMatchesFullRedraw(10);
+}
@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <wextestclass.h>
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../../renderer/base/thread.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace Microsoft::Console::Render;
+using namespace std::chrono_literals;
+
+class FramePacerTests
+{
+    TEST_CLASS(FramePacerTests);
+
+    TEST_METHOD(FirstFrameIsImmediate);
+    TEST_METHOD(IntervalFollowsPaintCost);
+    TEST_METHOD(IntervalHasMinimum);
+    TEST_METHOD(BacksOffWhileScrolling);
+    TEST_METHOD(InputAfterFloodIsNotThrottled);
+    TEST_METHOD(IdleResetsDelay);
+    TEST_METHOD(BackOffEndsOnceCalm);
+    TEST_METHOD(CountsFrameStats);
+
+    static constexpr til::CoordType viewportHeight = 30;
+
+    FramePacer _pacer;
+    FramePacer::clock::time_point _now;
+
+    TEST_METHOD_SETUP(MethodSetup)
+    {
+        _pacer = {};
+        _now = FramePacer::clock::time_point{} + 1h;
+        return true;
+    }
+
+    // Simulates painting a frame that took `paintTime`, after `rowsScrolled` rows scrolled by.
+    void _paintFrame(const std::chrono::microseconds paintTime, const til::CoordType rowsScrolled)
+    {
+        _pacer.FrameStarted(_now, rowsScrolled, viewportHeight);
+        _now += paintTime;
+        _pacer.FrameFinished(_now);
+    }
+
+    int64_t _delayUs(const bool scrolling) const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(_pacer.Delay(_now, scrolling)).count();
+    }
+};
+
+void FramePacerTests::FirstFrameIsImmediate()
+{
+    VERIFY_ARE_EQUAL(0, _delayUs(false));
+    VERIFY_ARE_EQUAL(0, _delayUs(true));
+}
+
+void FramePacerTests::IntervalFollowsPaintCost()
+{
+    // A 10ms frame results in a 20ms interval, so we spend at most half of the time painting.
+    _paintFrame(10ms, 0);
+    VERIFY_ARE_EQUAL(10000, _delayUs(false));
+
+    _now += 4ms;
+    VERIFY_ARE_EQUAL(6000, _delayUs(false));
+
+    _now += 10ms;
+    VERIFY_ARE_EQUAL(0, _delayUs(false));
+}
+
+void FramePacerTests::IntervalHasMinimum()
+{
+    _paintFrame(1ms, 0);
+    VERIFY_ARE_EQUAL(3000, _delayUs(false));
+}
+
+void FramePacerTests::BacksOffWhileScrolling()
+{
+    // Each frame that follows more than a page of output doubles the interval, up to 100ms.
+    static constexpr int64_t expected[]{ 7000, 15000, 31000, 63000, 99000, 99000 };
+    for (const auto delay : expected)
+    {
+        _paintFrame(1ms, 2 * viewportHeight);
+        VERIFY_ARE_EQUAL(delay, _delayUs(true));
+    }
+}
+
+void FramePacerTests::InputAfterFloodIsNotThrottled()
+{
+    for (auto i = 0; i < 8; ++i)
+    {
+        _paintFrame(1ms, 2 * viewportHeight);
+    }
+    VERIFY_ARE_EQUAL(99000, _delayUs(true));
+
+    Log::Comment(L"If nothing scrolled since, we only wait for the regular interval.");
+    VERIFY_ARE_EQUAL(3000, _delayUs(false));
+}
+
+void FramePacerTests::IdleResetsDelay()
+{
+    for (auto i = 0; i < 8; ++i)
+    {
+        _paintFrame(1ms, 2 * viewportHeight);
+    }
+
+    Log::Comment(L"After 100ms without a frame we paint right away.");
+    _now += 100ms;
+    VERIFY_ARE_EQUAL(0, _delayUs(true));
+
+    Log::Comment(L"The next flood of output starts over with a short interval.");
+    _paintFrame(1ms, 2 * viewportHeight);
+    VERIFY_ARE_EQUAL(7000, _delayUs(true));
+}
+
+void FramePacerTests::BackOffEndsOnceCalm()
+{
+    for (auto i = 0; i < 8; ++i)
+    {
+        _paintFrame(1ms, 2 * viewportHeight);
+    }
+
+    // Less than a page scrolled by, so the next frame uses the regular interval again.
+    _paintFrame(1ms, viewportHeight - 1);
+    VERIFY_ARE_EQUAL(3000, _delayUs(true));
+}
+
+void FramePacerTests::CountsFrameStats()
+{
+    _paintFrame(1ms, 0);
+    _now += 9ms;
+    _paintFrame(20ms, 2 * viewportHeight);
+
+    const auto& stats = _pacer.Stats();
+    VERIFY_ARE_EQUAL(2u, stats.framesPainted);
+    VERIFY_ARE_EQUAL(1u, stats.framesThrottled);
+
+    // 1ms falls into the first bucket (<= 1ms) and 20ms into the one for <= 33ms.
+    VERIFY_ARE_EQUAL(1u, stats.paintTime[0]);
+    VERIFY_ARE_EQUAL(1u, stats.paintTime[5]);
+    VERIFY_ARE_EQUAL(2u, std::accumulate(stats.paintTime.begin(), stats.paintTime.end(), uint64_t{}));
+
+    // Only the 2nd frame has a predecessor. It started 10ms after the first one (<= 16ms).
+    VERIFY_ARE_EQUAL(1u, stats.frameTime[4]);
+    VERIFY_ARE_EQUAL(1u, std::accumulate(stats.frameTime.begin(), stats.frameTime.end(), uint64_t{}));
+
+    // The moving average moved 1/8th of the way from 1ms towards 20ms, and
+    // the back-off doubled the previous interval of 4ms.
+    VERIFY_ARE_EQUAL(3375, stats.averagePaintTime.count());
+    VERIFY_ARE_EQUAL(8000, stats.frameInterval.count());
+}
@@ -12,6 +12,7 @@
 
 #include "globals.h"
 #include "../buffer/out/textBuffer.hpp"
+#include "../types/inc/CodepointWidthDetector.hpp"
 
 #include "input.h"
 #include "_stream.h"
@@ -148,16 +149,20 @@ class TextBufferTests
     TEST_METHOD(TestBurrito);
     TEST_METHOD(TestOverwriteChars);
     TEST_METHOD(TestRowReplaceText);
+    TEST_METHOD(TestRowReplaceTextLongCluster);
+    TEST_METHOD(TestRowReplaceTextInSlices);
 
     TEST_METHOD(TestAppendRTFText);
 
     void WriteLinesToBuffer(const std::vector<std::wstring>& text, TextBuffer& buffer);
     TEST_METHOD(GetWordBoundaries);
+    TEST_METHOD(WordDelimiterClasses);
     TEST_METHOD(MoveByWord);
     TEST_METHOD(GetGlyphBoundaries);
 
     TEST_METHOD(GetTextRects);
     TEST_METHOD(GetPlainText);
+    TEST_METHOD(GenCopyData);
 
     TEST_METHOD(HyperlinkTrim);
     TEST_METHOD(NoHyperlinkTrim);
@@ -2086,6 +2091,127 @@ void TextBufferTests::TestRowReplaceText()
 #undef complex
 }
 
+void TextBufferTests::TestRowReplaceTextLongCluster()
+{
+    static constexpr auto maxLength = CodepointWidthDetector::MaxGraphemeClusterLength;
+    static constexpr UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+
+    // An "e" followed by U+0301 COMBINING ACUTE ACCENT repeated far more often than a ROW could ever hold.
+    std::wstring text(100000, L'\x301');
+    text.front() = L'e';
+
+    {
+        Log::Comment(L"Long clusters are split into cells of MaxGraphemeClusterLength code units");
+        TextBuffer buffer{ { 10, 2 }, attr, cursorSize, false, _renderer };
+        auto& row = buffer.GetMutableRowByOffset(0);
+
+        RowWriteState state{
+            .text = text,
+            .columnLimit = 10,
+        };
+        row.ReplaceText(state);
+
+        VERIFY_ARE_EQUAL(text.size() - 10 * maxLength, state.text.size());
+        VERIFY_ARE_EQUAL(10, state.columnEnd);
+        VERIFY_ARE_EQUAL(10, state.columnEndDirty);
+        VERIFY_ARE_EQUAL(std::wstring_view{ text }.substr(0, 10 * maxLength), row.GetText());
+        for (til::CoordType col = 0; col < 10; ++col)
+        {
+            VERIFY_ARE_EQUAL(std::wstring_view{ text }.substr(col * maxLength, maxLength), row.GlyphAt(col));
+        }
+
+        auto& copy = buffer.GetMutableRowByOffset(1);
+        RowCopyTextFromState copyState{
+            .source = row,
+            .columnLimit = 10,
+        };
+        copy.CopyTextFrom(copyState);
+        VERIFY_ARE_EQUAL(row.GetText(), copy.GetText());
+    }
+
+    {
+        Log::Comment(L"A wide row stops accepting text before its char offsets overflow");
+        static constexpr til::CoordType width = 2000;
+        TextBuffer buffer{ { width, 2 }, attr, cursorSize, false, _renderer };
+        auto& row = buffer.GetMutableRowByOffset(0);
+
+        RowWriteState state{
+            .text = text,
+            .columnLimit = width,
+        };
+        row.ReplaceText(state);
+
+        // The text that didn't fit is returned as if the row was full, so that callers wrap to the next line.
+        const auto consumed = text.size() - state.text.size();
+        const auto columns = gsl::narrow_cast<til::CoordType>(consumed / maxLength);
+        VERIFY_ARE_EQUAL(0u, consumed % maxLength);
+        VERIFY_IS_TRUE(columns > 0 && columns < width);
+        VERIFY_ARE_EQUAL(width, state.columnEnd);
+        VERIFY_ARE_EQUAL(columns, state.columnEndDirty);
+
+        const auto rowText = row.GetText();
+        const std::wstring padding(width - columns, L' ');
+        VERIFY_IS_LESS_THAN_OR_EQUAL(rowText.size(), size_t{ 0x7fff });
+        VERIFY_ARE_EQUAL(std::wstring_view{ text }.substr(0, consumed), rowText.substr(0, consumed));
+        VERIFY_ARE_EQUAL(std::wstring_view{ padding }, rowText.substr(consumed));
+        VERIFY_ARE_EQUAL(std::wstring_view{ L" " }, row.GlyphAt(columns));
+
+        auto& copy = buffer.GetMutableRowByOffset(1);
+        RowCopyTextFromState copyState{
+            .source = row,
+            .columnLimit = width,
+        };
+        copy.CopyTextFrom(copyState);
+        VERIFY_ARE_EQUAL(rowText, copy.GetText());
+        VERIFY_ARE_EQUAL(row.GlyphAt(columns - 1), copy.GlyphAt(columns - 1));
+    }
+}
+
+void TextBufferTests::TestRowReplaceTextInSlices()
+{
+    // COOKED_READ_DATA writes its buffer in slices of roughly 256 code units, which it moves to the next
+    // grapheme cluster boundary. Writing these slices one after another must result in the same row as
+    // writing all of the text at once. Here "e" + U+0301 straddles the offset 256.
+    static constexpr til::CoordType width = 300;
+    static constexpr UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ { width, 2 }, attr, cursorSize, false, _renderer };
+
+    std::wstring text(255, L'a');
+    text.append(L"e\x301" L"b");
+
+    Log::Comment(L"The boundaries around an offset inside of a cluster");
+    VERIFY_ARE_EQUAL(255u, TextBuffer::GraphemePrev(text, 256));
+    VERIFY_ARE_EQUAL(257u, TextBuffer::GraphemeNext(text, TextBuffer::GraphemePrev(text, 256)));
+
+    auto& whole = buffer.GetMutableRowByOffset(0);
+    RowWriteState state{
+        .text = text,
+        .columnLimit = width,
+    };
+    whole.ReplaceText(state);
+
+    auto& sliced = buffer.GetMutableRowByOffset(1);
+    til::CoordType column = 0;
+    for (const auto& [beg, end] : std::initializer_list<std::pair<size_t, size_t>>{ { 0, 257 }, { 257, text.size() } })
+    {
+        RowWriteState sliceState{
+            .text = std::wstring_view{ text }.substr(beg, end - beg),
+            .columnBegin = column,
+            .columnLimit = width,
+        };
+        sliced.ReplaceText(sliceState);
+        VERIFY_IS_TRUE(sliceState.text.empty());
+        column = sliceState.columnEnd;
+    }
+
+    VERIFY_ARE_EQUAL(257, column);
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"e\x301" }, sliced.GlyphAt(255));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"b" }, sliced.GlyphAt(256));
+    VERIFY_ARE_EQUAL(whole.GetText(), sliced.GetText());
+}
+
 void TextBufferTests::TestAppendRTFText()
 {
     {
@@ -2337,6 +2463,49 @@ void TextBufferTests::GetWordBoundaries()
     }
 }
 
+void TextBufferTests::WordDelimiterClasses()
+{
+    const WordDelimiters delimiters{ L" /\\()\"'-.,:;<>~!@#$%^&*|+=[]{}~?\u2502\u00bb" };
+
+    VERIFY_IS_TRUE(DelimiterClass::ControlChar == delimiters.Classify(L'\0'));
+    VERIFY_IS_TRUE(DelimiterClass::ControlChar == delimiters.Classify(L'\t'));
+    VERIFY_IS_TRUE(DelimiterClass::ControlChar == delimiters.Classify(L' '));
+    VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == delimiters.Classify(L'/'));
+    VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == delimiters.Classify(L'~'));
+    VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == delimiters.Classify(L'\u2502'));
+    VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == delimiters.Classify(L'\u00bb'));
+    VERIFY_IS_TRUE(DelimiterClass::RegularChar == delimiters.Classify(L'a'));
+    VERIFY_IS_TRUE(DelimiterClass::RegularChar == delimiters.Classify(L'\x7f'));
+    VERIFY_IS_TRUE(DelimiterClass::RegularChar == delimiters.Classify(L'\u00e9'));
+    VERIFY_IS_TRUE(DelimiterClass::RegularChar == delimiters.Classify(L'\u754c'));
+
+    TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ { 8, 1 }, attr, 12, false, _renderer };
+    WriteLinesToBuffer({ L"a/\u754c\u00bbb" }, buffer);
+
+    // The classes of a whole row must match the ones of the individual columns,
+    // including both halves of the wide glyph and the trailing whitespace.
+    const auto& row = buffer.GetRowByOffset(0);
+    std::array<DelimiterClass, 8> classes{};
+    row.DelimiterClasses(classes, delimiters);
+
+    static constexpr std::array expected{
+        DelimiterClass::RegularChar,
+        DelimiterClass::DelimiterChar,
+        DelimiterClass::RegularChar,
+        DelimiterClass::RegularChar,
+        DelimiterClass::DelimiterChar,
+        DelimiterClass::RegularChar,
+        DelimiterClass::ControlChar,
+        DelimiterClass::ControlChar,
+    };
+    for (til::CoordType i = 0; i < 8; ++i)
+    {
+        VERIFY_IS_TRUE(til::at(expected, i) == til::at(classes, i));
+        VERIFY_IS_TRUE(til::at(expected, i) == row.DelimiterClassAt(i, delimiters));
+    }
+}
+
 void TextBufferTests::MoveByWord()
 {
     til::size bufferSize{ 80, 9001 };
@@ -2774,6 +2943,114 @@ void TextBufferTests::GetPlainText()
     }
 }
 
+void TextBufferTests::GenCopyData()
+{
+    // GenCopyData() produces the plain text, HTML and RTF of a selection in one pass.
+    // The expected HTML and RTF below were produced by the GenHTML/GenRTF implementations
+    // that predate GenCopyData(). Its output must remain byte for byte identical.
+
+    til::size bufferSize{ 10, 20 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, false, _renderer);
+
+    const std::vector<std::wstring> bufferText = { L"a<b>&c",
+                                                   L"  345",
+                                                   L"123  " };
+    WriteLinesToBuffer(bufferText, *_buffer);
+
+    // Give the second row a couple of different attributes, so that it consists of multiple runs.
+    {
+        auto& row = _buffer->GetMutableRowByOffset(1);
+        TextAttribute red{ FOREGROUND_RED };
+        red.SetUnderlineStyle(UnderlineStyle::CurlyUnderlined);
+        row.SetAttrToEnd(2, red);
+        row.ReplaceAttributes(3, 4, TextAttribute{ FOREGROUND_GREEN | BACKGROUND_BLUE });
+    }
+
+    const auto req = TextBuffer::CopyRequest{ *_buffer, { 1, 0 }, { 4, 2 }, false, true, true, false };
+    const auto GetAttributeColors = [](const TextAttribute& attr) {
+        const auto color = static_cast<COLORREF>(attr.GetLegacyAttributes());
+        return std::tuple{ color, color << 8, color << 16 };
+    };
+
+    const TextBuffer::CopyFormatting formatting{
+        .fontHeightPoints = 12,
+        .fontFaceName = L"Consolas",
+        .backgroundColor = RGB(0x0c, 0x0c, 0x0c),
+        .isIntenseBold = true,
+        .html = true,
+        .rtf = true,
+    };
+    const auto result = _buffer->GenCopyData(req, formatting, GetAttributeColors);
+
+    VERIFY_ARE_EQUAL(L"<b>&c\r\n  345\r\n123", result.plainText);
+
+    const std::string_view expectedHtml =
+        "Version:0.9\r\nStartHTML:0000000157\r\nEndHTML:0000000907\r\nStartFragment:0000000192\r\nEndFragment:0000000893\r\nStartSelection:0000000192\r\nEndSelection:0000000893\r\n"
+        "<!DOCTYPE><HTML><HEAD></HEAD><BODY><!--StartFragment -->"
+        "<DIV STYLE=\"display:inline-block;white-space:pre;background-color:#0C0C0C;font-family:'Consolas',monospace;font-size:12pt;padding:4px;\">"
+        "<SPAN STYLE=\"color:#7F0000;background-color:#007F00;\">&lt;b&gt;&amp;c</SPAN>"
+        "<BR><SPAN STYLE=\"color:#7F0000;background-color:#007F00;\">  </SPAN>"
+        "<SPAN STYLE=\"color:#040000;background-color:#000400;\"><SPAN STYLE=\"text-decoration:underline wavy #000004;\">3</SPAN></SPAN>"
+        "<SPAN STYLE=\"color:#120000;background-color:#001200;\">4</SPAN>"
+        "<SPAN STYLE=\"color:#040000;background-color:#000400;\"><SPAN STYLE=\"text-decoration:underline wavy #000004;\">5</SPAN></SPAN>"
+        "<BR><SPAN STYLE=\"color:#7F0000;background-color:#007F00;\">123</SPAN>"
+        "</DIV><!--EndFragment --></BODY></HTML>";
+    VERIFY_ARE_EQUAL(expectedHtml, std::string_view{ result.html });
+
+    // The CF_HTML offsets must point at the actual document and fragment.
+    VERIFY_IS_TRUE(result.html.substr(157).starts_with("<!DOCTYPE>"));
+    VERIFY_IS_TRUE(result.html.substr(192).starts_with("<!--StartFragment -->"));
+    VERIFY_IS_TRUE(result.html.substr(893).starts_with("</BODY>"));
+    VERIFY_ARE_EQUAL(907u, result.html.size());
+
+    const std::string_view expectedRtf =
+        "{\\rtf1\\ansi\\ansicpg1252\\deff0\\nouicompat{\\fonttbl{\\f0\\fmodern\\fcharset0 Consolas;}}"
+        "{\\colortbl ;\\red12\\green12\\blue12;\\red127\\green0\\blue0;\\red0\\green127\\blue0;\\red0\\green0\\blue127;\\red4\\green0\\blue0;\\red0\\green4\\blue0;\\red0\\green0\\blue4;\\red18\\green0\\blue0;\\red0\\green18\\blue0;\\red0\\green0\\blue18;}"
+        "\\viewkind4\\uc1\\pard\\slmult1\\f0\\fs24\\chshdng0\\chcbpat1"
+        "{\\cf2\\chshdng0\\chcbpat3 <b>&c}"
+        "\\line{\\cf2\\chshdng0\\chcbpat3   }"
+        "{\\cf5\\chshdng0\\chcbpat6\\ulwave\\ulc7 3}"
+        "{\\cf8\\chshdng0\\chcbpat9 4}"
+        "{\\cf5\\chshdng0\\chcbpat6\\ulwave\\ulc7 5}"
+        "\\line{\\cf2\\chshdng0\\chcbpat3 123}}";
+    VERIFY_ARE_EQUAL(expectedRtf, std::string_view{ result.rtf });
+
+    // Requesting only the plain text doesn't generate any markup.
+    const auto plainOnly = _buffer->GenCopyData(req, {}, GetAttributeColors);
+    VERIFY_ARE_EQUAL(result.plainText, plainOnly.plainText);
+    VERIFY_IS_TRUE(plainOnly.html.empty());
+    VERIFY_IS_TRUE(plainOnly.rtf.empty());
+
+    // A cancelled copy produces nothing.
+    std::stop_source stopSource;
+    stopSource.request_stop();
+    const auto cancelled = _buffer->GenCopyData(req, formatting, GetAttributeColors, stopSource.get_token());
+    VERIFY_IS_TRUE(cancelled.plainText.empty());
+    VERIFY_IS_TRUE(cancelled.html.empty());
+    VERIFY_IS_TRUE(cancelled.rtf.empty());
+
+    // The clipboard callers pass the token of a CopyDeadline, which doesn't interfere with a quick copy...
+    {
+        const TextBuffer::CopyDeadline deadline{ TextBuffer::CopyFormattingTimeout };
+        const auto timely = _buffer->GenCopyData(req, formatting, GetAttributeColors, deadline.get_token());
+        VERIFY_ARE_EQUAL(expectedHtml, std::string_view{ timely.html });
+    }
+
+    // ...but cancels the copy once it has expired.
+    {
+        const TextBuffer::CopyDeadline deadline{ std::chrono::milliseconds{ 1 } };
+        wil::unique_event expired{ wil::EventOptions::ManualReset };
+        const std::stop_callback onExpired{ deadline.get_token(), [&]() noexcept { expired.SetEvent(); } };
+        VERIFY_IS_TRUE(expired.wait(5000));
+
+        const auto late = _buffer->GenCopyData(req, formatting, GetAttributeColors, deadline.get_token());
+        VERIFY_IS_TRUE(late.plainText.empty());
+        VERIFY_IS_TRUE(late.html.empty());
+    }
+}
+
 // This tests that when we increment the circular buffer, obsolete hyperlink references
 // are removed from the hyperlink map
 void TextBufferTests::HyperlinkTrim()
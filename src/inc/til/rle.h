@@ -231,6 +231,20 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             ParentIt _it;
             size_type _pos;
         };
+
+        // The optional prefix index of basic_rle. ends[i] is the sum of the lengths of the runs [0, i].
+        // It's only valid as long as nothing modified the runs through basic_rle::runs().
+        template<typename Index>
+        struct rle_index
+        {
+            Index ends;
+            bool valid = false;
+        };
+
+        template<>
+        struct rle_index<void>
+        {
+        };
     } // namespace details
 
     // rle_pair is a simple clone of std::pair, with one difference:
@@ -286,7 +300,22 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         return !(lhs == rhs);
     }
 
-    template<typename T, typename S = std::size_t, typename Container = std::vector<rle_pair<T, S>>>
+    // rle_replacement is a single item for basic_rle::replace(std::span<const rle_replacement>).
+    // It replaces the range [start_index, end_index) with value.
+    template<typename T, typename S>
+    struct rle_replacement
+    {
+        S start_index{};
+        S end_index{};
+        T value{};
+    };
+
+    // basic_rle stores a sequence of values as runs of identical values.
+    //
+    // If Index is not void, it must be a container of S (like til::small_vector<S, N>) and basic_rle
+    // will maintain the cumulative length of the runs in it. This turns the lookup of a position
+    // in at(), slice(), replace(), etc. from a linear scan over all runs into a binary search.
+    template<typename T, typename S = std::size_t, typename Container = std::vector<rle_pair<T, S>>, typename Index = void>
     class basic_rle
     {
     public:
@@ -303,7 +332,11 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
         using rle_type = rle_pair<value_type, size_type>;
+        using replacement_type = rle_replacement<value_type, size_type>;
         using container = Container;
+        using index_container = Index;
+
+        static constexpr bool has_index = !std::is_void_v<Index>;
 
         // We don't check anywhere whether a size_type value is negative.
         // Having signed integers would break that.
@@ -317,7 +350,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         basic_rle& operator=(const basic_rle& other) = default;
 
         basic_rle(basic_rle&& other) noexcept :
-            _runs(std::move(other._runs)), _total_length(other._total_length)
+            _runs(std::move(other._runs)), _index(std::move(other._index)), _total_length(other._total_length)
         {
             // C++ fun fact:
             // "std::move" actually doesn't actually promise to _really_ move stuff from A to B,
@@ -332,18 +365,21 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             if (other._runs.empty())
             {
                 other._total_length = 0;
+                other._index_update(0);
             }
         }
 
         basic_rle& operator=(basic_rle&& other) noexcept
         {
             _runs = std::move(other._runs);
+            _index = std::move(other._index);
             _total_length = other._total_length;
 
             // See basic_rle(basic_rle&&) for why this is necessary.
             if (other._runs.empty())
             {
                 other._total_length = 0;
+                other._index_update(0);
             }
 
             return *this;
@@ -356,6 +392,8 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             {
                 _total_length += run.length;
             }
+
+            _index_update(0);
         }
 
         basic_rle(container&& runs) :
@@ -365,6 +403,8 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             {
                 _total_length += run.length;
             }
+
+            _index_update(0);
         }
 
         basic_rle(const size_type length, const value_type& value) :
@@ -374,11 +414,14 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             {
                 _runs.emplace_back(value, length);
             }
+
+            _index_update(0);
         }
 
         void swap(basic_rle& other) noexcept
         {
             std::swap(_runs, other._runs);
+            std::swap(_index, other._index);
             std::swap(_total_length, other._total_length);
         }
 
@@ -400,26 +443,28 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             return _runs;
         }
 
+        // Since the caller may modify the runs, this invalidates the index until the next modification
+        // through any of the other methods. Lookups fall back to a linear scan in the meantime.
         container& runs() noexcept
         {
+            if constexpr (has_index)
+            {
+                _index.valid = false;
+            }
             return _runs;
         }
 
         // Get the value at the position
         const_reference at(size_type position) const
         {
-            const auto begin = _runs.begin();
-            const auto end = _runs.end();
-
-            rle_scanner scanner(begin, end);
-            auto it = scanner.scan(position).first;
+            const auto [run, pos] = _scan(position);
 
-            if (it == end)
+            if (run == _runs.size())
             {
                 throw std::out_of_range("position out of range");
             }
 
-            return it->value;
+            return _runs[run].value;
         }
 
         // Returns the range [start_index, end_index) as a new vector.
@@ -443,11 +488,10 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             //
             // --> It's safe to subtract 1 from end_index
 
-            rle_scanner scanner(_runs.begin(), _runs.end());
-            const auto [begin_run, start_run_pos] = scanner.scan(start_index);
-            const auto [end_run, end_run_pos] = scanner.scan(end_index - 1);
+            const auto [begin_run, start_run_pos] = _scan(start_index);
+            const auto [end_run, end_run_pos] = _scan(end_index - 1);
 
-            container slice{ begin_run, end_run + 1 };
+            container slice{ _runs.begin() + begin_run, _runs.begin() + end_run + 1 };
             slice.back().length = end_run_pos + 1;
             slice.front().length -= start_run_pos;
 
@@ -491,6 +535,86 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             _replace_unchecked(start_index, end_index, replacements._runs);
         }
 
+        // Replaces multiple ranges at once, each with a single value, in a single pass over the runs.
+        // This is a lot cheaper than calling replace() for each range if there are many of them.
+        // The ranges must be sorted by start_index and must not overlap.
+        // If an end_index is larger than size() it's set to size().
+        void replace(const std::span<const replacement_type> replacements)
+        {
+            if (replacements.empty())
+            {
+                return;
+            }
+
+            size_type previous_end = 0;
+            for (const auto& r : replacements)
+            {
+                if (r.start_index < previous_end || r.start_index > std::min(r.end_index, _total_length))
+                {
+                    throw std::out_of_range("replacements must be sorted, must not overlap and start_index <= end_index");
+                }
+                previous_end = std::min(r.end_index, _total_length);
+            }
+
+            container result;
+            auto run = _runs.begin();
+            size_type run_begin = 0;
+            size_type pos = 0;
+
+            const auto append = [&](const value_type& value, size_type length) {
+                if (!length)
+                {
+                    return;
+                }
+                if (!result.empty() && result.back().value == value)
+                {
+                    result.back().length += length;
+                }
+                else
+                {
+                    result.emplace_back(value, length);
+                }
+            };
+            // Copies the existing runs in the range [pos, until) into result.
+            const auto copy_until = [&](size_type until) {
+                while (pos < until)
+                {
+                    const size_type run_end = run_begin + run->length;
+                    if (run_end > pos)
+                    {
+                        const size_type length = std::min(run_end, until) - pos;
+                        append(run->value, length);
+                        pos += length;
+                    }
+                    if (pos >= run_end)
+                    {
+                        run_begin = run_end;
+                        ++run;
+                    }
+                }
+            };
+
+            for (const auto& r : replacements)
+            {
+                const auto end_index = std::min(r.end_index, _total_length);
+                copy_until(r.start_index);
+                append(r.value, gsl::narrow_cast<size_type>(end_index - r.start_index));
+
+                // Skip the replaced runs. copy_until() will pick up the remainder of a partially replaced run.
+                pos = end_index;
+                while (run != _runs.end() && gsl::narrow_cast<size_type>(run_begin + run->length) <= pos)
+                {
+                    run_begin += run->length;
+                    ++run;
+                }
+            }
+
+            copy_until(_total_length);
+
+            _runs = std::move(result);
+            _index_update(0);
+        }
+
         // Replaces every instance of old_value in this vector with new_value.
         void replace_values(const value_type& old_value, const value_type& new_value)
         {
@@ -503,6 +627,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             }
 
             _compact();
+            _index_update(0);
         }
 
         // Adjust the size of the vector.
@@ -510,18 +635,21 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         // If the size is being decreased, the trailing runs are cut off to fit.
         void resize_trailing_extent(const size_type new_size)
         {
+            size_t first_changed_run = 0;
+
             if (new_size == 0)
             {
                 _runs.clear();
             }
             else if (new_size < _total_length)
             {
-                rle_scanner scanner(_runs.begin(), _runs.end());
-                auto [run, pos] = scanner.scan(new_size - 1);
+                const auto [run, pos] = _scan(new_size - 1);
+                const auto it = _runs.begin() + run;
 
-                run->length = ++pos;
+                it->length = gsl::narrow_cast<size_type>(pos + 1);
 
-                _runs.erase(++run, _runs.end());
+                _runs.erase(it + 1, _runs.end());
+                first_changed_run = run;
             }
             else if (new_size > _total_length)
             {
@@ -529,9 +657,56 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 auto& run = _runs.back();
 
                 run.length += new_size - _total_length;
+                first_changed_run = _runs.size() - 1;
             }
 
             _total_length = new_size;
+            _index_update(first_changed_run);
+        }
+
+        // Replaces all runs with `length` times `value` and updates the index in the same step.
+        // It's equivalent to assigning basic_rle(length, value), but doesn't construct a temporary.
+        // til::small_vector containers return their heap memory, which makes this noexcept for them.
+        void assign(const size_type length, const value_type& value) noexcept(_shrinkable<container>)
+        {
+            const size_t count = length ? 1 : 0;
+
+            if constexpr (_shrinkable<container>)
+            {
+                const auto runs = _runs.unsafe_shrink_to_size(count);
+                if (count)
+                {
+                    *runs = rle_type{ value, length };
+                }
+            }
+            else
+            {
+                _runs.clear();
+                if (count)
+                {
+                    _runs.emplace_back(value, length);
+                }
+            }
+
+            if constexpr (has_index)
+            {
+                if constexpr (_shrinkable<index_container>)
+                {
+                    const auto ends = _index.ends.unsafe_shrink_to_size(count);
+                    if (count)
+                    {
+                        *ends = length;
+                    }
+                    _index.valid = true;
+                }
+                else
+                {
+                    _index.valid = false;
+                    _index_update(0);
+                }
+            }
+
+            _total_length = length;
         }
 
         constexpr bool operator==(const basic_rle& other) const noexcept
@@ -617,6 +792,11 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 #endif
 
     private:
+        // til::small_vector can drop its contents and heap memory in one go via unsafe_shrink_to_size().
+        // It doesn't call any destructors, which is only fine for trivially destructible types.
+        template<typename C>
+        static constexpr bool _shrinkable = std::is_trivially_destructible_v<typename C::value_type> && requires(C& c) { c.unsafe_shrink_to_size(size_t{}); };
+
         template<typename It>
         struct rle_scanner
         {
@@ -649,10 +829,59 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             size_type total = 0;
         };
 
-        basic_rle(container&& runs, size_type size) noexcept :
+        // Returns the index of the run containing the given position and the offset of the position within that run.
+        // If the position is past the end, the run index is equal to _runs.size().
+        std::pair<size_t, size_type> _scan(size_type index) const noexcept
+        {
+            if constexpr (has_index)
+            {
+                if (_index.valid)
+                {
+                    const auto begin = _index.ends.begin();
+                    const auto it = std::upper_bound(begin, _index.ends.end(), index);
+                    const auto run = gsl::narrow_cast<size_t>(it - begin);
+                    const size_type run_begin = run == 0 ? size_type{ 0 } : *(it - 1);
+                    return { run, run == _runs.size() ? size_type{ 0 } : gsl::narrow_cast<size_type>(index - run_begin) };
+                }
+            }
+
+            rle_scanner scanner(_runs.begin(), _runs.end());
+            const auto [it, pos] = scanner.scan(index);
+            return { gsl::narrow_cast<size_t>(it - _runs.begin()), pos };
+        }
+
+        // Recalculates the cumulative lengths for all runs starting at first_changed_run.
+        // The preceding entries must still be correct. If the index was invalidated, it's rebuilt entirely.
+        void _index_update(size_t first_changed_run)
+        {
+            if constexpr (has_index)
+            {
+                static_assert(std::is_same_v<size_type, typename index_container::value_type>, "the value type of the Index must be S");
+
+                if (!_index.valid)
+                {
+                    first_changed_run = 0;
+                }
+
+                const auto count = _runs.size();
+                _index.ends.resize(count);
+
+                size_type total = first_changed_run == 0 ? 0 : _index.ends[first_changed_run - 1];
+                for (auto i = first_changed_run; i < count; ++i)
+                {
+                    total += _runs[i].length;
+                    _index.ends[i] = total;
+                }
+
+                _index.valid = true;
+            }
+        }
+
+        basic_rle(container&& runs, size_type size) :
             _runs(std::forward<container>(runs)),
             _total_length(size)
         {
+            _index_update(0);
         }
 
         void _compact()
@@ -860,15 +1089,21 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             // [Step6.2]: Otherwise if the space wasn't enough we need to insert the remaining runs.
             // [Step7]: Apply the additional lengths for adjacent runs.
             // [Step8]: Recalculate the _total_length.
+            // [Step9]: Update the cumulative lengths in the index, if any, starting at the first modified run.
             //
             //
             //
 
             // TODO GH#10135: Ensure replacements contains no runs with .length == 0.
 
-            rle_scanner scanner{ _runs.begin(), _runs.end() };
-            auto [begin, begin_pos] = scanner.scan(start_index);
-            auto [end, end_pos] = scanner.scan(end_index);
+            const auto [begin_run, begin_run_pos] = _scan(start_index);
+            const auto [end_run, end_run_pos] = _scan(end_index);
+            auto begin = _runs.begin() + begin_run;
+            auto end = _runs.begin() + end_run;
+            auto begin_pos = begin_run_pos;
+            auto end_pos = end_run_pos;
+            // Apart from the runs in [begin, end), the run preceding begin may be modified as well.
+            const auto first_changed_run = begin_run == 0 ? 0 : begin_run - 1;
 
             // This condition handles pure removals, where replacements.size() == 0.
             //
@@ -908,6 +1143,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
                 _runs.erase(begin, end);
                 _total_length -= removed;
+                _index_update(first_changed_run);
                 return;
             }
 
@@ -1019,9 +1255,13 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             {
                 _total_length += run.length;
             }
+
+            // [Step9]
+            _index_update(first_changed_run);
         }
 
         container _runs;
+        [[msvc::no_unique_address]] details::rle_index<Index> _index;
         S _total_length{ 0 };
 
 #ifdef UNIT_TESTING
@@ -1037,15 +1277,18 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
     template<typename T, typename S = std::size_t, std::size_t N = 1>
     using small_rle = basic_rle<T, S, til::small_vector<rle_pair<T, S>, N>>;
+
+    template<typename T, typename S = std::size_t, std::size_t N = 1>
+    using indexed_small_rle = basic_rle<T, S, til::small_vector<rle_pair<T, S>, N>, til::small_vector<S, N>>;
 };
 
 #ifdef __WEX_COMMON_H__
 namespace WEX::TestExecution
 {
-    template<typename T, typename S, typename Container>
-    class VerifyOutputTraits<::til::basic_rle<T, S, Container>>
+    template<typename T, typename S, typename Container, typename Index>
+    class VerifyOutputTraits<::til::basic_rle<T, S, Container, Index>>
     {
-        using rle_vector = ::til::basic_rle<T, S, Container>;
+        using rle_vector = ::til::basic_rle<T, S, Container, Index>;
 
     public:
         static WEX::Common::NoThrowString ToString(const rle_vector& object)
@@ -1054,10 +1297,10 @@ namespace WEX::TestExecution
         }
     };
 
-    template<typename T, typename S, typename Container>
-    class VerifyCompareTraits<::til::basic_rle<T, S, Container>, ::til::basic_rle<T, S, Container>>
+    template<typename T, typename S, typename Container, typename Index>
+    class VerifyCompareTraits<::til::basic_rle<T, S, Container, Index>, ::til::basic_rle<T, S, Container, Index>>
     {
-        using rle_vector = ::til::basic_rle<T, S, Container>;
+        using rle_vector = ::til::basic_rle<T, S, Container, Index>;
 
     public:
         static bool AreEqual(const rle_vector& expected, const rle_vector& actual) noexcept
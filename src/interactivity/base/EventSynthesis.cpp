@@ -32,6 +32,54 @@ static bool IsCharFullWidth(const wchar_t wch) noexcept
            (0xffe0 <= wch && wch <= 0xffe6); // Fullwidth symbol variants
 }
 
+// Routine Description:
+// - The shared implementation of SynthesizeKeyboardEvents and StringToKeyEvents.
+// Arguments:
+// - wch - the wchar_t to convert
+// - keyState - the result of VkKeyScanW() for wch
+// - sc - the scan code of the virtual key in the low byte of keyState
+// - keyEvents - receives the KeyEvents that represent the wchar_t being typed
+static void synthesizeKeyboardEvents(const wchar_t wch, const short keyState, const WORD sc, InputEventQueue& keyEvents)
+{
+    const auto vk = LOBYTE(keyState);
+
+    // The caller provides us with the result of VkKeyScanW() in keyState.
+    // The magic constants below are the expected (documented) return values from VkKeyScanW().
+    const auto modifierState = HIBYTE(keyState);
+    const auto shiftSet = WI_IsFlagSet(modifierState, 1);
+    const auto ctrlSet = WI_IsFlagSet(modifierState, 2);
+    const auto altSet = WI_IsFlagSet(modifierState, 4);
+    const auto altGrSet = WI_AreAllFlagsSet(modifierState, 4 | 2);
+
+    if (altGrSet)
+    {
+        keyEvents.push_back(SynthesizeKeyEvent(true, 1, VK_MENU, altScanCode, 0, ENHANCED_KEY | LEFT_CTRL_PRESSED | RIGHT_ALT_PRESSED));
+    }
+    else if (shiftSet)
+    {
+        keyEvents.push_back(SynthesizeKeyEvent(true, 1, VK_SHIFT, leftShiftScanCode, 0, SHIFT_PRESSED));
+    }
+
+    auto keyEvent = SynthesizeKeyEvent(true, 1, vk, sc, wch, 0);
+    WI_SetFlagIf(keyEvent.Event.KeyEvent.dwControlKeyState, SHIFT_PRESSED, shiftSet);
+    WI_SetFlagIf(keyEvent.Event.KeyEvent.dwControlKeyState, LEFT_CTRL_PRESSED, ctrlSet);
+    WI_SetFlagIf(keyEvent.Event.KeyEvent.dwControlKeyState, RIGHT_ALT_PRESSED, altSet);
+
+    keyEvents.push_back(keyEvent);
+    keyEvent.Event.KeyEvent.bKeyDown = FALSE;
+    keyEvents.push_back(keyEvent);
+
+    // handle yucky alt-gr keys
+    if (altGrSet)
+    {
+        keyEvents.push_back(SynthesizeKeyEvent(false, 1, VK_MENU, altScanCode, 0, ENHANCED_KEY));
+    }
+    else if (shiftSet)
+    {
+        keyEvents.push_back(SynthesizeKeyEvent(false, 1, VK_SHIFT, leftShiftScanCode, 0, 0));
+    }
+}
+
 void Microsoft::Console::Interactivity::CharToKeyEvents(const wchar_t wch, const unsigned int codepage, InputEventQueue& keyEvents)
 {
     static constexpr short invalidKey = -1;
@@ -73,42 +121,61 @@ void Microsoft::Console::Interactivity::CharToKeyEvents(const wchar_t wch, const
 // - will throw exception on error
 void Microsoft::Console::Interactivity::SynthesizeKeyboardEvents(const wchar_t wch, const short keyState, InputEventQueue& keyEvents)
 {
-    const auto vk = LOBYTE(keyState);
-    const auto sc = gsl::narrow<WORD>(OneCoreSafeMapVirtualKeyW(vk, MAPVK_VK_TO_VSC));
-    // The caller provides us with the result of VkKeyScanW() in keyState.
-    // The magic constants below are the expected (documented) return values from VkKeyScanW().
-    const auto modifierState = HIBYTE(keyState);
-    const auto shiftSet = WI_IsFlagSet(modifierState, 1);
-    const auto ctrlSet = WI_IsFlagSet(modifierState, 2);
-    const auto altSet = WI_IsFlagSet(modifierState, 4);
-    const auto altGrSet = WI_AreAllFlagsSet(modifierState, 4 | 2);
+    const auto sc = gsl::narrow<WORD>(OneCoreSafeMapVirtualKeyW(LOBYTE(keyState), MAPVK_VK_TO_VSC));
+    synthesizeKeyboardEvents(wch, keyState, sc, keyEvents);
+}
 
-    if (altGrSet)
-    {
-        keyEvents.push_back(SynthesizeKeyEvent(true, 1, VK_MENU, altScanCode, 0, ENHANCED_KEY | LEFT_CTRL_PRESSED | RIGHT_ALT_PRESSED));
-    }
-    else if (shiftSet)
+// Routine Description:
+// - converts a string into a series of KeyEvents as if it was typed using the
+//   keyboard. This is equivalent to calling CharToKeyEvents for each character,
+//   but it memoizes the keyboard layout lookups for ASCII characters, which
+//   make up the bulk of most pastes. The keyboard layout can't change while
+//   we're in here, so caching the results for the duration of the call is safe.
+// Arguments:
+// - text - the string to convert
+// - codepage - the codepage used for characters that have to be typed via the numpad
+// - keyEvents - receives the KeyEvents that represent the string being typed
+// Note:
+// - will throw exception on error
+void Microsoft::Console::Interactivity::StringToKeyEvents(const std::wstring_view text, const unsigned int codepage, InputEventQueue& keyEvents)
+{
+    struct CachedKey
     {
-        keyEvents.push_back(SynthesizeKeyEvent(true, 1, VK_SHIFT, leftShiftScanCode, 0, SHIFT_PRESSED));
-    }
+        short keyState;
+        WORD sc;
+        bool valid;
+    };
 
-    auto keyEvent = SynthesizeKeyEvent(true, 1, vk, sc, wch, 0);
-    WI_SetFlagIf(keyEvent.Event.KeyEvent.dwControlKeyState, SHIFT_PRESSED, shiftSet);
-    WI_SetFlagIf(keyEvent.Event.KeyEvent.dwControlKeyState, LEFT_CTRL_PRESSED, ctrlSet);
-    WI_SetFlagIf(keyEvent.Event.KeyEvent.dwControlKeyState, RIGHT_ALT_PRESSED, altSet);
+    // Each character produces at least a key down and key up event.
+    keyEvents.reserve(keyEvents.size() + text.size() * 2);
 
-    keyEvents.push_back(keyEvent);
-    keyEvent.Event.KeyEvent.bKeyDown = FALSE;
-    keyEvents.push_back(keyEvent);
+    std::array<CachedKey, 128> cache{};
 
-    // handle yucky alt-gr keys
-    if (altGrSet)
-    {
-        keyEvents.push_back(SynthesizeKeyEvent(false, 1, VK_MENU, altScanCode, 0, ENHANCED_KEY));
-    }
-    else if (shiftSet)
+    for (const auto wch : text)
     {
-        keyEvents.push_back(SynthesizeKeyEvent(false, 1, VK_SHIFT, leftShiftScanCode, 0, 0));
+        if (wch >= cache.size())
+        {
+            CharToKeyEvents(wch, codepage, keyEvents);
+            continue;
+        }
+
+        auto& entry = til::at(cache, wch);
+        if (!entry.valid)
+        {
+            entry.keyState = OneCoreSafeVkKeyScanW(wch);
+            entry.sc = gsl::narrow<WORD>(OneCoreSafeMapVirtualKeyW(LOBYTE(entry.keyState), MAPVK_VK_TO_VSC));
+            entry.valid = true;
+        }
+
+        if (entry.keyState == -1)
+        {
+            // Characters that aren't part of the keyboard layout take the slow path,
+            // which may synthesize them via Alt+Numpad.
+            CharToKeyEvents(wch, codepage, keyEvents);
+            continue;
+        }
+
+        synthesizeKeyboardEvents(wch, entry.keyState, entry.sc, keyEvents);
     }
 }
 
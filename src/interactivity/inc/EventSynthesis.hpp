@@ -20,4 +20,5 @@ namespace Microsoft::Console::Interactivity
     void CharToKeyEvents(wchar_t wch, unsigned int codepage, InputEventQueue& out);
     void SynthesizeKeyboardEvents(wchar_t wch, short keyState, InputEventQueue& out);
     void SynthesizeNumpadEvents(wchar_t wch, unsigned int codepage, InputEventQueue& out);
+    void StringToKeyEvents(std::wstring_view text, unsigned int codepage, InputEventQueue& out);
 }
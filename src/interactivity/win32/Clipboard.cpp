@@ -343,18 +343,45 @@ void Clipboard::StoreSelectionToClipboard(const bool copyFormatting)
     const auto& [selectionStart, selectionEnd] = selection.GetSelectionAnchors();
 
     const auto req = TextBuffer::CopyRequest::FromConfig(buffer, selectionStart, selectionEnd, singleLine, !selection.IsLineSelection(), false);
-    text = buffer.GetPlainText(req);
 
     if (copyFormatting)
     {
         const auto& fontData = gci.GetActiveOutputBuffer().GetCurrentFont();
-        const auto& fontName = fontData.GetFaceName();
-        const auto fontSizePt = fontData.GetUnscaledSize().height * 72 / ServiceLocator::LocateGlobals().dpi;
-        const auto bgColor = renderSettings.GetAttributeColors({}).second;
-        const auto isIntenseBold = renderSettings.GetRenderMode(::Microsoft::Console::Render::RenderSettings::Mode::IntenseIsBold);
-
-        htmlData = buffer.GenHTML(req, fontSizePt, fontName, bgColor, isIntenseBold, GetAttributeColors);
-        rtfData = buffer.GenRTF(req, fontSizePt, fontName, bgColor, isIntenseBold, GetAttributeColors);
+        const TextBuffer::CopyFormatting formatting{
+            .fontHeightPoints = fontData.GetUnscaledSize().height * 72 / ServiceLocator::LocateGlobals().dpi,
+            .fontFaceName = fontData.GetFaceName(),
+            .backgroundColor = renderSettings.GetAttributeColors({}).second,
+            .isIntenseBold = renderSettings.GetRenderMode(::Microsoft::Console::Render::RenderSettings::Mode::IntenseIsBold),
+            .html = true,
+            .rtf = true,
+        };
+
+        // Generate all three formats in a single pass over the selection.
+        // If that fails or takes too long, we'll still copy the plain text below.
+        try
+        {
+            const TextBuffer::CopyDeadline deadline{ TextBuffer::CopyFormattingTimeout };
+            auto copyData = buffer.GenCopyData(req, formatting, GetAttributeColors, deadline.get_token());
+            if (copyData.html.empty() && copyData.rtf.empty())
+            {
+                copyData.plainText = buffer.GetPlainText(req);
+            }
+
+            text = std::move(copyData.plainText);
+            htmlData = std::move(copyData.html);
+            rtfData = std::move(copyData.rtf);
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            htmlData.clear();
+            rtfData.clear();
+            text = buffer.GetPlainText(req);
+        }
+    }
+    else
+    {
+        text = buffer.GetPlainText(req);
     }
 
     const auto clipboard = _openClipboard(ServiceLocator::LocateConsoleWindow()->GetWindowHandle());
@@ -1807,6 +1807,121 @@ class UiaTextRangeTests
         }
     }
 
+    TEST_METHOD(MoveByGlyphsMatchesStepping)
+    {
+        // TextBuffer::MoveByGlyphs() is a faster version of calling MoveToNextGlyph()/MoveToPreviousGlyph()
+        // in a loop, which is what the UIA character movement used to do. Both have to agree exactly.
+        const auto bufferSize = _pTextBuffer->GetSize();
+        const auto right = bufferSize.RightInclusive();
+        _pTextBuffer->GetMutableRowByOffset(1).ReplaceCharacters(3, 2, L"\u304d");
+        _pTextBuffer->GetMutableRowByOffset(1).ReplaceCharacters(right - 1, 2, L"\u304d");
+        _pTextBuffer->GetMutableRowByOffset(3).ReplaceCharacters(0, 2, L"\u304d");
+
+        const til::point limits[]{
+            bufferSize.EndExclusive(),
+            { 0, 4 },
+            { 5, 1 },
+        };
+        const til::point starts[]{
+            bufferSize.Origin(),
+            { 2, 1 },
+            { 4, 1 },
+            { right, 1 },
+            { right, 2 },
+            { 1, 3 },
+            { 0, 4 },
+            { 10, 6 },
+            bufferSize.EndExclusive(),
+        };
+        const til::CoordType counts[]{ 1, 3, 200, -1, -3, -200 };
+
+        for (const auto limit : limits)
+        {
+            for (const auto start : starts)
+            {
+                for (const auto count : counts)
+                {
+                    for (const auto allowExclusiveEnd : { false, true })
+                    {
+                        auto expected = start;
+                        til::CoordType expectedMoved = 0;
+                        while (expectedMoved != count)
+                        {
+                            if (count > 0 ? !_pTextBuffer->MoveToNextGlyph(expected, allowExclusiveEnd, limit) : !_pTextBuffer->MoveToPreviousGlyph(expected, limit))
+                            {
+                                break;
+                            }
+                            expectedMoved += count > 0 ? 1 : -1;
+                        }
+
+                        auto actual = start;
+                        const auto actualMoved = _pTextBuffer->MoveByGlyphs(actual, count, allowExclusiveEnd, limit);
+
+                        Log::Comment(NoThrowString().Format(L"start: (%d, %d), limit: (%d, %d), count: %d, allowExclusiveEnd: %d", start.x, start.y, limit.x, limit.y, count, allowExclusiveEnd));
+                        VERIFY_ARE_EQUAL(expectedMoved, actualMoved);
+                        VERIFY_ARE_EQUAL(expected, actual);
+                    }
+                }
+            }
+        }
+    }
+
+    TEST_METHOD(BulkOperationsBenchmark)
+    {
+        // This isn't a correctness test. It logs how long the operations take that screen readers
+        // use to read or walk the entire buffer, so that regressions are easy to spot.
+        const auto measure = [](const wchar_t* name, auto&& func) {
+            const auto beg = std::chrono::steady_clock::now();
+            func();
+            const auto end = std::chrono::steady_clock::now();
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count();
+            Log::Comment(NoThrowString().Format(L"%s: %lldus", name, static_cast<long long>(us)));
+        };
+
+        // Use a variety of attributes, so that there's more than one attribute run per row.
+        TextAttribute italicAttr;
+        italicAttr.SetItalic(true);
+        for (til::CoordType y = 0; y < _pTextBuffer->TotalRowCount(); y += 3)
+        {
+            _pTextBuffer->GetMutableRowByOffset(y).ReplaceAttributes(10, 20, italicAttr);
+        }
+
+        Microsoft::WRL::ComPtr<UiaTextRange> utr;
+        THROW_IF_FAILED(Microsoft::WRL::MakeAndInitialize<UiaTextRange>(&utr, _pUiaData, &_dummyProvider));
+        THROW_IF_FAILED(utr->ExpandToEnclosingUnit(TextUnit_Document));
+
+        measure(L"GetText(-1)", [&]() {
+            wil::unique_bstr text;
+            VERIFY_SUCCEEDED(utr->GetText(-1, text.put()));
+            VERIFY_IS_GREATER_THAN(SysStringLen(text.get()), 0u);
+        });
+
+        measure(L"GetAttributeValue(IsItalic)", [&]() {
+            VARIANT result{};
+            VERIFY_SUCCEEDED(utr->GetAttributeValue(UIA_IsItalicAttributeId, &result));
+            VERIFY_ARE_EQUAL(VT_UNKNOWN, result.vt);
+        });
+
+        measure(L"FindAttribute(IsItalic)", [&]() {
+            VARIANT var{};
+            var.vt = VT_BOOL;
+            var.boolVal = VARIANT_TRUE;
+            Microsoft::WRL::ComPtr<ITextRangeProvider> result;
+            VERIFY_SUCCEEDED(utr->FindAttribute(UIA_IsItalicAttributeId, var, true, result.GetAddressOf()));
+            VERIFY_IS_NOT_NULL(result.Get());
+        });
+
+        measure(L"MoveEndpointByUnit(Character)", [&]() {
+            Microsoft::WRL::ComPtr<UiaTextRange> range;
+            THROW_IF_FAILED(Microsoft::WRL::MakeAndInitialize<UiaTextRange>(&range, _pUiaData, &_dummyProvider));
+            int moved = 0;
+            VERIFY_SUCCEEDED(range->MoveEndpointByUnit(TextPatternRangeEndpoint_End, TextUnit_Character, INT_MAX, &moved));
+            VERIFY_IS_GREATER_THAN(moved, 0);
+            VERIFY_SUCCEEDED(range->MoveEndpointByUnit(TextPatternRangeEndpoint_End, TextUnit_Character, INT_MIN + 1, &moved));
+            VERIFY_IS_LESS_THAN(moved, 0);
+        });
+    }
+
     TEST_METHOD(BlockRange)
     {
         // This test replicates GH#7960.
@@ -41,6 +41,10 @@ namespace Microsoft::Console::Render::Atlas
 #define ATLAS_DEBUG_DUMP_RENDER_TARGET 0
 #define ATLAS_DEBUG_DUMP_RENDER_TARGET_PATH LR"(%USERPROFILE%\Downloads\AtlasEngine)"
 
+    // Logs the glyph atlas hit/allocation/eviction/reset counters via OutputDebugStringW
+    // whenever the atlas is reset or glyphs get evicted from it.
+#define ATLAS_DEBUG_GLYPH_ATLAS_STATS 0
+
     template<typename T = D2D1_COLOR_F>
     constexpr T colorFromU32(u32 rgba)
     {
@@ -0,0 +1,788 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "BackendCPU.h"
+
+#include "BuiltinGlyphs.h"
+
+TIL_FAST_MATH_BEGIN
+
+// Disable a bunch of warnings which get in the way of writing performant code.
+#pragma warning(disable : 26429) // Symbol 'data' is never tested for nullness, it can be marked as not_null (f.23).
+#pragma warning(disable : 26446) // Prefer to use gsl::at() instead of unchecked subscript operator (bounds.4).
+#pragma warning(disable : 26459) // You called an STL function '...' with a raw pointer parameter at position '...' that may be unsafe [...].
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+#pragma warning(disable : 26482) // Only index into arrays using constant expressions (bounds.2).
+
+using namespace Microsoft::Console::Render::Atlas;
+
+namespace
+{
+    enum class LineStyle
+    {
+        Solid,
+        Dotted,
+        Dashed,
+        Curly,
+    };
+}
+
+// Returns x / 255 rounded to the nearest integer for any x in [0, 255 * 255].
+static constexpr u32 div255(u32 x) noexcept
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Blends the straight alpha `color` scaled by `coverage` (0-255) onto the premultiplied `dst` pixel (source-over).
+static constexpr u32 blendSourceOver(u32 dst, u32 color, u32 coverage) noexcept
+{
+    const auto a = div255((color >> 24) * coverage);
+    const auto ia = 255 - a;
+    auto result = (a + div255((dst >> 24) * ia)) << 24;
+
+    for (u32 shift = 0; shift < 24; shift += 8)
+    {
+        const auto s = div255(((color >> shift) & 0xff) * a);
+        const auto d = div255(((dst >> shift) & 0xff) * ia);
+        result |= (s + d) << shift;
+    }
+
+    return result;
+}
+
+static constexpr i32r intersect(const i32r& a, const i32r& b) noexcept
+{
+    return {
+        std::max(a.left, b.left),
+        std::max(a.top, b.top),
+        std::min(a.right, b.right),
+        std::min(a.bottom, b.bottom),
+    };
+}
+
+// This replicates SHADING_TYPE_TEXT_BUILTIN_GLYPH in shader_ps.hlsl. It has a lengthy comment
+// explaining how the RGB components of the texel select the generated pixel pattern.
+static u32 shadeBuiltinGlyph(u32 texel, i32 x, i32 y, i32 dotWidth, i32 dotHeight) noexcept
+{
+    const auto a = texel >> 24;
+    const auto r = (texel >> 16) & 0xff;
+    const auto g = (texel >> 8) & 0xff;
+    const auto b = texel & 0xff;
+    const auto posX = x / dotWidth;
+    const auto posY = y / dotHeight;
+    // frac(dot(pos, float2(r * -0.25f + 0.5f, 0.5f))) is 0 for every 2nd dot if r is 0 and for every 4th dot if r is 1.
+    const auto on = r >= 128 ? ((posX + 2 * posY) & 3) == 0 : ((posX + posY) & 1) == 0;
+    const auto stretched = on ? a : 0;
+    const auto inverted = g > stretched ? g - stretched : stretched - g;
+    return std::max(b, inverted);
+}
+
+BackendCPU::~BackendCPU()
+{
+    // The WIC and Direct2D objects must be released before we give up our MTA usage.
+    ReleaseResources();
+    _wicFactory.reset();
+
+    if (_mtaUsageCookie)
+    {
+        LOG_IF_FAILED(CoDecrementMTAUsage(_mtaUsageCookie));
+    }
+}
+
+void BackendCPU::ReleaseResources() noexcept
+{
+    _builtinGlyphBrush.reset();
+    _builtinGlyphRenderTarget.reset();
+    _builtinGlyphBitmap.reset();
+    // Ensure _handleSettingsUpdate() is called so that the glyph cache is reset.
+    _generation = {};
+    _fontGeneration = {};
+}
+
+void BackendCPU::Render(RenderingPayload& p)
+{
+    if (_generation != p.s.generation())
+    {
+        _handleSettingsUpdate(p);
+    }
+
+    _drawBackground(p);
+    _drawCursorPart1(p);
+    _drawText(p);
+    _drawCursorPart2(p);
+    _drawSelection(p);
+}
+
+bool BackendCPU::RequiresContinuousRedraw() noexcept
+{
+    return false;
+}
+
+std::span<const u32> BackendCPU::Image() const noexcept
+{
+    return { _image.data(), _image.size() };
+}
+
+u16x2 BackendCPU::ImageSize() const noexcept
+{
+    return _imageSize;
+}
+
+void BackendCPU::_handleSettingsUpdate(const RenderingPayload& p)
+{
+    const auto fontChanged = _fontGeneration != p.s->font.generation();
+    const auto sizeChanged = _imageSize != p.s->targetSize;
+
+    if (sizeChanged)
+    {
+        _image = Buffer<u32>{ static_cast<size_t>(p.s->targetSize.x) * p.s->targetSize.y };
+        _imageSize = p.s->targetSize;
+    }
+
+    if (fontChanged)
+    {
+        const auto& font = *p.s->font;
+
+        _glyphCache.clear();
+        // The builtin glyph bitmap is sized to fit the cell size.
+        _builtinGlyphBrush.reset();
+        _builtinGlyphRenderTarget.reset();
+        _builtinGlyphBitmap.reset();
+
+        // The curly line is positioned identically to BackendD3D::_updateFontDependents().
+        const auto cellHeight = static_cast<f32>(font.cellSize.y);
+        const auto duTop = static_cast<f32>(font.doubleUnderline[0].position);
+        const auto duBottom = static_cast<f32>(font.doubleUnderline[1].position);
+        const auto duHeight = static_cast<f32>(font.doubleUnderline[0].height);
+        const auto height = std::max(3.0f, duBottom + duHeight - duTop);
+        const auto top = std::min(duTop, floorf(cellHeight - height - duHeight));
+
+        _curlyLineHalfHeight = height * 0.5f;
+        _curlyUnderline.position = gsl::narrow_cast<u16>(lrintf(top));
+        _curlyUnderline.height = gsl::narrow_cast<u16>(lrintf(height));
+    }
+
+    _generation = p.s.generation();
+    _fontGeneration = p.s->font.generation();
+}
+
+void BackendCPU::_drawBackground(const RenderingPayload& p) noexcept
+{
+    // This upscales the background bitmap, in which each pixel corresponds to a cell,
+    // to the size of the image. It's the equivalent of BackendD2D's _backgroundBrush.
+    const auto cellSize = p.s->font->cellSize;
+    const auto cellCount = p.s->viewportCellCount;
+    const size_t width = _imageSize.x;
+    auto dst = _image.data();
+    size_t previousCellY = SIZE_MAX;
+
+    for (size_t y = 0; y < _imageSize.y; ++y, dst += width)
+    {
+        const auto cellY = std::min<size_t>(y / cellSize.y, cellCount.y - 1u);
+
+        // All pixel rows within a cell row are identical.
+        if (cellY == previousCellY)
+        {
+            memcpy(dst, dst - width, width * sizeof(u32));
+            continue;
+        }
+
+        const auto src = p.backgroundBitmap.data() + cellY * p.colorBitmapRowStride;
+
+        for (size_t x = 0, cellX = 0; x < width; x += cellSize.x, ++cellX)
+        {
+            const auto color = src[std::min<size_t>(cellX, cellCount.x - 1u)];
+            std::fill_n(dst + x, std::min<size_t>(cellSize.x, width - x), color);
+        }
+
+        previousCellY = cellY;
+    }
+}
+
+void BackendCPU::_drawText(const RenderingPayload& p)
+{
+    const auto& font = *p.s->font;
+    const i32r imageRect{ 0, 0, _imageSize.x, _imageSize.y };
+
+    u16 y = 0;
+    for (const auto row : p.rows)
+    {
+        const auto widthScale = row->lineRendition != LineRendition::SingleWidth ? 2.0f : 1.0f;
+        const auto heightScale = row->lineRendition >= LineRendition::DoubleHeightTop ? 2.0f : 1.0f;
+        const auto rowTop = static_cast<i32>(font.cellSize.y) * y;
+        auto baselineY = rowTop + font.baseline;
+        auto clip = imageRect;
+
+        if (row->lineRendition >= LineRendition::DoubleHeightTop)
+        {
+            // The glyphs of a double height row (DECDHL) are twice as tall as the row itself
+            // and only their top or bottom half is visible, depending on the line rendition.
+            baselineY = rowTop + font.baseline * 2;
+            if (row->lineRendition == LineRendition::DoubleHeightBottom)
+            {
+                baselineY -= font.cellSize.y;
+            }
+            clip.top = rowTop;
+            clip.bottom = rowTop + font.cellSize.y;
+        }
+
+        auto baselineX = 0.0f;
+
+        for (const auto& m : row->mappings)
+        {
+            for (auto i = m.glyphsFrom; i < m.glyphsTo; ++i)
+            {
+                const auto& mask = _getGlyphMask(p, m, row->glyphIndices[i], row->lineRendition);
+
+                if (mask.width)
+                {
+                    const auto& offset = row->glyphOffsets[i];
+                    const auto x = static_cast<i32>(lrintf((baselineX + offset.advanceOffset) * widthScale));
+                    const auto top = baselineY - static_cast<i32>(lrintf(offset.ascenderOffset * heightScale));
+                    _blendGlyphMask(mask, x, top, row->colors[i], clip);
+                }
+
+                baselineX += row->glyphAdvances[i];
+            }
+        }
+
+        if (!row->gridLineRanges.empty())
+        {
+            _drawGridlineRow(p, row, y);
+        }
+
+        ++y;
+    }
+}
+
+const BackendCPU::GlyphMask& BackendCPU::_getGlyphMask(const RenderingPayload& p, const FontMapping& m, u32 glyphIndex, LineRendition lineRendition)
+{
+    // The lack of a fontFace indicates a builtin glyph or soft font, in which case glyphIndex is a UTF-16 code unit.
+    const auto fontFace = m.fontFace.get();
+    auto& fontFaceEntry = _glyphCache[fontFace];
+    if (!fontFaceEntry.fontFace)
+    {
+        fontFaceEntry.fontFace = m.fontFace;
+    }
+
+    auto& glyphs = fontFaceEntry.glyphs[std::min<u8>(static_cast<u8>(lineRendition), 2)];
+    if (const auto it = glyphs.find(glyphIndex); it != glyphs.end()) [[likely]]
+    {
+        return it->second;
+    }
+
+    GlyphMask mask;
+    if (fontFace)
+    {
+        mask = _rasterizeGlyph(p, fontFace, glyphIndex, lineRendition);
+    }
+    else if (BuiltinGlyphs::IsSoftFontChar(glyphIndex))
+    {
+        mask = _rasterizeSoftFontGlyph(p, glyphIndex, lineRendition);
+    }
+    else
+    {
+        mask = _rasterizeBuiltinGlyph(p, glyphIndex, lineRendition);
+    }
+
+    return glyphs.emplace(glyphIndex, std::move(mask)).first->second;
+}
+
+BackendCPU::GlyphMask BackendCPU::_rasterizeGlyph(const RenderingPayload& p, IDWriteFontFace2* fontFace, u32 glyphIndex, LineRendition lineRendition) const
+{
+    const auto glyphIndexU16 = static_cast<u16>(glyphIndex);
+    const DWRITE_GLYPH_RUN glyphRun{
+        .fontFace = fontFace,
+        .fontEmSize = p.s->font->fontSize,
+        .glyphCount = 1,
+        .glyphIndices = &glyphIndexU16,
+    };
+    const DWRITE_MATRIX transform{
+        .m11 = lineRendition != LineRendition::SingleWidth ? 2.0f : 1.0f,
+        .m22 = lineRendition >= LineRendition::DoubleHeightTop ? 2.0f : 1.0f,
+    };
+    // ClearType depends on the background color and is implemented with a custom blending
+    // algorithm in BackendD3D. We use grayscale antialiasing instead to keep this simple.
+    const auto renderingMode = p.s->font->antialiasingMode == AntialiasingMode::Aliased ? DWRITE_RENDERING_MODE_ALIASED : DWRITE_RENDERING_MODE_NATURAL_SYMMETRIC;
+
+    wil::com_ptr<IDWriteGlyphRunAnalysis> glyphRunAnalysis;
+    THROW_IF_FAILED(p.dwriteFactory->CreateGlyphRunAnalysis(
+        /* glyphRun         */ &glyphRun,
+        /* transform        */ &transform,
+        /* renderingMode    */ renderingMode,
+        /* measuringMode    */ DWRITE_MEASURING_MODE_NATURAL,
+        /* gridFitMode      */ DWRITE_GRID_FIT_MODE_DEFAULT,
+        /* antialiasMode    */ DWRITE_TEXT_ANTIALIAS_MODE_GRAYSCALE,
+        /* baselineOriginX  */ 0,
+        /* baselineOriginY  */ 0,
+        /* glyphRunAnalysis */ glyphRunAnalysis.addressof()));
+
+    // Despite its name DWRITE_TEXTURE_ALIASED_1x1 results in a grayscale antialiased alpha mask.
+    RECT textureBounds{};
+    THROW_IF_FAILED(glyphRunAnalysis->GetAlphaTextureBounds(DWRITE_TEXTURE_ALIASED_1x1, &textureBounds));
+
+    GlyphMask mask;
+    if (!IsRectEmpty(&textureBounds))
+    {
+        mask.left = textureBounds.left;
+        mask.top = textureBounds.top;
+        mask.width = textureBounds.right - textureBounds.left;
+        mask.height = textureBounds.bottom - textureBounds.top;
+        mask.alpha = Buffer<u8>{ static_cast<size_t>(mask.width) * mask.height };
+        THROW_IF_FAILED(glyphRunAnalysis->CreateAlphaTexture(DWRITE_TEXTURE_ALIASED_1x1, &textureBounds, mask.alpha.data(), gsl::narrow_cast<UINT32>(mask.alpha.size())));
+    }
+    return mask;
+}
+
+BackendCPU::GlyphMask BackendCPU::_rasterizeBuiltinGlyph(const RenderingPayload& p, u32 glyphIndex, LineRendition lineRendition)
+{
+    const auto& font = *p.s->font;
+    const auto widthShift = static_cast<u8>(lineRendition != LineRendition::SingleWidth);
+    const auto heightShift = static_cast<u8>(lineRendition >= LineRendition::DoubleHeightTop);
+    const auto width = static_cast<u32>(font.cellSize.x) << widthShift;
+    const auto height = static_cast<u32>(font.cellSize.y) << heightShift;
+
+    if (!_builtinGlyphRenderTarget)
+    {
+        if (!_wicFactory)
+        {
+            // CoIncrementMTAUsage() allows us to use WIC without knowing whether or how the caller
+            // initialized COM, which is useful for tests and benchmarks that run on plain threads.
+            THROW_IF_FAILED(CoIncrementMTAUsage(&_mtaUsageCookie));
+            _wicFactory = wil::CoCreateInstance<IWICImagingFactory>(CLSID_WICImagingFactory);
+        }
+
+        // The bitmap is large enough to fit glyphs of double width and double height rows.
+        const auto bitmapWidth = static_cast<UINT>(font.cellSize.x) * 2;
+        const auto bitmapHeight = static_cast<UINT>(font.cellSize.y) * 2;
+        THROW_IF_FAILED(_wicFactory->CreateBitmap(bitmapWidth, bitmapHeight, GUID_WICPixelFormat32bppPBGRA, WICBitmapCacheOnLoad, _builtinGlyphBitmap.put()));
+
+        static constexpr D2D1_RENDER_TARGET_PROPERTIES props{
+            .type = D2D1_RENDER_TARGET_TYPE_SOFTWARE,
+            .pixelFormat = { DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED },
+        };
+        wil::com_ptr<ID2D1RenderTarget> renderTarget;
+        THROW_IF_FAILED(p.d2dFactory->CreateWicBitmapRenderTarget(_builtinGlyphBitmap.get(), &props, renderTarget.addressof()));
+        _builtinGlyphRenderTarget = renderTarget.query<ID2D1DeviceContext>();
+        _builtinGlyphRenderTarget->SetUnitMode(D2D1_UNIT_MODE_PIXELS);
+
+        static constexpr D2D1_COLOR_F color{ 1, 1, 1, 1 };
+        THROW_IF_FAILED(_builtinGlyphRenderTarget->CreateSolidColorBrush(&color, nullptr, _builtinGlyphBrush.put()));
+    }
+
+    const D2D1_RECT_F rect{ 0, 0, static_cast<f32>(width), static_cast<f32>(height) };
+    _builtinGlyphRenderTarget->BeginDraw();
+    _builtinGlyphRenderTarget->Clear();
+    BuiltinGlyphs::DrawBuiltinGlyph(p.d2dFactory.get(), _builtinGlyphRenderTarget.get(), _builtinGlyphBrush.get(), rect, glyphIndex);
+    THROW_IF_FAILED(_builtinGlyphRenderTarget->EndDraw());
+
+    // The dot size matches data.shadedGlyphDotSize in BackendD3D::_recreateConstBuffer().
+    const auto dotSize = std::max(1.0f, std::roundf(std::max(font.cellSize.x / 16.0f, font.cellSize.y / 32.0f)));
+
+    GlyphMask mask;
+    mask.top = -(static_cast<i32>(font.baseline) << heightShift);
+    mask.width = static_cast<i32>(width);
+    mask.height = static_cast<i32>(height);
+    mask.builtin = true;
+    mask.dotWidth = static_cast<i32>(dotSize) << widthShift;
+    mask.dotHeight = static_cast<i32>(dotSize) << heightShift;
+    mask.texels = Buffer<u32>{ static_cast<size_t>(width) * height };
+
+    const WICRect lockRect{ 0, 0, mask.width, mask.height };
+    wil::com_ptr<IWICBitmapLock> lock;
+    THROW_IF_FAILED(_builtinGlyphBitmap->Lock(&lockRect, WICBitmapLockRead, lock.addressof()));
+
+    UINT stride = 0;
+    UINT size = 0;
+    WICInProcPointer data = nullptr;
+    THROW_IF_FAILED(lock->GetStride(&stride));
+    THROW_IF_FAILED(lock->GetDataPointer(&size, &data));
+
+    for (u32 y = 0; y < height; ++y)
+    {
+        memcpy(mask.texels.data() + y * width, data + y * stride, width * sizeof(u32));
+    }
+
+    return mask;
+}
+
+BackendCPU::GlyphMask BackendCPU::_rasterizeSoftFontGlyph(const RenderingPayload& p, u32 glyphIndex, LineRendition lineRendition)
+{
+    const auto& font = *p.s->font;
+    const auto softFontWidth = static_cast<size_t>(font.softFontCellSize.width);
+    const auto softFontHeight = static_cast<size_t>(font.softFontCellSize.height);
+    const auto softFontIndex = glyphIndex - 0xEF20u;
+    const auto data = til::clamp_slice_len(font.softFontPattern, softFontHeight * softFontIndex, softFontHeight);
+
+    GlyphMask mask;
+
+    // This happens if someone wrote a U+EF2x character (by accident), but we don't even have soft fonts enabled yet.
+    if (data.empty() || data.size() != softFontHeight)
+    {
+        return mask;
+    }
+
+    const auto widthShift = static_cast<u8>(lineRendition != LineRendition::SingleWidth);
+    const auto heightShift = static_cast<u8>(lineRendition >= LineRendition::DoubleHeightTop);
+    const auto width = static_cast<size_t>(font.cellSize.x) << widthShift;
+    const auto height = static_cast<size_t>(font.cellSize.y) << heightShift;
+
+    mask.top = -(static_cast<i32>(font.baseline) << heightShift);
+    mask.width = static_cast<i32>(width);
+    mask.height = static_cast<i32>(height);
+    mask.alpha = Buffer<u8>{ width * height };
+
+    // Unlike BackendD3D, which uses Direct2D's cubic interpolation unless antialiasing is disabled,
+    // we always upscale with nearest neighbor sampling. It's simple and independent of Direct2D.
+    auto dst = mask.alpha.data();
+    for (size_t y = 0; y < height; ++y)
+    {
+        const auto bits = data[y * softFontHeight / height];
+        for (size_t x = 0; x < width; ++x)
+        {
+            const auto srcX = x * softFontWidth / width;
+            *dst++ = ((bits << srcX) & 0x8000) != 0 ? 0xff : 0x00;
+        }
+    }
+
+    return mask;
+}
+
+void BackendCPU::_blendGlyphMask(const GlyphMask& mask, i32 x, i32 y, u32 color, const i32r& clip) noexcept
+{
+    const auto left = x + mask.left;
+    const auto top = y + mask.top;
+    const auto r = intersect({ left, top, left + mask.width, top + mask.height }, clip);
+
+    for (auto py = r.top; py < r.bottom; ++py)
+    {
+        const auto dst = _image.data() + static_cast<size_t>(py) * _imageSize.x;
+        const auto srcOffset = static_cast<ptrdiff_t>(py - top) * mask.width - left;
+
+        if (!mask.builtin)
+        {
+            const auto src = mask.alpha.data() + srcOffset;
+            for (auto px = r.left; px < r.right; ++px)
+            {
+                if (const auto coverage = src[px])
+                {
+                    dst[px] = blendSourceOver(dst[px], color, coverage);
+                }
+            }
+        }
+        else
+        {
+            const auto src = mask.texels.data() + srcOffset;
+            for (auto px = r.left; px < r.right; ++px)
+            {
+                if (const auto coverage = shadeBuiltinGlyph(src[px], px, py, mask.dotWidth, mask.dotHeight))
+                {
+                    dst[px] = blendSourceOver(dst[px], color, coverage);
+                }
+            }
+        }
+    }
+}
+
+void BackendCPU::_drawGridlineRow(const RenderingPayload& p, const ShapedRow* row, u16 y) noexcept
+{
+    const auto& font = *p.s->font;
+    const auto widthShift = static_cast<u8>(row->lineRendition != LineRendition::SingleWidth);
+    const auto heightShift = static_cast<u8>(row->lineRendition >= LineRendition::DoubleHeightTop);
+    const auto cellWidth = static_cast<i32>(font.cellSize.x) << widthShift;
+    const auto rowTop = static_cast<i32>(font.cellSize.y) * y;
+    auto textCellTop = rowTop;
+    i32r clip{ 0, 0, _imageSize.x, _imageSize.y };
+
+    // Just like the glyphs in _drawText(), the decorations of a double height row (DECDHL)
+    // are laid out in a cell twice as tall as the row, of which only one half is visible.
+    if (heightShift)
+    {
+        if (row->lineRendition == LineRendition::DoubleHeightBottom)
+        {
+            textCellTop -= font.cellSize.y;
+        }
+        clip.top = rowTop;
+        clip.bottom = rowTop + font.cellSize.y;
+    }
+
+    const auto textCellBottom = textCellTop + (static_cast<i32>(font.cellSize.y) << heightShift);
+
+    const auto appendVerticalLines = [&](const GridLineRange& r, FontDecorationPosition pos) {
+        const auto from = r.from >> widthShift;
+        const auto to = r.to >> widthShift;
+        const auto offset = static_cast<i32>(pos.position) << widthShift;
+        const auto width = static_cast<i32>(pos.height) << widthShift;
+
+        for (auto col = from; col < to; ++col)
+        {
+            const auto left = col * cellWidth + offset;
+            _fillRectangle(intersect({ left, textCellTop, left + width, textCellBottom }, clip), r.gridlineColor);
+        }
+    };
+    const auto appendHorizontalLine = [&](const GridLineRange& r, FontDecorationPosition pos, LineStyle style, const u32 color) {
+        const auto top = textCellTop + (static_cast<i32>(pos.position) << heightShift);
+        const auto bottom = top + (static_cast<i32>(pos.height) << heightShift);
+        const auto rect = intersect({ (r.from >> widthShift) * cellWidth, top, (r.to >> widthShift) * cellWidth, bottom }, clip);
+
+        if (style == LineStyle::Solid)
+        {
+            _fillRectangle(rect, color);
+            return;
+        }
+
+        // The patterns below replicate SHADING_TYPE_DOTTED_LINE, SHADING_TYPE_DASHED_LINE
+        // and SHADING_TYPE_CURLY_LINE in shader_ps.hlsl, evaluated at the pixel centers.
+        const auto scaleX = static_cast<f32>(1 << widthShift);
+        const auto scaleY = static_cast<f32>(1 << heightShift);
+        const auto underlineWidth = static_cast<f32>(font.underline.height);
+        const auto strokeWidthHalf = font.doubleUnderline[0].height * scaleY * 0.5f;
+        const auto amp = (_curlyLineHalfHeight - strokeWidthHalf) * scaleY;
+        const auto freq = scaleX / _curlyLineHalfHeight * 1.57079632679489661923f;
+        const auto center = top + _curlyLineHalfHeight * scaleY;
+
+        for (auto py = rect.top; py < rect.bottom; ++py)
+        {
+            const auto dst = _image.data() + static_cast<size_t>(py) * _imageSize.x;
+
+            for (auto px = rect.left; px < rect.right; ++px)
+            {
+                const auto x = px + 0.5f;
+                f32 coverage;
+
+                switch (style)
+                {
+                case LineStyle::Dotted:
+                {
+                    const auto t = x / (3.0f * underlineWidth * scaleX);
+                    coverage = t - floorf(t) < (1.0f / 3.0f) ? 1.0f : 0.0f;
+                    break;
+                }
+                case LineStyle::Dashed:
+                {
+                    const auto t = x / (6.0f * underlineWidth * scaleX);
+                    coverage = t - floorf(t) < (4.0f / 6.0f) ? 1.0f : 0.0f;
+                    break;
+                }
+                default:
+                {
+                    const auto s = sinf(x * freq) * amp;
+                    const auto d = fabsf(center - (py + 0.5f) - s);
+                    coverage = 1.0f - std::clamp(d - strokeWidthHalf, 0.0f, 1.0f);
+                    break;
+                }
+                }
+
+                if (coverage > 0.0f)
+                {
+                    dst[px] = blendSourceOver(dst[px], color, static_cast<u32>(lrintf(coverage * 255.0f)));
+                }
+            }
+        }
+    };
+
+    for (const auto& r : row->gridLineRanges)
+    {
+        // AtlasEngine.cpp shouldn't add any gridlines if they don't do anything.
+        assert(r.lines.any());
+
+        if (r.lines.test(GridLines::Left))
+        {
+            appendVerticalLines(r, font.gridLeft);
+        }
+        if (r.lines.test(GridLines::Right))
+        {
+            appendVerticalLines(r, font.gridRight);
+        }
+        if (r.lines.test(GridLines::Top))
+        {
+            appendHorizontalLine(r, font.gridTop, LineStyle::Solid, r.gridlineColor);
+        }
+        if (r.lines.test(GridLines::Bottom))
+        {
+            appendHorizontalLine(r, font.gridBottom, LineStyle::Solid, r.gridlineColor);
+        }
+        if (r.lines.test(GridLines::Strikethrough))
+        {
+            appendHorizontalLine(r, font.strikethrough, LineStyle::Solid, r.gridlineColor);
+        }
+
+        if (r.lines.test(GridLines::Underline))
+        {
+            appendHorizontalLine(r, font.underline, LineStyle::Solid, r.underlineColor);
+        }
+        else if (r.lines.any(GridLines::DottedUnderline, GridLines::HyperlinkUnderline))
+        {
+            appendHorizontalLine(r, font.underline, LineStyle::Dotted, r.underlineColor);
+        }
+        else if (r.lines.test(GridLines::DashedUnderline))
+        {
+            appendHorizontalLine(r, font.underline, LineStyle::Dashed, r.underlineColor);
+        }
+        else if (r.lines.test(GridLines::CurlyUnderline))
+        {
+            appendHorizontalLine(r, _curlyUnderline, LineStyle::Curly, r.underlineColor);
+        }
+        else if (r.lines.test(GridLines::DoubleUnderline))
+        {
+            for (const auto pos : font.doubleUnderline)
+            {
+                appendHorizontalLine(r, pos, LineStyle::Solid, r.underlineColor);
+            }
+        }
+    }
+}
+
+void BackendCPU::_drawCursorPart1(const RenderingPayload& p) noexcept
+{
+    const auto cursorColor = p.s->cursor->cursorColor;
+
+    if (p.cursorRect.empty() || cursorColor == 0xffffffff)
+    {
+        return;
+    }
+
+    const auto cellSize = p.s->font->cellSize;
+    const i32r rect{
+        p.cursorRect.left * cellSize.x,
+        p.cursorRect.top * cellSize.y,
+        p.cursorRect.right * cellSize.x,
+        p.cursorRect.bottom * cellSize.y,
+    };
+    i32r rects[4];
+    const auto count = _getCursorRects(p, rect, rects);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        _fillRectangle(rects[i], cursorColor);
+    }
+}
+
+void BackendCPU::_drawCursorPart2(const RenderingPayload& p) noexcept
+{
+    // A cursor color of 0xffffffff indicates that the cursor inverts the colors below it.
+    if (p.cursorRect.empty() || p.s->cursor->cursorColor != 0xffffffff)
+    {
+        return;
+    }
+
+    const auto cellSize = p.s->font->cellSize;
+    const i32r rect{
+        p.cursorRect.left * cellSize.x,
+        p.cursorRect.top * cellSize.y,
+        p.cursorRect.right * cellSize.x,
+        p.cursorRect.bottom * cellSize.y,
+    };
+    i32r rects[4];
+    const auto count = _getCursorRects(p, rect, rects);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        _invertRectangle(rects[i]);
+    }
+}
+
+// Splits the cursor into up to 4 rectangles. The shapes are identical to BackendD2D::_drawCursor().
+size_t BackendCPU::_getCursorRects(const RenderingPayload& p, i32r rect, i32r (&rects)[4]) noexcept
+{
+    const auto& font = *p.s->font;
+    const auto thinLineWidth = static_cast<i32>(font.thinLineWidth);
+
+    switch (static_cast<CursorType>(p.s->cursor->cursorType))
+    {
+    case CursorType::Legacy:
+    {
+        const auto height = p.s->cursor->heightPercentage / 100.0f;
+        rect.top = static_cast<i32>(lrintf((rect.top - rect.bottom) * height + rect.bottom));
+        rects[0] = rect;
+        return 1;
+    }
+    case CursorType::VerticalBar:
+        rect.right = rect.left + thinLineWidth;
+        rects[0] = rect;
+        return 1;
+    case CursorType::Underscore:
+        rect.top += font.underline.position;
+        rect.bottom = rect.top + font.underline.height;
+        rects[0] = rect;
+        return 1;
+    case CursorType::EmptyBox:
+        rects[0] = { rect.left, rect.top, rect.right, rect.top + thinLineWidth };
+        rects[1] = { rect.left, rect.bottom - thinLineWidth, rect.right, rect.bottom };
+        rects[2] = { rect.left, rect.top + thinLineWidth, rect.left + thinLineWidth, rect.bottom - thinLineWidth };
+        rects[3] = { rect.right - thinLineWidth, rect.top + thinLineWidth, rect.right, rect.bottom - thinLineWidth };
+        return 4;
+    case CursorType::FullBox:
+        rects[0] = rect;
+        return 1;
+    case CursorType::DoubleUnderscore:
+    {
+        const auto top0 = rect.top + font.doubleUnderline[0].position;
+        const auto top1 = rect.top + font.doubleUnderline[1].position;
+        rects[0] = { rect.left, top0, rect.right, top0 + thinLineWidth };
+        rects[1] = { rect.left, top1, rect.right, top1 + thinLineWidth };
+        return 2;
+    }
+    default:
+        return 0;
+    }
+}
+
+void BackendCPU::_drawSelection(const RenderingPayload& p) noexcept
+{
+    const auto cellSize = p.s->font->cellSize;
+
+    i32 y = 0;
+    for (const auto& row : p.rows)
+    {
+        if (row->selectionTo > row->selectionFrom)
+        {
+            const i32r rect{
+                cellSize.x * row->selectionFrom,
+                cellSize.y * y,
+                cellSize.x * row->selectionTo,
+                cellSize.y * (y + 1),
+            };
+            _fillRectangle(rect, p.s->misc->selectionColor);
+        }
+
+        y++;
+    }
+}
+
+void BackendCPU::_fillRectangle(const i32r& rect, u32 color) noexcept
+{
+    const auto r = intersect(rect, { 0, 0, _imageSize.x, _imageSize.y });
+
+    for (auto y = r.top; y < r.bottom; ++y)
+    {
+        const auto dst = _image.data() + static_cast<size_t>(y) * _imageSize.x;
+        for (auto x = r.left; x < r.right; ++x)
+        {
+            dst[x] = blendSourceOver(dst[x], color, 0xff);
+        }
+    }
+}
+
+// The equivalent of D2D1_COMPOSITE_MODE_MASK_INVERT for premultiplied pixels.
+void BackendCPU::_invertRectangle(const i32r& rect) noexcept
+{
+    const auto r = intersect(rect, { 0, 0, _imageSize.x, _imageSize.y });
+
+    for (auto y = r.top; y < r.bottom; ++y)
+    {
+        const auto dst = _image.data() + static_cast<size_t>(y) * _imageSize.x;
+        for (auto x = r.left; x < r.right; ++x)
+        {
+            const auto px = dst[x];
+            const auto a = px >> 24;
+            // Since the pixels are premultiplied, each color component is <= a.
+            const auto rgb = a * 0x010101 - (px & 0xffffff);
+            dst[x] = (px & 0xff000000) | rgb;
+        }
+    }
+}
+
+TIL_FAST_MATH_END
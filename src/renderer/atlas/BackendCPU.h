@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "Backend.h"
+
+namespace Microsoft::Console::Render::Atlas
+{
+    // BackendCPU is a reference implementation of IBackend which rasterizes the RenderingPayload into
+    // an image in system memory instead of presenting it via the swap chain. It requires neither
+    // a GPU nor a window, which makes it suitable for profiling the cost of building a frame
+    // and for comparing the output of the other backends against golden images.
+    //
+    // It isn't meant to be fast. It redraws the entire image every frame and
+    // doesn't implement ClearType, color glyphs or custom shaders.
+    struct BackendCPU : IBackend
+    {
+        BackendCPU() = default;
+        ~BackendCPU() override;
+
+        BackendCPU(const BackendCPU&) = delete;
+        BackendCPU& operator=(const BackendCPU&) = delete;
+
+        void ReleaseResources() noexcept override;
+        void Render(RenderingPayload& payload) override;
+        bool RequiresContinuousRedraw() noexcept override;
+
+        // The image has a size of ImageSize().x * ImageSize().y pixels without any row padding.
+        // The pixels are stored in the same format as RenderingPayload::backgroundBitmap, that is,
+        // as premultiplied RGBA with the red component in the least significant byte.
+        std::span<const u32> Image() const noexcept;
+        u16x2 ImageSize() const noexcept;
+
+    private:
+        struct GlyphMask
+        {
+            // The offset of the top left corner of the mask relative to the glyph's baseline origin.
+            i32 left = 0;
+            i32 top = 0;
+            i32 width = 0;
+            i32 height = 0;
+            // Builtin glyphs store premultiplied BGRA texels, because their RGB components control
+            // the generation of shaded patterns, just like in BackendD3D's pixel shader.
+            // Everything else stores a grayscale alpha mask.
+            bool builtin = false;
+            // The size of a single dot of the shaded patterns of builtin glyphs.
+            i32 dotWidth = 1;
+            i32 dotHeight = 1;
+            Buffer<u8> alpha;
+            Buffer<u32> texels;
+        };
+
+        struct FontFaceEntry
+        {
+            // This reference ensures that the IDWriteFontFace2* key in _glyphCache stays unique.
+            wil::com_ptr<IDWriteFontFace2> fontFace;
+            // Glyphs are rasterized with the line rendition's scale applied.
+            // Index 0 is for single width, 1 for double width and 2 for double height.
+            std::unordered_map<u32, GlyphMask> glyphs[3];
+        };
+
+        ATLAS_ATTR_COLD void _handleSettingsUpdate(const RenderingPayload& p);
+        void _drawBackground(const RenderingPayload& p) noexcept;
+        void _drawText(const RenderingPayload& p);
+        const GlyphMask& _getGlyphMask(const RenderingPayload& p, const FontMapping& m, u32 glyphIndex, LineRendition lineRendition);
+        ATLAS_ATTR_COLD GlyphMask _rasterizeGlyph(const RenderingPayload& p, IDWriteFontFace2* fontFace, u32 glyphIndex, LineRendition lineRendition) const;
+        ATLAS_ATTR_COLD GlyphMask _rasterizeBuiltinGlyph(const RenderingPayload& p, u32 glyphIndex, LineRendition lineRendition);
+        ATLAS_ATTR_COLD static GlyphMask _rasterizeSoftFontGlyph(const RenderingPayload& p, u32 glyphIndex, LineRendition lineRendition);
+        void _blendGlyphMask(const GlyphMask& mask, i32 x, i32 y, u32 color, const i32r& clip) noexcept;
+        ATLAS_ATTR_COLD void _drawGridlineRow(const RenderingPayload& p, const ShapedRow* row, u16 y) noexcept;
+        void _drawCursorPart1(const RenderingPayload& p) noexcept;
+        void _drawCursorPart2(const RenderingPayload& p) noexcept;
+        static size_t _getCursorRects(const RenderingPayload& p, i32r rect, i32r (&rects)[4]) noexcept;
+        void _drawSelection(const RenderingPayload& p) noexcept;
+        void _fillRectangle(const i32r& rect, u32 color) noexcept;
+        void _invertRectangle(const i32r& rect) noexcept;
+
+        Buffer<u32> _image;
+        u16x2 _imageSize{};
+
+        std::unordered_map<IDWriteFontFace2*, FontFaceEntry> _glyphCache;
+        f32 _curlyLineHalfHeight = 0;
+        FontDecorationPosition _curlyUnderline;
+
+        // Builtin glyphs are drawn with Direct2D's software rasterizer into this WIC bitmap.
+        CO_MTA_USAGE_COOKIE _mtaUsageCookie = nullptr;
+        wil::com_ptr<IWICImagingFactory> _wicFactory;
+        wil::com_ptr<IWICBitmap> _builtinGlyphBitmap;
+        wil::com_ptr<ID2D1DeviceContext> _builtinGlyphRenderTarget;
+        wil::com_ptr<ID2D1SolidColorBrush> _builtinGlyphBrush;
+
+        til::generation_t _generation;
+        til::generation_t _fontGeneration;
+    };
+}
@@ -711,7 +711,7 @@ void BackendD3D::_resetGlyphAtlas(const RenderingPayload& p)
     const auto targetArea = static_cast<u32>(p.s->targetSize.x) * p.s->targetSize.y;
 
     const auto minAreaByFont = cellArea * 95; // Covers all printable ASCII characters
-    const auto minAreaByGrowth = static_cast<u32>(_rectPacker.width) * _rectPacker.height * 2;
+    const auto minAreaByGrowth = static_cast<u32>(_glyphAtlasPacker.Width()) * _glyphAtlasPacker.Height() * 2;
 
     // It's hard to say what the max. size of the cache should be. Optimally I think we should use as much
     // memory as is available, but the rendering code in this project is a big mess and so integrating
@@ -733,12 +733,20 @@ void BackendD3D::_resetGlyphAtlas(const RenderingPayload& p)
     const auto u = static_cast<u16>(1u << ((index + 2) / 2));
     const auto v = static_cast<u16>(1u << ((index + 1) / 2));
 
-    if (u != _rectPacker.width || v != _rectPacker.height)
+    if (u != _glyphAtlasPacker.Width() || v != _glyphAtlasPacker.Height())
     {
         _resizeGlyphAtlas(p, u, v);
     }
 
-    stbrp_init_target(&_rectPacker, u, v, _rectPackerData.data(), _rectPackerData.size());
+#if ATLAS_DEBUG_GLYPH_ATLAS_STATS
+    {
+        const auto& stats = _glyphAtlasPacker.GetStats();
+        OutputDebugStringW(fmt::format(FMT_COMPILE(L"glyph atlas reset: {}x{}, hits: {}, allocations: {}, evictions: {}, resets: {}\n"), u, v, stats.hits, stats.allocations, stats.evictions, stats.resets).c_str());
+    }
+#endif
+
+    _glyphAtlasPacker.Reset(u, v);
+    _glyphAtlasCanGrow = static_cast<u32>(u) * v < clamp(maxAreaByFont, minArea, maxArea);
 
     // This is a little imperfect, because it only releases the memory of the glyph mappings, not the memory held by
     // any DirectWrite fonts. On the other side, the amount of fonts on a system is always finite, where "finite"
@@ -822,8 +830,6 @@ void BackendD3D::_resizeGlyphAtlas(const RenderingPayload& p, const u16 u, const
 
     ID3D11ShaderResourceView* resources[]{ _backgroundBitmapView.get(), _glyphAtlasView.get() };
     p.deviceContext->PSSetShaderResources(0, 2, &resources[0]);
-
-    _rectPackerData = Buffer<stbrp_node>{ u };
 }
 
 BackendD3D::QuadInstance& BackendD3D::_getLastQuad() noexcept
@@ -982,6 +988,8 @@ void BackendD3D::_drawText(RenderingPayload& p)
         _resetGlyphAtlas(p);
     }
 
+    _glyphAtlasPacker.NextFrame();
+
     til::CoordType dirtyTop = til::CoordTypeMax;
     til::CoordType dirtyBottom = til::CoordTypeMin;
 
@@ -1037,8 +1045,9 @@ void BackendD3D::_drawText(RenderingPayload& p)
                     dx = 2;
                 }
 
+                // Entries whose shelf got evicted from the atlas are still in the map, but need to be redrawn.
                 auto glyphEntry = glyphs.lookup(glyphIndex);
-                if (!glyphEntry)
+                if (!glyphEntry || !_glyphAtlasPacker.Use(glyphEntry->shelf, glyphEntry->generation)) [[unlikely]]
                 {
                     glyphEntry = _drawGlyph(p, *row, *fontFaceEntry, glyphIndex);
                 }
@@ -1351,7 +1360,7 @@ BackendD3D::AtlasGlyphEntry* BackendD3D::_drawGlyph(const RenderingPayload& p, c
     const auto br = lrintf(bounds.right);
     const auto bb = lrintf(bounds.bottom);
 
-    stbrp_rect rect{
+    GlyphAtlasPacker::Rect rect{
         .w = br - bl,
         .h = bb - bt,
     };
@@ -1402,6 +1411,8 @@ BackendD3D::AtlasGlyphEntry* BackendD3D::_drawGlyph(const RenderingPayload& p, c
     glyphEntry->size.y = rect.h;
     glyphEntry->texcoord.x = rect.x;
     glyphEntry->texcoord.y = rect.y;
+    glyphEntry->shelf = rect.shelf;
+    glyphEntry->generation = rect.generation;
 
     if (row.lineRendition >= LineRendition::DoubleHeightTop)
     {
@@ -1414,7 +1425,7 @@ BackendD3D::AtlasGlyphEntry* BackendD3D::_drawGlyph(const RenderingPayload& p, c
 BackendD3D::AtlasGlyphEntry* BackendD3D::_drawBuiltinGlyph(const RenderingPayload& p, const ShapedRow& row, AtlasFontFaceEntry& fontFaceEntry, u32 glyphIndex)
 {
     auto baseline = p.s->font->baseline;
-    stbrp_rect rect{
+    GlyphAtlasPacker::Rect rect{
         .w = p.s->font->cellSize.x,
         .h = p.s->font->cellSize.y,
     };
@@ -1456,6 +1467,8 @@ BackendD3D::AtlasGlyphEntry* BackendD3D::_drawBuiltinGlyph(const RenderingPayloa
     glyphEntry->size.y = rect.h;
     glyphEntry->texcoord.x = rect.x;
     glyphEntry->texcoord.y = rect.y;
+    glyphEntry->shelf = rect.shelf;
+    glyphEntry->generation = rect.generation;
 
     if (row.lineRendition >= LineRendition::DoubleHeightTop)
     {
@@ -1522,27 +1535,75 @@ BackendD3D::ShadingType BackendD3D::_drawSoftFontGlyph(const RenderingPayload& p
     return ShadingType::TextGrayscale;
 }
 
-void BackendD3D::_drawGlyphAtlasAllocate(const RenderingPayload& p, stbrp_rect& rect)
+void BackendD3D::_drawGlyphAtlasAllocate(const RenderingPayload& p, GlyphAtlasPacker::Rect& rect)
 {
-    if (stbrp_pack_rects(&_rectPacker, &rect, 1))
+    if (_glyphAtlasPacker.Allocate(rect))
     {
         return;
     }
 
     _d2dEndDrawing();
     _flushQuads(p);
+
+    // As long as the atlas can still grow we prefer to reset it, because growing it is cheaper in the long run.
+    // Afterwards we evict the least recently used glyphs instead, which avoids having to redraw every glyph
+    // that is currently on screen. Only if everything in the atlas is in use we fall back to resetting it.
+    if (!_glyphAtlasCanGrow)
+    {
+        if (const auto band = _glyphAtlasPacker.Evict(rect.h); band.top < band.bottom)
+        {
+            _clearGlyphAtlasBand(band);
+
+            if (_glyphAtlasPacker.Allocate(rect))
+            {
+                return;
+            }
+        }
+    }
+
     _resetGlyphAtlas(p);
 
-    if (!stbrp_pack_rects(&_rectPacker, &rect, 1))
+    if (!_glyphAtlasPacker.Allocate(rect))
     {
         THROW_HR(HRESULT_FROM_WIN32(ERROR_POSSIBLE_DEADLOCK));
     }
 }
 
+// Clears the given area of the glyph atlas after it was evicted by GlyphAtlasPacker::Evict().
+// Glyphs are drawn with alpha blending, so anything that was there before would otherwise shine through.
+void BackendD3D::_clearGlyphAtlasBand(const GlyphAtlasPacker::Band& band)
+{
+    // _drawGlyph() may have already applied a transform for DECDWL/DECDHL glyphs.
+    D2D1_MATRIX_3X2_F transform;
+    _d2dRenderTarget->GetTransform(&transform);
+    _d2dRenderTarget->SetTransform(&identityTransform);
+
+    const D2D1_RECT_F rect{
+        0.0f,
+        static_cast<f32>(band.top),
+        static_cast<f32>(_glyphAtlasPacker.Width()),
+        static_cast<f32>(band.bottom),
+    };
+
+    _d2dBeginDrawing();
+    _d2dRenderTarget->PushAxisAlignedClip(&rect, D2D1_ANTIALIAS_MODE_ALIASED);
+    _d2dRenderTarget->Clear();
+    _d2dRenderTarget->PopAxisAlignedClip();
+    _d2dRenderTarget->SetTransform(&transform);
+
+#if ATLAS_DEBUG_GLYPH_ATLAS_STATS
+    const auto& stats = _glyphAtlasPacker.GetStats();
+    OutputDebugStringW(fmt::format(FMT_COMPILE(L"glyph atlas eviction: {}-{}, hits: {}, allocations: {}, evictions: {}, resets: {}\n"), band.top, band.bottom, stats.hits, stats.allocations, stats.evictions, stats.resets).c_str());
+#endif
+}
+
 BackendD3D::AtlasGlyphEntry* BackendD3D::_drawGlyphAllocateEntry(const ShapedRow& row, AtlasFontFaceEntry& fontFaceEntry, u32 glyphIndex)
 {
     const auto glyphEntry = fontFaceEntry.glyphs[WI_EnumValue(row.lineRendition)].insert(glyphIndex).first;
     glyphEntry->shadingType = ShadingType::Default;
+    // Whitespace glyphs don't occupy any space in the atlas. Shelf 0 is never evicted.
+    glyphEntry->shelf = 0;
+    glyphEntry->generation = 0;
     return glyphEntry;
 }
 
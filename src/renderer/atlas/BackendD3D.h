@@ -3,10 +3,10 @@
 
 #pragma once
 
-#include <stb_rect_pack.h>
 #include <til/flat_set.h>
 
 #include "Backend.h"
+#include "GlyphAtlasPacker.h"
 
 namespace Microsoft::Console::Render::Atlas
 {
@@ -109,6 +109,9 @@ namespace Microsoft::Console::Render::Atlas
             i16x2 offset;
             u16x2 size;
             u16x2 texcoord;
+            // The location of the glyph in _glyphAtlasPacker. See GlyphAtlasPacker::Use().
+            u16 shelf;
+            u32 generation;
         };
 
         struct AtlasGlyphEntryHashTrait
@@ -215,7 +218,8 @@ namespace Microsoft::Console::Render::Atlas
         [[nodiscard]] ATLAS_ATTR_COLD AtlasGlyphEntry* _drawGlyph(const RenderingPayload& p, const ShapedRow& row, AtlasFontFaceEntry& fontFaceEntry, u32 glyphIndex);
         AtlasGlyphEntry* _drawBuiltinGlyph(const RenderingPayload& p, const ShapedRow& row, AtlasFontFaceEntry& fontFaceEntry, u32 glyphIndex);
         ShadingType _drawSoftFontGlyph(const RenderingPayload& p, const D2D1_RECT_F& rect, u32 glyphIndex);
-        void _drawGlyphAtlasAllocate(const RenderingPayload& p, stbrp_rect& rect);
+        void _drawGlyphAtlasAllocate(const RenderingPayload& p, GlyphAtlasPacker::Rect& rect);
+        void _clearGlyphAtlasBand(const GlyphAtlasPacker::Band& band);
         static AtlasGlyphEntry* _drawGlyphAllocateEntry(const ShapedRow& row, AtlasFontFaceEntry& fontFaceEntry, u32 glyphIndex);
         static void _splitDoubleHeightGlyph(const RenderingPayload& p, const ShapedRow& row, AtlasFontFaceEntry& fontFaceEntry, AtlasGlyphEntry* glyphEntry);
         void _drawGridlines(const RenderingPayload& p, u16 y);
@@ -258,8 +262,9 @@ namespace Microsoft::Console::Render::Atlas
         wil::com_ptr<ID3D11ShaderResourceView> _glyphAtlasView;
         til::linear_flat_set<AtlasFontFaceEntry, AtlasFontFaceEntryHashTrait> _glyphAtlasMap;
         AtlasFontFaceEntry _builtinGlyphs;
-        Buffer<stbrp_node> _rectPackerData;
-        stbrp_context _rectPacker{};
+        GlyphAtlasPacker _glyphAtlasPacker;
+        // Once the glyph atlas reached its max. size we start evicting glyphs instead of resetting it.
+        bool _glyphAtlasCanGrow = true;
         til::CoordType _ligatureOverhangTriggerLeft = 0;
         til::CoordType _ligatureOverhangTriggerRight = 0;
 
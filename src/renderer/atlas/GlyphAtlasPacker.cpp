@@ -0,0 +1,211 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "GlyphAtlasPacker.h"
+
+#pragma warning(disable : 26446) // Prefer to use gsl::at() instead of unchecked subscript operator (bounds.4).
+#pragma warning(disable : 26472) // Don't use a static_cast for arithmetic conversions. Use brace initialization, gsl::narrow_cast or gsl::narrow (type.1).
+
+using namespace Microsoft::Console::Render::Atlas;
+
+// New shelves are rounded up to a multiple of this many pixels. This makes it more
+// likely that glyphs of slightly different heights (e.g. "a" vs. "g") share a shelf.
+static constexpr i32 shelfAlignment = 4;
+
+void GlyphAtlasPacker::Reset(u16 width, u16 height)
+{
+    _shelves.clear();
+    _shelves.emplace_back();
+    _width = width;
+    _height = height;
+    _nextY = 0;
+    _stats.resets++;
+}
+
+void GlyphAtlasPacker::NextFrame() noexcept
+{
+    _frame++;
+}
+
+bool GlyphAtlasPacker::Allocate(Rect& rect) noexcept
+{
+    if (rect.w <= 0 || rect.h <= 0 || rect.w > _width || rect.h > _height)
+    {
+        return false;
+    }
+
+    // Find the shelf that fits the glyph with the least amount of vertical waste.
+    // We allow up to 50% of waste, which prevents tiny glyphs (e.g. underscores)
+    // from using up the space on shelves that were meant for tall glyphs (e.g. emojis).
+    const auto maxHeight = rect.h + std::max(rect.h / 2, shelfAlignment);
+    size_t best = 0;
+    i32 bestWaste = INT32_MAX;
+    size_t fallback = 0;
+    i32 fallbackWaste = INT32_MAX;
+
+    for (size_t i = 1; i < _shelves.size(); ++i)
+    {
+        const auto& s = _shelves[i];
+        if (s.height < rect.h || _width - s.x < rect.w)
+        {
+            continue;
+        }
+
+        const auto waste = s.height - rect.h;
+        if (s.height <= maxHeight)
+        {
+            if (waste < bestWaste)
+            {
+                best = i;
+                bestWaste = waste;
+            }
+        }
+        else if (waste < fallbackWaste)
+        {
+            fallback = i;
+            fallbackWaste = waste;
+        }
+    }
+
+    // If no shelf fits well, open a new one at the bottom, if there's still space.
+    if (!best)
+    {
+        const auto height = std::min<i32>((rect.h + shelfAlignment - 1) & ~(shelfAlignment - 1), _height - _nextY);
+        if (height >= rect.h)
+        {
+            best = _shelves.size();
+            auto& s = _shelves.emplace_back();
+            s.y = _nextY;
+            s.height = gsl::narrow_cast<u16>(height);
+            s.generation = ++_generation;
+            _nextY = gsl::narrow_cast<u16>(_nextY + s.height);
+        }
+        else
+        {
+            best = fallback;
+        }
+    }
+
+    if (!best)
+    {
+        return false;
+    }
+
+    auto& s = _shelves[best];
+    rect.x = s.x;
+    rect.y = s.y;
+    rect.shelf = gsl::narrow_cast<u16>(best);
+    rect.generation = s.generation;
+    s.x = gsl::narrow_cast<u16>(s.x + rect.w);
+    s.lastUsed = _frame;
+    _stats.allocations++;
+    return true;
+}
+
+// Frees up a band of the atlas that is at least `height` pixels tall, by evicting the least recently
+// used shelf that is tall enough. If no such shelf exists, the coldest run of adjacent shelves that
+// is tall enough gets merged into a single shelf instead. Shelves that were used during the current
+// frame are never evicted, because the caller is likely to need those glyphs again shortly.
+//
+// Returns an empty band if nothing could be evicted. The caller should reset the atlas in that case.
+GlyphAtlasPacker::Band GlyphAtlasPacker::Evict(i32 height) noexcept
+{
+    const auto cold = [&](const Shelf& s) noexcept {
+        return s.height != 0 && s.lastUsed != _frame;
+    };
+
+    size_t best = 0;
+    u32 bestLastUsed = UINT32_MAX;
+    u16 bestHeight = UINT16_MAX;
+
+    for (size_t i = 1; i < _shelves.size(); ++i)
+    {
+        const auto& s = _shelves[i];
+        if (cold(s) && s.height >= height && (s.lastUsed < bestLastUsed || (s.lastUsed == bestLastUsed && s.height < bestHeight)))
+        {
+            best = i;
+            bestLastUsed = s.lastUsed;
+            bestHeight = s.height;
+        }
+    }
+
+    if (best)
+    {
+        auto& s = _shelves[best];
+        _evictShelf(s);
+        return { s.y, s.y + s.height };
+    }
+
+    // Shelves are stored in the order they were created in, which is also their vertical order.
+    // Shelves with a height of 0 were merged into their predecessor and can simply be skipped.
+    size_t bestBeg = 0;
+    size_t bestEnd = 0;
+
+    for (size_t beg = 1; beg < _shelves.size(); ++beg)
+    {
+        if (!cold(_shelves[beg]))
+        {
+            continue;
+        }
+
+        i32 total = 0;
+        u32 lastUsed = 0;
+
+        for (auto end = beg; end < _shelves.size(); ++end)
+        {
+            const auto& s = _shelves[end];
+            if (s.height == 0)
+            {
+                continue;
+            }
+            if (!cold(s))
+            {
+                break;
+            }
+
+            total += s.height;
+            lastUsed = std::max(lastUsed, s.lastUsed);
+
+            if (total >= height)
+            {
+                if (lastUsed < bestLastUsed)
+                {
+                    bestBeg = beg;
+                    bestEnd = end + 1;
+                    bestLastUsed = lastUsed;
+                }
+                break;
+            }
+        }
+    }
+
+    if (!bestBeg)
+    {
+        return {};
+    }
+
+    auto& first = _shelves[bestBeg];
+    _evictShelf(first);
+
+    for (auto i = bestBeg + 1; i < bestEnd; ++i)
+    {
+        auto& s = _shelves[i];
+        if (s.height)
+        {
+            first.height = gsl::narrow_cast<u16>(first.height + s.height);
+            _evictShelf(s);
+            s.height = 0;
+        }
+    }
+
+    return { first.y, first.y + first.height };
+}
+
+void GlyphAtlasPacker::_evictShelf(Shelf& shelf) noexcept
+{
+    shelf.x = 0;
+    shelf.generation = ++_generation;
+    shelf.lastUsed = _frame;
+    _stats.evictions++;
+}
@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "common.h"
+
+namespace Microsoft::Console::Render::Atlas
+{
+    // A shelf packer for the glyph atlas with least-recently-used eviction.
+    //
+    // The atlas is split into horizontal shelves which span its entire width. Glyphs are placed left to right
+    // onto the shelf whose height fits them best. Each shelf remembers the last frame it was used in, so that
+    // once the atlas is full we can evict the coldest shelf instead of throwing away the entire atlas.
+    // Glyphs refer to their shelf by its index and a generation. The latter is bumped whenever a shelf
+    // gets evicted, which invalidates all glyphs that were on it without having to find them.
+    //
+    // This class doesn't know anything about Direct3D and can be used on its own.
+    struct GlyphAtlasPacker
+    {
+        struct Rect
+        {
+            // IN: The size of the glyph.
+            i32 w = 0;
+            i32 h = 0;
+            // OUT: The position of the glyph in the atlas.
+            i32 x = 0;
+            i32 y = 0;
+            // OUT: The values to pass to IsValid()/Use() later on.
+            u16 shelf = 0;
+            u32 generation = 0;
+        };
+
+        // The area that was freed by Evict(). It needs to be cleared before anything gets drawn into it.
+        struct Band
+        {
+            i32 top = 0;
+            i32 bottom = 0;
+        };
+
+        struct Stats
+        {
+            u64 hits = 0;
+            u64 allocations = 0;
+            u64 evictions = 0;
+            u64 resets = 0;
+        };
+
+        void Reset(u16 width, u16 height);
+        void NextFrame() noexcept;
+        bool Allocate(Rect& rect) noexcept;
+        Band Evict(i32 height) noexcept;
+
+        // Returns true if the glyph with the given shelf/generation (as returned by Allocate())
+        // is still present in the atlas and marks its shelf as used during the current frame.
+        bool Use(u16 shelf, u32 generation) noexcept
+        {
+            auto& s = _shelves[shelf];
+            if (s.generation != generation)
+            {
+                return false;
+            }
+            s.lastUsed = _frame;
+            _stats.hits++;
+            return true;
+        }
+
+        u16 Width() const noexcept { return _width; }
+        u16 Height() const noexcept { return _height; }
+        const Stats& GetStats() const noexcept { return _stats; }
+
+    private:
+        struct Shelf
+        {
+            u16 y = 0;
+            // A height of 0 marks a shelf that was merged into its predecessor by Evict().
+            u16 height = 0;
+            // The next free column on this shelf.
+            u16 x = 0;
+            u32 generation = 0;
+            u32 lastUsed = 0;
+        };
+
+        void _evictShelf(Shelf& shelf) noexcept;
+
+        // _shelves[0] is a sentinel that's never allocated from or evicted. Glyphs without
+        // any pixels (whitespace) refer to it, which makes them valid for all eternity.
+        std::vector<Shelf> _shelves{ Shelf{} };
+        u16 _width = 0;
+        u16 _height = 0;
+        // The first row of pixels not covered by any shelf yet.
+        u16 _nextY = 0;
+        u32 _frame = 1;
+        // Every eviction hands out a new, unique generation.
+        u32 _generation = 0;
+        Stats _stats;
+    };
+}
@@ -0,0 +1,294 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "WexTestClass.h"
+#include "consoletaeftemplates.hpp"
+
+#include "../BackendCPU.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+using namespace Microsoft::Console::Render::Atlas;
+
+// The golden images in these tests are drawn as ASCII art, where each character is one
+// pixel (or one cell for backgrounds) of the color it's mapped to in the palette below.
+//
+// They only cover the parts of BackendCPU that produce identical results on every machine.
+// Glyphs rasterized by DirectWrite depend on the installed font files and aren't tested here.
+static constexpr std::pair<wchar_t, u32> palette[]{
+    { L'.', 0xff000000 }, // black
+    { L'b', 0xffff0000 }, // blue
+    { L'r', 0xff0000ff }, // red
+    { L'g', 0xff00ff00 }, // green
+    { L'w', 0xffffffff }, // white
+    { L'y', 0xff00ffff }, // yellow
+    { L's', 0xff7f7f7f }, // selectionColor blended onto black
+    { L'S', 0xffff7f7f }, // selectionColor blended onto blue
+};
+
+static constexpr u16 cellWidth = 4;
+static constexpr u16 cellHeight = 4;
+static constexpr u16 cellCountX = 3;
+static constexpr u16 cellCountY = 2;
+
+static constexpr u32 colorOf(wchar_t ch) noexcept
+{
+    for (const auto& [key, color] : palette)
+    {
+        if (key == ch)
+        {
+            return color;
+        }
+    }
+    return 0;
+}
+
+static constexpr wchar_t charOf(u32 color) noexcept
+{
+    for (const auto& [key, value] : palette)
+    {
+        if (value == color)
+        {
+            return key;
+        }
+    }
+    return L'?';
+}
+
+class BackendCPUTests
+{
+    TEST_CLASS(BackendCPUTests);
+
+    TEST_METHOD(DrawsBackgroundsCursorAndSelection);
+    TEST_METHOD(InvertsColorsBelowCursor);
+    TEST_METHOD(DrawsSoftFontGlyphsAndGridlines);
+    TEST_METHOD(DrawsBuiltinGlyphs);
+
+    // Sets up a payload for a 3x2 cell viewport with 4x4 pixel cells,
+    // similar to what AtlasEngine::_recreateCellCountDependentResources() does.
+    static void _initPayload(RenderingPayload& p, std::initializer_list<std::wstring_view> backgrounds)
+    {
+        p.s = DirtyGenerationalSettings();
+
+        const auto s = p.s.write();
+        s->targetSize = { cellWidth * cellCountX, cellHeight * cellCountY };
+        s->viewportCellCount = { cellCountX, cellCountY };
+
+        const auto font = s->font.write();
+        font->cellSize = { cellWidth, cellHeight };
+        font->baseline = 3;
+        font->thinLineWidth = 1;
+        font->underline = { 3, 1 };
+
+        p.unorderedRows = Buffer<ShapedRow>(cellCountY);
+        p.rows = Buffer<ShapedRow*>(cellCountY);
+        p.colorBitmapRowStride = cellCountX;
+        p.colorBitmapDepthStride = p.colorBitmapRowStride * cellCountY;
+        p.colorBitmap = Buffer<u32, 32>(p.colorBitmapDepthStride * 2);
+        p.backgroundBitmap = { p.colorBitmap.data(), p.colorBitmapDepthStride };
+        p.foregroundBitmap = { p.colorBitmap.data() + p.colorBitmapDepthStride, p.colorBitmapDepthStride };
+
+        auto it = p.unorderedRows.data();
+        for (auto& r : p.rows)
+        {
+            r = it++;
+        }
+
+        size_t y = 0;
+        for (const auto& row : backgrounds)
+        {
+            for (size_t x = 0; x < row.size(); ++x)
+            {
+                p.backgroundBitmap[y * p.colorBitmapRowStride + x] = colorOf(row[x]);
+            }
+            ++y;
+        }
+    }
+
+    // Appends a glyph that's drawn without a font face, meaning a builtin glyph or a soft font character.
+    static void _appendGlyph(ShapedRow& row, u16 ch, u32 color)
+    {
+        if (row.mappings.empty())
+        {
+            row.mappings.emplace_back();
+        }
+
+        row.glyphIndices.emplace_back(ch);
+        row.glyphAdvances.emplace_back(static_cast<f32>(cellWidth));
+        row.glyphOffsets.emplace_back();
+        row.colors.emplace_back(color);
+        row.mappings.back().glyphsTo = row.glyphIndices.size();
+    }
+
+    static void _verifyImage(const BackendCPU& backend, std::initializer_list<std::wstring_view> golden)
+    {
+        const auto size = backend.ImageSize();
+        const auto image = backend.Image();
+        VERIFY_ARE_EQUAL(static_cast<u16>(cellWidth * cellCountX), size.x);
+        VERIFY_ARE_EQUAL(static_cast<u16>(cellHeight * cellCountY), size.y);
+        VERIFY_ARE_EQUAL(golden.size(), static_cast<size_t>(size.y));
+
+        // Comparing the images row by row as ASCII art makes any failures easy to read.
+        std::wstring actual;
+        size_t y = 0;
+        for (const auto& expected : golden)
+        {
+            actual.clear();
+            for (size_t x = 0; x < size.x; ++x)
+            {
+                actual.push_back(charOf(image[y * size.x + x]));
+            }
+            VERIFY_ARE_EQUAL(expected, std::wstring_view{ actual });
+            ++y;
+        }
+    }
+};
+
+void BackendCPUTests::DrawsBackgroundsCursorAndSelection()
+{
+    RenderingPayload p;
+    _initPayload(p, {
+                        L".b.",
+                        L"r.g",
+                    });
+
+    const auto cursor = p.s.write()->cursor.write();
+    cursor->cursorColor = colorOf(L'y');
+    cursor->cursorType = static_cast<u16>(CursorType::EmptyBox);
+    p.cursorRect = { 1, 1, 2, 2 };
+
+    // The default selection color is translucent white.
+    p.rows[0]->selectionFrom = 0;
+    p.rows[0]->selectionTo = 2;
+
+    BackendCPU backend;
+    backend.Render(p);
+
+    _verifyImage(backend, {
+                              L"ssssSSSS....",
+                              L"ssssSSSS....",
+                              L"ssssSSSS....",
+                              L"ssssSSSS....",
+                              L"rrrryyyygggg",
+                              L"rrrry..ygggg",
+                              L"rrrry..ygggg",
+                              L"rrrryyyygggg",
+                          });
+}
+
+void BackendCPUTests::InvertsColorsBelowCursor()
+{
+    RenderingPayload p;
+    _initPayload(p, {
+                        L".b.",
+                        L"r.g",
+                    });
+
+    // A cursor color of 0xffffffff inverts the colors below the cursor.
+    // The legacy cursor with a height of 50% covers the bottom 2 pixel rows of the cells.
+    const auto cursor = p.s.write()->cursor.write();
+    cursor->cursorColor = 0xffffffff;
+    cursor->cursorType = static_cast<u16>(CursorType::Legacy);
+    cursor->heightPercentage = 50;
+    p.cursorRect = { 1, 0, 3, 1 };
+
+    BackendCPU backend;
+    backend.Render(p);
+
+    _verifyImage(backend, {
+                              L"....bbbb....",
+                              L"....bbbb....",
+                              L"....yyyywwww",
+                              L"....yyyywwww",
+                              L"rrrr....gggg",
+                              L"rrrr....gggg",
+                              L"rrrr....gggg",
+                              L"rrrr....gggg",
+                          });
+}
+
+void BackendCPUTests::DrawsSoftFontGlyphsAndGridlines()
+{
+    RenderingPayload p;
+    _initPayload(p, {
+                        L"...",
+                        L"...",
+                    });
+
+    const auto font = p.s.write()->font.write();
+    font->softFontCellSize = { 4, 4 };
+    font->softFontPattern = {
+        // U+EF20: an "X"
+        0b1001'0000'0000'0000,
+        0b0110'0000'0000'0000,
+        0b0110'0000'0000'0000,
+        0b1001'0000'0000'0000,
+        // U+EF21: a "C"
+        0b1110'0000'0000'0000,
+        0b1000'0000'0000'0000,
+        0b1000'0000'0000'0000,
+        0b1110'0000'0000'0000,
+    };
+
+    // The underline is drawn on top of the glyphs.
+    _appendGlyph(*p.rows[0], 0xEF20, colorOf(L'w'));
+    _appendGlyph(*p.rows[0], 0xEF21, colorOf(L'g'));
+    p.rows[0]->gridLineRanges.emplace_back(GridLineSet{ GridLines::Underline }, 0u, colorOf(L'r'), u16{ 1 }, u16{ 3 });
+
+    // Soft font glyphs in double width rows are upscaled with nearest neighbor sampling.
+    p.rows[1]->lineRendition = LineRendition::DoubleWidth;
+    _appendGlyph(*p.rows[1], 0xEF20, colorOf(L'w'));
+
+    BackendCPU backend;
+    backend.Render(p);
+
+    _verifyImage(backend, {
+                              L"w..wggg.....",
+                              L".ww.g.......",
+                              L".ww.g.......",
+                              L"w..wrrrrrrrr",
+                              L"ww....ww....",
+                              L"..wwww......",
+                              L"..wwww......",
+                              L"ww....ww....",
+                          });
+}
+
+void BackendCPUTests::DrawsBuiltinGlyphs()
+{
+    RenderingPayload p;
+    _initPayload(p, {
+                        L"...",
+                        L"...",
+                    });
+    THROW_IF_FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, __uuidof(p.d2dFactory), nullptr, reinterpret_cast<void**>(p.d2dFactory.addressof())));
+
+    // U+2588 FULL BLOCK, U+2580 UPPER HALF BLOCK and U+2592 MEDIUM SHADE.
+    // The checkerboard pattern of the latter is aligned to the image, just like in BackendD3D.
+    _appendGlyph(*p.rows[0], 0x2588, colorOf(L'b'));
+    _appendGlyph(*p.rows[0], 0x2580, colorOf(L'g'));
+    _appendGlyph(*p.rows[0], 0x2592, colorOf(L'w'));
+
+    // Only the top half of a double height glyph is visible in a DoubleHeightTop row.
+    // The top half of an upper half block is a filled double width cell.
+    p.rows[1]->lineRendition = LineRendition::DoubleHeightTop;
+    _appendGlyph(*p.rows[1], 0x2580, colorOf(L'r'));
+
+    BackendCPU backend;
+    backend.Render(p);
+
+    _verifyImage(backend, {
+                              L"bbbbggggw.w.",
+                              L"bbbbgggg.w.w",
+                              L"bbbb....w.w.",
+                              L"bbbb.....w.w",
+                              L"rrrrrrrr....",
+                              L"rrrrrrrr....",
+                              L"rrrrrrrr....",
+                              L"rrrrrrrr....",
+                          });
+}
@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "WexTestClass.h"
+
+#include "../GlyphAtlasPacker.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render::Atlas;
+
+using Rect = GlyphAtlasPacker::Rect;
+
+class GlyphAtlasPackerTests
+{
+    TEST_CLASS(GlyphAtlasPackerTests);
+
+    TEST_METHOD(PacksOntoShelves);
+    TEST_METHOD(PacksOntoTallerShelfWhenFull);
+    TEST_METHOD(RejectsOversizedGlyphs);
+    TEST_METHOD(OverflowFails);
+    TEST_METHOD(EvictsLeastRecentlyUsedShelf);
+    TEST_METHOD(NeverEvictsHotShelves);
+    TEST_METHOD(MergesAdjacentShelves);
+    TEST_METHOD(CountsStats);
+
+    static Rect _allocate(GlyphAtlasPacker& packer, i32 w, i32 h)
+    {
+        Rect rect{ w, h };
+        VERIFY_IS_TRUE(packer.Allocate(rect));
+        return rect;
+    }
+};
+
+void GlyphAtlasPackerTests::PacksOntoShelves()
+{
+    GlyphAtlasPacker packer;
+    packer.Reset(64, 64);
+
+    // The first glyph opens a shelf that's rounded up to 12px.
+    const auto a = _allocate(packer, 10, 10);
+    VERIFY_ARE_EQUAL(0, a.x);
+    VERIFY_ARE_EQUAL(0, a.y);
+    VERIFY_ARE_EQUAL(1u, a.shelf);
+
+    // A slightly taller glyph fits next to it.
+    const auto b = _allocate(packer, 10, 12);
+    VERIFY_ARE_EQUAL(10, b.x);
+    VERIFY_ARE_EQUAL(0, b.y);
+    VERIFY_ARE_EQUAL(a.shelf, b.shelf);
+    VERIFY_ARE_EQUAL(a.generation, b.generation);
+
+    // A glyph that doesn't fit onto the first shelf opens another one below it.
+    const auto c = _allocate(packer, 10, 20);
+    VERIFY_ARE_EQUAL(0, c.x);
+    VERIFY_ARE_EQUAL(12, c.y);
+    VERIFY_ARE_EQUAL(2u, c.shelf);
+
+    // A tiny glyph doesn't waste space on the existing, much taller shelves.
+    const auto d = _allocate(packer, 10, 4);
+    VERIFY_ARE_EQUAL(0, d.x);
+    VERIFY_ARE_EQUAL(32, d.y);
+    VERIFY_ARE_EQUAL(3u, d.shelf);
+
+    VERIFY_IS_TRUE(packer.Use(a.shelf, a.generation));
+    VERIFY_IS_TRUE(packer.Use(c.shelf, c.generation));
+    // The sentinel shelf used for whitespace is always valid.
+    VERIFY_IS_TRUE(packer.Use(0, 0));
+}
+
+void GlyphAtlasPackerTests::PacksOntoTallerShelfWhenFull()
+{
+    GlyphAtlasPacker packer;
+    packer.Reset(16, 8);
+
+    const auto a = _allocate(packer, 8, 8);
+
+    // There's no room left for another shelf, so the tiny glyph
+    // has to share the tall shelf instead of failing.
+    const auto b = _allocate(packer, 4, 2);
+    VERIFY_ARE_EQUAL(8, b.x);
+    VERIFY_ARE_EQUAL(0, b.y);
+    VERIFY_ARE_EQUAL(a.shelf, b.shelf);
+}
+
+void GlyphAtlasPackerTests::RejectsOversizedGlyphs()
+{
+    GlyphAtlasPacker packer;
+    packer.Reset(64, 64);
+
+    Rect wide{ 65, 4 };
+    VERIFY_IS_FALSE(packer.Allocate(wide));
+    Rect tall{ 4, 65 };
+    VERIFY_IS_FALSE(packer.Allocate(tall));
+    Rect empty{ 0, 4 };
+    VERIFY_IS_FALSE(packer.Allocate(empty));
+}
+
+void GlyphAtlasPackerTests::OverflowFails()
+{
+    GlyphAtlasPacker packer;
+    packer.Reset(16, 16);
+
+    _allocate(packer, 16, 8);
+    _allocate(packer, 16, 8);
+
+    Rect rect{ 16, 8 };
+    VERIFY_IS_FALSE(packer.Allocate(rect));
+    Rect narrow{ 1, 1 };
+    VERIFY_IS_FALSE(packer.Allocate(narrow));
+}
+
+void GlyphAtlasPackerTests::EvictsLeastRecentlyUsedShelf()
+{
+    GlyphAtlasPacker packer;
+    packer.Reset(16, 16);
+
+    const auto a = _allocate(packer, 16, 8);
+    const auto b = _allocate(packer, 16, 8);
+
+    packer.NextFrame();
+    VERIFY_IS_TRUE(packer.Use(b.shelf, b.generation));
+
+    // `a` wasn't used during this frame, so its shelf is the one to go.
+    const auto band = packer.Evict(8);
+    VERIFY_ARE_EQUAL(0, band.top);
+    VERIFY_ARE_EQUAL(8, band.bottom);
+
+    VERIFY_IS_FALSE(packer.Use(a.shelf, a.generation));
+    VERIFY_IS_TRUE(packer.Use(b.shelf, b.generation));
+
+    // The freed shelf can be allocated from again, with a new generation.
+    const auto c = _allocate(packer, 16, 8);
+    VERIFY_ARE_EQUAL(0, c.x);
+    VERIFY_ARE_EQUAL(0, c.y);
+    VERIFY_ARE_EQUAL(a.shelf, c.shelf);
+    VERIFY_ARE_NOT_EQUAL(a.generation, c.generation);
+}
+
+void GlyphAtlasPackerTests::NeverEvictsHotShelves()
+{
+    GlyphAtlasPacker packer;
+    packer.Reset(16, 16);
+
+    const auto a = _allocate(packer, 16, 8);
+    const auto b = _allocate(packer, 16, 8);
+
+    // Both shelves were allocated from during the current frame.
+    auto band = packer.Evict(8);
+    VERIFY_ARE_EQUAL(band.top, band.bottom);
+
+    packer.NextFrame();
+    VERIFY_IS_TRUE(packer.Use(a.shelf, a.generation));
+    VERIFY_IS_TRUE(packer.Use(b.shelf, b.generation));
+
+    band = packer.Evict(8);
+    VERIFY_ARE_EQUAL(band.top, band.bottom);
+    VERIFY_IS_TRUE(packer.Use(a.shelf, a.generation));
+    VERIFY_IS_TRUE(packer.Use(b.shelf, b.generation));
+}
+
+void GlyphAtlasPackerTests::MergesAdjacentShelves()
+{
+    GlyphAtlasPacker packer;
+    packer.Reset(16, 16);
+
+    Rect rects[4];
+    for (auto& r : rects)
+    {
+        r = _allocate(packer, 16, 4);
+    }
+
+    packer.NextFrame();
+    VERIFY_IS_TRUE(packer.Use(rects[3].shelf, rects[3].generation));
+
+    // No single shelf is 8px tall, so the first two get merged.
+    auto band = packer.Evict(8);
+    VERIFY_ARE_EQUAL(0, band.top);
+    VERIFY_ARE_EQUAL(8, band.bottom);
+
+    VERIFY_IS_FALSE(packer.Use(rects[0].shelf, rects[0].generation));
+    VERIFY_IS_FALSE(packer.Use(rects[1].shelf, rects[1].generation));
+    VERIFY_IS_TRUE(packer.Use(rects[2].shelf, rects[2].generation));
+    VERIFY_IS_TRUE(packer.Use(rects[3].shelf, rects[3].generation));
+
+    const auto tall = _allocate(packer, 16, 8);
+    VERIFY_ARE_EQUAL(0, tall.y);
+    VERIFY_ARE_EQUAL(rects[0].shelf, tall.shelf);
+
+    // Everything is hot now, and there's nothing left to evict.
+    band = packer.Evict(12);
+    VERIFY_ARE_EQUAL(band.top, band.bottom);
+}
+
+void GlyphAtlasPackerTests::CountsStats()
+{
+    GlyphAtlasPacker packer;
+    packer.Reset(16, 16);
+
+    const auto a = _allocate(packer, 16, 8);
+    _allocate(packer, 16, 8);
+    packer.NextFrame();
+    VERIFY_IS_TRUE(packer.Use(a.shelf, a.generation));
+    packer.Evict(8);
+    packer.Reset(16, 16);
+
+    const auto& stats = packer.GetStats();
+    VERIFY_ARE_EQUAL(1u, stats.hits);
+    VERIFY_ARE_EQUAL(2u, stats.allocations);
+    VERIFY_ARE_EQUAL(1u, stats.evictions);
+    VERIFY_ARE_EQUAL(2u, stats.resets);
+}
@@ -71,10 +71,11 @@ HRESULT RenderEngineBase::PrepareLineTransform(const LineRendition /*lineRenditi
 
 // Method Description:
 // - Blocks until the engine is able to render without blocking.
+// - The render thread paces its frames on its own, based on how long they take to
+//   paint and how fast the output is scrolling. Engines only need to override this
+//   if they have to wait for the display (e.g. a swap chain's frame latency object).
 void RenderEngineBase::WaitUntilCanRender() noexcept
 {
-    // Throttle the render loop a bit by default (~60 FPS), improving throughput.
-    Sleep(8);
 }
 
 void RenderEngineBase::UpdateHyperlinkHoveredId(const uint16_t /*hoveredId*/) noexcept
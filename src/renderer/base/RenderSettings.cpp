@@ -182,7 +182,7 @@ std::pair<COLORREF, COLORREF> RenderSettings::GetAttributeColors(const TextAttri
             fg != bg &&
             (_renderMode.test(Mode::AlwaysDistinguishableColors) || (fgTextColor.IsDefaultOrLegacy() && bgTextColor.IsDefaultOrLegacy())))
         {
-            fg = ColorFix::GetPerceivableColor(fg, bg, 0.5f * 0.5f);
+            fg = _getPerceivableColor(fg, bg);
         }
     }
 
@@ -246,13 +246,48 @@ COLORREF RenderSettings::GetAttributeUnderlineColor(const TextAttribute& attr) c
             (_renderMode.test(Mode::AlwaysDistinguishableColors) ||
              (_renderMode.test(Mode::IndexedDistinguishableColors) && ulTextColor.IsDefaultOrLegacy() && attr.GetBackground().IsDefaultOrLegacy())))
         {
-            ul = ColorFix::GetPerceivableColor(ul, bg, 0.5f * 0.5f);
+            ul = _getPerceivableColor(ul, bg);
         }
     }
 
     return ul;
 }
 
+// Routine Description:
+// - Returns how often the perceivable color adjustment was served from the cache.
+RenderSettings::ColorCacheStats RenderSettings::GetColorCacheStats() const noexcept
+{
+    return _colorCacheStats;
+}
+
+// Routine Description:
+// - Adjusts the given color to be perceivable on the reference (background) color.
+// - Since the adjustment is costly (conversions to OKLab and a search) and most
+//   screens only contain a handful of color pairs, the results are cached.
+// Arguments:
+// - color - The color to adjust.
+// - reference - The color it needs to be distinguishable from.
+// Return Value:
+// - The adjusted color.
+COLORREF RenderSettings::_getPerceivableColor(const COLORREF color, const COLORREF reference) const noexcept
+{
+    // Fibonacci hashing of both colors: The top 6 bits of the product are well mixed
+    // and make up the index into our 64 entries.
+    static_assert(std::tuple_size_v<decltype(_perceivableColorCache)> == 64);
+    const auto hash = (static_cast<uint64_t>(color) << 32 | reference) * UINT64_C(0x9E3779B97F4A7C15);
+    auto& entry = til::at(_perceivableColorCache, hash >> 58);
+
+    if (entry.color == color && entry.reference == reference)
+    {
+        _colorCacheStats.hits++;
+        return entry.result;
+    }
+
+    _colorCacheStats.misses++;
+    entry = { color, reference, ColorFix::GetPerceivableColor(color, reference, 0.5f * 0.5f) };
+    return entry.result;
+}
+
 // Routine Description:
 // - Increments the position in the blink cycle, toggling the blink rendition
 //   state on every second call, potentially triggering a redraw of the given
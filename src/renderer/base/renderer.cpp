@@ -57,67 +57,147 @@ Renderer::~Renderer()
 }
 
 // Routine Description:
-// - Walks through the console data structures to compose a new frame based on the data that has changed since last call and outputs it to the connected rendering engine.
+// - Walks through the console data structures to compose a new frame based on the data that has changed since last call and outputs it to the connected rendering engines.
 // Arguments:
 // - <none>
 // Return Value:
 // - HRESULT S_OK, GDI error, Safe Math error, or state/argument errors.
 [[nodiscard]] HRESULT Renderer::PaintFrame()
 {
-    FOREACH_ENGINE(pEngine)
+    // The engines that have yet to paint this frame successfully.
+    auto pending = _engines;
+
+    auto tries = maxRetriesForRenderEngine;
+    while (tries > 0)
     {
-        auto tries = maxRetriesForRenderEngine;
-        while (tries > 0)
+        if (_destructing)
         {
-            if (_destructing)
-            {
-                return S_FALSE;
-            }
+            return S_FALSE;
+        }
 
-            const auto hr = _PaintFrameForEngine(pEngine);
-            if (SUCCEEDED(hr))
-            {
-                break;
-            }
+        const auto hr = _PaintFrameForEngines(pending);
+        if (SUCCEEDED(hr))
+        {
+            break;
+        }
 
-            LOG_HR_IF(hr, hr != E_PENDING);
+        LOG_HR_IF(hr, hr != E_PENDING);
 
-            if (--tries == 0)
+        if (--tries == 0)
+        {
+            // Stop trying.
+            _pThread->DisablePainting();
+            if (_pfnRendererEnteredErrorState)
             {
-                // Stop trying.
-                _pThread->DisablePainting();
-                if (_pfnRendererEnteredErrorState)
-                {
-                    _pfnRendererEnteredErrorState();
-                }
-                // If there's no callback, we still don't want to FAIL_FAST: the renderer going black
-                // isn't near as bad as the entire application aborting. We're a component. We shouldn't
-                // abort applications that host us.
-                return S_FALSE;
+                _pfnRendererEnteredErrorState();
             }
-
-            // Add a bit of backoff.
-            // Sleep 150ms, 300ms, 450ms before failing out and disabling the renderer.
-            Sleep(renderBackoffBaseTimeMilliseconds * (maxRetriesForRenderEngine - tries));
+            // If there's no callback, we still don't want to FAIL_FAST: the renderer going black
+            // isn't near as bad as the entire application aborting. We're a component. We shouldn't
+            // abort applications that host us.
+            return S_FALSE;
         }
+
+        // Add a bit of backoff.
+        // Sleep 150ms, 300ms, 450ms before failing out and disabling the renderer.
+        Sleep(renderBackoffBaseTimeMilliseconds * (maxRetriesForRenderEngine - tries));
     }
 
     return S_OK;
 }
 
 [[nodiscard]] HRESULT Renderer::_PaintFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept
-try
 {
     FAIL_FAST_IF_NULL(pEngine); // This is a programming error. Fail fast.
 
-    _pData->LockConsole();
-    auto unlock = wil::scope_exit([&]() {
-        _pData->UnlockConsole();
-    });
+    IRenderEngine* engines[]{ pEngine };
+    return _PaintFrameForEngines(engines);
+}
+
+// Routine Description:
+// - Paints a frame with each of the given engines.
+// - The console lock is only held once for all engines, and the state they all share (cursor,
+//   selection, etc.) is only computed once. Presentation happens after the lock was released.
+// Arguments:
+// - engines - The engines to paint with. Null entries are skipped. Engines that painted
+//   successfully are set to null, so that the caller can retry the remaining ones.
+// Return Value:
+// - S_OK if all engines painted successfully, otherwise the first error.
+[[nodiscard]] HRESULT Renderer::_PaintFrameForEngines(const std::span<IRenderEngine*> engines) noexcept
+try
+{
+    auto hr = S_OK;
+    std::array<IRenderEngine*, std::tuple_size_v<decltype(_engines)>> present{};
+    auto presentCount = 0u;
+
+    {
+        _pData->LockConsole();
+        auto unlock = wil::scope_exit([&]() {
+            _pData->UnlockConsole();
+        });
+
+        // Last chance check if anything scrolled without an explicit invalidate notification since the last frame.
+        _CheckViewportAndScroll();
+
+        // Collect the engine-independent parts of the frame once for all engines.
+        _frameState.cursorInfo = _GetCursorInfo();
+        _frameState.selectionRects = _GetSelectionRects();
+        _frameState.searchSelectionRects = _GetSearchSelectionRects();
 
-    // Last chance check if anything scrolled without an explicit invalidate notification since the last frame.
-    _CheckViewportAndScroll();
+        for (auto& pEngine : engines)
+        {
+            if (!pEngine)
+            {
+                continue;
+            }
+
+            const auto engineHr = _PaintFrameContents(pEngine);
+            if (FAILED(engineHr))
+            {
+                hr = SUCCEEDED(hr) ? engineHr : hr;
+                continue;
+            }
+
+            // S_FALSE means that there was nothing to paint and thus nothing to present.
+            if (engineHr == S_OK && presentCount < present.size())
+            {
+                til::at(present, presentCount++) = pEngine;
+            }
+            pEngine = nullptr;
+        }
+    }
+
+    // Trigger out-of-lock presentation for renderers that can support it
+    for (size_t i = 0; i < presentCount; ++i)
+    {
+        const auto pEngine = til::at(present, i);
+        const auto presentHr = pEngine->Present();
+        if (FAILED(presentHr))
+        {
+            hr = SUCCEEDED(hr) ? presentHr : hr;
+
+            // Give the engine another try to paint (and present) the frame.
+            if (const auto it = std::find(engines.begin(), engines.end(), nullptr); it != engines.end())
+            {
+                *it = pEngine;
+            }
+        }
+    }
+
+    return hr;
+}
+CATCH_RETURN()
 
+// Routine Description:
+// - Paints the contents of the current frame with the given engine.
+// - The console lock must be held and _frameState must be up to date.
+// Arguments:
+// - pEngine - The engine to paint with.
+// Return Value:
+// - S_OK if the engine painted a frame that needs to be presented, S_FALSE if there was nothing
+//   to paint, or a relevant error via HRESULT.
+[[nodiscard]] HRESULT Renderer::_PaintFrameContents(_In_ IRenderEngine* const pEngine) noexcept
+try
+{
     // Try to start painting a frame
     const auto hr = pEngine->StartPaint();
     RETURN_IF_FAILED(hr);
@@ -127,7 +207,7 @@ try
     //      engine won't know that.
     if (S_FALSE == hr)
     {
-        return S_OK;
+        return S_FALSE;
     }
 
     auto endPaint = wil::scope_exit([&]() {
@@ -169,15 +249,6 @@ try
     // 6. Paint window title
     RETURN_IF_FAILED(_PaintTitle(pEngine));
 
-    // Force scope exit end paint to finish up collecting information and possibly painting
-    endPaint.reset();
-
-    // Force scope exit unlock to let go of global lock so other threads can run
-    unlock.reset();
-
-    // Trigger out-of-lock presentation for renderers that can support it
-    RETURN_IF_FAILED(pEngine->Present());
-
     // As we leave the scope, EndPaint will be called (declared above)
     return S_OK;
 }
@@ -419,6 +490,7 @@ bool Renderer::_CheckViewportAndScroll()
     }
 
     _ScrollPreviousSelection(coordDelta);
+    _NotifyScroll(coordDelta.y);
     return true;
 }
 
@@ -454,10 +526,23 @@ void Renderer::TriggerScroll(const til::point* const pcoordDelta)
     }
 
     _ScrollPreviousSelection(*pcoordDelta);
+    _NotifyScroll(pcoordDelta->y);
 
     NotifyPaintFrame();
 }
 
+// Routine Description:
+// - Lets the render thread know how fast the output is scrolling, so it can pace its frames accordingly.
+// Arguments:
+// - deltaY - the number of rows the contents moved by
+void Renderer::_NotifyScroll(const til::CoordType deltaY) noexcept
+{
+    if (_pThread && deltaY != 0)
+    {
+        _pThread->NotifyScroll(std::abs(deltaY), _viewport.Height());
+    }
+}
+
 // Routine Description:
 // - Called when the text buffer is about to circle its backing buffer.
 //      A renderer might want to get painted before that happens.
@@ -740,21 +825,21 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
             // of the backing buffer to fill in line 1 of the screen.
             const auto screenPosition = bufferLine.Origin() - til::point{ 0, view.Top() };
 
-            // Retrieve the cell information iterator limited to just this line we want to redraw.
-            auto it = buffer.GetCellDataAt(bufferLine.Origin(), bufferLine);
+            // Retrieve the row we want to redraw.
+            const auto& bufferRow = buffer.GetRowByOffset(bufferLine.Origin().y);
 
             // Calculate if two things are true:
             // 1. this row wrapped
             // 2. We're painting the last col of the row.
             // In that case, set lineWrapped=true for the _PaintBufferOutputHelper call.
-            const auto lineWrapped = (buffer.GetRowByOffset(bufferLine.Origin().y).WasWrapForced()) &&
+            const auto lineWrapped = bufferRow.WasWrapForced() &&
                                      (bufferLine.RightExclusive() == buffer.GetSize().Width());
 
             // Prepare the appropriate line transform for the current row and viewport offset.
             LOG_IF_FAILED(pEngine->PrepareLineTransform(lineRendition, screenPosition.y, view.Left()));
 
             // Ask the helper to paint through this specific line.
-            _PaintBufferOutputHelper(pEngine, it, screenPosition, lineWrapped);
+            _PaintBufferOutputHelper(pEngine, bufferRow, bufferLine.Left(), bufferLine.RightExclusive(), screenPosition, lineWrapped);
         }
     }
 }
@@ -765,154 +850,177 @@ static bool _IsAllSpaces(const std::wstring_view v)
     return v.find_first_not_of(L' ') == decltype(v)::npos;
 }
 
+// Routine Description:
+// - Paint helper for the text of a single row.
+// - It walks the row's attribute runs and glyphs directly and breaks the columns
+//   [columnBegin, columnEnd) into runs of clusters with identical attributes,
+//   patterns and font, each of which is handed to the engine in one go.
+// Arguments:
+// - pEngine - the engine to paint with
+// - row - the row to paint
+// - columnBegin, columnEnd - the range of columns within the row to paint
+// - target - the position on the screen of the column at columnBegin
+// - lineWrapped - whether the row wrapped and we're painting its last column
+// Return Value:
+// - <none>
 void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
-                                        TextBufferCellIterator it,
+                                        const ROW& row,
+                                        const til::CoordType columnBegin,
+                                        til::CoordType columnEnd,
                                         const til::point target,
                                         const bool lineWrapped)
 {
-    auto globalInvert{ _renderSettings.GetRenderMode(RenderSettings::Mode::ScreenReversed) };
+    const auto globalInvert{ _renderSettings.GetRenderMode(RenderSettings::Mode::ScreenReversed) };
+
+    columnEnd = std::min<til::CoordType>(columnEnd, row.size());
+    if (columnBegin < 0 || columnBegin >= columnEnd)
+    {
+        return;
+    }
+
+    // Find the attribute run that contains columnBegin. From here on we only ever move forward.
+    const auto& runs = row.Attributes().runs();
+    auto runIt = runs.begin();
+    til::CoordType runEnd = runIt->length;
+    while (runEnd <= columnBegin)
+    {
+        ++runIt;
+        runEnd += runIt->length;
+    }
 
-    // If we have valid data, let's figure out how to draw it.
-    if (it)
+    auto x = columnBegin;
+
+    // Retrieve the first color.
+    auto color = runIt->value;
+    // Retrieve the first pattern id
+    auto patternIds = _pData->GetPatternId(target);
+    // Determine whether we're using a soft font.
+    auto usingSoftFont = s_IsSoftFontChar(row.GlyphAt(x), _firstSoftFontChar, _lastSoftFontChar);
+
+    // This outer loop will continue until we reach the end of the text we are trying to draw.
+    while (x < columnEnd)
     {
-        // TODO: MSFT: 20961091 -  This is a perf issue. Instead of rebuilding this and allocing memory to hold the reinterpretation,
-        // we should have an iterator/view adapter for the rendering.
-        // That would probably also eliminate the RenderData needing to give us the entire TextBuffer as well...
-        // Retrieve the iterator for one line of information.
+        // Hold onto the current run color right here for the length of the outer loop.
+        // We'll be changing the persistent one as we run through the inner loop to detect
+        // when a run changes, but we will still need to know this color at the bottom
+        // when we go to draw gridlines for the length of the run.
+        const auto currentRunColor = color;
+
+        // Update the drawing brushes with our color and font usage.
+        THROW_IF_FAILED(_UpdateDrawingBrushes(pEngine, currentRunColor, usingSoftFont, false));
+
+        // Hold onto the column where this run starts and the target location it gets drawn at.
+        const auto currentRunColumn = x;
+        auto screenPoint = til::point{ target.x + (x - columnBegin), target.y };
         til::CoordType cols = 0;
 
-        // Retrieve the first color.
-        auto color = it->TextAttr();
-        // Retrieve the first pattern id
-        auto patternIds = _pData->GetPatternId(target);
-        // Determine whether we're using a soft font.
-        auto usingSoftFont = s_IsSoftFontChar(it->Chars(), _firstSoftFontChar, _lastSoftFontChar);
+        // Ensure that our cluster vector is clear.
+        _clusterBuffer.clear();
+
+        // Reset our flag to know when we're in the special circumstance
+        // of attempting to draw only the right-half of a two-column character
+        // as the first item in our run.
+        auto trimLeft = false;
+
+        // Run contains wide character (>1 columns)
+        auto containsWideCharacter = false;
 
-        // And hold the point where we should start drawing.
-        auto screenPoint = target;
+        // Whether the attribute run at x differs from the color we're painting with.
+        // That's only ever the case for runs of blank space, see below.
+        auto attrDiffers = false;
+        auto attrDiffersRunEnd = -1;
 
-        // This outer loop will continue until we reach the end of the text we are trying to draw.
-        while (it)
+        // This inner loop will accumulate clusters until the color changes.
+        // When the color changes, it will save the new color off and break.
+        // We also accumulate clusters according to regex patterns
+        do
         {
-            // Hold onto the current run color right here for the length of the outer loop.
-            // We'll be changing the persistent one as we run through the inner loops to detect
-            // when a run changes, but we will still need to know this color at the bottom
-            // when we go to draw gridlines for the length of the run.
-            const auto currentRunColor = color;
-
-            // Hold onto the current pattern id as well
-            const auto currentPatternId = patternIds;
-
-            // Update the drawing brushes with our color and font usage.
-            THROW_IF_FAILED(_UpdateDrawingBrushes(pEngine, currentRunColor, usingSoftFont, false));
-
-            // Advance the point by however many columns we've just outputted and reset the accumulator.
-            screenPoint.x += cols;
-            cols = 0;
-
-            // Hold onto the start of this run iterator and the target location where we started
-            // in case we need to do some special work to paint the line drawing characters.
-            const auto currentRunItStart = it;
-            const auto currentRunTargetStart = screenPoint;
-
-            // Ensure that our cluster vector is clear.
-            _clusterBuffer.clear();
-
-            // Reset our flag to know when we're in the special circumstance
-            // of attempting to draw only the right-half of a two-column character
-            // as the first item in our run.
-            auto trimLeft = false;
-
-            // Run contains wide character (>1 columns)
-            auto containsWideCharacter = false;
-
-            // This inner loop will accumulate clusters until the color changes.
-            // When the color changes, it will save the new color off and break.
-            // We also accumulate clusters according to regex patterns
-            do
+            while (runEnd <= x)
             {
-                til::point thisPoint{ screenPoint.x + cols, screenPoint.y };
-                const auto thisPointPatterns = _pData->GetPatternId(thisPoint);
-                const auto thisUsingSoftFont = s_IsSoftFontChar(it->Chars(), _firstSoftFontChar, _lastSoftFontChar);
-                const auto changedPatternOrFont = patternIds != thisPointPatterns || usingSoftFont != thisUsingSoftFont;
-                if (color != it->TextAttr() || changedPatternOrFont)
-                {
-                    auto newAttr{ it->TextAttr() };
-                    // foreground doesn't matter for runs of spaces (!)
-                    // if we trick it . . . we call Paint far fewer times for cmatrix
-                    if (!_IsAllSpaces(it->Chars()) || !newAttr.HasIdenticalVisualRepresentationForBlankSpace(color, globalInvert) || changedPatternOrFont)
-                    {
-                        color = newAttr;
-                        patternIds = thisPointPatterns;
-                        usingSoftFont = thisUsingSoftFont;
-                        break; // vend this run
-                    }
-                }
-
-                // Walk through the text data and turn it into rendering clusters.
-                // Keep the columnCount as we go to improve performance over digging it out of the vector at the end.
-                auto columnCount = it->Columns();
+                ++runIt;
+                runEnd += runIt->length;
+            }
+            if (attrDiffersRunEnd != runEnd)
+            {
+                attrDiffers = runIt->value != color;
+                attrDiffersRunEnd = runEnd;
+            }
 
-                // If we're on the first cluster to be added and it's marked as "trailing"
-                // (a.k.a. the right half of a two column character), then we need some special handling.
-                if (_clusterBuffer.empty() && it->DbcsAttr() == DbcsAttribute::Trailing)
+            const auto glyph = row.GlyphAt(x);
+            const til::point thisPoint{ target.x + (x - columnBegin), target.y };
+            const auto thisPointPatterns = _pData->GetPatternId(thisPoint);
+            const auto thisUsingSoftFont = s_IsSoftFontChar(glyph, _firstSoftFontChar, _lastSoftFontChar);
+            const auto changedPatternOrFont = patternIds != thisPointPatterns || usingSoftFont != thisUsingSoftFont;
+            if (attrDiffers || changedPatternOrFont)
+            {
+                const auto& newAttr = runIt->value;
+                // foreground doesn't matter for runs of spaces (!)
+                // if we trick it . . . we call Paint far fewer times for cmatrix
+                if (!_IsAllSpaces(glyph) || !newAttr.HasIdenticalVisualRepresentationForBlankSpace(color, globalInvert) || changedPatternOrFont)
                 {
-                    // Move left to the one so the whole character can be struck correctly.
-                    --screenPoint.x;
-                    // And tell the next function to trim off the left half of it.
-                    trimLeft = true;
-                    // And add one to the number of columns we expect it to take as we insert it.
-                    ++columnCount;
+                    color = newAttr;
+                    patternIds = thisPointPatterns;
+                    usingSoftFont = thisUsingSoftFont;
+                    break; // vend this run
                 }
+            }
 
-                if (columnCount > 1)
-                {
-                    containsWideCharacter = true;
-                }
+            // Turn the glyph into a rendering cluster.
+            // Keep the columnCount as we go to improve performance over digging it out of the vector at the end.
+            const auto next = row.NavigateToNext(x);
+            auto columnCount = next - x;
 
-                // Advance the cluster and column counts.
-                _clusterBuffer.emplace_back(it->Chars(), columnCount);
-                it += std::max(it->Columns(), 1); // prevent infinite loop for no visible columns
-                cols += columnCount;
+            // If we're on the first cluster to be added and it's marked as "trailing"
+            // (a.k.a. the right half of a two column character), then we need some special handling.
+            if (_clusterBuffer.empty() && x == columnBegin && row.DbcsAttrAt(x) == DbcsAttribute::Trailing)
+            {
+                // Move left to the one so the whole character can be struck correctly.
+                --screenPoint.x;
+                // And tell the next function to trim off the left half of it.
+                trimLeft = true;
+                // And add one to the number of columns we expect it to take as we insert it.
+                ++columnCount;
+            }
+
+            if (columnCount > 1)
+            {
+                containsWideCharacter = true;
+            }
 
-            } while (it);
+            // Advance the cluster and column counts.
+            _clusterBuffer.emplace_back(glyph, columnCount);
+            cols += columnCount;
+            x = next;
+        } while (x < columnEnd);
 
-            // Do the painting.
-            THROW_IF_FAILED(pEngine->PaintBufferLine({ _clusterBuffer.data(), _clusterBuffer.size() }, screenPoint, trimLeft, lineWrapped));
+        // Do the painting.
+        THROW_IF_FAILED(pEngine->PaintBufferLine({ _clusterBuffer.data(), _clusterBuffer.size() }, screenPoint, trimLeft, lineWrapped));
 
-            // If we're allowed to do grid drawing, draw that now too (since it will be coupled with the color data)
-            // We're only allowed to draw the grid lines under certain circumstances.
-            if (_pData->IsGridLineDrawingAllowed())
+        // If we're allowed to do grid drawing, draw that now too (since it will be coupled with the color data)
+        // We're only allowed to draw the grid lines under certain circumstances.
+        if (_pData->IsGridLineDrawingAllowed())
+        {
+            // See GH: 803
+            // If we found a wide character while we looped above, it's possible we skipped over the right half
+            // attribute that could have contained different line information than the left half.
+            if (containsWideCharacter)
             {
-                // See GH: 803
-                // If we found a wide character while we looped above, it's possible we skipped over the right half
-                // attribute that could have contained different line information than the left half.
-                if (containsWideCharacter)
+                // We need to go through the columns again to ensure we get the lines associated with each
+                // exact column. The code above will condense two-column characters into one, but it is possible
+                // (like with the IME) that the line drawing characters will vary from the left to right half
+                // of a wider character.
+                const auto end = std::min<til::CoordType>(x, row.size());
+                for (auto column = currentRunColumn; column < end; ++column)
                 {
-                    // Start from the original position in this run.
-                    auto lineIt = currentRunItStart;
-                    // Start from the original target in this run.
-                    auto lineTarget = currentRunTargetStart;
-
-                    // We need to go through the iterators again to ensure we get the lines associated with each
-                    // exact column. The code above will condense two-column characters into one, but it is possible
-                    // (like with the IME) that the line drawing characters will vary from the left to right half
-                    // of a wider character.
-                    // We could theoretically pre-pass for this in the loop above to be more efficient about walking
-                    // the iterator, but I fear it would make the code even more confusing than it already is.
-                    // Do that in the future if some WPR trace points you to this spot as super bad.
-                    for (til::CoordType colsPainted = 0; colsPainted < cols; ++colsPainted, ++lineIt, ++lineTarget.x)
-                    {
-                        auto lines = lineIt->TextAttr();
-                        _PaintBufferOutputGridLineHelper(pEngine, lines, 1, lineTarget);
-                    }
-                }
-                else
-                {
-                    // If nothing exciting is going on, draw the lines in bulk.
-                    _PaintBufferOutputGridLineHelper(pEngine, currentRunColor, cols, screenPoint);
+                    const til::point lineTarget{ target.x + (column - columnBegin), target.y };
+                    _PaintBufferOutputGridLineHelper(pEngine, row.GetAttrByColumn(column), 1, lineTarget);
                 }
             }
+            else
+            {
+                // If nothing exciting is going on, draw the lines in bulk.
+                _PaintBufferOutputGridLineHelper(pEngine, currentRunColor, cols, screenPoint);
+            }
         }
     }
 }
@@ -1106,10 +1214,9 @@ bool Renderer::_isInHoveredInterval(const til::point coordTarget) const noexcept
 // - <none>
 void Renderer::_PaintCursor(_In_ IRenderEngine* const pEngine)
 {
-    const auto cursorInfo = _GetCursorInfo();
-    if (cursorInfo.has_value())
+    if (const auto& cursorInfo = _frameState.cursorInfo)
     {
-        LOG_IF_FAILED(pEngine->PaintCursor(cursorInfo.value()));
+        LOG_IF_FAILED(pEngine->PaintCursor(*cursorInfo));
     }
 }
 
@@ -1127,7 +1234,7 @@ void Renderer::_PaintCursor(_In_ IRenderEngine* const pEngine)
 [[nodiscard]] HRESULT Renderer::_PrepareRenderInfo(_In_ IRenderEngine* const pEngine)
 {
     RenderFrameInfo info;
-    info.cursorInfo = _GetCursorInfo();
+    info.cursorInfo = _frameState.cursorInfo;
     return pEngine->PrepareRenderInfo(info);
 }
 
@@ -1163,9 +1270,13 @@ void Renderer::_PaintOverlay(IRenderEngine& engine,
                     const til::point target{ viewDirty.left, iRow };
                     const auto source = target - overlay.origin;
 
-                    auto it = overlay.buffer.GetCellLineDataAt(source);
+                    if (source.y < 0 || source.y >= overlay.buffer.GetSize().Height())
+                    {
+                        continue;
+                    }
 
-                    _PaintBufferOutputHelper(&engine, it, target, false);
+                    const auto& row = overlay.buffer.GetRowByOffset(source.y);
+                    _PaintBufferOutputHelper(&engine, row, source.x, row.size(), target, false);
                 }
             }
         }
@@ -1209,8 +1320,8 @@ void Renderer::_PaintSelection(_In_ IRenderEngine* const pEngine)
         LOG_IF_FAILED(pEngine->GetDirtyArea(dirtyAreas));
 
         // Get selection rectangles
-        const auto rectangles = _GetSelectionRects();
-        const auto searchRectangles = _GetSearchSelectionRects();
+        const auto& rectangles = _frameState.selectionRects;
+        const auto& searchRectangles = _frameState.searchSelectionRects;
 
         std::vector<til::rect> dirtySearchRectangles;
         for (auto& dirtyRect : dirtyAreas)
@@ -1438,6 +1549,13 @@ void Renderer::UpdateLastHoveredInterval(const std::optional<PointTree::interval
     _hoveredInterval = newInterval;
 }
 
+// Method Description:
+// - Returns the frame timing statistics of the render thread.
+FrameStats Renderer::GetFrameStats() const
+{
+    return _pThread ? _pThread->GetFrameStats() : FrameStats{};
+}
+
 // Method Description:
 // - Blocks until the engines are able to render without blocking.
 void Renderer::WaitUntilCanRender()
@@ -80,6 +80,7 @@ namespace Microsoft::Console::Render
         void EnablePainting();
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs);
         void WaitUntilCanRender();
+        FrameStats GetFrameStats() const;
 
         void AddRenderEngine(_In_ IRenderEngine* const pEngine);
         void RemoveRenderEngine(_In_ IRenderEngine* const pEngine);
@@ -96,11 +97,22 @@ namespace Microsoft::Console::Render
         static GridLineSet s_GetGridlines(const TextAttribute& textAttribute) noexcept;
         static bool s_IsSoftFontChar(const std::wstring_view& v, const size_t firstSoftFontChar, const size_t lastSoftFontChar);
 
+        // The parts of a frame that are identical for all engines. They're computed
+        // once per frame under the console lock, before any engine starts painting.
+        struct FrameState
+        {
+            std::optional<CursorOptions> cursorInfo;
+            std::vector<til::rect> selectionRects;
+            std::vector<til::rect> searchSelectionRects;
+        };
+
         [[nodiscard]] HRESULT _PaintFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept;
+        [[nodiscard]] HRESULT _PaintFrameForEngines(const std::span<IRenderEngine*> engines) noexcept;
+        [[nodiscard]] HRESULT _PaintFrameContents(_In_ IRenderEngine* const pEngine) noexcept;
         bool _CheckViewportAndScroll();
         [[nodiscard]] HRESULT _PaintBackground(_In_ IRenderEngine* const pEngine);
         void _PaintBufferOutput(_In_ IRenderEngine* const pEngine);
-        void _PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine, TextBufferCellIterator it, const til::point target, const bool lineWrapped);
+        void _PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine, const ROW& row, const til::CoordType columnBegin, til::CoordType columnEnd, const til::point target, const bool lineWrapped);
         void _PaintBufferOutputGridLineHelper(_In_ IRenderEngine* const pEngine, const TextAttribute textAttribute, const size_t cchLine, const til::point coordTarget);
         bool _isHoveredHyperlink(const TextAttribute& textAttribute) const noexcept;
         void _PaintSelection(_In_ IRenderEngine* const pEngine);
@@ -112,6 +124,7 @@ namespace Microsoft::Console::Render
         std::vector<til::rect> _GetSelectionRects() const;
         std::vector<til::rect> _GetSearchSelectionRects() const;
         void _ScrollPreviousSelection(const til::point delta);
+        void _NotifyScroll(const til::CoordType deltaY) noexcept;
         [[nodiscard]] HRESULT _PaintTitle(IRenderEngine* const pEngine);
         bool _isInHoveredInterval(til::point coordTarget) const noexcept;
         [[nodiscard]] std::optional<CursorOptions> _GetCursorInfo();
@@ -129,6 +142,7 @@ namespace Microsoft::Console::Render
         std::vector<Cluster> _clusterBuffer;
         std::vector<til::rect> _previousSelection;
         std::vector<til::rect> _previousSearchSelection;
+        FrameState _frameState;
         std::function<void()> _pfnBackgroundColorChanged;
         std::function<void()> _pfnFrameColorChanged;
         std::function<void()> _pfnRendererEnteredErrorState;
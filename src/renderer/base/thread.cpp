@@ -213,9 +213,35 @@ DWORD WINAPI RenderThread::_ThreadProc()
             ResetEvent(_hEvent);
         }
 
+        // Give the output a chance to accumulate if we painted only just now.
+        // We don't delay the final frame during shutdown.
+        if (_fKeepRunning)
+        {
+            const auto scrolling = _rowsScrolled.load(std::memory_order_relaxed) != 0;
+            const auto delay = _pacer.Delay(FramePacer::clock::now(), scrolling);
+            if (delay > FramePacer::clock::duration::zero())
+            {
+                Sleep(gsl::narrow_cast<DWORD>(std::chrono::ceil<std::chrono::milliseconds>(delay).count()));
+
+                // Any frame requested in the meantime is covered by the one we're about to paint.
+                _fNextFrameRequested.store(false, std::memory_order_relaxed);
+
+                // Painting might have been disabled while we were sleeping.
+                WaitForSingleObject(_hPaintEnabledEvent, INFINITE);
+            }
+        }
+
+        _pacer.FrameStarted(FramePacer::clock::now(), _rowsScrolled.exchange(0, std::memory_order_relaxed), _viewportHeight.load(std::memory_order_relaxed));
+
         ResetEvent(_hPaintCompletedEvent);
         LOG_IF_FAILED(_pRenderer->PaintFrame());
         SetEvent(_hPaintCompletedEvent);
+
+        _pacer.FrameFinished(FramePacer::clock::now());
+        {
+            const std::lock_guard lock{ _statsLock };
+            _stats = _pacer.Stats();
+        }
     }
 
     return S_OK;
@@ -233,6 +259,18 @@ void RenderThread::NotifyPaint() noexcept
     }
 }
 
+// Method Description:
+// - Informs the frame pacer that the viewport scrolled, so that it can skip frames
+//   when the output scrolls by faster than anyone could read it.
+// Arguments:
+// - rows - the number of rows the viewport scrolled by
+// - viewportHeight - the height of the viewport in rows
+void RenderThread::NotifyScroll(const til::CoordType rows, const til::CoordType viewportHeight) noexcept
+{
+    _rowsScrolled.fetch_add(rows, std::memory_order_relaxed);
+    _viewportHeight.store(viewportHeight, std::memory_order_relaxed);
+}
+
 void RenderThread::EnablePainting() noexcept
 {
     SetEvent(_hPaintEnabledEvent);
@@ -299,3 +337,100 @@ void RenderThread::WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) noe
     ResetEvent(_hPaintEnabledEvent);
     WaitForSingleObject(_hPaintCompletedEvent, dwTimeoutMs);
 }
+
+// Method Description:
+// - Returns the frame timing statistics collected since the thread started.
+FrameStats RenderThread::GetFrameStats() const
+{
+    const std::lock_guard lock{ _statsLock };
+    return _stats;
+}
+
+// Method Description:
+// - Returns how long the render thread should wait before painting the next frame.
+// Arguments:
+// - now - the current time
+// - scrolling - true if the viewport scrolled since the last frame
+// Return Value:
+// - The time to wait. Zero if the frame should be painted right away.
+FramePacer::clock::duration FramePacer::Delay(const clock::time_point now, const bool scrolling) const noexcept
+{
+    // After a period of inactivity we paint right away, because the frame was most
+    // likely caused by user input (like a key press) and latency matters most then.
+    if (!_hasPainted || now - _frameEnd >= maxInterval)
+    {
+        return clock::duration::zero();
+    }
+
+    // The back-off only applies as long as the output is still scrolling. Otherwise,
+    // a key press right after a flood of output would have to wait for it to expire.
+    const auto next = _frameStart + (scrolling ? _throttledInterval : _interval);
+    return next > now ? next - now : clock::duration::zero();
+}
+
+// Method Description:
+// - Called right before a frame is painted.
+// Arguments:
+// - now - the current time
+// - rowsScrolled - the number of rows the viewport scrolled since the last frame
+// - viewportHeight - the height of the viewport in rows
+void FramePacer::FrameStarted(const clock::time_point now, const til::CoordType rowsScrolled, const til::CoordType viewportHeight) noexcept
+{
+    if (_hasPainted)
+    {
+        _stats.frameTime.at(_bucket(now - _frameStart))++;
+    }
+
+    // A pause in the output ends any back-off. The next flood starts over at the regular interval.
+    if (_hasPainted && now - _frameEnd >= maxInterval)
+    {
+        _throttledInterval = _interval;
+    }
+
+    // If more than a page scrolled by since the last frame, nobody can read the output anyway.
+    _throttled = viewportHeight > 0 && rowsScrolled >= viewportHeight;
+    _frameStart = now;
+}
+
+// Method Description:
+// - Called right after a frame was painted. Updates the paint cost and the frame interval.
+// Arguments:
+// - now - the current time
+void FramePacer::FrameFinished(const clock::time_point now) noexcept
+{
+    const auto paintTime = std::chrono::duration_cast<std::chrono::microseconds>(now - _frameStart);
+
+    // An exponential moving average smooths over the occasional outlier (e.g. a full redraw).
+    _averagePaintTime = _hasPainted ? _averagePaintTime + (paintTime - _averagePaintTime) / 8 : paintTime;
+    _hasPainted = true;
+    _frameEnd = now;
+
+    // Painting holds the console lock. Spending at most half of the time on it
+    // ensures that the VT parser gets to run at least as much as we do.
+    _interval = std::clamp(2 * _averagePaintTime, minInterval, maxInterval);
+
+    // While the output scrolls faster than it's readable, intermediate frames only slow it
+    // down. We back off exponentially, and return to the regular interval once it calms down.
+    _throttledInterval = _throttled ? std::clamp(2 * _throttledInterval, _interval, maxInterval) : _interval;
+
+    _stats.paintTime.at(_bucket(paintTime))++;
+    _stats.framesPainted++;
+    if (_throttled)
+    {
+        _stats.framesThrottled++;
+    }
+    _stats.averagePaintTime = _averagePaintTime;
+    _stats.frameInterval = _throttledInterval;
+}
+
+const FrameStats& FramePacer::Stats() const noexcept
+{
+    return _stats;
+}
+
+size_t FramePacer::_bucket(const clock::duration duration) noexcept
+{
+    const auto ms = std::chrono::ceil<std::chrono::milliseconds>(duration).count();
+    const auto it = std::lower_bound(FrameStats::bucketBounds.begin(), FrameStats::bucketBounds.end(), ms);
+    return gsl::narrow_cast<size_t>(it - FrameStats::bucketBounds.begin());
+}
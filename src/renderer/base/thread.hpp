@@ -18,6 +18,58 @@ namespace Microsoft::Console::Render
 {
     class Renderer;
 
+    // A snapshot of the render thread's frame timing.
+    struct FrameStats
+    {
+        // Inclusive upper bounds of the histogram buckets in milliseconds.
+        // The last bucket counts everything above the last bound.
+        static constexpr std::array<uint32_t, 8> bucketBounds{ 1, 2, 4, 8, 16, 33, 66, 100 };
+        using Histogram = std::array<uint64_t, bucketBounds.size() + 1>;
+
+        // How long PaintFrame() took.
+        Histogram paintTime{};
+        // The time between the start of two consecutive frames.
+        Histogram frameTime{};
+        uint64_t framesPainted = 0;
+        // Frames that were postponed beyond the regular interval because the
+        // buffer was scrolling faster than anyone could've read it.
+        uint64_t framesThrottled = 0;
+        std::chrono::microseconds averagePaintTime{};
+        // The current interval, including any back-off while the output scrolls.
+        std::chrono::microseconds frameInterval{};
+    };
+
+    // Decides when the render thread paints the next frame. It aims to spend no more than
+    // half of the time painting (since painting holds the console lock and blocks the
+    // parser), and stretches the interval when output scrolls by faster than it's readable.
+    class FramePacer
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        static constexpr std::chrono::microseconds minInterval{ 4000 };
+        static constexpr std::chrono::microseconds maxInterval{ 100000 };
+
+        clock::duration Delay(clock::time_point now, bool scrolling) const noexcept;
+        void FrameStarted(clock::time_point now, til::CoordType rowsScrolled, til::CoordType viewportHeight) noexcept;
+        void FrameFinished(clock::time_point now) noexcept;
+        const FrameStats& Stats() const noexcept;
+
+    private:
+        static size_t _bucket(clock::duration duration) noexcept;
+
+        clock::time_point _frameStart{};
+        clock::time_point _frameEnd{};
+        std::chrono::microseconds _averagePaintTime{};
+        // The interval derived from the paint cost alone.
+        std::chrono::microseconds _interval{ minInterval };
+        // The interval while the output keeps scrolling faster than it's readable.
+        std::chrono::microseconds _throttledInterval{ minInterval };
+        bool _throttled = false;
+        bool _hasPainted = false;
+        FrameStats _stats;
+    };
+
     class RenderThread
     {
     public:
@@ -27,9 +79,11 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT Initialize(Renderer* const pRendererParent) noexcept;
 
         void NotifyPaint() noexcept;
+        void NotifyScroll(const til::CoordType rows, const til::CoordType viewportHeight) noexcept;
         void EnablePainting() noexcept;
         void DisablePainting() noexcept;
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) noexcept;
+        FrameStats GetFrameStats() const;
 
     private:
         static DWORD WINAPI s_ThreadProc(_In_ LPVOID lpParameter);
@@ -46,5 +100,12 @@ namespace Microsoft::Console::Render
         bool _fKeepRunning;
         std::atomic<bool> _fNextFrameRequested;
         std::atomic<bool> _fWaiting;
+
+        std::atomic<til::CoordType> _rowsScrolled{ 0 };
+        std::atomic<til::CoordType> _viewportHeight{ 0 };
+
+        FramePacer _pacer;
+        mutable std::mutex _statsLock;
+        FrameStats _stats;
     };
 }
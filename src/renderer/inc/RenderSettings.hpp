@@ -28,6 +28,12 @@ namespace Microsoft::Console::Render
             ScreenReversed
         };
 
+        struct ColorCacheStats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+        };
+
         RenderSettings() noexcept;
         void SetRenderMode(const Mode mode, const bool enabled) noexcept;
         bool GetRenderMode(const Mode mode) const noexcept;
@@ -43,13 +49,28 @@ namespace Microsoft::Console::Render
         std::pair<COLORREF, COLORREF> GetAttributeColorsWithAlpha(const TextAttribute& attr) const noexcept;
         COLORREF GetAttributeUnderlineColor(const TextAttribute& attr) const noexcept;
         void ToggleBlinkRendition(class Renderer& renderer) noexcept;
+        ColorCacheStats GetColorCacheStats() const noexcept;
 
     private:
+        // A direct-mapped cache of ColorFix::GetPerceivableColor() results. Since it's keyed by the
+        // resolved colors, it doesn't need to be invalidated when the color table or modes change.
+        // Like _blinkIsInUse it's updated by const getters, which are called under the console lock.
+        struct PerceivableColorCacheEntry
+        {
+            COLORREF color = INVALID_COLOR;
+            COLORREF reference = INVALID_COLOR;
+            COLORREF result = INVALID_COLOR;
+        };
+
+        COLORREF _getPerceivableColor(const COLORREF color, const COLORREF reference) const noexcept;
+
         til::enumset<Mode> _renderMode{ Mode::BlinkAllowed, Mode::IntenseIsBright };
         std::array<COLORREF, TextColor::TABLE_SIZE> _colorTable;
         std::array<size_t, static_cast<size_t>(ColorAlias::ENUM_COUNT)> _colorAliasIndices;
         size_t _blinkCycle = 0;
         mutable bool _blinkIsInUse = false;
         bool _blinkShouldBeFaint = false;
+        mutable std::array<PerceivableColorCacheEntry, 64> _perceivableColorCache;
+        mutable ColorCacheStats _colorCacheStats;
     };
 }
@@ -10,6 +10,11 @@
 using namespace Microsoft::Console::Render;
 using namespace Microsoft::Console::Types;
 
+// The speech API is limited to 1000 characters at a time.
+static constexpr size_t sapiLimit{ 1000 };
+// We always keep at least this much of the new output, even if the viewport is tiny.
+static constexpr size_t minNewOutputLimit{ 4 * sapiLimit };
+
 // Routine Description:
 // - Constructs a UIA engine for console text
 //   which primarily notifies automation clients of any activity
@@ -22,6 +27,7 @@ UiaEngine::UiaEngine(IUiaEventDispatcher* dispatcher) :
     _isEnabled{ true },
     _prevSelection{},
     _prevCursorRegion{},
+    _newOutputLimit{ minNewOutputLimit },
     RenderEngineBase()
 {
 }
@@ -56,6 +62,13 @@ UiaEngine::UiaEngine(IUiaEventDispatcher* dispatcher) :
     return S_OK;
 }
 
+// Routine Description:
+// - Returns how many new-output notifications were merged and how much of their text was dropped so far.
+UiaEngine::OutputNotificationStats UiaEngine::GetOutputNotificationStats() const noexcept
+{
+    return _outputStats;
+}
+
 // Routine Description:
 // - Notifies us that the console has changed the character region specified.
 // - NOTE: This typically triggers on cursor or text buffer changes
@@ -183,14 +196,48 @@ try
 
     if (!newText.empty())
     {
+        if (!_newOutput.empty())
+        {
+            _outputStats.mergedNotifications++;
+        }
+
         _newOutput.append(newText);
         _newOutput.push_back(L'\n');
         _textBufferChanged = true;
+
+        // During a flood of output we only trim occasionally, so that this stays amortized O(1).
+        if (_newOutput.size() > 2 * _newOutputLimit)
+        {
+            _trimNewOutput(_newOutputLimit);
+        }
     }
     return S_OK;
 }
 CATCH_LOG_RETURN_HR(E_FAIL);
 
+// Routine Description:
+// - Drops the oldest text in _newOutput, such that at most `limit` characters remain.
+//   Whatever we drop has scrolled out of the viewport already and reading it out is pointless.
+//   If possible the cut is made at a line break, so that we don't start reading mid-line.
+// Arguments:
+// - limit - the maximum number of characters to keep
+void UiaEngine::_trimNewOutput(const size_t limit)
+{
+    if (_newOutput.size() <= limit)
+    {
+        return;
+    }
+
+    auto cut = _newOutput.size() - limit;
+    if (const auto nl = _newOutput.find(L'\n', cut - 1); nl != std::wstring::npos && nl + 1 < _newOutput.size())
+    {
+        cut = nl + 1;
+    }
+
+    _outputStats.droppedCharacters += cut;
+    _newOutput.erase(0, cut);
+}
+
 // Routine Description:
 // - This is unused by this renderer.
 // Arguments:
@@ -240,14 +287,18 @@ CATCH_LOG_RETURN_HR(E_FAIL);
     // so present can work on the copy while another
     // thread might start filling the next "frame"
     // worth of text data.
+    try
+    {
+        _trimNewOutput(_newOutputLimit);
+    }
+    CATCH_LOG();
     std::swap(_queuedOutput, _newOutput);
     _newOutput.clear();
     return S_OK;
 }
 
-// RenderEngineBase defines a WaitUntilCanRender() that sleeps for 8ms to throttle rendering.
-// But UiaEngine is never the only engine running. Overriding this function prevents
-// us from sleeping 16ms per frame, when the other engine also sleeps for 8ms.
+// UiaEngine is never the only engine running and never needs to wait for the display.
+// The render thread's frame pacing applies to all engines at once.
 void UiaEngine::WaitUntilCanRender() noexcept
 {
 }
@@ -291,14 +342,21 @@ void UiaEngine::WaitUntilCanRender() noexcept
     }
     try
     {
-        // The speech API is limited to 1000 characters at a time.
-        // Break up the output into 1000 character chunks to ensure
-        // the output isn't cut off.
-        static constexpr size_t sapiLimit{ 1000 };
-        const std::wstring_view output{ _queuedOutput };
-        for (size_t offset = 0; offset < output.size(); offset += sapiLimit)
+        // Break up the output into chunks the speech API can handle to ensure
+        // the output isn't cut off. Where possible we break at the end of a line.
+        std::wstring_view output{ _queuedOutput };
+        while (!output.empty())
         {
-            _dispatcher->NotifyNewOutput(output.substr(offset, sapiLimit));
+            auto chunkLength = std::min(output.size(), sapiLimit);
+            if (chunkLength < output.size())
+            {
+                if (const auto nl = output.find_last_of(L'\n', chunkLength - 1); nl != std::wstring_view::npos)
+                {
+                    chunkLength = nl + 1;
+                }
+            }
+            _dispatcher->NotifyNewOutput(output.substr(0, chunkLength));
+            output = output.substr(chunkLength);
         }
     }
     CATCH_LOG();
@@ -453,8 +511,13 @@ void UiaEngine::WaitUntilCanRender() noexcept
 // - srNewViewport - The bounds of the new viewport.
 // Return Value:
 // - HRESULT S_OK
-[[nodiscard]] HRESULT UiaEngine::UpdateViewport(const til::inclusive_rect& /*srNewViewport*/) noexcept
+[[nodiscard]] HRESULT UiaEngine::UpdateViewport(const til::inclusive_rect& srNewViewport) noexcept
 {
+    // Anything beyond what fits into the viewport (plus a newline per row)
+    // has scrolled away by the time we announce it. See _trimNewOutput().
+    const auto width = gsl::narrow_cast<size_t>(std::max(0, srNewViewport.right - srNewViewport.left + 1));
+    const auto height = gsl::narrow_cast<size_t>(std::max(0, srNewViewport.bottom - srNewViewport.top + 1));
+    _newOutputLimit = std::max(minNewOutputLimit, (width + 1) * height);
     return S_FALSE;
 }
 
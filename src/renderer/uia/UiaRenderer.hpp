@@ -25,6 +25,15 @@ namespace Microsoft::Console::Render
     class UiaEngine final : public RenderEngineBase
     {
     public:
+        // Counts how much of the new-output text was condensed before being handed to the dispatcher.
+        struct OutputNotificationStats
+        {
+            // Notifications that were combined with earlier ones into a single batch.
+            uint64_t mergedNotifications = 0;
+            // Characters that were never announced, because they scrolled out of the viewport.
+            uint64_t droppedCharacters = 0;
+        };
+
         UiaEngine(Microsoft::Console::Types::IUiaEventDispatcher* dispatcher);
 
         // Only one UiaEngine may present information at a time.
@@ -32,6 +41,7 @@ namespace Microsoft::Console::Render
         // by events when there are multiple TermControls
         [[nodiscard]] HRESULT Enable() noexcept;
         [[nodiscard]] HRESULT Disable() noexcept;
+        OutputNotificationStats GetOutputNotificationStats() const noexcept;
 
         // IRenderEngine Members
         [[nodiscard]] HRESULT StartPaint() noexcept override;
@@ -66,6 +76,8 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _DoUpdateTitle(const std::wstring_view newTitle) noexcept override;
 
     private:
+        void _trimNewOutput(size_t limit);
+
         bool _isEnabled;
         bool _isPainting;
         bool _selectionChanged;
@@ -73,6 +85,9 @@ namespace Microsoft::Console::Render
         bool _cursorChanged;
         std::wstring _newOutput;
         std::wstring _queuedOutput;
+        // Text beyond this length has scrolled out of the viewport by the time we get to announce it.
+        size_t _newOutputLimit;
+        OutputNotificationStats _outputStats;
 
         Microsoft::Console::Types::IUiaEventDispatcher* _dispatcher;
 
@@ -7,24 +7,33 @@
 
 #include "ApiDispatchers.h"
 
+#include "../host/handle.h"
 #include "../host/tracing.hpp"
 
 #define CONSOLE_API_STRUCT(Routine, Struct, TraceName) \
     {                                                  \
-        Routine, sizeof(Struct), TraceName             \
+        Routine, sizeof(Struct), TraceName, false      \
     }
 #define CONSOLE_API_NO_PARAMETER(Routine, TraceName) \
     {                                                \
-        Routine, 0, TraceName                        \
+        Routine, 0, TraceName, false                 \
     }
 
-#define CONSOLE_API_DEPRECATED(Struct)                                    \
-    {                                                                     \
-        ApiDispatchers::ServerDeprecatedApi, sizeof(Struct), "Deprecated" \
+// Same as CONSOLE_API_STRUCT, but the entire dispatch (handle validation, reading the
+// input buffer, the API call itself and queuing waits) happens under a single acquisition
+// of the console lock. See ConsoleDispatchRequest.
+#define CONSOLE_API_STRUCT_LOCKED(Routine, Struct, TraceName) \
+    {                                                         \
+        Routine, sizeof(Struct), TraceName, true              \
     }
-#define CONSOLE_API_DEPRECATED_NO_PARAM()                    \
-    {                                                        \
-        ApiDispatchers::ServerDeprecatedApi, 0, "Deprecated" \
+
+#define CONSOLE_API_DEPRECATED(Struct)                                           \
+    {                                                                            \
+        ApiDispatchers::ServerDeprecatedApi, sizeof(Struct), "Deprecated", false \
+    }
+#define CONSOLE_API_DEPRECATED_NO_PARAM()                           \
+    {                                                               \
+        ApiDispatchers::ServerDeprecatedApi, 0, "Deprecated", false \
     }
 
 typedef struct _CONSOLE_API_DESCRIPTOR
@@ -32,6 +41,7 @@ typedef struct _CONSOLE_API_DESCRIPTOR
     PCONSOLE_API_ROUTINE Routine;
     ULONG RequiredSize;
     PCSTR TraceName;
+    bool DispatchLocked;
 } CONSOLE_API_DESCRIPTOR, *PCONSOLE_API_DESCRIPTOR;
 
 typedef struct _CONSOLE_API_LAYER_DESCRIPTOR
@@ -42,38 +52,38 @@ typedef struct _CONSOLE_API_LAYER_DESCRIPTOR
 
 const CONSOLE_API_DESCRIPTOR ConsoleApiLayer1[] = {
     CONSOLE_API_STRUCT(ApiDispatchers::ServerGetConsoleCP, CONSOLE_GETCP_MSG, "GetConsoleCP"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerGetConsoleMode, CONSOLE_MODE_MSG, "GetConsoleMode"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerGetConsoleMode, CONSOLE_MODE_MSG, "GetConsoleMode"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerSetConsoleMode, CONSOLE_MODE_MSG, "SetConsoleMode"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerGetNumberOfInputEvents, CONSOLE_GETNUMBEROFINPUTEVENTS_MSG, "GetNumberOfConsoleInputEvents"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerGetNumberOfInputEvents, CONSOLE_GETNUMBEROFINPUTEVENTS_MSG, "GetNumberOfConsoleInputEvents"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerGetConsoleInput, CONSOLE_GETCONSOLEINPUT_MSG, "GetConsoleInput"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerReadConsole, CONSOLE_READCONSOLE_MSG, "ReadConsole"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerWriteConsole, CONSOLE_WRITECONSOLE_MSG, "WriteConsole"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerWriteConsole, CONSOLE_WRITECONSOLE_MSG, "WriteConsole"),
     CONSOLE_API_DEPRECATED_NO_PARAM(), // ApiDispatchers::ServerConsoleNotifyLastClose
     CONSOLE_API_STRUCT(ApiDispatchers::ServerGetConsoleLangId, CONSOLE_LANGID_MSG, "GetConsoleLangId"),
     CONSOLE_API_DEPRECATED(CONSOLE_MAPBITMAP_MSG),
 };
 
 const CONSOLE_API_DESCRIPTOR ConsoleApiLayer2[] = {
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerFillConsoleOutput, CONSOLE_FILLCONSOLEOUTPUT_MSG, "FillConsoleOutput"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerFillConsoleOutput, CONSOLE_FILLCONSOLEOUTPUT_MSG, "FillConsoleOutput"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerGenerateConsoleCtrlEvent, CONSOLE_CTRLEVENT_MSG, "GenerateConsoleCtrlEvent"),
     CONSOLE_API_NO_PARAMETER(ApiDispatchers::ServerSetConsoleActiveScreenBuffer, "SetConsoleActiveScreenBuffer"),
     CONSOLE_API_NO_PARAMETER(ApiDispatchers::ServerFlushConsoleInputBuffer, "FlushConsoleInputBuffer"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerSetConsoleCP, CONSOLE_SETCP_MSG, "SetConsoleCP"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerGetConsoleCursorInfo, CONSOLE_GETCURSORINFO_MSG, "GetConsoleCursorInfo"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerSetConsoleCursorInfo, CONSOLE_SETCURSORINFO_MSG, "SetConsoleCursorInfo"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerGetConsoleScreenBufferInfo, CONSOLE_SCREENBUFFERINFO_MSG, "GetConsoleScreenBufferInfo"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerGetConsoleCursorInfo, CONSOLE_GETCURSORINFO_MSG, "GetConsoleCursorInfo"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerSetConsoleCursorInfo, CONSOLE_SETCURSORINFO_MSG, "SetConsoleCursorInfo"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerGetConsoleScreenBufferInfo, CONSOLE_SCREENBUFFERINFO_MSG, "GetConsoleScreenBufferInfo"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerSetConsoleScreenBufferInfo, CONSOLE_SCREENBUFFERINFO_MSG, "SetConsoleScreenBufferInfo"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerSetConsoleScreenBufferSize, CONSOLE_SETSCREENBUFFERSIZE_MSG, "SetConsoleScreenBufferSize"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerSetConsoleCursorPosition, CONSOLE_SETCURSORPOSITION_MSG, "SetConsoleCursorPosition"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerSetConsoleCursorPosition, CONSOLE_SETCURSORPOSITION_MSG, "SetConsoleCursorPosition"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerGetLargestConsoleWindowSize, CONSOLE_GETLARGESTWINDOWSIZE_MSG, "GetLargestConsoleWindowSize"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerScrollConsoleScreenBuffer, CONSOLE_SCROLLSCREENBUFFER_MSG, "ScrollConsoleScreenBuffer"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerSetConsoleTextAttribute, CONSOLE_SETTEXTATTRIBUTE_MSG, "SetConsoleTextAttribute"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerScrollConsoleScreenBuffer, CONSOLE_SCROLLSCREENBUFFER_MSG, "ScrollConsoleScreenBuffer"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerSetConsoleTextAttribute, CONSOLE_SETTEXTATTRIBUTE_MSG, "SetConsoleTextAttribute"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerSetConsoleWindowInfo, CONSOLE_SETWINDOWINFO_MSG, "SetConsoleWindowInfo"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerReadConsoleOutputString, CONSOLE_READCONSOLEOUTPUTSTRING_MSG, "ReadConsoleOutputString"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerReadConsoleOutputString, CONSOLE_READCONSOLEOUTPUTSTRING_MSG, "ReadConsoleOutputString"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerWriteConsoleInput, CONSOLE_WRITECONSOLEINPUT_MSG, "WriteConsoleInput"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerWriteConsoleOutput, CONSOLE_WRITECONSOLEOUTPUT_MSG, "WriteConsoleOutput"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerWriteConsoleOutputString, CONSOLE_WRITECONSOLEOUTPUTSTRING_MSG, "WriteConsoleOutputString"),
-    CONSOLE_API_STRUCT(ApiDispatchers::ServerReadConsoleOutput, CONSOLE_READCONSOLEOUTPUT_MSG, "ReadConsoleOutput"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerWriteConsoleOutput, CONSOLE_WRITECONSOLEOUTPUT_MSG, "WriteConsoleOutput"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerWriteConsoleOutputString, CONSOLE_WRITECONSOLEOUTPUTSTRING_MSG, "WriteConsoleOutputString"),
+    CONSOLE_API_STRUCT_LOCKED(ApiDispatchers::ServerReadConsoleOutput, CONSOLE_READCONSOLEOUTPUT_MSG, "ReadConsoleOutput"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerGetConsoleTitle, CONSOLE_GETTITLE_MSG, "GetConsoleTitle"),
     CONSOLE_API_STRUCT(ApiDispatchers::ServerSetConsoleTitle, CONSOLE_SETTITLE_MSG, "SetConsoleTitle"),
 };
@@ -162,6 +172,27 @@ PCONSOLE_API_MSG ApiSorter::ConsoleDispatchRequest(_Inout_ PCONSOLE_API_MSG Mess
         return Message;
     }
 
+    // Chatty clients (think progress bars) call APIs like WriteConsoleW or SetConsoleCursorPosition
+    // in quick succession, and each of them would otherwise acquire and release the console lock
+    // multiple times during a single dispatch. For the APIs in the tables above that are marked as
+    // "locked" we hold the lock for the entire dispatch instead, turning the nested acquisitions into
+    // simple recursion count increments. This also ensures that the handle lookup and the API call
+    // observe the same state. APIs that make blocking cross-thread calls (for instance
+    // SetConsoleDisplayMode, which ends up calling SendMessage) must not be marked as such.
+    // Code that needs to release the lock during a locked dispatch (like DECPS playing a note
+    // during WriteConsole) must use CONSOLE_INFORMATION::SuspendLock() instead of UnlockConsole().
+    const auto dispatchLocked = Descriptor->DispatchLocked;
+    if (dispatchLocked)
+    {
+        LockConsole();
+    }
+    const auto unlock = wil::scope_exit([&]() noexcept {
+        if (dispatchLocked)
+        {
+            UnlockConsole();
+        }
+    });
+
     auto ReplyPending = FALSE;
     Message->Complete.Write.Data = &Message->u;
     Message->Complete.Write.Size = Message->msgHeader.ApiDescriptorSize;
@@ -6,8 +6,9 @@
 
 using namespace Microsoft::Console::VirtualTerminal;
 
-FontBuffer::FontBuffer() noexcept
+FontBuffer::FontBuffer()
 {
+    _pendingSixelData.reserve(MAX_PENDING_DATA);
     SetEraseControl(DispatchTypes::DrcsEraseControl::AllRenditions);
 };
 
@@ -172,37 +173,41 @@ bool FontBuffer::SetStartChar(const VTParameter startChar,
     _charsetIdInitialized = false;
     _charsetIdBuilder.Clear();
 
+    // Any data left over from a previous sequence that was never finalized
+    // must be discarded, so it doesn't end up in the new font.
+    _pendingSixelData.clear();
+
     return true;
 }
 
 void FontBuffer::AddSixelData(const wchar_t ch)
 {
-    if (!_charsetIdInitialized)
-    {
-        _buildCharsetId(ch);
-    }
-    else if (ch >= L'?' && ch <= L'~')
-    {
-        _addSixelValue(ch - L'?');
-    }
-    else if (ch == L'/')
-    {
-        _endOfSixelLine();
-    }
-    else if (ch == L';')
+    // The data arrives one character at a time, but the decoder is a lot more
+    // efficient when given longer runs, so we buffer it until we have enough.
+    _pendingSixelData.push_back(ch);
+    if (_pendingSixelData.size() >= MAX_PENDING_DATA)
     {
-        _endOfCharacter();
+        _flushPendingSixelData();
     }
 }
 
+void FontBuffer::AddSixelData(const std::wstring_view data)
+{
+    _flushPendingSixelData();
+    _decodeSixelData(data);
+}
+
 bool FontBuffer::FinalizeSixelData()
 {
+    _flushPendingSixelData();
+
     // If the charset ID hasn't been initialized this isn't a valid update.
     RETURN_BOOL_IF_FALSE(_charsetIdInitialized);
 
     // Flush the current line to make sure we take all the used positions
     // into account when calculating the font dimensions.
     _endOfSixelLine();
+    _storeCharacterBitPattern();
 
     // If the buffer has been cleared, we'll need to recalculate the dimensions
     // using the latest attributes, adjust the character bit patterns to fit
@@ -298,8 +303,7 @@ void FontBuffer::_prepareNextCharacter()
 {
     _lastChar = _currentChar;
     _currentCharBuffer = std::next(_buffer.begin(), gsl::narrow_cast<size_t>(_currentChar * _fullHeight));
-    _sixelColumn = 0;
-    _sixelRow = 0;
+    _sixelDecoder.Clear();
 
     // If the buffer hasn't been cleared, we'll need to clear each character
     // position individually, before adding any new sixel data.
@@ -309,43 +313,83 @@ void FontBuffer::_prepareNextCharacter()
     }
 }
 
-void FontBuffer::_addSixelValue(const VTInt value) noexcept
+void FontBuffer::_flushPendingSixelData()
+{
+    _decodeSixelData(_pendingSixelData);
+    _pendingSixelData.clear();
+}
+
+void FontBuffer::_decodeSixelData(std::wstring_view data)
+{
+    while (!data.empty() && !_charsetIdInitialized)
+    {
+        _buildCharsetId(data.front());
+        data = data.substr(1);
+    }
+
+    // The decoder handles the sixel values, and stops on anything else, which
+    // leaves us to deal with the line and character separators. Anything that
+    // neither of us recognizes is simply ignored.
+    while (!data.empty())
+    {
+        data = data.substr(_sixelDecoder.Decode(data));
+        if (!data.empty())
+        {
+            const auto ch = data.front();
+            if (ch == L'/')
+            {
+                _endOfSixelLine();
+            }
+            else if (ch == L';')
+            {
+                _endOfCharacter();
+            }
+            data = data.substr(1);
+        }
+    }
+}
+
+void FontBuffer::_storeCharacterBitPattern() noexcept
 {
-    if (_currentChar < MAX_CHARS && _sixelColumn < _textWidth)
+    if (_currentChar < MAX_CHARS)
     {
-        // Each sixel updates six pixels of a single column, so we setup a bit
-        // mask for the column we want to update, and then set that bit in each
-        // row for which there is a corresponding "on" bit in the input value.
-        const auto outputColumnBit = (0x8000 >> (_sixelColumn + _textOffset));
+        // The decoder stores the leftmost pixel of each scanline in the least
+        // significant bit, while our bit patterns have it in the most significant
+        // bit, so the bits need to be reversed. Anything beyond the text width is
+        // masked out, and the result is then offset to match the text centering.
+        const auto textMask = (uint64_t{ 1 } << _textWidth) - 1;
         auto outputIterator = _currentCharBuffer;
-        auto inputValueMask = 1;
-        for (VTInt i = 0; i < 6 && _sixelRow + i < _fullHeight; i++)
+        for (size_t y = 0; y < gsl::narrow_cast<size_t>(_fullHeight); y++)
         {
-            *outputIterator |= (value & inputValueMask) ? outputColumnBit : 0;
+            auto bits = gsl::narrow_cast<uint32_t>(til::at(_sixelDecoder.GetScanline(y), 0) & textMask);
+            bits = ((bits >> 1) & 0x5555) | ((bits & 0x5555) << 1);
+            bits = ((bits >> 2) & 0x3333) | ((bits & 0x3333) << 2);
+            bits = ((bits >> 4) & 0x0F0F) | ((bits & 0x0F0F) << 4);
+            bits = ((bits >> 8) | (bits << 8)) & 0xFFFF;
+            *outputIterator |= gsl::narrow_cast<uint16_t>(bits >> _textOffset);
             ++outputIterator;
-            inputValueMask <<= 1;
         }
     }
-    _sixelColumn++;
 }
 
-void FontBuffer::_endOfSixelLine()
+void FontBuffer::_endOfSixelLine() noexcept
 {
-    // Move down six rows to the get to the next sixel position.
-    std::advance(_currentCharBuffer, 6);
-    _sixelRow += 6;
-
     // Keep track of the maximum width and height covered by the sixel data.
-    _usedWidth = std::max(_usedWidth, _sixelColumn);
-    _usedHeight = std::max(_usedHeight, _sixelRow);
-
-    // Reset the column number to the start of the next line.
-    _sixelColumn = 0;
+    // The column is clamped, since a repeat sequence can take it well beyond
+    // anything we could ever use.
+    const auto column = std::min<size_t>(_sixelDecoder.GetColumn(), MAX_WIDTH + 1);
+    _usedWidth = std::max(_usedWidth, gsl::narrow_cast<VTInt>(column));
+
+    // Move down six rows to get to the next sixel position.
+    _sixelDecoder.LineFeed();
+    const auto row = std::min<size_t>(_sixelDecoder.GetRow(), MAX_HEIGHT + 6);
+    _usedHeight = std::max(_usedHeight, gsl::narrow_cast<VTInt>(row));
 }
 
 void FontBuffer::_endOfCharacter()
 {
     _endOfSixelLine();
+    _storeCharacterBitPattern();
     _currentChar++;
     _prepareNextCharacter();
 }
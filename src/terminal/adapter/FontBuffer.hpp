@@ -12,13 +12,14 @@ Abstract:
 #pragma once
 
 #include "DispatchTypes.hpp"
+#include "SixelDecoder.hpp"
 
 namespace Microsoft::Console::VirtualTerminal
 {
     class FontBuffer
     {
     public:
-        FontBuffer() noexcept;
+        FontBuffer();
         ~FontBuffer() = default;
         bool SetEraseControl(const DispatchTypes::DrcsEraseControl eraseControl) noexcept;
         bool SetAttributes(const DispatchTypes::DrcsCellMatrix cellMatrix,
@@ -28,6 +29,7 @@ namespace Microsoft::Console::VirtualTerminal
         bool SetStartChar(const VTParameter startChar,
                           const DispatchTypes::CharsetSize charsetSize) noexcept;
         void AddSixelData(const wchar_t ch);
+        void AddSixelData(const std::wstring_view data);
         bool FinalizeSixelData();
 
         std::span<const uint16_t> GetBitPattern() const noexcept;
@@ -39,12 +41,15 @@ namespace Microsoft::Console::VirtualTerminal
         static constexpr VTInt MAX_WIDTH = 16;
         static constexpr VTInt MAX_HEIGHT = 32;
         static constexpr VTInt MAX_CHARS = 96;
+        static constexpr size_t MAX_PENDING_DATA = 4096;
 
         void _buildCharsetId(const wchar_t ch);
         void _prepareCharacterBuffer();
         void _prepareNextCharacter();
-        void _addSixelValue(const VTInt value) noexcept;
-        void _endOfSixelLine();
+        void _flushPendingSixelData();
+        void _decodeSixelData(std::wstring_view data);
+        void _storeCharacterBitPattern() noexcept;
+        void _endOfSixelLine() noexcept;
         void _endOfCharacter();
 
         std::tuple<VTInt, VTInt, VTInt> _calculateDimensions() const;
@@ -89,7 +94,7 @@ namespace Microsoft::Console::VirtualTerminal
         buffer_type _buffer;
         buffer_type::iterator _currentCharBuffer;
         bool _bufferCleared;
-        VTInt _sixelColumn;
-        VTInt _sixelRow;
+        SixelDecoder _sixelDecoder{ MAX_WIDTH, MAX_HEIGHT };
+        std::wstring _pendingSixelData;
     };
 }
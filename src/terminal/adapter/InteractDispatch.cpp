@@ -69,12 +69,7 @@ bool InteractDispatch::WriteString(const std::wstring_view string)
     {
         const auto codepage = _api.GetConsoleOutputCP();
         InputEventQueue keyEvents;
-
-        for (const auto& wch : string)
-        {
-            CharToKeyEvents(wch, codepage, keyEvents);
-        }
-
+        StringToKeyEvents(string, codepage, keyEvents);
         WriteInput(keyEvents);
     }
     return true;
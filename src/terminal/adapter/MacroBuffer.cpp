@@ -8,6 +8,159 @@
 
 using namespace Microsoft::Console::VirtualTerminal;
 
+// This is the engine used to record the actions dispatched while parsing a
+// macro. Anything that can't be replayed as a simple dispatch will mark the
+// macro as not compilable.
+class MacroBuffer::Compiler final : public IStateMachineEngine
+{
+public:
+    Compiler(CompiledMacro& compiledMacro) noexcept :
+        _compiledMacro{ compiledMacro }
+    {
+    }
+
+    void SetPosition(const size_t position) noexcept
+    {
+        _position = position;
+    }
+
+    bool Succeeded(const size_t macroLength) const noexcept
+    {
+        // If the last action wasn't triggered by the final character of the
+        // macro, it must have ended with an incomplete (or ignored) sequence,
+        // which would leave the state machine outside of the ground state.
+        return !_failed && _sourceOffset == macroLength;
+    }
+
+    bool EncounteredWin32InputModeSequence() const noexcept override
+    {
+        return false;
+    }
+
+    bool ActionExecute(const wchar_t wch) override
+    {
+        return _addToken(MacroToken::Type::Execute, {}, wch, 1);
+    }
+
+    bool ActionExecuteFromEscape(const wchar_t) noexcept override
+    {
+        return _fail();
+    }
+
+    bool ActionPrint(const wchar_t) override
+    {
+        // Consecutive characters are merged into a single print run.
+        auto& tokens = _compiledMacro.tokens;
+        if (!tokens.empty() && tokens.back().type == MacroToken::Type::Print && _sourceOffset == _position)
+        {
+            tokens.back().count++;
+            _sourceOffset = _position + 1;
+            return true;
+        }
+        return _addToken(MacroToken::Type::Print, {}, _position, 1);
+    }
+
+    bool ActionPrintString(const std::wstring_view) noexcept override
+    {
+        // We feed the state machine one character at a time, so we should
+        // never receive a print run. If we do, we can't tell where it started.
+        return _fail();
+    }
+
+    bool ActionPassThroughString(const std::wstring_view) noexcept override
+    {
+        return _fail();
+    }
+
+    bool ActionEscDispatch(const VTID id) override
+    {
+        return _addToken(MacroToken::Type::EscDispatch, id, 0, 0);
+    }
+
+    bool ActionVt52EscDispatch(const VTID, const VTParameters) noexcept override
+    {
+        return _fail();
+    }
+
+    bool ActionCsiDispatch(const VTID id, const VTParameters parameters) override
+    {
+        // A DECINVM can't be dispatched to the engine, because it would defer
+        // the invocation until the state machine completes another sequence.
+        // So we record it as a separate token that we can execute ourselves.
+        if (id == VTID("*z"))
+        {
+            const auto macroId = gsl::narrow_cast<size_t>(parameters.at(0).value_or(0));
+            return _addToken(MacroToken::Type::InvokeMacro, id, macroId, 0);
+        }
+
+        // The sub parameter ranges are stored in parallel with the parameters,
+        // and are relative to the start of the sequence's sub parameters.
+        auto& compiledMacro = _compiledMacro;
+        const auto offset = compiledMacro.parameters.size();
+        const auto subParameterOffset = compiledMacro.subParameters.size();
+        const auto count = parameters.empty() ? 0 : parameters.size();
+        for (size_t i = 0; i < count; i++)
+        {
+            const auto subParameters = std::span<const VTParameter>{ parameters.subParamsFor(i) };
+            const auto rangeStart = compiledMacro.subParameters.size() - subParameterOffset;
+            const auto rangeEnd = rangeStart + subParameters.size();
+            compiledMacro.parameters.push_back(parameters.at(i));
+            compiledMacro.subParameters.insert(compiledMacro.subParameters.end(), subParameters.begin(), subParameters.end());
+            compiledMacro.subParameterRanges.emplace_back(gsl::narrow_cast<BYTE>(rangeStart), gsl::narrow_cast<BYTE>(rangeEnd));
+        }
+        const auto subParameterCount = compiledMacro.subParameters.size() - subParameterOffset;
+        return _addToken(MacroToken::Type::CsiDispatch, id, offset, count, subParameterOffset, subParameterCount);
+    }
+
+    StringHandler ActionDcsDispatch(const VTID, const VTParameters) noexcept override
+    {
+        _fail();
+        return nullptr;
+    }
+
+    bool ActionClear() noexcept override
+    {
+        return true;
+    }
+
+    bool ActionIgnore() noexcept override
+    {
+        return true;
+    }
+
+    bool ActionOscDispatch(const size_t, const std::wstring_view) noexcept override
+    {
+        return _fail();
+    }
+
+    bool ActionSs3Dispatch(const wchar_t, const VTParameters) noexcept override
+    {
+        return _fail();
+    }
+
+private:
+    bool _addToken(const MacroToken::Type type, const VTID id, const size_t offset, const size_t count, const size_t subParameterOffset = 0, const size_t subParameterCount = 0)
+    {
+        // The source offset is the point in the macro text from which the
+        // remaining content would need to be parsed if we can't continue
+        // replaying tokens (e.g. if a sequence switches to VT52 mode).
+        _compiledMacro.tokens.push_back({ type, id, _sourceOffset, offset, count, subParameterOffset, subParameterCount });
+        _sourceOffset = _position + 1;
+        return true;
+    }
+
+    bool _fail() noexcept
+    {
+        _failed = true;
+        return true;
+    }
+
+    CompiledMacro& _compiledMacro;
+    size_t _position = 0;
+    size_t _sourceOffset = 0;
+    bool _failed = false;
+};
+
 size_t MacroBuffer::GetSpaceAvailable() const noexcept
 {
     return MAX_SPACE - _spaceUsed;
@@ -32,7 +185,7 @@ uint16_t MacroBuffer::CalculateChecksum() const noexcept
     return checksum;
 }
 
-void MacroBuffer::InvokeMacro(const size_t macroId, StateMachine& stateMachine)
+void MacroBuffer::InvokeMacro(const size_t macroId, StateMachine& stateMachine, const bool allowDirectDispatch)
 {
     if (macroId < _macros.size())
     {
@@ -53,7 +206,18 @@ void MacroBuffer::InvokeMacro(const size_t macroId, StateMachine& stateMachine)
                     _invokedSequenceLength = 0;
                 }
             });
-            stateMachine.ProcessString(macroSequence);
+            // Compiled macros can only be replayed if the state machine is in
+            // ANSI mode, since that's the mode in which they were parsed. And
+            // in conpty we need the original text, so any sequences that we
+            // don't handle can be passed through to the connected terminal.
+            if (allowDirectDispatch && stateMachine.GetParserMode(StateMachine::Mode::Ansi))
+            {
+                _dispatchCompiledMacro(macroId, stateMachine);
+            }
+            else
+            {
+                stateMachine.ProcessString(macroSequence);
+            }
         }
     }
 }
@@ -70,6 +234,9 @@ void MacroBuffer::ClearMacrosIfInUse()
         {
             std::fill(macro.begin(), macro.end(), AsciiChars::NUL);
         }
+        // Compiled macros can't be modified while they're being replayed,
+        // so we just set a flag to let the replay know it should stop.
+        _macrosCleared = true;
     }
 }
 
@@ -99,12 +266,17 @@ bool MacroBuffer::InitParser(const size_t macroId, const DispatchTypes::MacroDel
         {
         case DispatchTypes::MacroDeleteControl::DeleteId:
             _deleteMacro(_activeMacro());
+            til::at(_compiledMacros, macroId) = {};
             return true;
         case DispatchTypes::MacroDeleteControl::DeleteAll:
             for (auto& macro : _macros)
             {
                 _deleteMacro(macro);
             }
+            for (auto& compiledMacro : _compiledMacros)
+            {
+                compiledMacro = {};
+            }
             return true;
         default:
             return false;
@@ -268,3 +440,109 @@ bool MacroBuffer::_applyPendingRepeat()
     _repeatPending = false;
     return true;
 }
+
+const MacroBuffer::CompiledMacro& MacroBuffer::_compileMacro(const size_t macroId)
+{
+    auto& compiledMacro = til::at(_compiledMacros, macroId);
+    if (!compiledMacro.compiled)
+    {
+        const auto& macro = til::at(_macros, macroId);
+        compiledMacro = {};
+        compiledMacro.compiled = true;
+
+        // C1 controls are interpreted differently depending on the parser
+        // mode at the time of the invocation, so they can't be precompiled.
+        const auto isC1 = [](const auto ch) { return ch >= 0x80 && ch <= 0x9F; };
+        if (std::none_of(macro.begin(), macro.end(), isC1))
+        {
+            auto engine = std::make_unique<Compiler>(compiledMacro);
+            auto& compiler = *engine;
+            StateMachine compilerStateMachine{ std::move(engine) };
+            for (size_t i = 0; i < macro.length(); i++)
+            {
+                compiler.SetPosition(i);
+                compilerStateMachine.ProcessCharacter(til::at(macro, i));
+            }
+            compiledMacro.compilable = compiler.Succeeded(macro.length());
+        }
+
+        // There's no point holding on to the tokens if we can't use them.
+        if (!compiledMacro.compilable)
+        {
+            compiledMacro.tokens = {};
+            compiledMacro.parameters = {};
+            compiledMacro.subParameters = {};
+            compiledMacro.subParameterRanges = {};
+        }
+    }
+    return compiledMacro;
+}
+
+void MacroBuffer::_dispatchCompiledMacro(const size_t macroId, StateMachine& stateMachine)
+{
+    const auto& compiledMacro = _compileMacro(macroId);
+    const auto macroSequence = std::wstring_view{ til::at(_macros, macroId) };
+    if (!compiledMacro.compilable)
+    {
+        stateMachine.ProcessString(macroSequence);
+        return;
+    }
+
+    for (const auto& token : compiledMacro.tokens)
+    {
+        // If the macros were cleared by an RIS, there's nothing more to output.
+        if (_macrosCleared)
+        {
+            return;
+        }
+        // If the last sequence switched the parser into VT52 mode, the rest
+        // of the macro will need to be parsed again in the new mode.
+        if (!stateMachine.GetParserMode(StateMachine::Mode::Ansi))
+        {
+            stateMachine.ProcessString(macroSequence.substr(token.sourceOffset));
+            return;
+        }
+        _dispatchToken(macroId, compiledMacro, token, stateMachine);
+    }
+}
+
+void MacroBuffer::_dispatchToken(const size_t macroId, const CompiledMacro& compiledMacro, const MacroToken& token, StateMachine& stateMachine)
+try
+{
+    // As with the state machine, a failure in one action shouldn't prevent
+    // the rest of the macro from being executed, unless we're shutting down.
+    auto& engine = stateMachine.Engine();
+    switch (token.type)
+    {
+    case MacroToken::Type::Print:
+        engine.ActionPrintString(std::wstring_view{ til::at(_macros, macroId) }.substr(token.offset, token.count));
+        break;
+    case MacroToken::Type::Execute:
+        engine.ActionExecute(gsl::narrow_cast<wchar_t>(token.offset));
+        break;
+    case MacroToken::Type::EscDispatch:
+        engine.ActionEscDispatch(token.id);
+        break;
+    case MacroToken::Type::CsiDispatch:
+    {
+        const auto parameters = std::span{ compiledMacro.parameters }.subspan(token.offset, token.count);
+        const auto subParameters = std::span{ compiledMacro.subParameters }.subspan(token.subParameterOffset, token.subParameterCount);
+        const auto subParameterRanges = std::span{ compiledMacro.subParameterRanges }.subspan(token.offset, token.count);
+        engine.ActionCsiDispatch(token.id, { parameters, subParameters, subParameterRanges });
+        break;
+    }
+    case MacroToken::Type::InvokeMacro:
+        InvokeMacro(token.offset, stateMachine, true);
+        break;
+    default:
+        break;
+    }
+}
+catch (const StateMachine::ShutdownException&)
+{
+    throw;
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
+}
@@ -15,6 +15,7 @@ Abstract:
 #include <array>
 #include <bitset>
 #include <string>
+#include <vector>
 
 // fwdecl unittest classes
 #ifdef UNIT_TESTING
@@ -41,7 +42,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         size_t GetSpaceAvailable() const noexcept;
         uint16_t CalculateChecksum() const noexcept;
-        void InvokeMacro(const size_t macroId, StateMachine& stateMachine);
+        void InvokeMacro(const size_t macroId, StateMachine& stateMachine, const bool allowDirectDispatch);
         void ClearMacrosIfInUse();
         bool InitParser(const size_t macroId, const DispatchTypes::MacroDeleteControl deleteControl, const DispatchTypes::MacroEncoding encoding);
         bool ParseDefinition(const wchar_t ch);
@@ -53,6 +54,48 @@ namespace Microsoft::Console::VirtualTerminal
         void _deleteMacro(std::wstring& macro) noexcept;
         bool _applyPendingRepeat();
 
+        // The first time a macro is invoked, we run it through a separate state
+        // machine that records the actions it dispatches. Later invocations can
+        // then replay those actions directly against the engine, without the
+        // content having to be parsed again. Macros that contain anything we
+        // can't record (string sequences, C1 controls, incomplete sequences)
+        // are marked as not compilable, and are always replayed as text.
+        struct MacroToken
+        {
+            enum class Type : uint8_t
+            {
+                Print,
+                Execute,
+                EscDispatch,
+                CsiDispatch,
+                InvokeMacro
+            };
+
+            Type type;
+            VTID id;
+            size_t sourceOffset;
+            size_t offset;
+            size_t count;
+            size_t subParameterOffset;
+            size_t subParameterCount;
+        };
+
+        struct CompiledMacro
+        {
+            bool compiled = false;
+            bool compilable = false;
+            std::vector<MacroToken> tokens;
+            std::vector<VTParameter> parameters;
+            std::vector<VTParameter> subParameters;
+            std::vector<std::pair<BYTE, BYTE>> subParameterRanges;
+        };
+
+        class Compiler;
+
+        const CompiledMacro& _compileMacro(const size_t macroId);
+        void _dispatchCompiledMacro(const size_t macroId, StateMachine& stateMachine);
+        void _dispatchToken(const size_t macroId, const CompiledMacro& compiledMacro, const MacroToken& token, StateMachine& stateMachine);
+
         enum class State
         {
             ExpectingText,
@@ -67,6 +110,8 @@ namespace Microsoft::Console::VirtualTerminal
         size_t _repeatCount{ 0 };
         size_t _repeatStart{ 0 };
         std::array<std::wstring, 64> _macros;
+        std::array<CompiledMacro, 64> _compiledMacros;
+        bool _macrosCleared{ false };
         size_t _activeMacroId{ 0 };
         size_t _spaceUsed{ 0 };
         size_t _invokedDepth{ 0 };
@@ -0,0 +1,237 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "SixelDecoder.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+#pragma warning(disable : 26490) // Don't use reinterpret_cast (type.1).
+
+static constexpr bool _isSixel(const wchar_t ch) noexcept
+{
+    return ch >= L'?' && ch <= L'~';
+}
+
+// Each scanline of the bitmap is a sequence of 64-bit words holding one bit
+// per pixel, with the leftmost pixel in the least significant bit.
+SixelDecoder::SixelDecoder(const size_t width, const size_t height) :
+    _width{ width },
+    _height{ height },
+    _stride{ (width + 63) / 64 },
+    _bitmap(_stride * height)
+{
+}
+
+void SixelDecoder::Clear() noexcept
+{
+    std::fill(_bitmap.begin(), _bitmap.end(), uint64_t{ 0 });
+    _column = 0;
+    _row = 0;
+    _repeatPending = false;
+    _repeatCount = 0;
+}
+
+// Decodes as much of the given data as it can, and returns the number of
+// characters consumed. Decoding stops at the first character that isn't a
+// sixel, a repeat introducer, a graphics carriage return, or a graphics new
+// line, so the caller can deal with anything that's specific to its format.
+// A repeat sequence may be split across calls.
+size_t SixelDecoder::Decode(const std::wstring_view data) noexcept
+{
+    size_t i = 0;
+
+    while (i < data.size())
+    {
+        const auto ch = til::at(data, i);
+
+        if (_repeatPending)
+        {
+            if (ch >= L'0' && ch <= L'9')
+            {
+                _repeatCount = std::min(_repeatCount * 10 + (ch - L'0'), MAX_REPEAT_COUNT);
+                i++;
+                continue;
+            }
+
+            // Anything other than a sixel cancels the repeat, but is otherwise
+            // processed as usual. A repeat count of 0 is interpreted as 1.
+            _repeatPending = false;
+            if (_isSixel(ch))
+            {
+                _addRepeatedSixel(ch - L'?', std::max<size_t>(_repeatCount, 1));
+                i++;
+                continue;
+            }
+        }
+
+        if (_isSixel(ch))
+        {
+            auto runEnd = i + 1;
+            while (runEnd < data.size() && _isSixel(til::at(data, runEnd)))
+            {
+                runEnd++;
+            }
+            _addSixels(data.substr(i, runEnd - i));
+            i = runEnd;
+            continue;
+        }
+
+        switch (ch)
+        {
+        case L'!':
+            _repeatPending = true;
+            _repeatCount = 0;
+            break;
+        case L'$':
+            CarriageReturn();
+            break;
+        case L'-':
+            LineFeed();
+            break;
+        default:
+            return i;
+        }
+        i++;
+    }
+
+    return data.size();
+}
+
+void SixelDecoder::CarriageReturn() noexcept
+{
+    _column = 0;
+}
+
+void SixelDecoder::LineFeed() noexcept
+{
+    // Move down six rows to get to the next sixel band.
+    _column = 0;
+    _row += 6;
+}
+
+size_t SixelDecoder::GetColumn() const noexcept
+{
+    return _column;
+}
+
+size_t SixelDecoder::GetRow() const noexcept
+{
+    return _row;
+}
+
+std::span<const uint64_t> SixelDecoder::GetScanline(const size_t y) const noexcept
+{
+    return { _bitmap.data() + y * _stride, _stride };
+}
+
+void SixelDecoder::_addSixels(const std::wstring_view sixels) noexcept
+{
+    const auto column = _column;
+    _column += sixels.size();
+
+    // Anything beyond the bounds of the bitmap is discarded.
+    if (column >= _width || _row >= _height)
+    {
+        return;
+    }
+
+    const auto count = std::min(sixels.size(), _width - column);
+    const auto data = sixels.data();
+
+    // We process the sixels in blocks of 16, transposing each block of 16
+    // six-pixel columns into six 16-pixel scanline masks.
+    for (size_t i = 0; i < count; i += 16)
+    {
+        const auto blockSize = std::min<size_t>(count - i, 16);
+        std::array<uint16_t, 6> masks{};
+
+#if defined(TIL_SSE_INTRINSICS)
+        if (blockSize == 16)
+        {
+            // Narrow the 16 characters to bytes and subtract the sixel offset, leaving
+            // a 6-bit value in each byte. Shifting bit N of every byte into the byte's
+            // most significant bit then lets movemask collect it into scanline N.
+            // (The 16-bit shifts don't leak between bytes in a way that matters,
+            // since movemask only looks at bit 7 of each byte.)
+            const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 8));
+            const auto values = _mm_sub_epi8(_mm_packus_epi16(lo, hi), _mm_set1_epi8('?'));
+            masks[0] = gsl::narrow_cast<uint16_t>(_mm_movemask_epi8(_mm_slli_epi16(values, 7)));
+            masks[1] = gsl::narrow_cast<uint16_t>(_mm_movemask_epi8(_mm_slli_epi16(values, 6)));
+            masks[2] = gsl::narrow_cast<uint16_t>(_mm_movemask_epi8(_mm_slli_epi16(values, 5)));
+            masks[3] = gsl::narrow_cast<uint16_t>(_mm_movemask_epi8(_mm_slli_epi16(values, 4)));
+            masks[4] = gsl::narrow_cast<uint16_t>(_mm_movemask_epi8(_mm_slli_epi16(values, 3)));
+            masks[5] = gsl::narrow_cast<uint16_t>(_mm_movemask_epi8(_mm_slli_epi16(values, 2)));
+        }
+        else
+#endif
+        {
+            for (size_t j = 0; j < blockSize; j++)
+            {
+                const auto value = data[i + j] - L'?';
+                for (size_t bit = 0; bit < 6; bit++)
+                {
+                    til::at(masks, bit) |= gsl::narrow_cast<uint16_t>(((value >> bit) & 1) << j);
+                }
+            }
+        }
+
+        _orColumnMasks(masks, column + i);
+    }
+}
+
+void SixelDecoder::_addRepeatedSixel(const uint16_t value, const size_t count) noexcept
+{
+    const auto column = _column;
+    _column += count;
+
+    if (column >= _width || _row >= _height || value == 0)
+    {
+        return;
+    }
+
+    const auto endColumn = std::min(column + count, _width);
+    const auto rows = std::min<size_t>(6, _height - _row);
+
+    for (size_t bit = 0; bit < rows; bit++)
+    {
+        if ((value >> bit) & 1)
+        {
+            const auto scanline = _bitmap.data() + (_row + bit) * _stride;
+            for (auto x = column; x < endColumn;)
+            {
+                const auto shift = x % 64;
+                const auto length = std::min(64 - shift, endColumn - x);
+                const auto bits = length == 64 ? ~uint64_t{ 0 } : ((uint64_t{ 1 } << length) - 1) << shift;
+                scanline[x / 64] |= bits;
+                x += length;
+            }
+        }
+    }
+}
+
+void SixelDecoder::_orColumnMasks(const std::array<uint16_t, 6>& masks, const size_t column) noexcept
+{
+    const auto word = column / 64;
+    const auto shift = column % 64;
+    const auto rows = std::min<size_t>(6, _height - _row);
+
+    for (size_t bit = 0; bit < rows; bit++)
+    {
+        const uint64_t mask = til::at(masks, bit);
+        const auto scanline = _bitmap.data() + (_row + bit) * _stride + word;
+        scanline[0] |= mask << shift;
+        // A block may straddle two words. _addSixels() clips the block to the
+        // bitmap width, so if any bits spill over, the second word must exist.
+        // Conversely, a block clipped within the last word has nothing to spill.
+        if (shift > 48)
+        {
+            if (const auto spill = mask >> (64 - shift))
+            {
+                scanline[1] |= spill;
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- SixelDecoder.hpp
+
+Abstract:
+- This decodes sixel data into a monochrome bitmap. It isn't tied to any
+  particular cell size or purpose, so while it's currently used to construct
+  the DECDLD soft fonts in the FontBuffer, it could equally serve as the basis
+  for a sixel image layer (with one bitmap per color register, for example).
+--*/
+
+#pragma once
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    class SixelDecoder
+    {
+    public:
+        SixelDecoder(const size_t width, const size_t height);
+        void Clear() noexcept;
+        size_t Decode(const std::wstring_view data) noexcept;
+        void CarriageReturn() noexcept;
+        void LineFeed() noexcept;
+
+        size_t GetColumn() const noexcept;
+        size_t GetRow() const noexcept;
+        std::span<const uint64_t> GetScanline(const size_t y) const noexcept;
+
+    private:
+        static constexpr size_t MAX_REPEAT_COUNT = 32767;
+
+        void _addSixels(const std::wstring_view sixels) noexcept;
+        void _addRepeatedSixel(const uint16_t value, const size_t count) noexcept;
+        void _orColumnMasks(const std::array<uint16_t, 6>& masks, const size_t column) noexcept;
+
+        size_t _width;
+        size_t _height;
+        size_t _stride;
+        std::vector<uint64_t> _bitmap;
+        size_t _column = 0;
+        size_t _row = 0;
+        bool _repeatPending = false;
+        size_t _repeatCount = 0;
+    };
+}
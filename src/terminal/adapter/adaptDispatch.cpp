@@ -57,13 +57,8 @@ void AdaptDispatch::PrintString(const std::wstring_view string)
 {
     if (_termOutput.NeedToTranslate())
     {
-        std::wstring buffer;
-        buffer.reserve(string.size());
-        for (auto& wch : string)
-        {
-            buffer.push_back(_termOutput.TranslateKey(wch));
-        }
-        _WriteToBuffer(buffer);
+        _termOutput.TranslateString(string, _translationBuffer);
+        _WriteToBuffer(_translationBuffer);
     }
     else
     {
@@ -983,12 +978,35 @@ void AdaptDispatch::_ChangeRectAttributes(TextBuffer& textBuffer, const til::rec
 {
     if (changeRect)
     {
+        // The changes only depend on the existing attributes, so instead of modifying each
+        // cell individually, we can compute the new attributes once per run of the row
+        // and apply all of them with a single multi-range replace.
+        std::vector<til::rle_replacement<TextAttribute, uint16_t>> replacements;
+
         for (auto row = changeRect.top; row < changeRect.bottom; row++)
         {
             auto& rowBuffer = textBuffer.GetMutableRowByOffset(row);
-            for (auto col = changeRect.left; col < changeRect.right; col++)
+            til::CoordType runBegin = 0;
+
+            replacements.clear();
+
+            for (const auto& run : std::as_const(rowBuffer).Attributes().runs())
             {
-                auto attr = rowBuffer.GetAttrByColumn(col);
+                const auto runEnd = runBegin + run.length;
+                const auto col = std::max(runBegin, changeRect.left);
+                const auto colEnd = std::min(runEnd, changeRect.right);
+                runBegin = runEnd;
+
+                if (col >= colEnd)
+                {
+                    if (runEnd >= changeRect.right)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                auto attr = run.value;
                 auto characterAttributes = attr.GetCharacterAttributes();
                 characterAttributes &= changeOps.andAttrMask;
                 characterAttributes ^= changeOps.xorAttrMask;
@@ -1005,8 +1023,10 @@ void AdaptDispatch::_ChangeRectAttributes(TextBuffer& textBuffer, const til::rec
                 {
                     attr.SetUnderlineColor(*changeOps.underlineColor);
                 }
-                rowBuffer.ReplaceAttributes(col, col + 1, attr);
+                replacements.push_back({ gsl::narrow_cast<uint16_t>(col), gsl::narrow_cast<uint16_t>(colEnd), attr });
             }
+
+            rowBuffer.ReplaceAttributes(replacements);
         }
         textBuffer.TriggerRedraw(Viewport::FromExclusive(changeRect));
         _api.NotifyAccessibilityChange(changeRect);
@@ -4108,11 +4128,14 @@ bool AdaptDispatch::InvokeMacro(const VTInt macroId)
         // once it has finished processing the current operation, and
         // has returned to the ground state. Note that we're capturing
         // a copy of the _macroBuffer pointer here to make sure it won't
-        // be deleted (e.g. from an invoked RIS) while still in use.
+        // be deleted (e.g. from an invoked RIS) while still in use. In conpty
+        // the macro content has to be parsed as text, so that any sequences we
+        // don't handle can still be passed through to the connected terminal.
         const auto macroBuffer = _macroBuffer;
+        const auto allowDirectDispatch = !_api.IsConsolePty();
         auto& stateMachine = _api.GetStateMachine();
         stateMachine.OnCsiComplete([=, &stateMachine]() {
-            macroBuffer->InvokeMacro(macroId, stateMachine);
+            macroBuffer->InvokeMacro(macroId, stateMachine, allowDirectDispatch);
         });
     }
     return true;
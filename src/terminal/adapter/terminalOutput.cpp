@@ -29,6 +29,7 @@ TerminalOutput::TerminalOutput(const bool grEnabled) noexcept :
     _gsetIds.at(1) = VTID("B");
     _gsetIds.at(2) = grId;
     _gsetIds.at(3) = grId;
+    _UpdateTranslationTable();
 }
 
 void TerminalOutput::SoftReset() noexcept
@@ -127,6 +128,7 @@ bool TerminalOutput::LockingShift(const size_t gsetNumber)
     {
         _glTranslationTable = {};
     }
+    _UpdateTranslationTable();
     return true;
 }
 
@@ -140,6 +142,7 @@ bool TerminalOutput::LockingShiftRight(const size_t gsetNumber)
     {
         _grTranslationTable = {};
     }
+    _UpdateTranslationTable();
     return true;
 }
 
@@ -221,6 +224,132 @@ wchar_t TerminalOutput::TranslateKey(const wchar_t wch) const noexcept
     return wchFound;
 }
 
+#pragma warning(push)
+#pragma warning(disable : 26429) // Symbol '...' is never tested for nullness, it can be marked as not_null (f.23).
+#pragma warning(disable : 26472) // Don't use a static_cast for arithmetic conversions. Use brace initialization, gsl::narrow_cast or gsl::narrow (type.1).
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+#pragma warning(disable : 26490) // Don't use reinterpret_cast (type.1).
+
+[[msvc::forceinline]] static size_t findTranslatablePlain(const wchar_t* beg, const wchar_t* end, const wchar_t* it, const wchar_t min, const wchar_t range) noexcept
+{
+#pragma loop(no_vector)
+    for (; it < end && static_cast<wchar_t>(*it - min) >= range; ++it)
+    {
+    }
+    return it - beg;
+}
+
+// Returns the number of leading characters outside of [min, min + range),
+// all of which are guaranteed to map to themselves. range must not be 0.
+static size_t findTranslatable(const wchar_t* data, size_t count, const wchar_t min, const wchar_t range) noexcept
+{
+    // The following vectorized code replicates findTranslatablePlain, which checks for:
+    //   (wch - min) < range
+    // or rather its more SIMD friendly equivalent:
+    //   (wch - min) <= (range - 1)
+#if defined(TIL_SSE_INTRINSICS)
+
+    auto it = data;
+    const auto vecMin = _mm_set1_epi16(static_cast<short>(min));
+    const auto vecMax = _mm_set1_epi16(static_cast<short>(range - 1));
+    const auto z = _mm_setzero_si128();
+
+    for (const auto end = data + (count & ~size_t{ 7 }); it < end; it += 8)
+    {
+        const auto wch = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+        // As in the VT parser: a <= b is equivalent to "max(0, a - b) == 0", which is what "SubS" computes.
+        const auto a = _mm_subs_epu16(_mm_sub_epi16(wch, vecMin), vecMax);
+        const auto mask = _mm_movemask_epi8(_mm_cmpeq_epi16(a, z));
+
+        if (mask)
+        {
+            unsigned long offset;
+            _BitScanForward(&offset, mask);
+            it += offset / 2;
+            return it - data;
+        }
+    }
+
+    return findTranslatablePlain(data, data + count, it, min, range);
+
+#elif defined(TIL_ARM_NEON_INTRINSICS)
+
+    auto it = data;
+    uint64_t mask;
+
+    for (const auto end = data + (count & ~size_t{ 7 }); it < end;)
+    {
+        const auto wch = vld1q_u16(reinterpret_cast<const uint16_t*>(it));
+        const auto c = vcleq_u16(vsubq_u16(wch, vdupq_n_u16(min)), vdupq_n_u16(range - 1));
+
+        mask = vgetq_lane_u64(vreinterpretq_u64_u16(c), 0);
+        if (mask)
+        {
+            goto exitWithMask;
+        }
+        it += 4;
+
+        mask = vgetq_lane_u64(vreinterpretq_u64_u16(c), 1);
+        if (mask)
+        {
+            goto exitWithMask;
+        }
+        it += 4;
+    }
+
+    return findTranslatablePlain(data, data + count, it, min, range);
+
+exitWithMask:
+    unsigned long offset;
+    _BitScanForward64(&offset, mask);
+    it += offset / 16;
+    return it - data;
+
+#else
+
+    return findTranslatablePlain(data, data + count, data, min, range);
+
+#endif
+}
+
+// Routine Description:
+// - Translates an entire string, producing the same result as calling TranslateKey for each character.
+// Arguments:
+// - string - The text to translate.
+// - buffer - Receives the translated text. It's reused between calls to avoid allocations.
+void TerminalOutput::TranslateString(const std::wstring_view string, std::wstring& buffer) const
+{
+    buffer.resize(string.size());
+
+    auto in = string.data();
+    const auto end = in + string.size();
+    auto out = buffer.data();
+
+    // A single shift only applies to the first character.
+    if (_ssSetNumber != 0 && in != end)
+    {
+        *out++ = TranslateKey(*in++);
+    }
+
+    while (in != end)
+    {
+        // Copy the characters that map to themselves in bulk...
+        const auto count = gsl::narrow_cast<size_t>(end - in);
+        const auto identity = _translationRange ? findTranslatable(in, count, _translationMin, _translationRange) : count;
+        memcpy(out, in, identity * sizeof(wchar_t));
+        in += identity;
+        out += identity;
+
+        // ...and look up the ones that may not.
+        if (in != end)
+        {
+            *out++ = til::at(_translationTable, *in++);
+        }
+    }
+}
+
+#pragma warning(pop)
+
 const std::wstring_view TerminalOutput::_LookupTranslationTable94(const VTID charset) const
 {
     // Note that the DRCS set can be designated with either a 94 or 96 sequence,
@@ -358,3 +487,35 @@ void TerminalOutput::_ReplaceDrcsTable(const std::wstring_view oldTable, const s
         LockingShiftRight(_grSetNumber);
     }
 }
+
+// Routine Description:
+// - Flattens the current GL and GR translation tables into _translationTable,
+//   and determines the range of code units that may need translation.
+void TerminalOutput::_UpdateTranslationTable() noexcept
+{
+    size_t min = _translationTable.size();
+    size_t max = 0;
+
+    for (size_t wch = 0; wch < _translationTable.size(); wch++)
+    {
+        auto wchFound = gsl::narrow_cast<wchar_t>(wch);
+        if (wch - 0x20u < _glTranslationTable.size())
+        {
+            wchFound = til::at(_glTranslationTable, wch - 0x20u);
+        }
+        else if (wch - 0xA0u < _grTranslationTable.size())
+        {
+            wchFound = til::at(_grTranslationTable, wch - 0xA0u);
+        }
+        til::at(_translationTable, wch) = wchFound;
+
+        if (wchFound != wch)
+        {
+            min = std::min(min, wch);
+            max = wch;
+        }
+    }
+
+    _translationMin = gsl::narrow_cast<wchar_t>(min <= max ? min : 0);
+    _translationRange = gsl::narrow_cast<wchar_t>(min <= max ? max - min + 1 : 0);
+}
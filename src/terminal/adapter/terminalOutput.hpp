@@ -31,6 +31,7 @@ namespace Microsoft::Console::VirtualTerminal
         VTID GetUserPreferenceCharsetId() const noexcept;
         size_t GetUserPreferenceCharsetSize() const noexcept;
         wchar_t TranslateKey(const wchar_t wch) const noexcept;
+        void TranslateString(const std::wstring_view string, std::wstring& buffer) const;
         bool Designate94Charset(const size_t gsetNumber, const VTID charset);
         bool Designate96Charset(const size_t gsetNumber, const VTID charset);
         void SetDrcs94Designation(const VTID charset);
@@ -51,6 +52,7 @@ namespace Microsoft::Console::VirtualTerminal
         const std::wstring_view _LookupTranslationTable96(const VTID charset) const;
         bool _SetTranslationTable(const size_t gsetNumber, const std::wstring_view translationTable);
         void _ReplaceDrcsTable(const std::wstring_view oldTable, const std::wstring_view newTable);
+        void _UpdateTranslationTable() noexcept;
 
         VTID _upssId;
         std::wstring_view _upssTranslationTable;
@@ -64,5 +66,12 @@ namespace Microsoft::Console::VirtualTerminal
         bool _grTranslationEnabled = false;
         VTID _drcsId = 0;
         std::wstring_view _drcsTranslationTable;
+
+        // The GL and GR tables flattened into a single lookup table for the code units 0-255.
+        // Only the code units in [_translationMin, _translationMin + _translationRange)
+        // can map to something other than themselves.
+        std::array<wchar_t, 256> _translationTable{};
+        wchar_t _translationMin = 0;
+        wchar_t _translationRange = 0;
     };
 }
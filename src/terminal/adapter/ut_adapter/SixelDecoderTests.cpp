@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <wextestclass.h>
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../SixelDecoder.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+// Decodes the given data one sixel at a time into a bitmap of bools. This is what
+// SixelDecoder is expected to produce, without any of its blocks and words.
+// Only sixels, "$" and "-" are supported.
+static std::vector<bool> referenceDecode(const size_t width, const size_t height, const std::wstring_view data)
+{
+    std::vector<bool> pixels(width * height);
+    size_t column = 0;
+    size_t row = 0;
+
+    for (const auto ch : data)
+    {
+        switch (ch)
+        {
+        case L'$':
+            column = 0;
+            break;
+        case L'-':
+            column = 0;
+            row += 6;
+            break;
+        default:
+            for (size_t bit = 0; bit < 6; bit++)
+            {
+                if (((ch - L'?') >> bit) & 1 && column < width && row + bit < height)
+                {
+                    pixels[(row + bit) * width + column] = true;
+                }
+            }
+            column++;
+            break;
+        }
+    }
+
+    return pixels;
+}
+
+// Compares every pixel of the decoder's bitmap against the reference and
+// verifies that no bits are set beyond the bitmap width.
+static void verifyBitmap(const SixelDecoder& decoder, const size_t width, const size_t height, const std::vector<bool>& expected)
+{
+    for (size_t y = 0; y < height; y++)
+    {
+        const auto scanline = decoder.GetScanline(y);
+        VERIFY_ARE_EQUAL((width + 63) / 64, scanline.size());
+
+        for (size_t x = 0; x < scanline.size() * 64; x++)
+        {
+            const auto actual = ((scanline[x / 64] >> (x % 64)) & 1) != 0;
+            const auto wanted = x < width && expected[y * width + x];
+            if (actual != wanted)
+            {
+                VERIFY_FAIL(NoThrowString().Format(L"pixel %zu,%zu is %d, expected %d", x, y, actual, wanted));
+            }
+        }
+    }
+}
+
+// Generates a run of sixels in which each column differs from its neighbours.
+static std::wstring makeSixels(const size_t count, const size_t seed)
+{
+    std::wstring sixels;
+    for (size_t i = 0; i < count; i++)
+    {
+        sixels.push_back(gsl::narrow_cast<wchar_t>(L'?' + (i * 37 + seed * 11 + 1) % 64));
+    }
+    return sixels;
+}
+
+class SixelDecoderTests
+{
+    TEST_CLASS(SixelDecoderTests);
+
+    TEST_METHOD(BlockStraddlesWords)
+    {
+        static constexpr size_t width = 200;
+        static constexpr size_t height = 6;
+        SixelDecoder decoder{ width, height };
+
+        for (const size_t offset : { 49, 56, 63, 120, 127, 185 })
+        {
+            Log::Comment(NoThrowString().Format(L"16 set columns starting at column %zu", offset));
+            const auto data = std::wstring(offset, L'?') + std::wstring(16, L'~');
+            decoder.Clear();
+            VERIFY_ARE_EQUAL(data.size(), decoder.Decode(data));
+            verifyBitmap(decoder, width, height, referenceDecode(width, height, data));
+        }
+
+        Log::Comment(L"A block straddling the last two words");
+        decoder.Clear();
+        auto data = std::wstring(190, L'?') + std::wstring(16, L'~');
+        decoder.Decode(data);
+        VERIFY_ARE_EQUAL(data.size(), decoder.GetColumn());
+        VERIFY_ARE_EQUAL(0xC000000000000000ull, decoder.GetScanline(0)[2]);
+        VERIFY_ARE_EQUAL(0x00000000000000FFull, decoder.GetScanline(0)[3]);
+        verifyBitmap(decoder, width, height, referenceDecode(width, height, data));
+
+        Log::Comment(L"A block that's clipped within the last word doesn't spill into the next scanline");
+        static constexpr size_t narrowWidth = 192;
+        SixelDecoder narrowDecoder{ narrowWidth, height * 2 };
+        data = std::wstring(180, L'?') + std::wstring(16, L'~');
+        narrowDecoder.Decode(data);
+        VERIFY_ARE_EQUAL(0xFFF0000000000000ull, narrowDecoder.GetScanline(5)[2]);
+        VERIFY_ARE_EQUAL(0ull, narrowDecoder.GetScanline(6)[0]);
+        verifyBitmap(narrowDecoder, narrowWidth, height * 2, referenceDecode(narrowWidth, height * 2, data));
+    }
+
+    TEST_METHOD(BlocksAtNonZeroOffsets)
+    {
+        // With SSE2 every full block of 16 sixels is transposed in one go. Shifting
+        // the start of the run makes those blocks land at every possible bit offset.
+        static constexpr size_t width = 300;
+        static constexpr size_t height = 12;
+        SixelDecoder decoder{ width, height };
+
+        for (size_t offset = 0; offset < 80; offset++)
+        {
+            const auto data = std::wstring(offset, L'?') + makeSixels(100, offset) + L"-" + makeSixels(width + 20, offset + 1);
+            decoder.Clear();
+            VERIFY_ARE_EQUAL(data.size(), decoder.Decode(data));
+            verifyBitmap(decoder, width, height, referenceDecode(width, height, data));
+        }
+    }
+
+    TEST_METHOD(BlocksInSeparateCalls)
+    {
+        static constexpr size_t width = 150;
+        static constexpr size_t height = 6;
+        SixelDecoder decoder{ width, height };
+
+        Log::Comment(L"Runs split across calls continue where the previous one stopped");
+        const auto data = makeSixels(width, 3);
+        for (const size_t split : { 1, 15, 17, 64, 70 })
+        {
+            decoder.Clear();
+            VERIFY_ARE_EQUAL(split, decoder.Decode(std::wstring_view{ data }.substr(0, split)));
+            VERIFY_ARE_EQUAL(data.size() - split, decoder.Decode(std::wstring_view{ data }.substr(split)));
+            verifyBitmap(decoder, width, height, referenceDecode(width, height, data));
+        }
+    }
+
+    TEST_METHOD(RepeatSplitAcrossCalls)
+    {
+        static constexpr size_t width = 128;
+        static constexpr size_t height = 6;
+        SixelDecoder decoder{ width, height };
+        const auto expected = referenceDecode(width, height, L"N" + std::wstring(100, L'~') + L"N");
+
+        for (const auto& parts : std::initializer_list<std::initializer_list<std::wstring_view>>{
+                 { L"N!100~N" },
+                 { L"N!", L"100~N" },
+                 { L"N!1", L"00~N" },
+                 { L"N!10", L"0", L"~N" },
+                 { L"N!100", L"~N" },
+                 { L"N", L"!", L"1", L"0", L"0", L"~", L"N" },
+             })
+        {
+            decoder.Clear();
+            for (const auto part : parts)
+            {
+                VERIFY_ARE_EQUAL(part.size(), decoder.Decode(part));
+            }
+            VERIFY_ARE_EQUAL(102u, decoder.GetColumn());
+            verifyBitmap(decoder, width, height, expected);
+        }
+
+        Log::Comment(L"A repeat that crosses the right edge is clipped");
+        decoder.Clear();
+        decoder.Decode(L"!120?");
+        decoder.Decode(L"!20~");
+        VERIFY_ARE_EQUAL(140u, decoder.GetColumn());
+        verifyBitmap(decoder, width, height, referenceDecode(width, height, std::wstring(120, L'?') + std::wstring(20, L'~')));
+    }
+
+    TEST_METHOD(StopsAtUnknownCharacters)
+    {
+        SixelDecoder decoder{ 100, 12 };
+
+        VERIFY_ARE_EQUAL(3u, decoder.Decode(L"~~~;~~~"));
+        VERIFY_ARE_EQUAL(3u, decoder.GetColumn());
+
+        VERIFY_ARE_EQUAL(2u, decoder.Decode(L"$-/"));
+        VERIFY_ARE_EQUAL(0u, decoder.GetColumn());
+        VERIFY_ARE_EQUAL(6u, decoder.GetRow());
+
+        Log::Comment(L"An unknown character cancels a pending repeat");
+        VERIFY_ARE_EQUAL(3u, decoder.Decode(L"!50/~"));
+        VERIFY_ARE_EQUAL(1u, decoder.Decode(L"~"));
+        VERIFY_ARE_EQUAL(1u, decoder.GetColumn());
+    }
+};
@@ -2995,6 +2995,48 @@ public:
         VERIFY_IS_TRUE(decdld(CellMatrix::Default, 0, FontSet::Size132x24, FontUsage::FullCell, bitmapOf6x18));
     }
 
+    TEST_METHOD(SoftFontSixelDecoding)
+    {
+        const auto decdld = [](const std::wstring_view data, const bool oneCharAtATime) {
+            FontBuffer fontBuffer;
+            fontBuffer.SetEraseControl(DispatchTypes::DrcsEraseControl::AllChars);
+            fontBuffer.SetAttributes(DispatchTypes::DrcsCellMatrix::Default, 0, DispatchTypes::DrcsFontSet::Size80x24, DispatchTypes::DrcsFontUsage::FullCell);
+            fontBuffer.SetStartChar(0, DispatchTypes::CharsetSize::Size94);
+            if (oneCharAtATime)
+            {
+                for (auto ch : data)
+                {
+                    fontBuffer.AddSixelData(ch);
+                }
+            }
+            else
+            {
+                fontBuffer.AddSixelData(data);
+            }
+            VERIFY_IS_TRUE(fontBuffer.FinalizeSixelData());
+            const auto bitPattern = fontBuffer.GetBitPattern();
+            return std::vector<uint16_t>{ bitPattern.begin(), bitPattern.end() };
+        };
+
+        // The rows are wider than the maximum cell width, so they exercise the
+        // clipping, and they're long enough to be decoded in blocks of 16.
+        const auto expanded = L"B~~~~~~~~~~@@@@@@@@@@/AAAAAAAAAABBBBBBBBBB;NNNNNNNNNNNNNNNNNNNN/??????????zzzzzzzzzz";
+        const auto repeated = L"B!10~!10@/!10A!10B;!20N/!10?!10z";
+        const auto expected = decdld(expanded, true);
+
+        Log::Comment(L"Pattern is the same when the data is delivered in a single span");
+        VERIFY_IS_TRUE(expected == decdld(expanded, false));
+
+        Log::Comment(L"Pattern is the same when the data is run-length encoded");
+        VERIFY_IS_TRUE(expected == decdld(repeated, true));
+        VERIFY_IS_TRUE(expected == decdld(repeated, false));
+
+        Log::Comment(L"The first character is drawn, and the second is different");
+        const auto cellHeight = expected.size() / 96;
+        VERIFY_IS_TRUE(std::any_of(expected.begin(), expected.begin() + cellHeight, [](auto bits) { return bits != 0; }));
+        VERIFY_IS_FALSE(std::equal(expected.begin(), expected.begin() + cellHeight, expected.begin() + cellHeight));
+    }
+
     TEST_METHOD(TogglingC1ParserMode)
     {
         _stateMachine->SetParserMode(StateMachine::Mode::AcceptC1, false);
@@ -3091,6 +3133,69 @@ public:
         VERIFY_ARE_EQUAL(96u, termOutput.GetUserPreferenceCharsetSize());
     }
 
+    TEST_METHOD(TranslateStringMatchesTranslateKey)
+    {
+        auto& termOutput = _pDispatch->_termOutput;
+        termOutput.SoftReset();
+        termOutput.EnableGrTranslation(true);
+
+        // All code units from 0 to 0x17F, with runs of untranslated text long enough for the vectorized path.
+        std::wstring text;
+        for (wchar_t wch = 0; wch < 0x180; wch++)
+        {
+            text += wch;
+            if (wch % 16 == 0)
+            {
+                text += L"0123456789ABCDEF";
+            }
+        }
+
+        const auto verifyTranslation = [&](const size_t singleShift = 0) {
+            std::wstring expected;
+            if (singleShift)
+            {
+                termOutput.SingleShift(singleShift);
+            }
+            for (const auto wch : text)
+            {
+                expected += termOutput.TranslateKey(wch);
+            }
+
+            std::wstring actual;
+            if (singleShift)
+            {
+                termOutput.SingleShift(singleShift);
+            }
+            termOutput.TranslateString(text, actual);
+            VERIFY_ARE_EQUAL(expected, actual);
+        };
+
+        Log::Comment(L"DEC Special Graphics in GL, DEC Supplemental in GR");
+        termOutput.Designate94Charset(0, VTID("0"));
+        termOutput.Designate94Charset(2, VTID("%5"));
+        termOutput.LockingShiftRight(2);
+        verifyTranslation();
+
+        Log::Comment(L"With a single shift pending");
+        verifyTranslation(2);
+        verifyTranslation(3);
+
+        Log::Comment(L"A national replacement charset in GL, ISO Latin-Greek in GR");
+        termOutput.Designate94Charset(1, VTID("K"));
+        termOutput.LockingShift(1);
+        termOutput.Designate96Charset(3, VTID("F"));
+        termOutput.LockingShiftRight(3);
+        verifyTranslation();
+
+        Log::Comment(L"Only a single shift and nothing else to translate");
+        termOutput.SoftReset();
+        termOutput.Designate94Charset(2, VTID("0"));
+        verifyTranslation(2);
+
+        termOutput.EnableGrTranslation(false);
+        termOutput.SoftReset();
+    }
+
     TEST_METHOD(RequestUserPreferenceCharsets)
     {
         auto& termOutput = _pDispatch->_termOutput;
@@ -3255,6 +3360,7 @@ public:
 
         const auto setMacroText = [&](const auto id, const auto value) {
             _pDispatch->_macroBuffer->_macros.at(id) = value;
+            _pDispatch->_macroBuffer->_compiledMacros.at(id) = {};
         };
 
         setMacroText(0, L"Macro 0");
@@ -3307,6 +3413,23 @@ public:
         _stateMachine->ProcessString(L"\033[0*z");
         VERIFY_ARE_EQUAL(L"<[<[<[<[<[<[<[<[]>]>]>]>]>]>]>]>", getBufferOutput());
 
+        Log::Comment(L"Controls and sequences are replayed from a compiled macro");
+        setMacroText(3, L"ABC\bD\033[4GE\033[38:2::0:0:255mF");
+        _testGetSet->PrepData();
+        _stateMachine->ProcessString(L"\033[3*z");
+        VERIFY_ARE_EQUAL(L"ABDEF", getBufferOutput());
+        VERIFY_IS_TRUE(_pDispatch->_macroBuffer->_compiledMacros.at(3).compilable);
+        _testGetSet->PrepData();
+        _stateMachine->ProcessString(L"\033[3*z");
+        VERIFY_ARE_EQUAL(L"ABDEF", getBufferOutput());
+
+        Log::Comment(L"Content following a switch to VT52 mode is parsed in that mode");
+        setMacroText(4, L"A\033[?2lB\033CD\033<E");
+        _testGetSet->PrepData();
+        _stateMachine->ProcessString(L"\033[4*z");
+        VERIFY_ARE_EQUAL(L"AB DE", getBufferOutput());
+        VERIFY_IS_TRUE(_stateMachine->GetParserMode(StateMachine::Mode::Ansi));
+
         _pDispatch->_macroBuffer = nullptr;
     }
 
@@ -502,10 +502,10 @@ TerminalInput::OutputType TerminalInput::_makeAlternateScrollOutput(const short
 {
     if (delta > 0)
     {
-        return MakeOutput(_keyMap.at(VK_UP));
+        return MakeOutput(_lookupKey(VK_UP));
     }
     else
     {
-        return MakeOutput(_keyMap.at(VK_DOWN));
+        return MakeOutput(_lookupKey(VK_DOWN));
     }
 }
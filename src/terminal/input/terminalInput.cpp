@@ -224,10 +224,12 @@ TerminalInput::OutputType TerminalInput::HandleKey(const INPUT_RECORD& event)
     WI_SetFlagIf(keyCombo, Alt, altIsPressed);
     WI_SetFlagIf(keyCombo, Shift, shiftIsPressed);
     WI_SetFlagIf(keyCombo, Enhanced, enhancedReturnKey);
-    const auto keyMatch = _keyMap.find(keyCombo);
-    if (keyMatch != _keyMap.end())
+    if (virtualKeyCode <= 0xFF)
     {
-        return keyMatch->second;
+        if (const auto keyMatch = _lookupKey(keyCombo); !keyMatch.empty())
+        {
+            return MakeOutput(keyMatch);
+        }
     }
 
     // If it's not in the key map, we'll use the UnicodeChar, if provided,
@@ -329,29 +331,30 @@ try
 {
     auto defineKeyWithUnusedModifiers = [this](const int keyCode, const std::wstring& sequence) {
         for (auto m = 0; m < 8; m++)
-            _keyMap[VTModifier(m) + keyCode] = sequence;
+            _defineKey(VTModifier(m) + keyCode, sequence);
     };
     auto defineKeyWithAltModifier = [this](const int keyCode, const std::wstring& sequence) {
-        _keyMap[keyCode] = sequence;
-        _keyMap[Alt + keyCode] = L"\x1B" + sequence;
+        _defineKey(keyCode, sequence);
+        _defineKey(Alt + keyCode, L"\x1B" + sequence);
     };
     auto defineKeypadKey = [this](const int keyCode, const wchar_t* prefix, const wchar_t finalChar) {
-        _keyMap[keyCode] = fmt::format(FMT_COMPILE(L"{}{}"), prefix, finalChar);
+        _defineKey(keyCode, fmt::format(FMT_COMPILE(L"{}{}"), prefix, finalChar));
         for (auto m = 1; m < 8; m++)
-            _keyMap[VTModifier(m) + keyCode] = fmt::format(FMT_COMPILE(L"{}1;{}{}"), _csi, m + 1, finalChar);
+            _defineKey(VTModifier(m) + keyCode, fmt::format(FMT_COMPILE(L"{}1;{}{}"), _csi, m + 1, finalChar));
     };
     auto defineEditingKey = [this](const int keyCode, const int parm) {
-        _keyMap[keyCode] = fmt::format(FMT_COMPILE(L"{}{}~"), _csi, parm);
+        _defineKey(keyCode, fmt::format(FMT_COMPILE(L"{}{}~"), _csi, parm));
         for (auto m = 1; m < 8; m++)
-            _keyMap[VTModifier(m) + keyCode] = fmt::format(FMT_COMPILE(L"{}{};{}~"), _csi, parm, m + 1);
+            _defineKey(VTModifier(m) + keyCode, fmt::format(FMT_COMPILE(L"{}{};{}~"), _csi, parm, m + 1));
     };
     auto defineNumericKey = [this](const int keyCode, const wchar_t finalChar) {
-        _keyMap[keyCode] = fmt::format(FMT_COMPILE(L"{}{}"), _ss3, finalChar);
+        _defineKey(keyCode, fmt::format(FMT_COMPILE(L"{}{}"), _ss3, finalChar));
         for (auto m = 1; m < 8; m++)
-            _keyMap[VTModifier(m) + keyCode] = fmt::format(FMT_COMPILE(L"{}{}{}"), _ss3, m + 1, finalChar);
+            _defineKey(VTModifier(m) + keyCode, fmt::format(FMT_COMPILE(L"{}{}{}"), _ss3, m + 1, finalChar));
     };
 
-    _keyMap.clear();
+    _keyMap.fill({});
+    _keyMapStrings.clear();
 
     // PAUSE doesn't have a VT mapping, but traditionally we've mapped it to ^Z,
     // regardless of modifiers.
@@ -519,6 +522,28 @@ try
 }
 CATCH_LOG()
 
+// Assigns the given sequence to a key combination in the key map, replacing any
+// previous definition. Since the map is rebuilt from scratch whenever one of the
+// relevant modes changes, replaced sequences are simply left in _keyMapStrings.
+void TerminalInput::_defineKey(const int keyCombo, const std::wstring_view sequence)
+{
+    const auto offset = _keyMapStrings.size();
+    _keyMapStrings.append(sequence);
+    til::at(_keyMap, keyCombo) = {
+        gsl::narrow<uint16_t>(offset),
+        gsl::narrow<uint16_t>(sequence.size()),
+    };
+}
+
+// Returns the sequence assigned to the given key combination,
+// or an empty string if the combination isn't mapped.
+std::wstring_view TerminalInput::_lookupKey(const int keyCombo) const noexcept
+{
+    const auto& entry = til::at(_keyMap, keyCombo);
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+    return { _keyMapStrings.data() + entry.offset, entry.length };
+}
+
 DWORD TerminalInput::_trackControlKeyState(const KEY_EVENT_RECORD& key)
 {
     // First record which key state bits were previously off but are now on.
@@ -73,7 +73,16 @@ namespace Microsoft::Console::VirtualTerminal
         DWORD _lastControlKeyState = 0;
         uint64_t _lastLeftCtrlTime = 0;
         uint64_t _lastRightAltTime = 0;
-        std::unordered_map<int, std::wstring> _keyMap;
+        // The key map is a flat table indexed by the virtual key code in the low
+        // byte and our VTModifier bits in the high bits. Each entry refers to a
+        // slice of _keyMapStrings, so a lookup is a single array access.
+        struct KeyMapEntry
+        {
+            uint16_t offset = 0;
+            uint16_t length = 0;
+        };
+        std::array<KeyMapEntry, 16 * 256> _keyMap{};
+        std::wstring _keyMapStrings;
         std::wstring _focusInSequence;
         std::wstring _focusOutSequence;
 
@@ -86,6 +95,8 @@ namespace Microsoft::Console::VirtualTerminal
         static constexpr auto _ss3 = L"\x1BO";
 
         void _initKeyboardMap() noexcept;
+        void _defineKey(const int keyCombo, const std::wstring_view sequence);
+        std::wstring_view _lookupKey(const int keyCombo) const noexcept;
         DWORD _trackControlKeyState(const KEY_EVENT_RECORD& key);
         std::array<byte, 256> _getKeyboardState(const WORD virtualKeyCode, const DWORD controlKeyState) const;
         [[nodiscard]] static wchar_t _makeCtrlChar(const wchar_t ch);
@@ -31,11 +31,6 @@ static constexpr std::array<CsiToVkey, 10> s_csiMap = {
     CsiToVkey{ CsiActionCodes::CSI_F4, VK_F4 }
 };
 
-static bool operator==(const CsiToVkey& pair, const VTID id) noexcept
-{
-    return pair.action == id;
-}
-
 struct GenericToVkey
 {
     GenericKeyIdentifiers identifier;
@@ -59,11 +54,6 @@ static constexpr std::array<GenericToVkey, 14> s_genericMap = {
     GenericToVkey{ GenericKeyIdentifiers::F12, VK_F12 },
 };
 
-static bool operator==(const GenericToVkey& pair, const GenericKeyIdentifiers identifier) noexcept
-{
-    return pair.identifier == identifier;
-}
-
 struct Ss3ToVkey
 {
     Ss3ActionCodes action;
@@ -83,10 +73,37 @@ static constexpr std::array<Ss3ToVkey, 10> s_ss3Map = {
     Ss3ToVkey{ Ss3ActionCodes::SS3_F4, VK_F4 },
 };
 
-static bool operator==(const Ss3ToVkey& pair, const Ss3ActionCodes code) noexcept
-{
-    return pair.action == code;
-}
+// The mapping tables above are kept as lists of pairs for readability. At runtime
+// we look keys up via the following direct-indexed tables instead, which turns
+// each lookup into a single bounds check and load. A vkey of 0 means "unmapped".
+// All CSI and SS3 cursor key finals are plain ASCII, and all generic key
+// identifiers are smaller than 32.
+static constexpr auto s_csiVkeys = [] {
+    std::array<short, 128> table{};
+    for (const auto& pair : s_csiMap)
+    {
+        table[gsl::narrow_cast<size_t>(pair.action)] = pair.vkey;
+    }
+    return table;
+}();
+
+static constexpr auto s_genericVkeys = [] {
+    std::array<short, 32> table{};
+    for (const auto& pair : s_genericMap)
+    {
+        table[static_cast<size_t>(pair.identifier)] = pair.vkey;
+    }
+    return table;
+}();
+
+static constexpr auto s_ss3Vkeys = [] {
+    std::array<short, 128> table{};
+    for (const auto& pair : s_ss3Map)
+    {
+        table[static_cast<size_t>(pair.action)] = pair.vkey;
+    }
+    return table;
+}();
 
 InputStateMachineEngine::InputStateMachineEngine(std::unique_ptr<IInteractDispatch> pDispatch) :
     InputStateMachineEngine(std::move(pDispatch), false)
@@ -287,6 +304,7 @@ bool InputStateMachineEngine::ActionPassThroughString(const std::wstring_view st
         if (!string.empty())
         {
             InputEventQueue inputEvents;
+            inputEvents.reserve(string.size());
             for (const auto& wch : string)
             {
                 inputEvents.push_back(SynthesizeKeyEvent(true, 1, 0, 0, wch, 0));
@@ -942,16 +960,9 @@ bool InputStateMachineEngine::_UpdateSGRMouseButtonState(const VTID id,
 // true iff we found the key
 bool InputStateMachineEngine::_GetGenericVkey(const GenericKeyIdentifiers identifier, short& vkey) const
 {
-    vkey = 0;
-
-    const auto mapping = std::find(s_genericMap.cbegin(), s_genericMap.cend(), identifier);
-    if (mapping != s_genericMap.end())
-    {
-        vkey = mapping->vkey;
-        return true;
-    }
-
-    return false;
+    const auto index = static_cast<size_t>(identifier);
+    vkey = index < s_genericVkeys.size() ? til::at(s_genericVkeys, index) : 0;
+    return vkey != 0;
 }
 
 // Method Description:
@@ -963,16 +974,9 @@ bool InputStateMachineEngine::_GetGenericVkey(const GenericKeyIdentifiers identi
 // true iff we found the key
 bool InputStateMachineEngine::_GetCursorKeysVkey(const VTID id, short& vkey) const
 {
-    vkey = 0;
-
-    const auto mapping = std::find(s_csiMap.cbegin(), s_csiMap.cend(), id);
-    if (mapping != s_csiMap.end())
-    {
-        vkey = mapping->vkey;
-        return true;
-    }
-
-    return false;
+    const auto index = static_cast<uint64_t>(id);
+    vkey = index < s_csiVkeys.size() ? til::at(s_csiVkeys, gsl::narrow_cast<size_t>(index)) : 0;
+    return vkey != 0;
 }
 
 // Method Description:
@@ -984,16 +988,9 @@ bool InputStateMachineEngine::_GetCursorKeysVkey(const VTID id, short& vkey) con
 // true iff we found the key
 bool InputStateMachineEngine::_GetSs3KeysVkey(const wchar_t wch, short& vkey) const
 {
-    vkey = 0;
-
-    const auto mapping = std::find(s_ss3Map.cbegin(), s_ss3Map.cend(), (Ss3ActionCodes)wch);
-    if (mapping != s_ss3Map.end())
-    {
-        vkey = mapping->vkey;
-        return true;
-    }
-
-    return false;
+    const auto index = static_cast<size_t>(wch);
+    vkey = index < s_ss3Vkeys.size() ? til::at(s_ss3Vkeys, index) : 0;
+    return vkey != 0;
 }
 
 // Method Description:
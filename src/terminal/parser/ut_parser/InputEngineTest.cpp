@@ -274,6 +274,8 @@ class Microsoft::Console::VirtualTerminal::InputEngineTest
 
     TEST_METHOD(TestWin32InputParsing);
     TEST_METHOD(TestWin32InputOptionals);
+    TEST_METHOD(TestBulkStringToKeyEvents);
+    TEST_METHOD(TestVkeyLookupTables);
 
     friend class TestInteractDispatch;
 };
@@ -1607,3 +1609,57 @@ void InputEngineTest::TestWin32InputOptionals()
         }
     }
 }
+
+void InputEngineTest::TestBulkStringToKeyEvents()
+{
+    // StringToKeyEvents memoizes keyboard layout lookups, but it must
+    // produce exactly the same records as converting one char at a time.
+    const std::wstring_view text{ L"Hello, World! ~`|\\{}[] hello again\r\n\tü€😀ABCabc" };
+
+    InputEventQueue expected;
+    for (const auto& wch : text)
+    {
+        Microsoft::Console::Interactivity::CharToKeyEvents(wch, CP_USA, expected);
+    }
+
+    InputEventQueue actual;
+    Microsoft::Console::Interactivity::StringToKeyEvents(text, CP_USA, actual);
+
+    VERIFY_ARE_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        const auto& e = til::at(expected, i);
+        const auto& a = til::at(actual, i);
+        Log::Comment(NoThrowString().Format(L"\texpected:\t") + VerifyOutputTraits<INPUT_RECORD>::ToString(e));
+        Log::Comment(NoThrowString().Format(L"\tActual  :\t") + VerifyOutputTraits<INPUT_RECORD>::ToString(a));
+        VERIFY_ARE_EQUAL(0, memcmp(&e, &a, sizeof(INPUT_RECORD)));
+    }
+}
+
+void InputEngineTest::TestVkeyLookupTables()
+{
+    auto pfn = std::bind(&TestState::TestInputCallback, &testState, std::placeholders::_1);
+    auto dispatch = std::make_unique<TestInteractDispatch>(pfn, &testState);
+    auto engine = std::make_unique<InputStateMachineEngine>(std::move(dispatch));
+
+    short vkey = 0;
+
+    VERIFY_IS_TRUE(engine->_GetCursorKeysVkey(CsiActionCodes::ArrowUp, vkey));
+    VERIFY_ARE_EQUAL(VK_UP, vkey);
+    VERIFY_IS_TRUE(engine->_GetCursorKeysVkey(CsiActionCodes::CSI_F4, vkey));
+    VERIFY_ARE_EQUAL(VK_F4, vkey);
+    VERIFY_IS_FALSE(engine->_GetCursorKeysVkey(CsiActionCodes::MouseDown, vkey));
+    VERIFY_IS_FALSE(engine->_GetCursorKeysVkey(CsiActionCodes::Generic, vkey));
+
+    VERIFY_IS_TRUE(engine->_GetGenericVkey(GenericKeyIdentifiers::Delete, vkey));
+    VERIFY_ARE_EQUAL(VK_DELETE, vkey);
+    VERIFY_IS_TRUE(engine->_GetGenericVkey(GenericKeyIdentifiers::F12, vkey));
+    VERIFY_ARE_EQUAL(VK_F12, vkey);
+    VERIFY_IS_FALSE(engine->_GetGenericVkey(static_cast<GenericKeyIdentifiers>(16), vkey));
+    VERIFY_IS_FALSE(engine->_GetGenericVkey(static_cast<GenericKeyIdentifiers>(200), vkey));
+
+    VERIFY_IS_TRUE(engine->_GetSs3KeysVkey(L'H', vkey));
+    VERIFY_ARE_EQUAL(VK_HOME, vkey);
+    VERIFY_IS_FALSE(engine->_GetSs3KeysVkey(L'Z', vkey));
+    VERIFY_IS_FALSE(engine->_GetSs3KeysVkey(L'\x2603', vkey));
+}
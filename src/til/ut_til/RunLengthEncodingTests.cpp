@@ -13,10 +13,10 @@ using namespace WEX::TestExecution;
 
 namespace WEX::TestExecution
 {
-    template<typename T, typename S, typename Container>
-    class VerifyCompareTraits<::std::string_view, ::til::basic_rle<T, S, Container>>
+    template<typename T, typename S, typename Container, typename Index>
+    class VerifyCompareTraits<::std::string_view, ::til::basic_rle<T, S, Container, Index>>
     {
-        using rle_vector = ::til::basic_rle<T, S, Container>;
+        using rle_vector = ::til::basic_rle<T, S, Container, Index>;
         using value_type = typename rle_vector::value_type;
 
     public:
@@ -88,9 +88,11 @@ namespace WEX::TestExecution
 class RunLengthEncodingTests
 {
     using rle_vector = til::small_rle<uint16_t, uint16_t, 16>;
+    using indexed_rle_vector = til::indexed_small_rle<uint16_t, uint16_t, 16>;
     using value_type = rle_vector::value_type;
     using size_type = rle_vector::size_type;
     using rle_type = rle_vector::rle_type;
+    using replacement_type = rle_vector::replacement_type;
 
     using basic_container = std::basic_string<value_type>;
     using basic_container_view = std::basic_string_view<value_type>;
@@ -180,6 +182,27 @@ class RunLengthEncodingTests
         return to;
     }
 
+    // Checks that the cumulative lengths in the index match the runs and that at() agrees with a linear decode.
+    static void verify_index(const indexed_rle_vector& rle)
+    {
+        VERIFY_IS_TRUE(rle._index.valid);
+        VERIFY_ARE_EQUAL(rle._runs.size(), rle._index.ends.size());
+
+        size_type total = 0;
+        for (size_t i = 0; i < rle._runs.size(); ++i)
+        {
+            total += rle._runs[i].length;
+            VERIFY_ARE_EQUAL(total, rle._index.ends[i]);
+        }
+
+        const auto decoded = rle_decode(rle._runs);
+        for (size_type i = 0; i < decoded.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(decoded[i], rle.at(i));
+        }
+        VERIFY_THROWS(rle.at(rle.size()), std::out_of_range);
+    }
+
     TEST_CLASS(RunLengthEncodingTests)
 
     TEST_METHOD(ConstructDefault)
@@ -378,6 +401,154 @@ class RunLengthEncodingTests
         }
     }
 
+    TEST_METHOD(ReplaceMultipleRanges)
+    {
+        struct TestCase
+        {
+            std::string_view source;
+            std::vector<replacement_type> replacements;
+            std::string_view expected;
+        };
+
+        const std::array<TestCase, 9> test_cases{
+            {
+                // no replacements
+                { "1|3 3|2|1 1 1|5 5", {}, "1|3 3|2|1 1 1|5 5" },
+                // single range
+                { "1|3 3|2|1 1 1|5 5", { { 2, 5, 6 } }, "1|3|6 6 6|1 1|5 5" },
+                // all
+                { "1|3 3|2|1 1 1|5 5", { { 0, 9, 6 } }, "6 6 6 6 6 6 6 6 6" },
+                // end_index is clamped to size()
+                { "1|3 3|2|1 1 1|5 5", { { 7, 100, 6 } }, "1|3 3|2|1 1 1|6 6" },
+                // multiple ranges within a run
+                { "1 1 1 1 1 1 1 1 1", { { 1, 2, 2 }, { 4, 5, 3 }, { 7, 8, 4 } }, "1|2|1 1|3|1 1|4|1" },
+                // multiple ranges across runs
+                { "1|3 3|2|1 1 1|5 5", { { 0, 2, 6 }, { 3, 5, 7 }, { 8, 9, 8 } }, "6 6|3|7 7|1 1|5|8" },
+                // adjacent ranges
+                { "1|3 3|2|1 1 1|5 5", { { 1, 3, 6 }, { 3, 4, 7 }, { 4, 7, 6 } }, "1|6 6|7|6 6 6|5 5" },
+                // join with surrounding runs and each other
+                { "1|3 3|2|1 1 1|5 5", { { 1, 3, 1 }, { 3, 4, 1 }, { 7, 9, 1 } }, "1 1 1 1 1 1 1 1 1" },
+                // empty ranges
+                { "1|3 3|2|1 1 1|5 5", { { 1, 1, 6 }, { 4, 4, 7 } }, "1|3 3|2|1 1 1|5 5" },
+            }
+        };
+
+        auto idx = 0;
+
+        for (const auto& test_case : test_cases)
+        {
+            rle_vector rle{ rle_encode(test_case.source) };
+            indexed_rle_vector indexed{ rle_encode(test_case.source) };
+
+            rle.replace(test_case.replacements);
+            indexed.replace(test_case.replacements);
+
+            VERIFY_ARE_EQUAL(
+                test_case.expected,
+                rle,
+                NoThrowString().Format(
+                    L"test case: %d\nsource:    %hs\nexpected:  %hs\nactual:    %s",
+                    idx,
+                    test_case.source.data(),
+                    test_case.expected.data(),
+                    rle.to_string().c_str()));
+            VERIFY_ARE_EQUAL(test_case.expected, indexed);
+            verify_index(indexed);
+
+            ++idx;
+        }
+
+        // The ranges must be sorted and must not overlap.
+        {
+            rle_vector rle{ rle_encode("1|3 3|2|1 1 1|5 5") };
+            const std::array<replacement_type, 2> unsorted{ { { 4, 5, 6 }, { 1, 2, 7 } } };
+            const std::array<replacement_type, 2> overlapping{ { { 1, 4, 6 }, { 3, 5, 7 } } };
+            const std::array<replacement_type, 1> reversed{ { { 5, 4, 6 } } };
+            VERIFY_THROWS(rle.replace(unsorted), std::out_of_range);
+            VERIFY_THROWS(rle.replace(overlapping), std::out_of_range);
+            VERIFY_THROWS(rle.replace(reversed), std::out_of_range);
+            VERIFY_ARE_EQUAL("1|3 3|2|1 1 1|5 5"sv, rle);
+        }
+    }
+
+    TEST_METHOD(Index)
+    {
+        indexed_rle_vector rle{ rle_encode("1|3 3|2|1 1 1|5 5") };
+        verify_index(rle);
+
+        // Each modification keeps the index up to date.
+        rle.replace(2, 6, rle_encode("6|7 7|8"));
+        VERIFY_ARE_EQUAL("1|3|6|7 7|8|1|5 5"sv, rle);
+        verify_index(rle);
+
+        rle.replace(1, 4, rle_type{ 1, 1 });
+        VERIFY_ARE_EQUAL("1 1|7|8|1|5 5"sv, rle);
+        verify_index(rle);
+
+        rle.replace(4, 4, rle_encode("9 9"));
+        VERIFY_ARE_EQUAL("1 1|7|8|9 9|1|5 5"sv, rle);
+        verify_index(rle);
+
+        rle.replace(0, 3, rle_encode(""));
+        VERIFY_ARE_EQUAL("8|9 9|1|5 5"sv, rle);
+        verify_index(rle);
+
+        rle.replace_values(9, 8);
+        VERIFY_ARE_EQUAL("8 8 8|1|5 5"sv, rle);
+        verify_index(rle);
+
+        rle.resize_trailing_extent(4);
+        VERIFY_ARE_EQUAL("8 8 8|1"sv, rle);
+        verify_index(rle);
+
+        rle.resize_trailing_extent(6);
+        VERIFY_ARE_EQUAL("8 8 8|1 1 1"sv, rle);
+        verify_index(rle);
+
+        // Mutable access to the runs invalidates the index, but lookups still work.
+        rle.runs().front().value = 2;
+        VERIFY_IS_FALSE(rle._index.valid);
+        VERIFY_ARE_EQUAL(2u, rle.at(2));
+        VERIFY_ARE_EQUAL(1u, rle.at(3));
+
+        // The next modification rebuilds it.
+        rle.replace(0, 1, rle_type{ 3, 1 });
+        VERIFY_ARE_EQUAL("3|2 2|1 1 1"sv, rle);
+        verify_index(rle);
+
+        // Copies and moves carry the index along.
+        auto copy{ rle };
+        verify_index(copy);
+        auto moved{ std::move(copy) };
+        verify_index(moved);
+    }
+
+    TEST_METHOD(Assign)
+    {
+        // 20 runs don't fit into the 16 inline ones, forcing a heap allocation.
+        indexed_rle_vector rle{ rle_encode("1|2|1|2|1|2|1|2|1|2|1|2|1|2|1|2|1|2|1|2") };
+        VERIFY_ARE_NOT_EQUAL(16u, rle._runs.capacity());
+
+        // Mutable access to the runs invalidates the index. assign() makes it valid again.
+        rle.runs().front().value = 3;
+        rle.assign(5, 7);
+        VERIFY_ARE_EQUAL("7 7 7 7 7"sv, rle);
+        verify_index(rle);
+
+        Log::Comment(L"The heap memory was returned.");
+        VERIFY_ARE_EQUAL(16u, rle._runs.capacity());
+        VERIFY_ARE_EQUAL(16u, rle._index.ends.capacity());
+
+        rle.assign(0, 7);
+        VERIFY_ARE_EQUAL(0u, rle.size());
+        verify_index(rle);
+
+        Log::Comment(L"Containers other than til::small_vector work too.");
+        til::rle<value_type, size_type> vec{ { { 1, 1 }, { 2, 1 }, { 3, 1 } } };
+        vec.assign(3, 1);
+        VERIFY_ARE_EQUAL("1 1 1"sv, vec);
+    }
+
     TEST_METHOD(ReplaceValues)
     {
         struct TestCase
@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include <thread>
+
+#include "til/ticket_lock.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TicketLockTests
+{
+    BEGIN_TEST_CLASS(TicketLockTests)
+        TEST_CLASS_PROPERTY(L"TestTimeout", L"0:0:10") // 10s timeout, in case the lock isn't released
+    END_TEST_CLASS()
+
+    // ConhostInternalGetSet::PlayMidiNote suspends the console lock while a note is playing.
+    // At that point the lock is held more than once, because ApiSorter holds it for the
+    // entire WriteConsole dispatch. Suspending must release it nonetheless.
+    TEST_METHOD(SuspendReleasesRecursiveLock)
+    {
+        til::recursive_ticket_lock lock;
+        lock.lock();
+        lock.lock();
+        VERIFY_ARE_EQUAL(2u, lock.recursion_depth());
+
+        {
+            const auto suspension = lock.suspend();
+            VERIFY_ARE_EQUAL(0u, lock.recursion_depth());
+
+            auto acquired = false;
+            std::thread{ [&]() {
+                lock.lock();
+                acquired = true;
+                lock.unlock();
+            } }.join();
+            VERIFY_IS_TRUE(acquired);
+        }
+
+        Log::Comment(L"The recursion count is restored once the suspension ends");
+        VERIFY_ARE_EQUAL(2u, lock.recursion_depth());
+        lock.unlock();
+        VERIFY_ARE_EQUAL(1u, lock.recursion_depth());
+        lock.unlock();
+        VERIFY_ARE_EQUAL(0u, lock.recursion_depth());
+
+        std::thread{ [&]() {
+            lock.lock();
+            lock.unlock();
+        } }.join();
+    }
+
+    TEST_METHOD(SuspendWithoutOwnership)
+    {
+        til::recursive_ticket_lock lock;
+
+        {
+            // Suspending a lock the current thread doesn't hold is a no-op...
+            const auto suspension = lock.suspend();
+            VERIFY_ARE_EQUAL(0u, lock.recursion_depth());
+        }
+
+        // ...and doesn't acquire it when the suspension ends.
+        VERIFY_IS_FALSE(lock.is_locked());
+    }
+};
@@ -21,6 +21,9 @@ struct BenchmarkContext
     std::string_view utf8_128Ki;
     std::wstring_view utf16_4Ki;
     std::wstring_view utf16_128Ki;
+    std::wstring_view ascii_128Ki;
+    std::wstring_view cjk_128Ki;
+    std::wstring_view emoji_128Ki;
 };
 
 struct Benchmark
@@ -111,6 +114,57 @@ static constexpr Benchmark s_benchmarks[]{
             }
         },
     },
+    Benchmark{
+        .title = "WriteConsoleW ASCII 128Ki",
+        .exec = [](const BenchmarkContext& ctx, Measurements measurements) {
+            for (auto& d : measurements)
+            {
+                const auto beg = query_perf_counter();
+                WriteConsoleW(ctx.output, ctx.ascii_128Ki.data(), static_cast<DWORD>(ctx.ascii_128Ki.size()), nullptr, nullptr);
+                const auto end = query_perf_counter();
+                d = perf_delta(beg, end);
+
+                if (end >= ctx.time_limit)
+                {
+                    break;
+                }
+            }
+        },
+    },
+    Benchmark{
+        .title = "WriteConsoleW CJK 128Ki",
+        .exec = [](const BenchmarkContext& ctx, Measurements measurements) {
+            for (auto& d : measurements)
+            {
+                const auto beg = query_perf_counter();
+                WriteConsoleW(ctx.output, ctx.cjk_128Ki.data(), static_cast<DWORD>(ctx.cjk_128Ki.size()), nullptr, nullptr);
+                const auto end = query_perf_counter();
+                d = perf_delta(beg, end);
+
+                if (end >= ctx.time_limit)
+                {
+                    break;
+                }
+            }
+        },
+    },
+    Benchmark{
+        .title = "WriteConsoleW emoji 128Ki",
+        .exec = [](const BenchmarkContext& ctx, Measurements measurements) {
+            for (auto& d : measurements)
+            {
+                const auto beg = query_perf_counter();
+                WriteConsoleW(ctx.output, ctx.emoji_128Ki.data(), static_cast<DWORD>(ctx.emoji_128Ki.size()), nullptr, nullptr);
+                const auto end = query_perf_counter();
+                d = perf_delta(beg, end);
+
+                if (end >= ctx.time_limit)
+                {
+                    break;
+                }
+            }
+        },
+    },
     Benchmark{
         .title = "Copy to clipboard 4Ki",
         .exec = [](const BenchmarkContext& ctx, Measurements measurements) {
@@ -176,6 +230,205 @@ static constexpr Benchmark s_benchmarks[]{
                 const auto end = query_perf_counter();
                 d = perf_delta(beg, end);
 
+                if (end >= ctx.time_limit)
+                {
+                    break;
+                }
+            }
+        },
+    },
+    Benchmark{
+        .title = "WriteConsoleInputW VT keys 4Ki",
+        .exec = [](const BenchmarkContext& ctx, Measurements measurements) {
+            // With ENABLE_VIRTUAL_TERMINAL_INPUT set, every key event written to the input
+            // buffer gets translated into a VT sequence by TerminalInput::HandleKey.
+            // This measures the cost of that translation for a mix of cursor keys,
+            // editing keys and modified alphanumeric keys.
+            static constexpr DWORD cap = 4 * 1024;
+            static constexpr WORD keys[]{ VK_UP, VK_DOWN, VK_LEFT, VK_RIGHT, VK_HOME, VK_END, VK_PRIOR, VK_NEXT, VK_DELETE, VK_F5, VK_RETURN, VK_BACK, 'A', 'Z' };
+            static constexpr DWORD modifiers[]{ 0, SHIFT_PRESSED, LEFT_CTRL_PRESSED, LEFT_ALT_PRESSED, LEFT_CTRL_PRESSED | SHIFT_PRESSED };
+
+            const auto scratch = mem::get_scratch_arena(ctx.arena);
+            const auto buf = scratch.arena.push_zeroed<INPUT_RECORD>(cap);
+
+            for (DWORD i = 0; i < cap; ++i)
+            {
+                const auto vk = keys[i % _countof(keys)];
+                auto& key = buf[i];
+                key.EventType = KEY_EVENT;
+                key.Event.KeyEvent.bKeyDown = TRUE;
+                key.Event.KeyEvent.wRepeatCount = 1;
+                key.Event.KeyEvent.wVirtualKeyCode = vk;
+                key.Event.KeyEvent.wVirtualScanCode = static_cast<WORD>(MapVirtualKeyW(vk, MAPVK_VK_TO_VSC));
+                key.Event.KeyEvent.dwControlKeyState = modifiers[(i / _countof(keys)) % _countof(modifiers)];
+            }
+
+            DWORD mode = 0;
+            GetConsoleMode(ctx.input, &mode);
+            SetConsoleMode(ctx.input, mode | ENABLE_VIRTUAL_TERMINAL_INPUT);
+            FlushConsoleInputBuffer(ctx.input);
+
+            for (auto& d : measurements)
+            {
+                DWORD written;
+
+                const auto beg = query_perf_counter();
+                WriteConsoleInputW(ctx.input, buf, cap, &written);
+                const auto end = query_perf_counter();
+                d = perf_delta(beg, end);
+
+                FlushConsoleInputBuffer(ctx.input);
+
+                if (end >= ctx.time_limit)
+                {
+                    break;
+                }
+            }
+
+            SetConsoleMode(ctx.input, mode);
+        },
+    },
+    Benchmark{
+        .title = "WriteConsoleOutputW 240x80",
+        .exec = [](const BenchmarkContext& ctx, Measurements measurements) {
+            // Full-screen applications (file managers, curses-like UIs) redraw their entire
+            // window with a single WriteConsoleOutputW call. The payload alternates between
+            // a handful of colors, similar to what such an application might draw.
+            static constexpr SHORT w = 240;
+            static constexpr SHORT h = 80;
+            static constexpr WORD colors[]{ 0x1F, 0x1E, 0x30, 0x07 };
+
+            const auto scratch = mem::get_scratch_arena(ctx.arena);
+            const auto buf = scratch.arena.push_zeroed<CHAR_INFO>(w * h);
+
+            for (int i = 0; i < w * h; ++i)
+            {
+                buf[i].Char.UnicodeChar = ctx.utf16_4Ki[i % ctx.utf16_4Ki.size()];
+                buf[i].Attributes = colors[(i / 16) % _countof(colors)];
+            }
+
+            CONSOLE_SCREEN_BUFFER_INFO info{};
+            GetConsoleScreenBufferInfo(ctx.output, &info);
+            SetConsoleScreenBufferSize(ctx.output, { std::max(info.dwSize.X, w), std::max(info.dwSize.Y, h) });
+
+            for (auto& d : measurements)
+            {
+                SMALL_RECT rect{ 0, 0, w - 1, h - 1 };
+
+                const auto beg = query_perf_counter();
+                WriteConsoleOutputW(ctx.output, buf, { w, h }, {}, &rect);
+                const auto end = query_perf_counter();
+                d = perf_delta(beg, end);
+
+                if (end >= ctx.time_limit)
+                {
+                    break;
+                }
+            }
+
+            SetConsoleScreenBufferSize(ctx.output, info.dwSize);
+        },
+    },
+    Benchmark{
+        .title = "ReadConsoleOutputW 240x80",
+        .exec = [](const BenchmarkContext& ctx, Measurements measurements) {
+            static constexpr SHORT w = 240;
+            static constexpr SHORT h = 80;
+
+            const auto scratch = mem::get_scratch_arena(ctx.arena);
+            const auto buf = scratch.arena.push_zeroed<CHAR_INFO>(w * h);
+
+            CONSOLE_SCREEN_BUFFER_INFO info{};
+            GetConsoleScreenBufferInfo(ctx.output, &info);
+            SetConsoleScreenBufferSize(ctx.output, { std::max(info.dwSize.X, w), std::max(info.dwSize.Y, h) });
+            WriteConsoleW(ctx.output, ctx.utf16_128Ki.data(), static_cast<DWORD>(ctx.utf16_128Ki.size()), nullptr, nullptr);
+
+            for (auto& d : measurements)
+            {
+                SMALL_RECT rect{ 0, 0, w - 1, h - 1 };
+
+                const auto beg = query_perf_counter();
+                ReadConsoleOutputW(ctx.output, buf, { w, h }, {}, &rect);
+                const auto end = query_perf_counter();
+                d = perf_delta(beg, end);
+
+                if (end >= ctx.time_limit)
+                {
+                    break;
+                }
+            }
+
+            SetConsoleScreenBufferSize(ctx.output, info.dwSize);
+        },
+    },
+    Benchmark{
+        .title = "Progress bar 1Ki calls",
+        .exec = [](const BenchmarkContext& ctx, Measurements measurements) {
+            // Mimics a chatty client that redraws a progress indicator by repositioning
+            // the cursor and writing a handful of characters at a time. Each call is tiny,
+            // so this mostly measures the per-API dispatch overhead of the console server.
+            static constexpr int calls = 1024;
+            static constexpr wchar_t spinner[]{ L'|', L'/', L'-', L'\\' };
+
+            CONSOLE_SCREEN_BUFFER_INFO info{};
+            GetConsoleScreenBufferInfo(ctx.output, &info);
+            const auto origin = info.dwCursorPosition;
+
+            for (auto& d : measurements)
+            {
+                const auto beg = query_perf_counter();
+                for (int i = 0; i < calls; i += 2)
+                {
+                    SetConsoleCursorPosition(ctx.output, origin);
+                    WriteConsoleW(ctx.output, &spinner[(i / 2) % _countof(spinner)], 1, nullptr, nullptr);
+                }
+                const auto end = query_perf_counter();
+                d = perf_delta(beg, end);
+
+                if (end >= ctx.time_limit)
+                {
+                    break;
+                }
+            }
+        },
+    },
+    Benchmark{
+        .title = "DECINVM form redraw 256 calls",
+        .exec = [](const BenchmarkContext& ctx, Measurements measurements) {
+            // Mimics a forms-based application that redraws its whole screen from a
+            // stored macro on every keystroke, so this mostly measures macro replay.
+            static constexpr int calls = 256;
+            static constexpr std::wstring_view define{
+                L"\033P1;0;0!z"
+                L"\033[H\033[2J"
+                L"\033[3;3H\033[1mCustomer ID:\033[m\033[3;20H\033[4m                              \033[m"
+                L"\033[5;3H\033[1mName:\033[m\033[5;20H\033[4m                              \033[m"
+                L"\033[7;3H\033[1mCompany:\033[m\033[7;20H\033[4m                              \033[m"
+                L"\033[9;3H\033[1mStreet:\033[m\033[9;20H\033[4m                              \033[m"
+                L"\033[11;3H\033[1mCity:\033[m\033[11;20H\033[4m                              \033[m"
+                L"\033[13;3H\033[1mState:\033[m\033[13;20H\033[4m                              \033[m"
+                L"\033[15;3H\033[1mPostal code:\033[m\033[15;20H\033[4m                              \033[m"
+                L"\033[17;3H\033[1mCountry:\033[m\033[17;20H\033[4m                              \033[m"
+                L"\033[19;3H\033[1mPhone:\033[m\033[19;20H\033[4m                              \033[m"
+                L"\033[21;3H\033[1mEmail:\033[m\033[21;20H\033[4m                              \033[m"
+                L"\033[23;3H\033[1mOrder number:\033[m\033[23;20H\033[4m                              \033[m"
+                L"\033[25;3H\033[1mStatus:\033[m\033[25;20H\033[4m                              \033[m"
+                L"\033\\"
+            };
+            static constexpr std::wstring_view invoke{ L"\033[1*z" };
+
+            WriteConsoleW(ctx.output, define.data(), static_cast<DWORD>(define.size()), nullptr, nullptr);
+
+            for (auto& d : measurements)
+            {
+                const auto beg = query_perf_counter();
+                for (int i = 0; i < calls; ++i)
+                {
+                    WriteConsoleW(ctx.output, invoke.data(), static_cast<DWORD>(invoke.size()), nullptr, nullptr);
+                }
+                const auto end = query_perf_counter();
+                d = perf_delta(beg, end);
+
                 if (end >= ctx.time_limit)
                 {
                     break;
@@ -190,6 +443,13 @@ static constexpr size_t s_benchmarks_count = _countof(s_benchmarks);
 static constexpr std::string_view payload_utf8{ "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labor眠い子猫はマグロ狩りの夢を見る" };
 static constexpr std::wstring_view payload_utf16{ L"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labor眠い子猫はマグロ狩りの夢を見る" };
 
+// These exercise the text segmentation in ROW::ReplaceText for a single script each.
+// The ASCII one is 128 columns, the CJK one is 32 columns and the emoji one is 8 grapheme clusters (16 columns)
+// mixing ZWJ sequences, a flag, a skin tone modifier and VS16 sequences.
+static constexpr std::wstring_view payload_ascii{ L"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut e" };
+static constexpr std::wstring_view payload_cjk{ L"眠い子猫はマグロ狩りの夢を見る。" };
+static constexpr std::wstring_view payload_emoji{ L"\U0001F468\u200D\U0001F469\u200D\U0001F467\U0001F1E9\U0001F1EA\U0001F44D\U0001F3FD\u2764\uFE0F\U0001F600\U0001F3F3\uFE0F\u200D\U0001F308\U0001F408\u200D\u2B1B\U0001F642" };
+
 static bool print_warning();
 static AccumulatedResults* prepare_results(mem::Arena& arena, std::span<const wchar_t*> paths);
 static std::span<Measurements> run_benchmarks_for_path(mem::Arena& arena, const wchar_t* path);
@@ -382,6 +642,9 @@ static std::span<Measurements> run_benchmarks_for_path(mem::Arena& arena, const
         .utf8_128Ki = mem::repeat_string(scratch.arena, payload_utf8, 128 * 1024 / 128),
         .utf16_4Ki = mem::repeat_string(scratch.arena, payload_utf16, 4 * 1024 / 128),
         .utf16_128Ki = mem::repeat_string(scratch.arena, payload_utf16, 128 * 1024 / 128),
+        .ascii_128Ki = mem::repeat_string(scratch.arena, payload_ascii, 128 * 1024 / 128),
+        .cjk_128Ki = mem::repeat_string(scratch.arena, payload_cjk, 128 * 1024 / 32),
+        .emoji_128Ki = mem::repeat_string(scratch.arena, payload_emoji, 128 * 1024 / 16),
     };
 
     prepare_conhost(ctx, parent_hwnd);
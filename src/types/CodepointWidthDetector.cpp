@@ -4,6 +4,10 @@
 #include "precomp.h"
 #include "inc/CodepointWidthDetector.hpp"
 
+#include <til/unicode.h>
+
+#include "../inc/unicode.hpp"
+
 namespace
 {
     // used to store range data in CodepointWidthDetector's internal map
@@ -323,6 +327,2001 @@ namespace
         UnicodeRange{ 0xf0000, 0xffffd, 1 },
         UnicodeRange{ 0x100000, 0x10fffd, 1 },
     };
+
+    // The Grapheme_Cluster_Break property as defined by UAX #29, with Extended_Pictographic folded in.
+    // Extended_Pictographic codepoints all have Grapheme_Cluster_Break=Other, which makes this lossless.
+    enum GraphemeBreak : uint8_t
+    {
+        Other,
+        CR,
+        LF,
+        Control,
+        Extend,
+        ZWJ,
+        RegionalIndicator,
+        Prepend,
+        SpacingMark,
+        L,
+        V,
+        T,
+        LV,
+        LVT,
+        ExtendedPictographic,
+        GraphemeBreakCount,
+    };
+
+    // Each entry marks the first codepoint of a run of codepoints sharing the same property.
+    struct GraphemeBreakRange final
+    {
+        char32_t lowerBound : 24;
+        char32_t property : 8;
+    };
+
+    static bool operator<(const unsigned int searchTerm, const GraphemeBreakRange& range) noexcept
+    {
+        return searchTerm < range.lowerBound;
+    }
+
+    // Unicode 15.0.0 Grapheme_Cluster_Break and Extended_Pictographic properties.
+    // Regenerate with .\tools\Generate-GraphemeBreakTableFromUCD.ps1.
+    static constexpr std::array<GraphemeBreakRange, 1853> s_graphemeBreakTable{
+        GraphemeBreakRange{ 0x0, Control },
+        GraphemeBreakRange{ 0xa, LF },
+        GraphemeBreakRange{ 0xb, Control },
+        GraphemeBreakRange{ 0xd, CR },
+        GraphemeBreakRange{ 0xe, Control },
+        GraphemeBreakRange{ 0x20, Other },
+        GraphemeBreakRange{ 0x7f, Control },
+        GraphemeBreakRange{ 0xa0, Other },
+        GraphemeBreakRange{ 0xa9, ExtendedPictographic },
+        GraphemeBreakRange{ 0xaa, Other },
+        GraphemeBreakRange{ 0xad, Control },
+        GraphemeBreakRange{ 0xae, ExtendedPictographic },
+        GraphemeBreakRange{ 0xaf, Other },
+        GraphemeBreakRange{ 0x300, Extend },
+        GraphemeBreakRange{ 0x370, Other },
+        GraphemeBreakRange{ 0x483, Extend },
+        GraphemeBreakRange{ 0x48a, Other },
+        GraphemeBreakRange{ 0x591, Extend },
+        GraphemeBreakRange{ 0x5be, Other },
+        GraphemeBreakRange{ 0x5bf, Extend },
+        GraphemeBreakRange{ 0x5c0, Other },
+        GraphemeBreakRange{ 0x5c1, Extend },
+        GraphemeBreakRange{ 0x5c3, Other },
+        GraphemeBreakRange{ 0x5c4, Extend },
+        GraphemeBreakRange{ 0x5c6, Other },
+        GraphemeBreakRange{ 0x5c7, Extend },
+        GraphemeBreakRange{ 0x5c8, Other },
+        GraphemeBreakRange{ 0x600, Prepend },
+        GraphemeBreakRange{ 0x606, Other },
+        GraphemeBreakRange{ 0x610, Extend },
+        GraphemeBreakRange{ 0x61b, Other },
+        GraphemeBreakRange{ 0x61c, Control },
+        GraphemeBreakRange{ 0x61d, Other },
+        GraphemeBreakRange{ 0x64b, Extend },
+        GraphemeBreakRange{ 0x660, Other },
+        GraphemeBreakRange{ 0x670, Extend },
+        GraphemeBreakRange{ 0x671, Other },
+        GraphemeBreakRange{ 0x6d6, Extend },
+        GraphemeBreakRange{ 0x6dd, Prepend },
+        GraphemeBreakRange{ 0x6de, Other },
+        GraphemeBreakRange{ 0x6df, Extend },
+        GraphemeBreakRange{ 0x6e5, Other },
+        GraphemeBreakRange{ 0x6e7, Extend },
+        GraphemeBreakRange{ 0x6e9, Other },
+        GraphemeBreakRange{ 0x6ea, Extend },
+        GraphemeBreakRange{ 0x6ee, Other },
+        GraphemeBreakRange{ 0x70f, Prepend },
+        GraphemeBreakRange{ 0x710, Other },
+        GraphemeBreakRange{ 0x711, Extend },
+        GraphemeBreakRange{ 0x712, Other },
+        GraphemeBreakRange{ 0x730, Extend },
+        GraphemeBreakRange{ 0x74b, Other },
+        GraphemeBreakRange{ 0x7a6, Extend },
+        GraphemeBreakRange{ 0x7b1, Other },
+        GraphemeBreakRange{ 0x7eb, Extend },
+        GraphemeBreakRange{ 0x7f4, Other },
+        GraphemeBreakRange{ 0x7fd, Extend },
+        GraphemeBreakRange{ 0x7fe, Other },
+        GraphemeBreakRange{ 0x816, Extend },
+        GraphemeBreakRange{ 0x81a, Other },
+        GraphemeBreakRange{ 0x81b, Extend },
+        GraphemeBreakRange{ 0x824, Other },
+        GraphemeBreakRange{ 0x825, Extend },
+        GraphemeBreakRange{ 0x828, Other },
+        GraphemeBreakRange{ 0x829, Extend },
+        GraphemeBreakRange{ 0x82e, Other },
+        GraphemeBreakRange{ 0x859, Extend },
+        GraphemeBreakRange{ 0x85c, Other },
+        GraphemeBreakRange{ 0x890, Prepend },
+        GraphemeBreakRange{ 0x892, Other },
+        GraphemeBreakRange{ 0x898, Extend },
+        GraphemeBreakRange{ 0x8a0, Other },
+        GraphemeBreakRange{ 0x8ca, Extend },
+        GraphemeBreakRange{ 0x8e2, Prepend },
+        GraphemeBreakRange{ 0x8e3, Extend },
+        GraphemeBreakRange{ 0x903, SpacingMark },
+        GraphemeBreakRange{ 0x904, Other },
+        GraphemeBreakRange{ 0x93a, Extend },
+        GraphemeBreakRange{ 0x93b, SpacingMark },
+        GraphemeBreakRange{ 0x93c, Extend },
+        GraphemeBreakRange{ 0x93d, Other },
+        GraphemeBreakRange{ 0x93e, SpacingMark },
+        GraphemeBreakRange{ 0x941, Extend },
+        GraphemeBreakRange{ 0x949, SpacingMark },
+        GraphemeBreakRange{ 0x94d, Extend },
+        GraphemeBreakRange{ 0x94e, SpacingMark },
+        GraphemeBreakRange{ 0x950, Other },
+        GraphemeBreakRange{ 0x951, Extend },
+        GraphemeBreakRange{ 0x958, Other },
+        GraphemeBreakRange{ 0x962, Extend },
+        GraphemeBreakRange{ 0x964, Other },
+        GraphemeBreakRange{ 0x981, Extend },
+        GraphemeBreakRange{ 0x982, SpacingMark },
+        GraphemeBreakRange{ 0x984, Other },
+        GraphemeBreakRange{ 0x9bc, Extend },
+        GraphemeBreakRange{ 0x9bd, Other },
+        GraphemeBreakRange{ 0x9be, Extend },
+        GraphemeBreakRange{ 0x9bf, SpacingMark },
+        GraphemeBreakRange{ 0x9c1, Extend },
+        GraphemeBreakRange{ 0x9c5, Other },
+        GraphemeBreakRange{ 0x9c7, SpacingMark },
+        GraphemeBreakRange{ 0x9c9, Other },
+        GraphemeBreakRange{ 0x9cb, SpacingMark },
+        GraphemeBreakRange{ 0x9cd, Extend },
+        GraphemeBreakRange{ 0x9ce, Other },
+        GraphemeBreakRange{ 0x9d7, Extend },
+        GraphemeBreakRange{ 0x9d8, Other },
+        GraphemeBreakRange{ 0x9e2, Extend },
+        GraphemeBreakRange{ 0x9e4, Other },
+        GraphemeBreakRange{ 0x9fe, Extend },
+        GraphemeBreakRange{ 0x9ff, Other },
+        GraphemeBreakRange{ 0xa01, Extend },
+        GraphemeBreakRange{ 0xa03, SpacingMark },
+        GraphemeBreakRange{ 0xa04, Other },
+        GraphemeBreakRange{ 0xa3c, Extend },
+        GraphemeBreakRange{ 0xa3d, Other },
+        GraphemeBreakRange{ 0xa3e, SpacingMark },
+        GraphemeBreakRange{ 0xa41, Extend },
+        GraphemeBreakRange{ 0xa43, Other },
+        GraphemeBreakRange{ 0xa47, Extend },
+        GraphemeBreakRange{ 0xa49, Other },
+        GraphemeBreakRange{ 0xa4b, Extend },
+        GraphemeBreakRange{ 0xa4e, Other },
+        GraphemeBreakRange{ 0xa51, Extend },
+        GraphemeBreakRange{ 0xa52, Other },
+        GraphemeBreakRange{ 0xa70, Extend },
+        GraphemeBreakRange{ 0xa72, Other },
+        GraphemeBreakRange{ 0xa75, Extend },
+        GraphemeBreakRange{ 0xa76, Other },
+        GraphemeBreakRange{ 0xa81, Extend },
+        GraphemeBreakRange{ 0xa83, SpacingMark },
+        GraphemeBreakRange{ 0xa84, Other },
+        GraphemeBreakRange{ 0xabc, Extend },
+        GraphemeBreakRange{ 0xabd, Other },
+        GraphemeBreakRange{ 0xabe, SpacingMark },
+        GraphemeBreakRange{ 0xac1, Extend },
+        GraphemeBreakRange{ 0xac6, Other },
+        GraphemeBreakRange{ 0xac7, Extend },
+        GraphemeBreakRange{ 0xac9, SpacingMark },
+        GraphemeBreakRange{ 0xaca, Other },
+        GraphemeBreakRange{ 0xacb, SpacingMark },
+        GraphemeBreakRange{ 0xacd, Extend },
+        GraphemeBreakRange{ 0xace, Other },
+        GraphemeBreakRange{ 0xae2, Extend },
+        GraphemeBreakRange{ 0xae4, Other },
+        GraphemeBreakRange{ 0xafa, Extend },
+        GraphemeBreakRange{ 0xb00, Other },
+        GraphemeBreakRange{ 0xb01, Extend },
+        GraphemeBreakRange{ 0xb02, SpacingMark },
+        GraphemeBreakRange{ 0xb04, Other },
+        GraphemeBreakRange{ 0xb3c, Extend },
+        GraphemeBreakRange{ 0xb3d, Other },
+        GraphemeBreakRange{ 0xb3e, Extend },
+        GraphemeBreakRange{ 0xb40, SpacingMark },
+        GraphemeBreakRange{ 0xb41, Extend },
+        GraphemeBreakRange{ 0xb45, Other },
+        GraphemeBreakRange{ 0xb47, SpacingMark },
+        GraphemeBreakRange{ 0xb49, Other },
+        GraphemeBreakRange{ 0xb4b, SpacingMark },
+        GraphemeBreakRange{ 0xb4d, Extend },
+        GraphemeBreakRange{ 0xb4e, Other },
+        GraphemeBreakRange{ 0xb55, Extend },
+        GraphemeBreakRange{ 0xb58, Other },
+        GraphemeBreakRange{ 0xb62, Extend },
+        GraphemeBreakRange{ 0xb64, Other },
+        GraphemeBreakRange{ 0xb82, Extend },
+        GraphemeBreakRange{ 0xb83, Other },
+        GraphemeBreakRange{ 0xbbe, Extend },
+        GraphemeBreakRange{ 0xbbf, SpacingMark },
+        GraphemeBreakRange{ 0xbc0, Extend },
+        GraphemeBreakRange{ 0xbc1, SpacingMark },
+        GraphemeBreakRange{ 0xbc3, Other },
+        GraphemeBreakRange{ 0xbc6, SpacingMark },
+        GraphemeBreakRange{ 0xbc9, Other },
+        GraphemeBreakRange{ 0xbca, SpacingMark },
+        GraphemeBreakRange{ 0xbcd, Extend },
+        GraphemeBreakRange{ 0xbce, Other },
+        GraphemeBreakRange{ 0xbd7, Extend },
+        GraphemeBreakRange{ 0xbd8, Other },
+        GraphemeBreakRange{ 0xc00, Extend },
+        GraphemeBreakRange{ 0xc01, SpacingMark },
+        GraphemeBreakRange{ 0xc04, Extend },
+        GraphemeBreakRange{ 0xc05, Other },
+        GraphemeBreakRange{ 0xc3c, Extend },
+        GraphemeBreakRange{ 0xc3d, Other },
+        GraphemeBreakRange{ 0xc3e, Extend },
+        GraphemeBreakRange{ 0xc41, SpacingMark },
+        GraphemeBreakRange{ 0xc45, Other },
+        GraphemeBreakRange{ 0xc46, Extend },
+        GraphemeBreakRange{ 0xc49, Other },
+        GraphemeBreakRange{ 0xc4a, Extend },
+        GraphemeBreakRange{ 0xc4e, Other },
+        GraphemeBreakRange{ 0xc55, Extend },
+        GraphemeBreakRange{ 0xc57, Other },
+        GraphemeBreakRange{ 0xc62, Extend },
+        GraphemeBreakRange{ 0xc64, Other },
+        GraphemeBreakRange{ 0xc81, Extend },
+        GraphemeBreakRange{ 0xc82, SpacingMark },
+        GraphemeBreakRange{ 0xc84, Other },
+        GraphemeBreakRange{ 0xcbc, Extend },
+        GraphemeBreakRange{ 0xcbd, Other },
+        GraphemeBreakRange{ 0xcbe, SpacingMark },
+        GraphemeBreakRange{ 0xcbf, Extend },
+        GraphemeBreakRange{ 0xcc0, SpacingMark },
+        GraphemeBreakRange{ 0xcc2, Extend },
+        GraphemeBreakRange{ 0xcc3, SpacingMark },
+        GraphemeBreakRange{ 0xcc5, Other },
+        GraphemeBreakRange{ 0xcc6, Extend },
+        GraphemeBreakRange{ 0xcc7, SpacingMark },
+        GraphemeBreakRange{ 0xcc9, Other },
+        GraphemeBreakRange{ 0xcca, SpacingMark },
+        GraphemeBreakRange{ 0xccc, Extend },
+        GraphemeBreakRange{ 0xcce, Other },
+        GraphemeBreakRange{ 0xcd5, Extend },
+        GraphemeBreakRange{ 0xcd7, Other },
+        GraphemeBreakRange{ 0xce2, Extend },
+        GraphemeBreakRange{ 0xce4, Other },
+        GraphemeBreakRange{ 0xcf3, SpacingMark },
+        GraphemeBreakRange{ 0xcf4, Other },
+        GraphemeBreakRange{ 0xd00, Extend },
+        GraphemeBreakRange{ 0xd02, SpacingMark },
+        GraphemeBreakRange{ 0xd04, Other },
+        GraphemeBreakRange{ 0xd3b, Extend },
+        GraphemeBreakRange{ 0xd3d, Other },
+        GraphemeBreakRange{ 0xd3e, Extend },
+        GraphemeBreakRange{ 0xd3f, SpacingMark },
+        GraphemeBreakRange{ 0xd41, Extend },
+        GraphemeBreakRange{ 0xd45, Other },
+        GraphemeBreakRange{ 0xd46, SpacingMark },
+        GraphemeBreakRange{ 0xd49, Other },
+        GraphemeBreakRange{ 0xd4a, SpacingMark },
+        GraphemeBreakRange{ 0xd4d, Extend },
+        GraphemeBreakRange{ 0xd4e, Prepend },
+        GraphemeBreakRange{ 0xd4f, Other },
+        GraphemeBreakRange{ 0xd57, Extend },
+        GraphemeBreakRange{ 0xd58, Other },
+        GraphemeBreakRange{ 0xd62, Extend },
+        GraphemeBreakRange{ 0xd64, Other },
+        GraphemeBreakRange{ 0xd81, Extend },
+        GraphemeBreakRange{ 0xd82, SpacingMark },
+        GraphemeBreakRange{ 0xd84, Other },
+        GraphemeBreakRange{ 0xdca, Extend },
+        GraphemeBreakRange{ 0xdcb, Other },
+        GraphemeBreakRange{ 0xdcf, Extend },
+        GraphemeBreakRange{ 0xdd0, SpacingMark },
+        GraphemeBreakRange{ 0xdd2, Extend },
+        GraphemeBreakRange{ 0xdd5, Other },
+        GraphemeBreakRange{ 0xdd6, Extend },
+        GraphemeBreakRange{ 0xdd7, Other },
+        GraphemeBreakRange{ 0xdd8, SpacingMark },
+        GraphemeBreakRange{ 0xddf, Extend },
+        GraphemeBreakRange{ 0xde0, Other },
+        GraphemeBreakRange{ 0xdf2, SpacingMark },
+        GraphemeBreakRange{ 0xdf4, Other },
+        GraphemeBreakRange{ 0xe31, Extend },
+        GraphemeBreakRange{ 0xe32, Other },
+        GraphemeBreakRange{ 0xe33, SpacingMark },
+        GraphemeBreakRange{ 0xe34, Extend },
+        GraphemeBreakRange{ 0xe3b, Other },
+        GraphemeBreakRange{ 0xe47, Extend },
+        GraphemeBreakRange{ 0xe4f, Other },
+        GraphemeBreakRange{ 0xeb1, Extend },
+        GraphemeBreakRange{ 0xeb2, Other },
+        GraphemeBreakRange{ 0xeb3, SpacingMark },
+        GraphemeBreakRange{ 0xeb4, Extend },
+        GraphemeBreakRange{ 0xebd, Other },
+        GraphemeBreakRange{ 0xec8, Extend },
+        GraphemeBreakRange{ 0xecf, Other },
+        GraphemeBreakRange{ 0xf18, Extend },
+        GraphemeBreakRange{ 0xf1a, Other },
+        GraphemeBreakRange{ 0xf35, Extend },
+        GraphemeBreakRange{ 0xf36, Other },
+        GraphemeBreakRange{ 0xf37, Extend },
+        GraphemeBreakRange{ 0xf38, Other },
+        GraphemeBreakRange{ 0xf39, Extend },
+        GraphemeBreakRange{ 0xf3a, Other },
+        GraphemeBreakRange{ 0xf3e, SpacingMark },
+        GraphemeBreakRange{ 0xf40, Other },
+        GraphemeBreakRange{ 0xf71, Extend },
+        GraphemeBreakRange{ 0xf7f, SpacingMark },
+        GraphemeBreakRange{ 0xf80, Extend },
+        GraphemeBreakRange{ 0xf85, Other },
+        GraphemeBreakRange{ 0xf86, Extend },
+        GraphemeBreakRange{ 0xf88, Other },
+        GraphemeBreakRange{ 0xf8d, Extend },
+        GraphemeBreakRange{ 0xf98, Other },
+        GraphemeBreakRange{ 0xf99, Extend },
+        GraphemeBreakRange{ 0xfbd, Other },
+        GraphemeBreakRange{ 0xfc6, Extend },
+        GraphemeBreakRange{ 0xfc7, Other },
+        GraphemeBreakRange{ 0x102d, Extend },
+        GraphemeBreakRange{ 0x1031, SpacingMark },
+        GraphemeBreakRange{ 0x1032, Extend },
+        GraphemeBreakRange{ 0x1038, Other },
+        GraphemeBreakRange{ 0x1039, Extend },
+        GraphemeBreakRange{ 0x103b, SpacingMark },
+        GraphemeBreakRange{ 0x103d, Extend },
+        GraphemeBreakRange{ 0x103f, Other },
+        GraphemeBreakRange{ 0x1056, SpacingMark },
+        GraphemeBreakRange{ 0x1058, Extend },
+        GraphemeBreakRange{ 0x105a, Other },
+        GraphemeBreakRange{ 0x105e, Extend },
+        GraphemeBreakRange{ 0x1061, Other },
+        GraphemeBreakRange{ 0x1071, Extend },
+        GraphemeBreakRange{ 0x1075, Other },
+        GraphemeBreakRange{ 0x1082, Extend },
+        GraphemeBreakRange{ 0x1083, Other },
+        GraphemeBreakRange{ 0x1084, SpacingMark },
+        GraphemeBreakRange{ 0x1085, Extend },
+        GraphemeBreakRange{ 0x1087, Other },
+        GraphemeBreakRange{ 0x108d, Extend },
+        GraphemeBreakRange{ 0x108e, Other },
+        GraphemeBreakRange{ 0x109d, Extend },
+        GraphemeBreakRange{ 0x109e, Other },
+        GraphemeBreakRange{ 0x1100, L },
+        GraphemeBreakRange{ 0x1160, V },
+        GraphemeBreakRange{ 0x11a8, T },
+        GraphemeBreakRange{ 0x1200, Other },
+        GraphemeBreakRange{ 0x135d, Extend },
+        GraphemeBreakRange{ 0x1360, Other },
+        GraphemeBreakRange{ 0x1712, Extend },
+        GraphemeBreakRange{ 0x1715, SpacingMark },
+        GraphemeBreakRange{ 0x1716, Other },
+        GraphemeBreakRange{ 0x1732, Extend },
+        GraphemeBreakRange{ 0x1734, SpacingMark },
+        GraphemeBreakRange{ 0x1735, Other },
+        GraphemeBreakRange{ 0x1752, Extend },
+        GraphemeBreakRange{ 0x1754, Other },
+        GraphemeBreakRange{ 0x1772, Extend },
+        GraphemeBreakRange{ 0x1774, Other },
+        GraphemeBreakRange{ 0x17b4, Extend },
+        GraphemeBreakRange{ 0x17b6, SpacingMark },
+        GraphemeBreakRange{ 0x17b7, Extend },
+        GraphemeBreakRange{ 0x17be, SpacingMark },
+        GraphemeBreakRange{ 0x17c6, Extend },
+        GraphemeBreakRange{ 0x17c7, SpacingMark },
+        GraphemeBreakRange{ 0x17c9, Extend },
+        GraphemeBreakRange{ 0x17d4, Other },
+        GraphemeBreakRange{ 0x17dd, Extend },
+        GraphemeBreakRange{ 0x17de, Other },
+        GraphemeBreakRange{ 0x180b, Extend },
+        GraphemeBreakRange{ 0x180e, Control },
+        GraphemeBreakRange{ 0x180f, Extend },
+        GraphemeBreakRange{ 0x1810, Other },
+        GraphemeBreakRange{ 0x1885, Extend },
+        GraphemeBreakRange{ 0x1887, Other },
+        GraphemeBreakRange{ 0x18a9, Extend },
+        GraphemeBreakRange{ 0x18aa, Other },
+        GraphemeBreakRange{ 0x1920, Extend },
+        GraphemeBreakRange{ 0x1923, SpacingMark },
+        GraphemeBreakRange{ 0x1927, Extend },
+        GraphemeBreakRange{ 0x1929, SpacingMark },
+        GraphemeBreakRange{ 0x192c, Other },
+        GraphemeBreakRange{ 0x1930, SpacingMark },
+        GraphemeBreakRange{ 0x1932, Extend },
+        GraphemeBreakRange{ 0x1933, SpacingMark },
+        GraphemeBreakRange{ 0x1939, Extend },
+        GraphemeBreakRange{ 0x193c, Other },
+        GraphemeBreakRange{ 0x1a17, Extend },
+        GraphemeBreakRange{ 0x1a19, SpacingMark },
+        GraphemeBreakRange{ 0x1a1b, Extend },
+        GraphemeBreakRange{ 0x1a1c, Other },
+        GraphemeBreakRange{ 0x1a55, SpacingMark },
+        GraphemeBreakRange{ 0x1a56, Extend },
+        GraphemeBreakRange{ 0x1a57, SpacingMark },
+        GraphemeBreakRange{ 0x1a58, Extend },
+        GraphemeBreakRange{ 0x1a5f, Other },
+        GraphemeBreakRange{ 0x1a60, Extend },
+        GraphemeBreakRange{ 0x1a61, Other },
+        GraphemeBreakRange{ 0x1a62, Extend },
+        GraphemeBreakRange{ 0x1a63, Other },
+        GraphemeBreakRange{ 0x1a65, Extend },
+        GraphemeBreakRange{ 0x1a6d, SpacingMark },
+        GraphemeBreakRange{ 0x1a73, Extend },
+        GraphemeBreakRange{ 0x1a7d, Other },
+        GraphemeBreakRange{ 0x1a7f, Extend },
+        GraphemeBreakRange{ 0x1a80, Other },
+        GraphemeBreakRange{ 0x1ab0, Extend },
+        GraphemeBreakRange{ 0x1acf, Other },
+        GraphemeBreakRange{ 0x1b00, Extend },
+        GraphemeBreakRange{ 0x1b04, SpacingMark },
+        GraphemeBreakRange{ 0x1b05, Other },
+        GraphemeBreakRange{ 0x1b34, Extend },
+        GraphemeBreakRange{ 0x1b3b, SpacingMark },
+        GraphemeBreakRange{ 0x1b3c, Extend },
+        GraphemeBreakRange{ 0x1b3d, SpacingMark },
+        GraphemeBreakRange{ 0x1b42, Extend },
+        GraphemeBreakRange{ 0x1b43, SpacingMark },
+        GraphemeBreakRange{ 0x1b45, Other },
+        GraphemeBreakRange{ 0x1b6b, Extend },
+        GraphemeBreakRange{ 0x1b74, Other },
+        GraphemeBreakRange{ 0x1b80, Extend },
+        GraphemeBreakRange{ 0x1b82, SpacingMark },
+        GraphemeBreakRange{ 0x1b83, Other },
+        GraphemeBreakRange{ 0x1ba1, SpacingMark },
+        GraphemeBreakRange{ 0x1ba2, Extend },
+        GraphemeBreakRange{ 0x1ba6, SpacingMark },
+        GraphemeBreakRange{ 0x1ba8, Extend },
+        GraphemeBreakRange{ 0x1baa, SpacingMark },
+        GraphemeBreakRange{ 0x1bab, Extend },
+        GraphemeBreakRange{ 0x1bae, Other },
+        GraphemeBreakRange{ 0x1be6, Extend },
+        GraphemeBreakRange{ 0x1be7, SpacingMark },
+        GraphemeBreakRange{ 0x1be8, Extend },
+        GraphemeBreakRange{ 0x1bea, SpacingMark },
+        GraphemeBreakRange{ 0x1bed, Extend },
+        GraphemeBreakRange{ 0x1bee, SpacingMark },
+        GraphemeBreakRange{ 0x1bef, Extend },
+        GraphemeBreakRange{ 0x1bf2, SpacingMark },
+        GraphemeBreakRange{ 0x1bf4, Other },
+        GraphemeBreakRange{ 0x1c24, SpacingMark },
+        GraphemeBreakRange{ 0x1c2c, Extend },
+        GraphemeBreakRange{ 0x1c34, SpacingMark },
+        GraphemeBreakRange{ 0x1c36, Extend },
+        GraphemeBreakRange{ 0x1c38, Other },
+        GraphemeBreakRange{ 0x1cd0, Extend },
+        GraphemeBreakRange{ 0x1cd3, Other },
+        GraphemeBreakRange{ 0x1cd4, Extend },
+        GraphemeBreakRange{ 0x1ce1, SpacingMark },
+        GraphemeBreakRange{ 0x1ce2, Extend },
+        GraphemeBreakRange{ 0x1ce9, Other },
+        GraphemeBreakRange{ 0x1ced, Extend },
+        GraphemeBreakRange{ 0x1cee, Other },
+        GraphemeBreakRange{ 0x1cf4, Extend },
+        GraphemeBreakRange{ 0x1cf5, Other },
+        GraphemeBreakRange{ 0x1cf7, SpacingMark },
+        GraphemeBreakRange{ 0x1cf8, Extend },
+        GraphemeBreakRange{ 0x1cfa, Other },
+        GraphemeBreakRange{ 0x1dc0, Extend },
+        GraphemeBreakRange{ 0x1e00, Other },
+        GraphemeBreakRange{ 0x200b, Control },
+        GraphemeBreakRange{ 0x200c, Extend },
+        GraphemeBreakRange{ 0x200d, ZWJ },
+        GraphemeBreakRange{ 0x200e, Control },
+        GraphemeBreakRange{ 0x2010, Other },
+        GraphemeBreakRange{ 0x2028, Control },
+        GraphemeBreakRange{ 0x202f, Other },
+        GraphemeBreakRange{ 0x203c, ExtendedPictographic },
+        GraphemeBreakRange{ 0x203d, Other },
+        GraphemeBreakRange{ 0x2049, ExtendedPictographic },
+        GraphemeBreakRange{ 0x204a, Other },
+        GraphemeBreakRange{ 0x2060, Control },
+        GraphemeBreakRange{ 0x2070, Other },
+        GraphemeBreakRange{ 0x20d0, Extend },
+        GraphemeBreakRange{ 0x20f1, Other },
+        GraphemeBreakRange{ 0x2122, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2123, Other },
+        GraphemeBreakRange{ 0x2139, ExtendedPictographic },
+        GraphemeBreakRange{ 0x213a, Other },
+        GraphemeBreakRange{ 0x2194, ExtendedPictographic },
+        GraphemeBreakRange{ 0x219a, Other },
+        GraphemeBreakRange{ 0x21a9, ExtendedPictographic },
+        GraphemeBreakRange{ 0x21ab, Other },
+        GraphemeBreakRange{ 0x231a, ExtendedPictographic },
+        GraphemeBreakRange{ 0x231c, Other },
+        GraphemeBreakRange{ 0x2328, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2329, Other },
+        GraphemeBreakRange{ 0x2388, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2389, Other },
+        GraphemeBreakRange{ 0x23cf, ExtendedPictographic },
+        GraphemeBreakRange{ 0x23d0, Other },
+        GraphemeBreakRange{ 0x23e9, ExtendedPictographic },
+        GraphemeBreakRange{ 0x23f4, Other },
+        GraphemeBreakRange{ 0x23f8, ExtendedPictographic },
+        GraphemeBreakRange{ 0x23fb, Other },
+        GraphemeBreakRange{ 0x24c2, ExtendedPictographic },
+        GraphemeBreakRange{ 0x24c3, Other },
+        GraphemeBreakRange{ 0x25aa, ExtendedPictographic },
+        GraphemeBreakRange{ 0x25ac, Other },
+        GraphemeBreakRange{ 0x25b6, ExtendedPictographic },
+        GraphemeBreakRange{ 0x25b7, Other },
+        GraphemeBreakRange{ 0x25c0, ExtendedPictographic },
+        GraphemeBreakRange{ 0x25c1, Other },
+        GraphemeBreakRange{ 0x25fb, ExtendedPictographic },
+        GraphemeBreakRange{ 0x25ff, Other },
+        GraphemeBreakRange{ 0x2600, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2606, Other },
+        GraphemeBreakRange{ 0x2607, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2613, Other },
+        GraphemeBreakRange{ 0x2614, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2686, Other },
+        GraphemeBreakRange{ 0x2690, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2706, Other },
+        GraphemeBreakRange{ 0x2708, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2713, Other },
+        GraphemeBreakRange{ 0x2714, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2715, Other },
+        GraphemeBreakRange{ 0x2716, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2717, Other },
+        GraphemeBreakRange{ 0x271d, ExtendedPictographic },
+        GraphemeBreakRange{ 0x271e, Other },
+        GraphemeBreakRange{ 0x2721, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2722, Other },
+        GraphemeBreakRange{ 0x2728, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2729, Other },
+        GraphemeBreakRange{ 0x2733, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2735, Other },
+        GraphemeBreakRange{ 0x2744, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2745, Other },
+        GraphemeBreakRange{ 0x2747, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2748, Other },
+        GraphemeBreakRange{ 0x274c, ExtendedPictographic },
+        GraphemeBreakRange{ 0x274d, Other },
+        GraphemeBreakRange{ 0x274e, ExtendedPictographic },
+        GraphemeBreakRange{ 0x274f, Other },
+        GraphemeBreakRange{ 0x2753, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2756, Other },
+        GraphemeBreakRange{ 0x2757, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2758, Other },
+        GraphemeBreakRange{ 0x2763, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2768, Other },
+        GraphemeBreakRange{ 0x2795, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2798, Other },
+        GraphemeBreakRange{ 0x27a1, ExtendedPictographic },
+        GraphemeBreakRange{ 0x27a2, Other },
+        GraphemeBreakRange{ 0x27b0, ExtendedPictographic },
+        GraphemeBreakRange{ 0x27b1, Other },
+        GraphemeBreakRange{ 0x27bf, ExtendedPictographic },
+        GraphemeBreakRange{ 0x27c0, Other },
+        GraphemeBreakRange{ 0x2934, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2936, Other },
+        GraphemeBreakRange{ 0x2b05, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2b08, Other },
+        GraphemeBreakRange{ 0x2b1b, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2b1d, Other },
+        GraphemeBreakRange{ 0x2b50, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2b51, Other },
+        GraphemeBreakRange{ 0x2b55, ExtendedPictographic },
+        GraphemeBreakRange{ 0x2b56, Other },
+        GraphemeBreakRange{ 0x2cef, Extend },
+        GraphemeBreakRange{ 0x2cf2, Other },
+        GraphemeBreakRange{ 0x2d7f, Extend },
+        GraphemeBreakRange{ 0x2d80, Other },
+        GraphemeBreakRange{ 0x2de0, Extend },
+        GraphemeBreakRange{ 0x2e00, Other },
+        GraphemeBreakRange{ 0x302a, Extend },
+        GraphemeBreakRange{ 0x3030, ExtendedPictographic },
+        GraphemeBreakRange{ 0x3031, Other },
+        GraphemeBreakRange{ 0x303d, ExtendedPictographic },
+        GraphemeBreakRange{ 0x303e, Other },
+        GraphemeBreakRange{ 0x3099, Extend },
+        GraphemeBreakRange{ 0x309b, Other },
+        GraphemeBreakRange{ 0x3297, ExtendedPictographic },
+        GraphemeBreakRange{ 0x3298, Other },
+        GraphemeBreakRange{ 0x3299, ExtendedPictographic },
+        GraphemeBreakRange{ 0x329a, Other },
+        GraphemeBreakRange{ 0xa66f, Extend },
+        GraphemeBreakRange{ 0xa673, Other },
+        GraphemeBreakRange{ 0xa674, Extend },
+        GraphemeBreakRange{ 0xa67e, Other },
+        GraphemeBreakRange{ 0xa69e, Extend },
+        GraphemeBreakRange{ 0xa6a0, Other },
+        GraphemeBreakRange{ 0xa6f0, Extend },
+        GraphemeBreakRange{ 0xa6f2, Other },
+        GraphemeBreakRange{ 0xa802, Extend },
+        GraphemeBreakRange{ 0xa803, Other },
+        GraphemeBreakRange{ 0xa806, Extend },
+        GraphemeBreakRange{ 0xa807, Other },
+        GraphemeBreakRange{ 0xa80b, Extend },
+        GraphemeBreakRange{ 0xa80c, Other },
+        GraphemeBreakRange{ 0xa823, SpacingMark },
+        GraphemeBreakRange{ 0xa825, Extend },
+        GraphemeBreakRange{ 0xa827, SpacingMark },
+        GraphemeBreakRange{ 0xa828, Other },
+        GraphemeBreakRange{ 0xa82c, Extend },
+        GraphemeBreakRange{ 0xa82d, Other },
+        GraphemeBreakRange{ 0xa880, SpacingMark },
+        GraphemeBreakRange{ 0xa882, Other },
+        GraphemeBreakRange{ 0xa8b4, SpacingMark },
+        GraphemeBreakRange{ 0xa8c4, Extend },
+        GraphemeBreakRange{ 0xa8c6, Other },
+        GraphemeBreakRange{ 0xa8e0, Extend },
+        GraphemeBreakRange{ 0xa8f2, Other },
+        GraphemeBreakRange{ 0xa8ff, Extend },
+        GraphemeBreakRange{ 0xa900, Other },
+        GraphemeBreakRange{ 0xa926, Extend },
+        GraphemeBreakRange{ 0xa92e, Other },
+        GraphemeBreakRange{ 0xa947, Extend },
+        GraphemeBreakRange{ 0xa952, SpacingMark },
+        GraphemeBreakRange{ 0xa954, Other },
+        GraphemeBreakRange{ 0xa960, L },
+        GraphemeBreakRange{ 0xa97d, Other },
+        GraphemeBreakRange{ 0xa980, Extend },
+        GraphemeBreakRange{ 0xa983, SpacingMark },
+        GraphemeBreakRange{ 0xa984, Other },
+        GraphemeBreakRange{ 0xa9b3, Extend },
+        GraphemeBreakRange{ 0xa9b4, SpacingMark },
+        GraphemeBreakRange{ 0xa9b6, Extend },
+        GraphemeBreakRange{ 0xa9ba, SpacingMark },
+        GraphemeBreakRange{ 0xa9bc, Extend },
+        GraphemeBreakRange{ 0xa9be, SpacingMark },
+        GraphemeBreakRange{ 0xa9c1, Other },
+        GraphemeBreakRange{ 0xa9e5, Extend },
+        GraphemeBreakRange{ 0xa9e6, Other },
+        GraphemeBreakRange{ 0xaa29, Extend },
+        GraphemeBreakRange{ 0xaa2f, SpacingMark },
+        GraphemeBreakRange{ 0xaa31, Extend },
+        GraphemeBreakRange{ 0xaa33, SpacingMark },
+        GraphemeBreakRange{ 0xaa35, Extend },
+        GraphemeBreakRange{ 0xaa37, Other },
+        GraphemeBreakRange{ 0xaa43, Extend },
+        GraphemeBreakRange{ 0xaa44, Other },
+        GraphemeBreakRange{ 0xaa4c, Extend },
+        GraphemeBreakRange{ 0xaa4d, SpacingMark },
+        GraphemeBreakRange{ 0xaa4e, Other },
+        GraphemeBreakRange{ 0xaa7c, Extend },
+        GraphemeBreakRange{ 0xaa7d, Other },
+        GraphemeBreakRange{ 0xaab0, Extend },
+        GraphemeBreakRange{ 0xaab1, Other },
+        GraphemeBreakRange{ 0xaab2, Extend },
+        GraphemeBreakRange{ 0xaab5, Other },
+        GraphemeBreakRange{ 0xaab7, Extend },
+        GraphemeBreakRange{ 0xaab9, Other },
+        GraphemeBreakRange{ 0xaabe, Extend },
+        GraphemeBreakRange{ 0xaac0, Other },
+        GraphemeBreakRange{ 0xaac1, Extend },
+        GraphemeBreakRange{ 0xaac2, Other },
+        GraphemeBreakRange{ 0xaaeb, SpacingMark },
+        GraphemeBreakRange{ 0xaaec, Extend },
+        GraphemeBreakRange{ 0xaaee, SpacingMark },
+        GraphemeBreakRange{ 0xaaf0, Other },
+        GraphemeBreakRange{ 0xaaf5, SpacingMark },
+        GraphemeBreakRange{ 0xaaf6, Extend },
+        GraphemeBreakRange{ 0xaaf7, Other },
+        GraphemeBreakRange{ 0xabe3, SpacingMark },
+        GraphemeBreakRange{ 0xabe5, Extend },
+        GraphemeBreakRange{ 0xabe6, SpacingMark },
+        GraphemeBreakRange{ 0xabe8, Extend },
+        GraphemeBreakRange{ 0xabe9, SpacingMark },
+        GraphemeBreakRange{ 0xabeb, Other },
+        GraphemeBreakRange{ 0xabec, SpacingMark },
+        GraphemeBreakRange{ 0xabed, Extend },
+        GraphemeBreakRange{ 0xabee, Other },
+        GraphemeBreakRange{ 0xac00, LV },
+        GraphemeBreakRange{ 0xac01, LVT },
+        GraphemeBreakRange{ 0xac1c, LV },
+        GraphemeBreakRange{ 0xac1d, LVT },
+        GraphemeBreakRange{ 0xac38, LV },
+        GraphemeBreakRange{ 0xac39, LVT },
+        GraphemeBreakRange{ 0xac54, LV },
+        GraphemeBreakRange{ 0xac55, LVT },
+        GraphemeBreakRange{ 0xac70, LV },
+        GraphemeBreakRange{ 0xac71, LVT },
+        GraphemeBreakRange{ 0xac8c, LV },
+        GraphemeBreakRange{ 0xac8d, LVT },
+        GraphemeBreakRange{ 0xaca8, LV },
+        GraphemeBreakRange{ 0xaca9, LVT },
+        GraphemeBreakRange{ 0xacc4, LV },
+        GraphemeBreakRange{ 0xacc5, LVT },
+        GraphemeBreakRange{ 0xace0, LV },
+        GraphemeBreakRange{ 0xace1, LVT },
+        GraphemeBreakRange{ 0xacfc, LV },
+        GraphemeBreakRange{ 0xacfd, LVT },
+        GraphemeBreakRange{ 0xad18, LV },
+        GraphemeBreakRange{ 0xad19, LVT },
+        GraphemeBreakRange{ 0xad34, LV },
+        GraphemeBreakRange{ 0xad35, LVT },
+        GraphemeBreakRange{ 0xad50, LV },
+        GraphemeBreakRange{ 0xad51, LVT },
+        GraphemeBreakRange{ 0xad6c, LV },
+        GraphemeBreakRange{ 0xad6d, LVT },
+        GraphemeBreakRange{ 0xad88, LV },
+        GraphemeBreakRange{ 0xad89, LVT },
+        GraphemeBreakRange{ 0xada4, LV },
+        GraphemeBreakRange{ 0xada5, LVT },
+        GraphemeBreakRange{ 0xadc0, LV },
+        GraphemeBreakRange{ 0xadc1, LVT },
+        GraphemeBreakRange{ 0xaddc, LV },
+        GraphemeBreakRange{ 0xaddd, LVT },
+        GraphemeBreakRange{ 0xadf8, LV },
+        GraphemeBreakRange{ 0xadf9, LVT },
+        GraphemeBreakRange{ 0xae14, LV },
+        GraphemeBreakRange{ 0xae15, LVT },
+        GraphemeBreakRange{ 0xae30, LV },
+        GraphemeBreakRange{ 0xae31, LVT },
+        GraphemeBreakRange{ 0xae4c, LV },
+        GraphemeBreakRange{ 0xae4d, LVT },
+        GraphemeBreakRange{ 0xae68, LV },
+        GraphemeBreakRange{ 0xae69, LVT },
+        GraphemeBreakRange{ 0xae84, LV },
+        GraphemeBreakRange{ 0xae85, LVT },
+        GraphemeBreakRange{ 0xaea0, LV },
+        GraphemeBreakRange{ 0xaea1, LVT },
+        GraphemeBreakRange{ 0xaebc, LV },
+        GraphemeBreakRange{ 0xaebd, LVT },
+        GraphemeBreakRange{ 0xaed8, LV },
+        GraphemeBreakRange{ 0xaed9, LVT },
+        GraphemeBreakRange{ 0xaef4, LV },
+        GraphemeBreakRange{ 0xaef5, LVT },
+        GraphemeBreakRange{ 0xaf10, LV },
+        GraphemeBreakRange{ 0xaf11, LVT },
+        GraphemeBreakRange{ 0xaf2c, LV },
+        GraphemeBreakRange{ 0xaf2d, LVT },
+        GraphemeBreakRange{ 0xaf48, LV },
+        GraphemeBreakRange{ 0xaf49, LVT },
+        GraphemeBreakRange{ 0xaf64, LV },
+        GraphemeBreakRange{ 0xaf65, LVT },
+        GraphemeBreakRange{ 0xaf80, LV },
+        GraphemeBreakRange{ 0xaf81, LVT },
+        GraphemeBreakRange{ 0xaf9c, LV },
+        GraphemeBreakRange{ 0xaf9d, LVT },
+        GraphemeBreakRange{ 0xafb8, LV },
+        GraphemeBreakRange{ 0xafb9, LVT },
+        GraphemeBreakRange{ 0xafd4, LV },
+        GraphemeBreakRange{ 0xafd5, LVT },
+        GraphemeBreakRange{ 0xaff0, LV },
+        GraphemeBreakRange{ 0xaff1, LVT },
+        GraphemeBreakRange{ 0xb00c, LV },
+        GraphemeBreakRange{ 0xb00d, LVT },
+        GraphemeBreakRange{ 0xb028, LV },
+        GraphemeBreakRange{ 0xb029, LVT },
+        GraphemeBreakRange{ 0xb044, LV },
+        GraphemeBreakRange{ 0xb045, LVT },
+        GraphemeBreakRange{ 0xb060, LV },
+        GraphemeBreakRange{ 0xb061, LVT },
+        GraphemeBreakRange{ 0xb07c, LV },
+        GraphemeBreakRange{ 0xb07d, LVT },
+        GraphemeBreakRange{ 0xb098, LV },
+        GraphemeBreakRange{ 0xb099, LVT },
+        GraphemeBreakRange{ 0xb0b4, LV },
+        GraphemeBreakRange{ 0xb0b5, LVT },
+        GraphemeBreakRange{ 0xb0d0, LV },
+        GraphemeBreakRange{ 0xb0d1, LVT },
+        GraphemeBreakRange{ 0xb0ec, LV },
+        GraphemeBreakRange{ 0xb0ed, LVT },
+        GraphemeBreakRange{ 0xb108, LV },
+        GraphemeBreakRange{ 0xb109, LVT },
+        GraphemeBreakRange{ 0xb124, LV },
+        GraphemeBreakRange{ 0xb125, LVT },
+        GraphemeBreakRange{ 0xb140, LV },
+        GraphemeBreakRange{ 0xb141, LVT },
+        GraphemeBreakRange{ 0xb15c, LV },
+        GraphemeBreakRange{ 0xb15d, LVT },
+        GraphemeBreakRange{ 0xb178, LV },
+        GraphemeBreakRange{ 0xb179, LVT },
+        GraphemeBreakRange{ 0xb194, LV },
+        GraphemeBreakRange{ 0xb195, LVT },
+        GraphemeBreakRange{ 0xb1b0, LV },
+        GraphemeBreakRange{ 0xb1b1, LVT },
+        GraphemeBreakRange{ 0xb1cc, LV },
+        GraphemeBreakRange{ 0xb1cd, LVT },
+        GraphemeBreakRange{ 0xb1e8, LV },
+        GraphemeBreakRange{ 0xb1e9, LVT },
+        GraphemeBreakRange{ 0xb204, LV },
+        GraphemeBreakRange{ 0xb205, LVT },
+        GraphemeBreakRange{ 0xb220, LV },
+        GraphemeBreakRange{ 0xb221, LVT },
+        GraphemeBreakRange{ 0xb23c, LV },
+        GraphemeBreakRange{ 0xb23d, LVT },
+        GraphemeBreakRange{ 0xb258, LV },
+        GraphemeBreakRange{ 0xb259, LVT },
+        GraphemeBreakRange{ 0xb274, LV },
+        GraphemeBreakRange{ 0xb275, LVT },
+        GraphemeBreakRange{ 0xb290, LV },
+        GraphemeBreakRange{ 0xb291, LVT },
+        GraphemeBreakRange{ 0xb2ac, LV },
+        GraphemeBreakRange{ 0xb2ad, LVT },
+        GraphemeBreakRange{ 0xb2c8, LV },
+        GraphemeBreakRange{ 0xb2c9, LVT },
+        GraphemeBreakRange{ 0xb2e4, LV },
+        GraphemeBreakRange{ 0xb2e5, LVT },
+        GraphemeBreakRange{ 0xb300, LV },
+        GraphemeBreakRange{ 0xb301, LVT },
+        GraphemeBreakRange{ 0xb31c, LV },
+        GraphemeBreakRange{ 0xb31d, LVT },
+        GraphemeBreakRange{ 0xb338, LV },
+        GraphemeBreakRange{ 0xb339, LVT },
+        GraphemeBreakRange{ 0xb354, LV },
+        GraphemeBreakRange{ 0xb355, LVT },
+        GraphemeBreakRange{ 0xb370, LV },
+        GraphemeBreakRange{ 0xb371, LVT },
+        GraphemeBreakRange{ 0xb38c, LV },
+        GraphemeBreakRange{ 0xb38d, LVT },
+        GraphemeBreakRange{ 0xb3a8, LV },
+        GraphemeBreakRange{ 0xb3a9, LVT },
+        GraphemeBreakRange{ 0xb3c4, LV },
+        GraphemeBreakRange{ 0xb3c5, LVT },
+        GraphemeBreakRange{ 0xb3e0, LV },
+        GraphemeBreakRange{ 0xb3e1, LVT },
+        GraphemeBreakRange{ 0xb3fc, LV },
+        GraphemeBreakRange{ 0xb3fd, LVT },
+        GraphemeBreakRange{ 0xb418, LV },
+        GraphemeBreakRange{ 0xb419, LVT },
+        GraphemeBreakRange{ 0xb434, LV },
+        GraphemeBreakRange{ 0xb435, LVT },
+        GraphemeBreakRange{ 0xb450, LV },
+        GraphemeBreakRange{ 0xb451, LVT },
+        GraphemeBreakRange{ 0xb46c, LV },
+        GraphemeBreakRange{ 0xb46d, LVT },
+        GraphemeBreakRange{ 0xb488, LV },
+        GraphemeBreakRange{ 0xb489, LVT },
+        GraphemeBreakRange{ 0xb4a4, LV },
+        GraphemeBreakRange{ 0xb4a5, LVT },
+        GraphemeBreakRange{ 0xb4c0, LV },
+        GraphemeBreakRange{ 0xb4c1, LVT },
+        GraphemeBreakRange{ 0xb4dc, LV },
+        GraphemeBreakRange{ 0xb4dd, LVT },
+        GraphemeBreakRange{ 0xb4f8, LV },
+        GraphemeBreakRange{ 0xb4f9, LVT },
+        GraphemeBreakRange{ 0xb514, LV },
+        GraphemeBreakRange{ 0xb515, LVT },
+        GraphemeBreakRange{ 0xb530, LV },
+        GraphemeBreakRange{ 0xb531, LVT },
+        GraphemeBreakRange{ 0xb54c, LV },
+        GraphemeBreakRange{ 0xb54d, LVT },
+        GraphemeBreakRange{ 0xb568, LV },
+        GraphemeBreakRange{ 0xb569, LVT },
+        GraphemeBreakRange{ 0xb584, LV },
+        GraphemeBreakRange{ 0xb585, LVT },
+        GraphemeBreakRange{ 0xb5a0, LV },
+        GraphemeBreakRange{ 0xb5a1, LVT },
+        GraphemeBreakRange{ 0xb5bc, LV },
+        GraphemeBreakRange{ 0xb5bd, LVT },
+        GraphemeBreakRange{ 0xb5d8, LV },
+        GraphemeBreakRange{ 0xb5d9, LVT },
+        GraphemeBreakRange{ 0xb5f4, LV },
+        GraphemeBreakRange{ 0xb5f5, LVT },
+        GraphemeBreakRange{ 0xb610, LV },
+        GraphemeBreakRange{ 0xb611, LVT },
+        GraphemeBreakRange{ 0xb62c, LV },
+        GraphemeBreakRange{ 0xb62d, LVT },
+        GraphemeBreakRange{ 0xb648, LV },
+        GraphemeBreakRange{ 0xb649, LVT },
+        GraphemeBreakRange{ 0xb664, LV },
+        GraphemeBreakRange{ 0xb665, LVT },
+        GraphemeBreakRange{ 0xb680, LV },
+        GraphemeBreakRange{ 0xb681, LVT },
+        GraphemeBreakRange{ 0xb69c, LV },
+        GraphemeBreakRange{ 0xb69d, LVT },
+        GraphemeBreakRange{ 0xb6b8, LV },
+        GraphemeBreakRange{ 0xb6b9, LVT },
+        GraphemeBreakRange{ 0xb6d4, LV },
+        GraphemeBreakRange{ 0xb6d5, LVT },
+        GraphemeBreakRange{ 0xb6f0, LV },
+        GraphemeBreakRange{ 0xb6f1, LVT },
+        GraphemeBreakRange{ 0xb70c, LV },
+        GraphemeBreakRange{ 0xb70d, LVT },
+        GraphemeBreakRange{ 0xb728, LV },
+        GraphemeBreakRange{ 0xb729, LVT },
+        GraphemeBreakRange{ 0xb744, LV },
+        GraphemeBreakRange{ 0xb745, LVT },
+        GraphemeBreakRange{ 0xb760, LV },
+        GraphemeBreakRange{ 0xb761, LVT },
+        GraphemeBreakRange{ 0xb77c, LV },
+        GraphemeBreakRange{ 0xb77d, LVT },
+        GraphemeBreakRange{ 0xb798, LV },
+        GraphemeBreakRange{ 0xb799, LVT },
+        GraphemeBreakRange{ 0xb7b4, LV },
+        GraphemeBreakRange{ 0xb7b5, LVT },
+        GraphemeBreakRange{ 0xb7d0, LV },
+        GraphemeBreakRange{ 0xb7d1, LVT },
+        GraphemeBreakRange{ 0xb7ec, LV },
+        GraphemeBreakRange{ 0xb7ed, LVT },
+        GraphemeBreakRange{ 0xb808, LV },
+        GraphemeBreakRange{ 0xb809, LVT },
+        GraphemeBreakRange{ 0xb824, LV },
+        GraphemeBreakRange{ 0xb825, LVT },
+        GraphemeBreakRange{ 0xb840, LV },
+        GraphemeBreakRange{ 0xb841, LVT },
+        GraphemeBreakRange{ 0xb85c, LV },
+        GraphemeBreakRange{ 0xb85d, LVT },
+        GraphemeBreakRange{ 0xb878, LV },
+        GraphemeBreakRange{ 0xb879, LVT },
+        GraphemeBreakRange{ 0xb894, LV },
+        GraphemeBreakRange{ 0xb895, LVT },
+        GraphemeBreakRange{ 0xb8b0, LV },
+        GraphemeBreakRange{ 0xb8b1, LVT },
+        GraphemeBreakRange{ 0xb8cc, LV },
+        GraphemeBreakRange{ 0xb8cd, LVT },
+        GraphemeBreakRange{ 0xb8e8, LV },
+        GraphemeBreakRange{ 0xb8e9, LVT },
+        GraphemeBreakRange{ 0xb904, LV },
+        GraphemeBreakRange{ 0xb905, LVT },
+        GraphemeBreakRange{ 0xb920, LV },
+        GraphemeBreakRange{ 0xb921, LVT },
+        GraphemeBreakRange{ 0xb93c, LV },
+        GraphemeBreakRange{ 0xb93d, LVT },
+        GraphemeBreakRange{ 0xb958, LV },
+        GraphemeBreakRange{ 0xb959, LVT },
+        GraphemeBreakRange{ 0xb974, LV },
+        GraphemeBreakRange{ 0xb975, LVT },
+        GraphemeBreakRange{ 0xb990, LV },
+        GraphemeBreakRange{ 0xb991, LVT },
+        GraphemeBreakRange{ 0xb9ac, LV },
+        GraphemeBreakRange{ 0xb9ad, LVT },
+        GraphemeBreakRange{ 0xb9c8, LV },
+        GraphemeBreakRange{ 0xb9c9, LVT },
+        GraphemeBreakRange{ 0xb9e4, LV },
+        GraphemeBreakRange{ 0xb9e5, LVT },
+        GraphemeBreakRange{ 0xba00, LV },
+        GraphemeBreakRange{ 0xba01, LVT },
+        GraphemeBreakRange{ 0xba1c, LV },
+        GraphemeBreakRange{ 0xba1d, LVT },
+        GraphemeBreakRange{ 0xba38, LV },
+        GraphemeBreakRange{ 0xba39, LVT },
+        GraphemeBreakRange{ 0xba54, LV },
+        GraphemeBreakRange{ 0xba55, LVT },
+        GraphemeBreakRange{ 0xba70, LV },
+        GraphemeBreakRange{ 0xba71, LVT },
+        GraphemeBreakRange{ 0xba8c, LV },
+        GraphemeBreakRange{ 0xba8d, LVT },
+        GraphemeBreakRange{ 0xbaa8, LV },
+        GraphemeBreakRange{ 0xbaa9, LVT },
+        GraphemeBreakRange{ 0xbac4, LV },
+        GraphemeBreakRange{ 0xbac5, LVT },
+        GraphemeBreakRange{ 0xbae0, LV },
+        GraphemeBreakRange{ 0xbae1, LVT },
+        GraphemeBreakRange{ 0xbafc, LV },
+        GraphemeBreakRange{ 0xbafd, LVT },
+        GraphemeBreakRange{ 0xbb18, LV },
+        GraphemeBreakRange{ 0xbb19, LVT },
+        GraphemeBreakRange{ 0xbb34, LV },
+        GraphemeBreakRange{ 0xbb35, LVT },
+        GraphemeBreakRange{ 0xbb50, LV },
+        GraphemeBreakRange{ 0xbb51, LVT },
+        GraphemeBreakRange{ 0xbb6c, LV },
+        GraphemeBreakRange{ 0xbb6d, LVT },
+        GraphemeBreakRange{ 0xbb88, LV },
+        GraphemeBreakRange{ 0xbb89, LVT },
+        GraphemeBreakRange{ 0xbba4, LV },
+        GraphemeBreakRange{ 0xbba5, LVT },
+        GraphemeBreakRange{ 0xbbc0, LV },
+        GraphemeBreakRange{ 0xbbc1, LVT },
+        GraphemeBreakRange{ 0xbbdc, LV },
+        GraphemeBreakRange{ 0xbbdd, LVT },
+        GraphemeBreakRange{ 0xbbf8, LV },
+        GraphemeBreakRange{ 0xbbf9, LVT },
+        GraphemeBreakRange{ 0xbc14, LV },
+        GraphemeBreakRange{ 0xbc15, LVT },
+        GraphemeBreakRange{ 0xbc30, LV },
+        GraphemeBreakRange{ 0xbc31, LVT },
+        GraphemeBreakRange{ 0xbc4c, LV },
+        GraphemeBreakRange{ 0xbc4d, LVT },
+        GraphemeBreakRange{ 0xbc68, LV },
+        GraphemeBreakRange{ 0xbc69, LVT },
+        GraphemeBreakRange{ 0xbc84, LV },
+        GraphemeBreakRange{ 0xbc85, LVT },
+        GraphemeBreakRange{ 0xbca0, LV },
+        GraphemeBreakRange{ 0xbca1, LVT },
+        GraphemeBreakRange{ 0xbcbc, LV },
+        GraphemeBreakRange{ 0xbcbd, LVT },
+        GraphemeBreakRange{ 0xbcd8, LV },
+        GraphemeBreakRange{ 0xbcd9, LVT },
+        GraphemeBreakRange{ 0xbcf4, LV },
+        GraphemeBreakRange{ 0xbcf5, LVT },
+        GraphemeBreakRange{ 0xbd10, LV },
+        GraphemeBreakRange{ 0xbd11, LVT },
+        GraphemeBreakRange{ 0xbd2c, LV },
+        GraphemeBreakRange{ 0xbd2d, LVT },
+        GraphemeBreakRange{ 0xbd48, LV },
+        GraphemeBreakRange{ 0xbd49, LVT },
+        GraphemeBreakRange{ 0xbd64, LV },
+        GraphemeBreakRange{ 0xbd65, LVT },
+        GraphemeBreakRange{ 0xbd80, LV },
+        GraphemeBreakRange{ 0xbd81, LVT },
+        GraphemeBreakRange{ 0xbd9c, LV },
+        GraphemeBreakRange{ 0xbd9d, LVT },
+        GraphemeBreakRange{ 0xbdb8, LV },
+        GraphemeBreakRange{ 0xbdb9, LVT },
+        GraphemeBreakRange{ 0xbdd4, LV },
+        GraphemeBreakRange{ 0xbdd5, LVT },
+        GraphemeBreakRange{ 0xbdf0, LV },
+        GraphemeBreakRange{ 0xbdf1, LVT },
+        GraphemeBreakRange{ 0xbe0c, LV },
+        GraphemeBreakRange{ 0xbe0d, LVT },
+        GraphemeBreakRange{ 0xbe28, LV },
+        GraphemeBreakRange{ 0xbe29, LVT },
+        GraphemeBreakRange{ 0xbe44, LV },
+        GraphemeBreakRange{ 0xbe45, LVT },
+        GraphemeBreakRange{ 0xbe60, LV },
+        GraphemeBreakRange{ 0xbe61, LVT },
+        GraphemeBreakRange{ 0xbe7c, LV },
+        GraphemeBreakRange{ 0xbe7d, LVT },
+        GraphemeBreakRange{ 0xbe98, LV },
+        GraphemeBreakRange{ 0xbe99, LVT },
+        GraphemeBreakRange{ 0xbeb4, LV },
+        GraphemeBreakRange{ 0xbeb5, LVT },
+        GraphemeBreakRange{ 0xbed0, LV },
+        GraphemeBreakRange{ 0xbed1, LVT },
+        GraphemeBreakRange{ 0xbeec, LV },
+        GraphemeBreakRange{ 0xbeed, LVT },
+        GraphemeBreakRange{ 0xbf08, LV },
+        GraphemeBreakRange{ 0xbf09, LVT },
+        GraphemeBreakRange{ 0xbf24, LV },
+        GraphemeBreakRange{ 0xbf25, LVT },
+        GraphemeBreakRange{ 0xbf40, LV },
+        GraphemeBreakRange{ 0xbf41, LVT },
+        GraphemeBreakRange{ 0xbf5c, LV },
+        GraphemeBreakRange{ 0xbf5d, LVT },
+        GraphemeBreakRange{ 0xbf78, LV },
+        GraphemeBreakRange{ 0xbf79, LVT },
+        GraphemeBreakRange{ 0xbf94, LV },
+        GraphemeBreakRange{ 0xbf95, LVT },
+        GraphemeBreakRange{ 0xbfb0, LV },
+        GraphemeBreakRange{ 0xbfb1, LVT },
+        GraphemeBreakRange{ 0xbfcc, LV },
+        GraphemeBreakRange{ 0xbfcd, LVT },
+        GraphemeBreakRange{ 0xbfe8, LV },
+        GraphemeBreakRange{ 0xbfe9, LVT },
+        GraphemeBreakRange{ 0xc004, LV },
+        GraphemeBreakRange{ 0xc005, LVT },
+        GraphemeBreakRange{ 0xc020, LV },
+        GraphemeBreakRange{ 0xc021, LVT },
+        GraphemeBreakRange{ 0xc03c, LV },
+        GraphemeBreakRange{ 0xc03d, LVT },
+        GraphemeBreakRange{ 0xc058, LV },
+        GraphemeBreakRange{ 0xc059, LVT },
+        GraphemeBreakRange{ 0xc074, LV },
+        GraphemeBreakRange{ 0xc075, LVT },
+        GraphemeBreakRange{ 0xc090, LV },
+        GraphemeBreakRange{ 0xc091, LVT },
+        GraphemeBreakRange{ 0xc0ac, LV },
+        GraphemeBreakRange{ 0xc0ad, LVT },
+        GraphemeBreakRange{ 0xc0c8, LV },
+        GraphemeBreakRange{ 0xc0c9, LVT },
+        GraphemeBreakRange{ 0xc0e4, LV },
+        GraphemeBreakRange{ 0xc0e5, LVT },
+        GraphemeBreakRange{ 0xc100, LV },
+        GraphemeBreakRange{ 0xc101, LVT },
+        GraphemeBreakRange{ 0xc11c, LV },
+        GraphemeBreakRange{ 0xc11d, LVT },
+        GraphemeBreakRange{ 0xc138, LV },
+        GraphemeBreakRange{ 0xc139, LVT },
+        GraphemeBreakRange{ 0xc154, LV },
+        GraphemeBreakRange{ 0xc155, LVT },
+        GraphemeBreakRange{ 0xc170, LV },
+        GraphemeBreakRange{ 0xc171, LVT },
+        GraphemeBreakRange{ 0xc18c, LV },
+        GraphemeBreakRange{ 0xc18d, LVT },
+        GraphemeBreakRange{ 0xc1a8, LV },
+        GraphemeBreakRange{ 0xc1a9, LVT },
+        GraphemeBreakRange{ 0xc1c4, LV },
+        GraphemeBreakRange{ 0xc1c5, LVT },
+        GraphemeBreakRange{ 0xc1e0, LV },
+        GraphemeBreakRange{ 0xc1e1, LVT },
+        GraphemeBreakRange{ 0xc1fc, LV },
+        GraphemeBreakRange{ 0xc1fd, LVT },
+        GraphemeBreakRange{ 0xc218, LV },
+        GraphemeBreakRange{ 0xc219, LVT },
+        GraphemeBreakRange{ 0xc234, LV },
+        GraphemeBreakRange{ 0xc235, LVT },
+        GraphemeBreakRange{ 0xc250, LV },
+        GraphemeBreakRange{ 0xc251, LVT },
+        GraphemeBreakRange{ 0xc26c, LV },
+        GraphemeBreakRange{ 0xc26d, LVT },
+        GraphemeBreakRange{ 0xc288, LV },
+        GraphemeBreakRange{ 0xc289, LVT },
+        GraphemeBreakRange{ 0xc2a4, LV },
+        GraphemeBreakRange{ 0xc2a5, LVT },
+        GraphemeBreakRange{ 0xc2c0, LV },
+        GraphemeBreakRange{ 0xc2c1, LVT },
+        GraphemeBreakRange{ 0xc2dc, LV },
+        GraphemeBreakRange{ 0xc2dd, LVT },
+        GraphemeBreakRange{ 0xc2f8, LV },
+        GraphemeBreakRange{ 0xc2f9, LVT },
+        GraphemeBreakRange{ 0xc314, LV },
+        GraphemeBreakRange{ 0xc315, LVT },
+        GraphemeBreakRange{ 0xc330, LV },
+        GraphemeBreakRange{ 0xc331, LVT },
+        GraphemeBreakRange{ 0xc34c, LV },
+        GraphemeBreakRange{ 0xc34d, LVT },
+        GraphemeBreakRange{ 0xc368, LV },
+        GraphemeBreakRange{ 0xc369, LVT },
+        GraphemeBreakRange{ 0xc384, LV },
+        GraphemeBreakRange{ 0xc385, LVT },
+        GraphemeBreakRange{ 0xc3a0, LV },
+        GraphemeBreakRange{ 0xc3a1, LVT },
+        GraphemeBreakRange{ 0xc3bc, LV },
+        GraphemeBreakRange{ 0xc3bd, LVT },
+        GraphemeBreakRange{ 0xc3d8, LV },
+        GraphemeBreakRange{ 0xc3d9, LVT },
+        GraphemeBreakRange{ 0xc3f4, LV },
+        GraphemeBreakRange{ 0xc3f5, LVT },
+        GraphemeBreakRange{ 0xc410, LV },
+        GraphemeBreakRange{ 0xc411, LVT },
+        GraphemeBreakRange{ 0xc42c, LV },
+        GraphemeBreakRange{ 0xc42d, LVT },
+        GraphemeBreakRange{ 0xc448, LV },
+        GraphemeBreakRange{ 0xc449, LVT },
+        GraphemeBreakRange{ 0xc464, LV },
+        GraphemeBreakRange{ 0xc465, LVT },
+        GraphemeBreakRange{ 0xc480, LV },
+        GraphemeBreakRange{ 0xc481, LVT },
+        GraphemeBreakRange{ 0xc49c, LV },
+        GraphemeBreakRange{ 0xc49d, LVT },
+        GraphemeBreakRange{ 0xc4b8, LV },
+        GraphemeBreakRange{ 0xc4b9, LVT },
+        GraphemeBreakRange{ 0xc4d4, LV },
+        GraphemeBreakRange{ 0xc4d5, LVT },
+        GraphemeBreakRange{ 0xc4f0, LV },
+        GraphemeBreakRange{ 0xc4f1, LVT },
+        GraphemeBreakRange{ 0xc50c, LV },
+        GraphemeBreakRange{ 0xc50d, LVT },
+        GraphemeBreakRange{ 0xc528, LV },
+        GraphemeBreakRange{ 0xc529, LVT },
+        GraphemeBreakRange{ 0xc544, LV },
+        GraphemeBreakRange{ 0xc545, LVT },
+        GraphemeBreakRange{ 0xc560, LV },
+        GraphemeBreakRange{ 0xc561, LVT },
+        GraphemeBreakRange{ 0xc57c, LV },
+        GraphemeBreakRange{ 0xc57d, LVT },
+        GraphemeBreakRange{ 0xc598, LV },
+        GraphemeBreakRange{ 0xc599, LVT },
+        GraphemeBreakRange{ 0xc5b4, LV },
+        GraphemeBreakRange{ 0xc5b5, LVT },
+        GraphemeBreakRange{ 0xc5d0, LV },
+        GraphemeBreakRange{ 0xc5d1, LVT },
+        GraphemeBreakRange{ 0xc5ec, LV },
+        GraphemeBreakRange{ 0xc5ed, LVT },
+        GraphemeBreakRange{ 0xc608, LV },
+        GraphemeBreakRange{ 0xc609, LVT },
+        GraphemeBreakRange{ 0xc624, LV },
+        GraphemeBreakRange{ 0xc625, LVT },
+        GraphemeBreakRange{ 0xc640, LV },
+        GraphemeBreakRange{ 0xc641, LVT },
+        GraphemeBreakRange{ 0xc65c, LV },
+        GraphemeBreakRange{ 0xc65d, LVT },
+        GraphemeBreakRange{ 0xc678, LV },
+        GraphemeBreakRange{ 0xc679, LVT },
+        GraphemeBreakRange{ 0xc694, LV },
+        GraphemeBreakRange{ 0xc695, LVT },
+        GraphemeBreakRange{ 0xc6b0, LV },
+        GraphemeBreakRange{ 0xc6b1, LVT },
+        GraphemeBreakRange{ 0xc6cc, LV },
+        GraphemeBreakRange{ 0xc6cd, LVT },
+        GraphemeBreakRange{ 0xc6e8, LV },
+        GraphemeBreakRange{ 0xc6e9, LVT },
+        GraphemeBreakRange{ 0xc704, LV },
+        GraphemeBreakRange{ 0xc705, LVT },
+        GraphemeBreakRange{ 0xc720, LV },
+        GraphemeBreakRange{ 0xc721, LVT },
+        GraphemeBreakRange{ 0xc73c, LV },
+        GraphemeBreakRange{ 0xc73d, LVT },
+        GraphemeBreakRange{ 0xc758, LV },
+        GraphemeBreakRange{ 0xc759, LVT },
+        GraphemeBreakRange{ 0xc774, LV },
+        GraphemeBreakRange{ 0xc775, LVT },
+        GraphemeBreakRange{ 0xc790, LV },
+        GraphemeBreakRange{ 0xc791, LVT },
+        GraphemeBreakRange{ 0xc7ac, LV },
+        GraphemeBreakRange{ 0xc7ad, LVT },
+        GraphemeBreakRange{ 0xc7c8, LV },
+        GraphemeBreakRange{ 0xc7c9, LVT },
+        GraphemeBreakRange{ 0xc7e4, LV },
+        GraphemeBreakRange{ 0xc7e5, LVT },
+        GraphemeBreakRange{ 0xc800, LV },
+        GraphemeBreakRange{ 0xc801, LVT },
+        GraphemeBreakRange{ 0xc81c, LV },
+        GraphemeBreakRange{ 0xc81d, LVT },
+        GraphemeBreakRange{ 0xc838, LV },
+        GraphemeBreakRange{ 0xc839, LVT },
+        GraphemeBreakRange{ 0xc854, LV },
+        GraphemeBreakRange{ 0xc855, LVT },
+        GraphemeBreakRange{ 0xc870, LV },
+        GraphemeBreakRange{ 0xc871, LVT },
+        GraphemeBreakRange{ 0xc88c, LV },
+        GraphemeBreakRange{ 0xc88d, LVT },
+        GraphemeBreakRange{ 0xc8a8, LV },
+        GraphemeBreakRange{ 0xc8a9, LVT },
+        GraphemeBreakRange{ 0xc8c4, LV },
+        GraphemeBreakRange{ 0xc8c5, LVT },
+        GraphemeBreakRange{ 0xc8e0, LV },
+        GraphemeBreakRange{ 0xc8e1, LVT },
+        GraphemeBreakRange{ 0xc8fc, LV },
+        GraphemeBreakRange{ 0xc8fd, LVT },
+        GraphemeBreakRange{ 0xc918, LV },
+        GraphemeBreakRange{ 0xc919, LVT },
+        GraphemeBreakRange{ 0xc934, LV },
+        GraphemeBreakRange{ 0xc935, LVT },
+        GraphemeBreakRange{ 0xc950, LV },
+        GraphemeBreakRange{ 0xc951, LVT },
+        GraphemeBreakRange{ 0xc96c, LV },
+        GraphemeBreakRange{ 0xc96d, LVT },
+        GraphemeBreakRange{ 0xc988, LV },
+        GraphemeBreakRange{ 0xc989, LVT },
+        GraphemeBreakRange{ 0xc9a4, LV },
+        GraphemeBreakRange{ 0xc9a5, LVT },
+        GraphemeBreakRange{ 0xc9c0, LV },
+        GraphemeBreakRange{ 0xc9c1, LVT },
+        GraphemeBreakRange{ 0xc9dc, LV },
+        GraphemeBreakRange{ 0xc9dd, LVT },
+        GraphemeBreakRange{ 0xc9f8, LV },
+        GraphemeBreakRange{ 0xc9f9, LVT },
+        GraphemeBreakRange{ 0xca14, LV },
+        GraphemeBreakRange{ 0xca15, LVT },
+        GraphemeBreakRange{ 0xca30, LV },
+        GraphemeBreakRange{ 0xca31, LVT },
+        GraphemeBreakRange{ 0xca4c, LV },
+        GraphemeBreakRange{ 0xca4d, LVT },
+        GraphemeBreakRange{ 0xca68, LV },
+        GraphemeBreakRange{ 0xca69, LVT },
+        GraphemeBreakRange{ 0xca84, LV },
+        GraphemeBreakRange{ 0xca85, LVT },
+        GraphemeBreakRange{ 0xcaa0, LV },
+        GraphemeBreakRange{ 0xcaa1, LVT },
+        GraphemeBreakRange{ 0xcabc, LV },
+        GraphemeBreakRange{ 0xcabd, LVT },
+        GraphemeBreakRange{ 0xcad8, LV },
+        GraphemeBreakRange{ 0xcad9, LVT },
+        GraphemeBreakRange{ 0xcaf4, LV },
+        GraphemeBreakRange{ 0xcaf5, LVT },
+        GraphemeBreakRange{ 0xcb10, LV },
+        GraphemeBreakRange{ 0xcb11, LVT },
+        GraphemeBreakRange{ 0xcb2c, LV },
+        GraphemeBreakRange{ 0xcb2d, LVT },
+        GraphemeBreakRange{ 0xcb48, LV },
+        GraphemeBreakRange{ 0xcb49, LVT },
+        GraphemeBreakRange{ 0xcb64, LV },
+        GraphemeBreakRange{ 0xcb65, LVT },
+        GraphemeBreakRange{ 0xcb80, LV },
+        GraphemeBreakRange{ 0xcb81, LVT },
+        GraphemeBreakRange{ 0xcb9c, LV },
+        GraphemeBreakRange{ 0xcb9d, LVT },
+        GraphemeBreakRange{ 0xcbb8, LV },
+        GraphemeBreakRange{ 0xcbb9, LVT },
+        GraphemeBreakRange{ 0xcbd4, LV },
+        GraphemeBreakRange{ 0xcbd5, LVT },
+        GraphemeBreakRange{ 0xcbf0, LV },
+        GraphemeBreakRange{ 0xcbf1, LVT },
+        GraphemeBreakRange{ 0xcc0c, LV },
+        GraphemeBreakRange{ 0xcc0d, LVT },
+        GraphemeBreakRange{ 0xcc28, LV },
+        GraphemeBreakRange{ 0xcc29, LVT },
+        GraphemeBreakRange{ 0xcc44, LV },
+        GraphemeBreakRange{ 0xcc45, LVT },
+        GraphemeBreakRange{ 0xcc60, LV },
+        GraphemeBreakRange{ 0xcc61, LVT },
+        GraphemeBreakRange{ 0xcc7c, LV },
+        GraphemeBreakRange{ 0xcc7d, LVT },
+        GraphemeBreakRange{ 0xcc98, LV },
+        GraphemeBreakRange{ 0xcc99, LVT },
+        GraphemeBreakRange{ 0xccb4, LV },
+        GraphemeBreakRange{ 0xccb5, LVT },
+        GraphemeBreakRange{ 0xccd0, LV },
+        GraphemeBreakRange{ 0xccd1, LVT },
+        GraphemeBreakRange{ 0xccec, LV },
+        GraphemeBreakRange{ 0xcced, LVT },
+        GraphemeBreakRange{ 0xcd08, LV },
+        GraphemeBreakRange{ 0xcd09, LVT },
+        GraphemeBreakRange{ 0xcd24, LV },
+        GraphemeBreakRange{ 0xcd25, LVT },
+        GraphemeBreakRange{ 0xcd40, LV },
+        GraphemeBreakRange{ 0xcd41, LVT },
+        GraphemeBreakRange{ 0xcd5c, LV },
+        GraphemeBreakRange{ 0xcd5d, LVT },
+        GraphemeBreakRange{ 0xcd78, LV },
+        GraphemeBreakRange{ 0xcd79, LVT },
+        GraphemeBreakRange{ 0xcd94, LV },
+        GraphemeBreakRange{ 0xcd95, LVT },
+        GraphemeBreakRange{ 0xcdb0, LV },
+        GraphemeBreakRange{ 0xcdb1, LVT },
+        GraphemeBreakRange{ 0xcdcc, LV },
+        GraphemeBreakRange{ 0xcdcd, LVT },
+        GraphemeBreakRange{ 0xcde8, LV },
+        GraphemeBreakRange{ 0xcde9, LVT },
+        GraphemeBreakRange{ 0xce04, LV },
+        GraphemeBreakRange{ 0xce05, LVT },
+        GraphemeBreakRange{ 0xce20, LV },
+        GraphemeBreakRange{ 0xce21, LVT },
+        GraphemeBreakRange{ 0xce3c, LV },
+        GraphemeBreakRange{ 0xce3d, LVT },
+        GraphemeBreakRange{ 0xce58, LV },
+        GraphemeBreakRange{ 0xce59, LVT },
+        GraphemeBreakRange{ 0xce74, LV },
+        GraphemeBreakRange{ 0xce75, LVT },
+        GraphemeBreakRange{ 0xce90, LV },
+        GraphemeBreakRange{ 0xce91, LVT },
+        GraphemeBreakRange{ 0xceac, LV },
+        GraphemeBreakRange{ 0xcead, LVT },
+        GraphemeBreakRange{ 0xcec8, LV },
+        GraphemeBreakRange{ 0xcec9, LVT },
+        GraphemeBreakRange{ 0xcee4, LV },
+        GraphemeBreakRange{ 0xcee5, LVT },
+        GraphemeBreakRange{ 0xcf00, LV },
+        GraphemeBreakRange{ 0xcf01, LVT },
+        GraphemeBreakRange{ 0xcf1c, LV },
+        GraphemeBreakRange{ 0xcf1d, LVT },
+        GraphemeBreakRange{ 0xcf38, LV },
+        GraphemeBreakRange{ 0xcf39, LVT },
+        GraphemeBreakRange{ 0xcf54, LV },
+        GraphemeBreakRange{ 0xcf55, LVT },
+        GraphemeBreakRange{ 0xcf70, LV },
+        GraphemeBreakRange{ 0xcf71, LVT },
+        GraphemeBreakRange{ 0xcf8c, LV },
+        GraphemeBreakRange{ 0xcf8d, LVT },
+        GraphemeBreakRange{ 0xcfa8, LV },
+        GraphemeBreakRange{ 0xcfa9, LVT },
+        GraphemeBreakRange{ 0xcfc4, LV },
+        GraphemeBreakRange{ 0xcfc5, LVT },
+        GraphemeBreakRange{ 0xcfe0, LV },
+        GraphemeBreakRange{ 0xcfe1, LVT },
+        GraphemeBreakRange{ 0xcffc, LV },
+        GraphemeBreakRange{ 0xcffd, LVT },
+        GraphemeBreakRange{ 0xd018, LV },
+        GraphemeBreakRange{ 0xd019, LVT },
+        GraphemeBreakRange{ 0xd034, LV },
+        GraphemeBreakRange{ 0xd035, LVT },
+        GraphemeBreakRange{ 0xd050, LV },
+        GraphemeBreakRange{ 0xd051, LVT },
+        GraphemeBreakRange{ 0xd06c, LV },
+        GraphemeBreakRange{ 0xd06d, LVT },
+        GraphemeBreakRange{ 0xd088, LV },
+        GraphemeBreakRange{ 0xd089, LVT },
+        GraphemeBreakRange{ 0xd0a4, LV },
+        GraphemeBreakRange{ 0xd0a5, LVT },
+        GraphemeBreakRange{ 0xd0c0, LV },
+        GraphemeBreakRange{ 0xd0c1, LVT },
+        GraphemeBreakRange{ 0xd0dc, LV },
+        GraphemeBreakRange{ 0xd0dd, LVT },
+        GraphemeBreakRange{ 0xd0f8, LV },
+        GraphemeBreakRange{ 0xd0f9, LVT },
+        GraphemeBreakRange{ 0xd114, LV },
+        GraphemeBreakRange{ 0xd115, LVT },
+        GraphemeBreakRange{ 0xd130, LV },
+        GraphemeBreakRange{ 0xd131, LVT },
+        GraphemeBreakRange{ 0xd14c, LV },
+        GraphemeBreakRange{ 0xd14d, LVT },
+        GraphemeBreakRange{ 0xd168, LV },
+        GraphemeBreakRange{ 0xd169, LVT },
+        GraphemeBreakRange{ 0xd184, LV },
+        GraphemeBreakRange{ 0xd185, LVT },
+        GraphemeBreakRange{ 0xd1a0, LV },
+        GraphemeBreakRange{ 0xd1a1, LVT },
+        GraphemeBreakRange{ 0xd1bc, LV },
+        GraphemeBreakRange{ 0xd1bd, LVT },
+        GraphemeBreakRange{ 0xd1d8, LV },
+        GraphemeBreakRange{ 0xd1d9, LVT },
+        GraphemeBreakRange{ 0xd1f4, LV },
+        GraphemeBreakRange{ 0xd1f5, LVT },
+        GraphemeBreakRange{ 0xd210, LV },
+        GraphemeBreakRange{ 0xd211, LVT },
+        GraphemeBreakRange{ 0xd22c, LV },
+        GraphemeBreakRange{ 0xd22d, LVT },
+        GraphemeBreakRange{ 0xd248, LV },
+        GraphemeBreakRange{ 0xd249, LVT },
+        GraphemeBreakRange{ 0xd264, LV },
+        GraphemeBreakRange{ 0xd265, LVT },
+        GraphemeBreakRange{ 0xd280, LV },
+        GraphemeBreakRange{ 0xd281, LVT },
+        GraphemeBreakRange{ 0xd29c, LV },
+        GraphemeBreakRange{ 0xd29d, LVT },
+        GraphemeBreakRange{ 0xd2b8, LV },
+        GraphemeBreakRange{ 0xd2b9, LVT },
+        GraphemeBreakRange{ 0xd2d4, LV },
+        GraphemeBreakRange{ 0xd2d5, LVT },
+        GraphemeBreakRange{ 0xd2f0, LV },
+        GraphemeBreakRange{ 0xd2f1, LVT },
+        GraphemeBreakRange{ 0xd30c, LV },
+        GraphemeBreakRange{ 0xd30d, LVT },
+        GraphemeBreakRange{ 0xd328, LV },
+        GraphemeBreakRange{ 0xd329, LVT },
+        GraphemeBreakRange{ 0xd344, LV },
+        GraphemeBreakRange{ 0xd345, LVT },
+        GraphemeBreakRange{ 0xd360, LV },
+        GraphemeBreakRange{ 0xd361, LVT },
+        GraphemeBreakRange{ 0xd37c, LV },
+        GraphemeBreakRange{ 0xd37d, LVT },
+        GraphemeBreakRange{ 0xd398, LV },
+        GraphemeBreakRange{ 0xd399, LVT },
+        GraphemeBreakRange{ 0xd3b4, LV },
+        GraphemeBreakRange{ 0xd3b5, LVT },
+        GraphemeBreakRange{ 0xd3d0, LV },
+        GraphemeBreakRange{ 0xd3d1, LVT },
+        GraphemeBreakRange{ 0xd3ec, LV },
+        GraphemeBreakRange{ 0xd3ed, LVT },
+        GraphemeBreakRange{ 0xd408, LV },
+        GraphemeBreakRange{ 0xd409, LVT },
+        GraphemeBreakRange{ 0xd424, LV },
+        GraphemeBreakRange{ 0xd425, LVT },
+        GraphemeBreakRange{ 0xd440, LV },
+        GraphemeBreakRange{ 0xd441, LVT },
+        GraphemeBreakRange{ 0xd45c, LV },
+        GraphemeBreakRange{ 0xd45d, LVT },
+        GraphemeBreakRange{ 0xd478, LV },
+        GraphemeBreakRange{ 0xd479, LVT },
+        GraphemeBreakRange{ 0xd494, LV },
+        GraphemeBreakRange{ 0xd495, LVT },
+        GraphemeBreakRange{ 0xd4b0, LV },
+        GraphemeBreakRange{ 0xd4b1, LVT },
+        GraphemeBreakRange{ 0xd4cc, LV },
+        GraphemeBreakRange{ 0xd4cd, LVT },
+        GraphemeBreakRange{ 0xd4e8, LV },
+        GraphemeBreakRange{ 0xd4e9, LVT },
+        GraphemeBreakRange{ 0xd504, LV },
+        GraphemeBreakRange{ 0xd505, LVT },
+        GraphemeBreakRange{ 0xd520, LV },
+        GraphemeBreakRange{ 0xd521, LVT },
+        GraphemeBreakRange{ 0xd53c, LV },
+        GraphemeBreakRange{ 0xd53d, LVT },
+        GraphemeBreakRange{ 0xd558, LV },
+        GraphemeBreakRange{ 0xd559, LVT },
+        GraphemeBreakRange{ 0xd574, LV },
+        GraphemeBreakRange{ 0xd575, LVT },
+        GraphemeBreakRange{ 0xd590, LV },
+        GraphemeBreakRange{ 0xd591, LVT },
+        GraphemeBreakRange{ 0xd5ac, LV },
+        GraphemeBreakRange{ 0xd5ad, LVT },
+        GraphemeBreakRange{ 0xd5c8, LV },
+        GraphemeBreakRange{ 0xd5c9, LVT },
+        GraphemeBreakRange{ 0xd5e4, LV },
+        GraphemeBreakRange{ 0xd5e5, LVT },
+        GraphemeBreakRange{ 0xd600, LV },
+        GraphemeBreakRange{ 0xd601, LVT },
+        GraphemeBreakRange{ 0xd61c, LV },
+        GraphemeBreakRange{ 0xd61d, LVT },
+        GraphemeBreakRange{ 0xd638, LV },
+        GraphemeBreakRange{ 0xd639, LVT },
+        GraphemeBreakRange{ 0xd654, LV },
+        GraphemeBreakRange{ 0xd655, LVT },
+        GraphemeBreakRange{ 0xd670, LV },
+        GraphemeBreakRange{ 0xd671, LVT },
+        GraphemeBreakRange{ 0xd68c, LV },
+        GraphemeBreakRange{ 0xd68d, LVT },
+        GraphemeBreakRange{ 0xd6a8, LV },
+        GraphemeBreakRange{ 0xd6a9, LVT },
+        GraphemeBreakRange{ 0xd6c4, LV },
+        GraphemeBreakRange{ 0xd6c5, LVT },
+        GraphemeBreakRange{ 0xd6e0, LV },
+        GraphemeBreakRange{ 0xd6e1, LVT },
+        GraphemeBreakRange{ 0xd6fc, LV },
+        GraphemeBreakRange{ 0xd6fd, LVT },
+        GraphemeBreakRange{ 0xd718, LV },
+        GraphemeBreakRange{ 0xd719, LVT },
+        GraphemeBreakRange{ 0xd734, LV },
+        GraphemeBreakRange{ 0xd735, LVT },
+        GraphemeBreakRange{ 0xd750, LV },
+        GraphemeBreakRange{ 0xd751, LVT },
+        GraphemeBreakRange{ 0xd76c, LV },
+        GraphemeBreakRange{ 0xd76d, LVT },
+        GraphemeBreakRange{ 0xd788, LV },
+        GraphemeBreakRange{ 0xd789, LVT },
+        GraphemeBreakRange{ 0xd7a4, Other },
+        GraphemeBreakRange{ 0xd7b0, V },
+        GraphemeBreakRange{ 0xd7c7, Other },
+        GraphemeBreakRange{ 0xd7cb, T },
+        GraphemeBreakRange{ 0xd7fc, Other },
+        GraphemeBreakRange{ 0xd800, Control },
+        GraphemeBreakRange{ 0xe000, Other },
+        GraphemeBreakRange{ 0xfb1e, Extend },
+        GraphemeBreakRange{ 0xfb1f, Other },
+        GraphemeBreakRange{ 0xfe00, Extend },
+        GraphemeBreakRange{ 0xfe10, Other },
+        GraphemeBreakRange{ 0xfe20, Extend },
+        GraphemeBreakRange{ 0xfe30, Other },
+        GraphemeBreakRange{ 0xfeff, Control },
+        GraphemeBreakRange{ 0xff00, Other },
+        GraphemeBreakRange{ 0xff9e, Extend },
+        GraphemeBreakRange{ 0xffa0, Other },
+        GraphemeBreakRange{ 0xfff0, Control },
+        GraphemeBreakRange{ 0xfffc, Other },
+        GraphemeBreakRange{ 0x101fd, Extend },
+        GraphemeBreakRange{ 0x101fe, Other },
+        GraphemeBreakRange{ 0x102e0, Extend },
+        GraphemeBreakRange{ 0x102e1, Other },
+        GraphemeBreakRange{ 0x10376, Extend },
+        GraphemeBreakRange{ 0x1037b, Other },
+        GraphemeBreakRange{ 0x10a01, Extend },
+        GraphemeBreakRange{ 0x10a04, Other },
+        GraphemeBreakRange{ 0x10a05, Extend },
+        GraphemeBreakRange{ 0x10a07, Other },
+        GraphemeBreakRange{ 0x10a0c, Extend },
+        GraphemeBreakRange{ 0x10a10, Other },
+        GraphemeBreakRange{ 0x10a38, Extend },
+        GraphemeBreakRange{ 0x10a3b, Other },
+        GraphemeBreakRange{ 0x10a3f, Extend },
+        GraphemeBreakRange{ 0x10a40, Other },
+        GraphemeBreakRange{ 0x10ae5, Extend },
+        GraphemeBreakRange{ 0x10ae7, Other },
+        GraphemeBreakRange{ 0x10d24, Extend },
+        GraphemeBreakRange{ 0x10d28, Other },
+        GraphemeBreakRange{ 0x10eab, Extend },
+        GraphemeBreakRange{ 0x10ead, Other },
+        GraphemeBreakRange{ 0x10efd, Extend },
+        GraphemeBreakRange{ 0x10f00, Other },
+        GraphemeBreakRange{ 0x10f46, Extend },
+        GraphemeBreakRange{ 0x10f51, Other },
+        GraphemeBreakRange{ 0x10f82, Extend },
+        GraphemeBreakRange{ 0x10f86, Other },
+        GraphemeBreakRange{ 0x11000, SpacingMark },
+        GraphemeBreakRange{ 0x11001, Extend },
+        GraphemeBreakRange{ 0x11002, SpacingMark },
+        GraphemeBreakRange{ 0x11003, Other },
+        GraphemeBreakRange{ 0x11038, Extend },
+        GraphemeBreakRange{ 0x11047, Other },
+        GraphemeBreakRange{ 0x11070, Extend },
+        GraphemeBreakRange{ 0x11071, Other },
+        GraphemeBreakRange{ 0x11073, Extend },
+        GraphemeBreakRange{ 0x11075, Other },
+        GraphemeBreakRange{ 0x1107f, Extend },
+        GraphemeBreakRange{ 0x11082, SpacingMark },
+        GraphemeBreakRange{ 0x11083, Other },
+        GraphemeBreakRange{ 0x110b0, SpacingMark },
+        GraphemeBreakRange{ 0x110b3, Extend },
+        GraphemeBreakRange{ 0x110b7, SpacingMark },
+        GraphemeBreakRange{ 0x110b9, Extend },
+        GraphemeBreakRange{ 0x110bb, Other },
+        GraphemeBreakRange{ 0x110bd, Prepend },
+        GraphemeBreakRange{ 0x110be, Other },
+        GraphemeBreakRange{ 0x110c2, Extend },
+        GraphemeBreakRange{ 0x110c3, Other },
+        GraphemeBreakRange{ 0x110cd, Prepend },
+        GraphemeBreakRange{ 0x110ce, Other },
+        GraphemeBreakRange{ 0x11100, Extend },
+        GraphemeBreakRange{ 0x11103, Other },
+        GraphemeBreakRange{ 0x11127, Extend },
+        GraphemeBreakRange{ 0x1112c, SpacingMark },
+        GraphemeBreakRange{ 0x1112d, Extend },
+        GraphemeBreakRange{ 0x11135, Other },
+        GraphemeBreakRange{ 0x11145, SpacingMark },
+        GraphemeBreakRange{ 0x11147, Other },
+        GraphemeBreakRange{ 0x11173, Extend },
+        GraphemeBreakRange{ 0x11174, Other },
+        GraphemeBreakRange{ 0x11180, Extend },
+        GraphemeBreakRange{ 0x11182, SpacingMark },
+        GraphemeBreakRange{ 0x11183, Other },
+        GraphemeBreakRange{ 0x111b3, SpacingMark },
+        GraphemeBreakRange{ 0x111b6, Extend },
+        GraphemeBreakRange{ 0x111bf, SpacingMark },
+        GraphemeBreakRange{ 0x111c1, Other },
+        GraphemeBreakRange{ 0x111c2, Prepend },
+        GraphemeBreakRange{ 0x111c4, Other },
+        GraphemeBreakRange{ 0x111c9, Extend },
+        GraphemeBreakRange{ 0x111cd, Other },
+        GraphemeBreakRange{ 0x111ce, SpacingMark },
+        GraphemeBreakRange{ 0x111cf, Extend },
+        GraphemeBreakRange{ 0x111d0, Other },
+        GraphemeBreakRange{ 0x1122c, SpacingMark },
+        GraphemeBreakRange{ 0x1122f, Extend },
+        GraphemeBreakRange{ 0x11232, SpacingMark },
+        GraphemeBreakRange{ 0x11234, Extend },
+        GraphemeBreakRange{ 0x11235, SpacingMark },
+        GraphemeBreakRange{ 0x11236, Extend },
+        GraphemeBreakRange{ 0x11238, Other },
+        GraphemeBreakRange{ 0x1123e, Extend },
+        GraphemeBreakRange{ 0x1123f, Other },
+        GraphemeBreakRange{ 0x11241, Extend },
+        GraphemeBreakRange{ 0x11242, Other },
+        GraphemeBreakRange{ 0x112df, Extend },
+        GraphemeBreakRange{ 0x112e0, SpacingMark },
+        GraphemeBreakRange{ 0x112e3, Extend },
+        GraphemeBreakRange{ 0x112eb, Other },
+        GraphemeBreakRange{ 0x11300, Extend },
+        GraphemeBreakRange{ 0x11302, SpacingMark },
+        GraphemeBreakRange{ 0x11304, Other },
+        GraphemeBreakRange{ 0x1133b, Extend },
+        GraphemeBreakRange{ 0x1133d, Other },
+        GraphemeBreakRange{ 0x1133e, Extend },
+        GraphemeBreakRange{ 0x1133f, SpacingMark },
+        GraphemeBreakRange{ 0x11340, Extend },
+        GraphemeBreakRange{ 0x11341, SpacingMark },
+        GraphemeBreakRange{ 0x11345, Other },
+        GraphemeBreakRange{ 0x11347, SpacingMark },
+        GraphemeBreakRange{ 0x11349, Other },
+        GraphemeBreakRange{ 0x1134b, SpacingMark },
+        GraphemeBreakRange{ 0x1134e, Other },
+        GraphemeBreakRange{ 0x11357, Extend },
+        GraphemeBreakRange{ 0x11358, Other },
+        GraphemeBreakRange{ 0x11362, SpacingMark },
+        GraphemeBreakRange{ 0x11364, Other },
+        GraphemeBreakRange{ 0x11366, Extend },
+        GraphemeBreakRange{ 0x1136d, Other },
+        GraphemeBreakRange{ 0x11370, Extend },
+        GraphemeBreakRange{ 0x11375, Other },
+        GraphemeBreakRange{ 0x11435, SpacingMark },
+        GraphemeBreakRange{ 0x11438, Extend },
+        GraphemeBreakRange{ 0x11440, SpacingMark },
+        GraphemeBreakRange{ 0x11442, Extend },
+        GraphemeBreakRange{ 0x11445, SpacingMark },
+        GraphemeBreakRange{ 0x11446, Extend },
+        GraphemeBreakRange{ 0x11447, Other },
+        GraphemeBreakRange{ 0x1145e, Extend },
+        GraphemeBreakRange{ 0x1145f, Other },
+        GraphemeBreakRange{ 0x114b0, Extend },
+        GraphemeBreakRange{ 0x114b1, SpacingMark },
+        GraphemeBreakRange{ 0x114b3, Extend },
+        GraphemeBreakRange{ 0x114b9, SpacingMark },
+        GraphemeBreakRange{ 0x114ba, Extend },
+        GraphemeBreakRange{ 0x114bb, SpacingMark },
+        GraphemeBreakRange{ 0x114bd, Extend },
+        GraphemeBreakRange{ 0x114be, SpacingMark },
+        GraphemeBreakRange{ 0x114bf, Extend },
+        GraphemeBreakRange{ 0x114c1, SpacingMark },
+        GraphemeBreakRange{ 0x114c2, Extend },
+        GraphemeBreakRange{ 0x114c4, Other },
+        GraphemeBreakRange{ 0x115af, Extend },
+        GraphemeBreakRange{ 0x115b0, SpacingMark },
+        GraphemeBreakRange{ 0x115b2, Extend },
+        GraphemeBreakRange{ 0x115b6, Other },
+        GraphemeBreakRange{ 0x115b8, SpacingMark },
+        GraphemeBreakRange{ 0x115bc, Extend },
+        GraphemeBreakRange{ 0x115be, SpacingMark },
+        GraphemeBreakRange{ 0x115bf, Extend },
+        GraphemeBreakRange{ 0x115c1, Other },
+        GraphemeBreakRange{ 0x115dc, Extend },
+        GraphemeBreakRange{ 0x115de, Other },
+        GraphemeBreakRange{ 0x11630, SpacingMark },
+        GraphemeBreakRange{ 0x11633, Extend },
+        GraphemeBreakRange{ 0x1163b, SpacingMark },
+        GraphemeBreakRange{ 0x1163d, Extend },
+        GraphemeBreakRange{ 0x1163e, SpacingMark },
+        GraphemeBreakRange{ 0x1163f, Extend },
+        GraphemeBreakRange{ 0x11641, Other },
+        GraphemeBreakRange{ 0x116ab, Extend },
+        GraphemeBreakRange{ 0x116ac, SpacingMark },
+        GraphemeBreakRange{ 0x116ad, Extend },
+        GraphemeBreakRange{ 0x116ae, SpacingMark },
+        GraphemeBreakRange{ 0x116b0, Extend },
+        GraphemeBreakRange{ 0x116b6, SpacingMark },
+        GraphemeBreakRange{ 0x116b7, Extend },
+        GraphemeBreakRange{ 0x116b8, Other },
+        GraphemeBreakRange{ 0x1171d, Extend },
+        GraphemeBreakRange{ 0x11720, Other },
+        GraphemeBreakRange{ 0x11722, Extend },
+        GraphemeBreakRange{ 0x11726, SpacingMark },
+        GraphemeBreakRange{ 0x11727, Extend },
+        GraphemeBreakRange{ 0x1172c, Other },
+        GraphemeBreakRange{ 0x1182c, SpacingMark },
+        GraphemeBreakRange{ 0x1182f, Extend },
+        GraphemeBreakRange{ 0x11838, SpacingMark },
+        GraphemeBreakRange{ 0x11839, Extend },
+        GraphemeBreakRange{ 0x1183b, Other },
+        GraphemeBreakRange{ 0x11930, Extend },
+        GraphemeBreakRange{ 0x11931, SpacingMark },
+        GraphemeBreakRange{ 0x11936, Other },
+        GraphemeBreakRange{ 0x11937, SpacingMark },
+        GraphemeBreakRange{ 0x11939, Other },
+        GraphemeBreakRange{ 0x1193b, Extend },
+        GraphemeBreakRange{ 0x1193d, SpacingMark },
+        GraphemeBreakRange{ 0x1193e, Extend },
+        GraphemeBreakRange{ 0x1193f, Prepend },
+        GraphemeBreakRange{ 0x11940, SpacingMark },
+        GraphemeBreakRange{ 0x11941, Prepend },
+        GraphemeBreakRange{ 0x11942, SpacingMark },
+        GraphemeBreakRange{ 0x11943, Extend },
+        GraphemeBreakRange{ 0x11944, Other },
+        GraphemeBreakRange{ 0x119d1, SpacingMark },
+        GraphemeBreakRange{ 0x119d4, Extend },
+        GraphemeBreakRange{ 0x119d8, Other },
+        GraphemeBreakRange{ 0x119da, Extend },
+        GraphemeBreakRange{ 0x119dc, SpacingMark },
+        GraphemeBreakRange{ 0x119e0, Extend },
+        GraphemeBreakRange{ 0x119e1, Other },
+        GraphemeBreakRange{ 0x119e4, SpacingMark },
+        GraphemeBreakRange{ 0x119e5, Other },
+        GraphemeBreakRange{ 0x11a01, Extend },
+        GraphemeBreakRange{ 0x11a0b, Other },
+        GraphemeBreakRange{ 0x11a33, Extend },
+        GraphemeBreakRange{ 0x11a39, SpacingMark },
+        GraphemeBreakRange{ 0x11a3a, Prepend },
+        GraphemeBreakRange{ 0x11a3b, Extend },
+        GraphemeBreakRange{ 0x11a3f, Other },
+        GraphemeBreakRange{ 0x11a47, Extend },
+        GraphemeBreakRange{ 0x11a48, Other },
+        GraphemeBreakRange{ 0x11a51, Extend },
+        GraphemeBreakRange{ 0x11a57, SpacingMark },
+        GraphemeBreakRange{ 0x11a59, Extend },
+        GraphemeBreakRange{ 0x11a5c, Other },
+        GraphemeBreakRange{ 0x11a84, Prepend },
+        GraphemeBreakRange{ 0x11a8a, Extend },
+        GraphemeBreakRange{ 0x11a97, SpacingMark },
+        GraphemeBreakRange{ 0x11a98, Extend },
+        GraphemeBreakRange{ 0x11a9a, Other },
+        GraphemeBreakRange{ 0x11c2f, SpacingMark },
+        GraphemeBreakRange{ 0x11c30, Extend },
+        GraphemeBreakRange{ 0x11c37, Other },
+        GraphemeBreakRange{ 0x11c38, Extend },
+        GraphemeBreakRange{ 0x11c3e, SpacingMark },
+        GraphemeBreakRange{ 0x11c3f, Extend },
+        GraphemeBreakRange{ 0x11c40, Other },
+        GraphemeBreakRange{ 0x11c92, Extend },
+        GraphemeBreakRange{ 0x11ca8, Other },
+        GraphemeBreakRange{ 0x11ca9, SpacingMark },
+        GraphemeBreakRange{ 0x11caa, Extend },
+        GraphemeBreakRange{ 0x11cb1, SpacingMark },
+        GraphemeBreakRange{ 0x11cb2, Extend },
+        GraphemeBreakRange{ 0x11cb4, SpacingMark },
+        GraphemeBreakRange{ 0x11cb5, Extend },
+        GraphemeBreakRange{ 0x11cb7, Other },
+        GraphemeBreakRange{ 0x11d31, Extend },
+        GraphemeBreakRange{ 0x11d37, Other },
+        GraphemeBreakRange{ 0x11d3a, Extend },
+        GraphemeBreakRange{ 0x11d3b, Other },
+        GraphemeBreakRange{ 0x11d3c, Extend },
+        GraphemeBreakRange{ 0x11d3e, Other },
+        GraphemeBreakRange{ 0x11d3f, Extend },
+        GraphemeBreakRange{ 0x11d46, Prepend },
+        GraphemeBreakRange{ 0x11d47, Extend },
+        GraphemeBreakRange{ 0x11d48, Other },
+        GraphemeBreakRange{ 0x11d8a, SpacingMark },
+        GraphemeBreakRange{ 0x11d8f, Other },
+        GraphemeBreakRange{ 0x11d90, Extend },
+        GraphemeBreakRange{ 0x11d92, Other },
+        GraphemeBreakRange{ 0x11d93, SpacingMark },
+        GraphemeBreakRange{ 0x11d95, Extend },
+        GraphemeBreakRange{ 0x11d96, SpacingMark },
+        GraphemeBreakRange{ 0x11d97, Extend },
+        GraphemeBreakRange{ 0x11d98, Other },
+        GraphemeBreakRange{ 0x11ef3, Extend },
+        GraphemeBreakRange{ 0x11ef5, SpacingMark },
+        GraphemeBreakRange{ 0x11ef7, Other },
+        GraphemeBreakRange{ 0x11f00, Extend },
+        GraphemeBreakRange{ 0x11f02, Prepend },
+        GraphemeBreakRange{ 0x11f03, SpacingMark },
+        GraphemeBreakRange{ 0x11f04, Other },
+        GraphemeBreakRange{ 0x11f34, SpacingMark },
+        GraphemeBreakRange{ 0x11f36, Extend },
+        GraphemeBreakRange{ 0x11f3b, Other },
+        GraphemeBreakRange{ 0x11f3e, SpacingMark },
+        GraphemeBreakRange{ 0x11f40, Extend },
+        GraphemeBreakRange{ 0x11f41, SpacingMark },
+        GraphemeBreakRange{ 0x11f42, Extend },
+        GraphemeBreakRange{ 0x11f43, Other },
+        GraphemeBreakRange{ 0x13430, Control },
+        GraphemeBreakRange{ 0x13440, Extend },
+        GraphemeBreakRange{ 0x13441, Other },
+        GraphemeBreakRange{ 0x13447, Extend },
+        GraphemeBreakRange{ 0x13456, Other },
+        GraphemeBreakRange{ 0x16af0, Extend },
+        GraphemeBreakRange{ 0x16af5, Other },
+        GraphemeBreakRange{ 0x16b30, Extend },
+        GraphemeBreakRange{ 0x16b37, Other },
+        GraphemeBreakRange{ 0x16f4f, Extend },
+        GraphemeBreakRange{ 0x16f50, Other },
+        GraphemeBreakRange{ 0x16f51, SpacingMark },
+        GraphemeBreakRange{ 0x16f88, Other },
+        GraphemeBreakRange{ 0x16f8f, Extend },
+        GraphemeBreakRange{ 0x16f93, Other },
+        GraphemeBreakRange{ 0x16fe4, Extend },
+        GraphemeBreakRange{ 0x16fe5, Other },
+        GraphemeBreakRange{ 0x16ff0, SpacingMark },
+        GraphemeBreakRange{ 0x16ff2, Other },
+        GraphemeBreakRange{ 0x1bc9d, Extend },
+        GraphemeBreakRange{ 0x1bc9f, Other },
+        GraphemeBreakRange{ 0x1bca0, Control },
+        GraphemeBreakRange{ 0x1bca4, Other },
+        GraphemeBreakRange{ 0x1cf00, Extend },
+        GraphemeBreakRange{ 0x1cf2e, Other },
+        GraphemeBreakRange{ 0x1cf30, Extend },
+        GraphemeBreakRange{ 0x1cf47, Other },
+        GraphemeBreakRange{ 0x1d165, Extend },
+        GraphemeBreakRange{ 0x1d166, SpacingMark },
+        GraphemeBreakRange{ 0x1d167, Extend },
+        GraphemeBreakRange{ 0x1d16a, Other },
+        GraphemeBreakRange{ 0x1d16d, SpacingMark },
+        GraphemeBreakRange{ 0x1d16e, Extend },
+        GraphemeBreakRange{ 0x1d173, Control },
+        GraphemeBreakRange{ 0x1d17b, Extend },
+        GraphemeBreakRange{ 0x1d183, Other },
+        GraphemeBreakRange{ 0x1d185, Extend },
+        GraphemeBreakRange{ 0x1d18c, Other },
+        GraphemeBreakRange{ 0x1d1aa, Extend },
+        GraphemeBreakRange{ 0x1d1ae, Other },
+        GraphemeBreakRange{ 0x1d242, Extend },
+        GraphemeBreakRange{ 0x1d245, Other },
+        GraphemeBreakRange{ 0x1da00, Extend },
+        GraphemeBreakRange{ 0x1da37, Other },
+        GraphemeBreakRange{ 0x1da3b, Extend },
+        GraphemeBreakRange{ 0x1da6d, Other },
+        GraphemeBreakRange{ 0x1da75, Extend },
+        GraphemeBreakRange{ 0x1da76, Other },
+        GraphemeBreakRange{ 0x1da84, Extend },
+        GraphemeBreakRange{ 0x1da85, Other },
+        GraphemeBreakRange{ 0x1da9b, Extend },
+        GraphemeBreakRange{ 0x1daa0, Other },
+        GraphemeBreakRange{ 0x1daa1, Extend },
+        GraphemeBreakRange{ 0x1dab0, Other },
+        GraphemeBreakRange{ 0x1e000, Extend },
+        GraphemeBreakRange{ 0x1e007, Other },
+        GraphemeBreakRange{ 0x1e008, Extend },
+        GraphemeBreakRange{ 0x1e019, Other },
+        GraphemeBreakRange{ 0x1e01b, Extend },
+        GraphemeBreakRange{ 0x1e022, Other },
+        GraphemeBreakRange{ 0x1e023, Extend },
+        GraphemeBreakRange{ 0x1e025, Other },
+        GraphemeBreakRange{ 0x1e026, Extend },
+        GraphemeBreakRange{ 0x1e02b, Other },
+        GraphemeBreakRange{ 0x1e08f, Extend },
+        GraphemeBreakRange{ 0x1e090, Other },
+        GraphemeBreakRange{ 0x1e130, Extend },
+        GraphemeBreakRange{ 0x1e137, Other },
+        GraphemeBreakRange{ 0x1e2ae, Extend },
+        GraphemeBreakRange{ 0x1e2af, Other },
+        GraphemeBreakRange{ 0x1e2ec, Extend },
+        GraphemeBreakRange{ 0x1e2f0, Other },
+        GraphemeBreakRange{ 0x1e4ec, Extend },
+        GraphemeBreakRange{ 0x1e4f0, Other },
+        GraphemeBreakRange{ 0x1e8d0, Extend },
+        GraphemeBreakRange{ 0x1e8d7, Other },
+        GraphemeBreakRange{ 0x1e944, Extend },
+        GraphemeBreakRange{ 0x1e94b, Other },
+        GraphemeBreakRange{ 0x1f000, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f100, Other },
+        GraphemeBreakRange{ 0x1f10d, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f110, Other },
+        GraphemeBreakRange{ 0x1f12f, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f130, Other },
+        GraphemeBreakRange{ 0x1f16c, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f172, Other },
+        GraphemeBreakRange{ 0x1f17e, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f180, Other },
+        GraphemeBreakRange{ 0x1f18e, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f18f, Other },
+        GraphemeBreakRange{ 0x1f191, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f19b, Other },
+        GraphemeBreakRange{ 0x1f1ad, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f1e6, RegionalIndicator },
+        GraphemeBreakRange{ 0x1f200, Other },
+        GraphemeBreakRange{ 0x1f201, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f210, Other },
+        GraphemeBreakRange{ 0x1f21a, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f21b, Other },
+        GraphemeBreakRange{ 0x1f22f, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f230, Other },
+        GraphemeBreakRange{ 0x1f232, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f23b, Other },
+        GraphemeBreakRange{ 0x1f23c, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f240, Other },
+        GraphemeBreakRange{ 0x1f249, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f3fb, Extend },
+        GraphemeBreakRange{ 0x1f400, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f53e, Other },
+        GraphemeBreakRange{ 0x1f546, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f650, Other },
+        GraphemeBreakRange{ 0x1f680, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f700, Other },
+        GraphemeBreakRange{ 0x1f774, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f780, Other },
+        GraphemeBreakRange{ 0x1f7d5, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f800, Other },
+        GraphemeBreakRange{ 0x1f80c, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f810, Other },
+        GraphemeBreakRange{ 0x1f848, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f850, Other },
+        GraphemeBreakRange{ 0x1f85a, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f860, Other },
+        GraphemeBreakRange{ 0x1f888, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f890, Other },
+        GraphemeBreakRange{ 0x1f8ae, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f900, Other },
+        GraphemeBreakRange{ 0x1f90c, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f93b, Other },
+        GraphemeBreakRange{ 0x1f93c, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f946, Other },
+        GraphemeBreakRange{ 0x1f947, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1fb00, Other },
+        GraphemeBreakRange{ 0x1fc00, ExtendedPictographic },
+        GraphemeBreakRange{ 0x1fffe, Other },
+        GraphemeBreakRange{ 0xe0000, Control },
+        GraphemeBreakRange{ 0xe0020, Extend },
+        GraphemeBreakRange{ 0xe0080, Control },
+        GraphemeBreakRange{ 0xe0100, Extend },
+        GraphemeBreakRange{ 0xe01f0, Control },
+        GraphemeBreakRange{ 0xe1000, Other },
+    };
+
+    // s_graphemeJoinRules[prev] has bit `next` set if UAX #29 forbids a break between two adjacent codepoints
+    // with the properties prev and next. Rules GB11 to GB13 need more context than that and are handled by
+    // GraphemeNext() itself. Since those rules only ever forbid breaks, a break according to this table is
+    // final unless the pair is ZWJ/ExtendedPictographic or RegionalIndicator/RegionalIndicator.
+    static constexpr auto s_graphemeJoinRules = []() {
+        constexpr auto bit = [](const GraphemeBreak gb) {
+            return static_cast<uint16_t>(1u << gb);
+        };
+
+        std::array<uint16_t, GraphemeBreakCount> rules{};
+
+        for (uint8_t prev = 0; prev < GraphemeBreakCount; ++prev)
+        {
+            uint16_t join = 0;
+
+            switch (prev)
+            {
+            case CR:
+                join = bit(LF); // GB3
+                break;
+            case LF:
+            case Control:
+                break; // GB4
+            case Prepend:
+                join = static_cast<uint16_t>(~(bit(CR) | bit(LF) | bit(Control))); // GB9b (GB5 takes precedence)
+                break;
+            case L:
+                join = bit(L) | bit(V) | bit(LV) | bit(LVT); // GB6
+                break;
+            case LV:
+            case V:
+                join = bit(V) | bit(T); // GB7
+                break;
+            case LVT:
+            case T:
+                join = bit(T); // GB8
+                break;
+            default:
+                break;
+            }
+
+            if (prev != CR && prev != LF && prev != Control)
+            {
+                join |= bit(Extend) | bit(ZWJ) | bit(SpacingMark); // GB9, GB9a
+            }
+
+            rules[prev] = join;
+        }
+
+        return rules;
+    }();
+
+    static constexpr bool graphemeJoins(const GraphemeBreak prev, const GraphemeBreak next) noexcept
+    {
+        return (til::at(s_graphemeJoinRules, prev) >> next) & 1;
+    }
+
+    static GraphemeBreak graphemeBreakProperty(const char32_t codepoint) noexcept
+    {
+        // Fast lane for ASCII and Latin-1, which don't need the table.
+        if (codepoint < 0x300)
+        {
+            if (codepoint >= 0x20 && codepoint < 0x7f)
+            {
+                return Other;
+            }
+            if (codepoint < 0x20 || (codepoint >= 0x7f && codepoint < 0xa0) || codepoint == 0xad)
+            {
+                return codepoint == L'\r' ? CR : codepoint == L'\n' ? LF : Control;
+            }
+            return codepoint == 0xa9 || codepoint == 0xae ? ExtendedPictographic : Other;
+        }
+
+#pragma warning(suppress : 26447) // The function is declared 'noexcept' but calls function 'upper_bound<...>()' which may throw exceptions (f.6).
+        const auto it = std::upper_bound(s_graphemeBreakTable.begin(), s_graphemeBreakTable.end(), codepoint);
+        // The first entry starts at U+0000, so `it` can't be the beginning.
+        return static_cast<GraphemeBreak>(std::prev(it)->property);
+    }
+
+    // Decodes the codepoint at str[offset] and returns the offset past it. Unpaired surrogates decode to U+FFFD.
+    static size_t decodeCodepoint(const std::wstring_view& str, size_t offset, char32_t& codepoint) noexcept
+    {
+        const auto wch = til::at(str, offset++);
+        codepoint = wch;
+
+        if (til::is_surrogate(wch))
+        {
+            codepoint = UNICODE_REPLACEMENT;
+            if (til::is_leading_surrogate(wch) && offset < str.size() && til::is_trailing_surrogate(til::at(str, offset)))
+            {
+                codepoint = til::combine_surrogates(wch, til::at(str, offset++));
+            }
+        }
+
+        return offset;
+    }
+
+    // Returns true if the given surrogate pair encodes a regional indicator (U+1F1E6 to U+1F1FF).
+    static constexpr bool isRegionalIndicator(const wchar_t lead, const wchar_t trail) noexcept
+    {
+        return lead == 0xD83C && trail >= 0xDDE6 && trail <= 0xDDFF;
+    }
 }
 
 // Routine Description:
@@ -374,6 +2373,206 @@ bool CodepointWidthDetector::IsWide(const std::wstring_view& glyph) noexcept
     return GetWidth(glyph) == CodepointWidth::Wide;
 }
 
+// Routine Description:
+// - finds the end of the extended grapheme cluster (UAX #29) starting at `offset`
+//   and measures how many columns it occupies in the terminal.
+// - The width of a cluster is the width of its first codepoint, because everything that follows
+//   (combining marks, emoji modifiers, joined emoji, etc.) is drawn on top of or merged into it.
+//   The exception is a U+FE0F VARIATION SELECTOR-16 which requests the wide emoji presentation.
+// - Clusters are cut off after MaxGraphemeClusterLength code units. The remainder starts a new cluster.
+// Arguments:
+// - str - the utf16 encoded text to segment
+// - offset - the position of the start of a grapheme cluster in str
+// - width - optional, receives the width of the cluster in columns
+// Return Value:
+// - the position of the start of the next grapheme cluster
+size_t CodepointWidthDetector::GraphemeNext(const std::wstring_view& str, size_t offset, int* width) noexcept
+{
+    const auto len = str.size();
+
+    if (offset >= len)
+    {
+        if (width)
+        {
+            *width = 0;
+        }
+        return len;
+    }
+
+    // ASCII fast lane: Two adjacent ASCII characters always form a boundary, except for CR LF.
+    {
+        const auto wch = til::at(str, offset);
+        if (wch < 0x80 && (offset + 1 == len || (til::at(str, offset + 1) < 0x80 && wch != L'\r')))
+        {
+            if (width)
+            {
+                *width = 1;
+            }
+            return offset + 1;
+        }
+    }
+
+    char32_t codepoint;
+    auto end = decodeCodepoint(str, offset, codepoint);
+    auto prev = graphemeBreakProperty(codepoint);
+    int columns = 1;
+
+    if (width && codepoint >= 0x80)
+    {
+        const auto glyph = codepoint == UNICODE_REPLACEMENT ? std::wstring_view{ &UNICODE_REPLACEMENT, 1 } : str.substr(offset, end - offset);
+        columns = _lookupGlyphWidth(codepoint, glyph);
+    }
+
+    // State for GB11: "ExtendedPictographic Extend* ZWJ × ExtendedPictographic".
+    enum
+    {
+        EmojiNone,
+        EmojiExtend,
+        EmojiZWJ,
+    } emoji = prev == ExtendedPictographic ? EmojiExtend : EmojiNone;
+    // State for GB12/GB13: Regional indicators form pairs.
+    auto regionalIndicators = prev == RegionalIndicator ? 1 : 0;
+
+    while (end < len)
+    {
+        const auto next = decodeCodepoint(str, end, codepoint);
+        if (next - offset > MaxGraphemeClusterLength)
+        {
+            break;
+        }
+
+        const auto prop = graphemeBreakProperty(codepoint);
+
+        if (!graphemeJoins(prev, prop) &&
+            !(prop == ExtendedPictographic && emoji == EmojiZWJ) &&
+            !(prop == RegionalIndicator && prev == RegionalIndicator && (regionalIndicators & 1)))
+        {
+            break;
+        }
+
+        switch (prop)
+        {
+        case ExtendedPictographic:
+            emoji = EmojiExtend;
+            break;
+        case Extend:
+            emoji = emoji == EmojiExtend ? EmojiExtend : EmojiNone;
+            break;
+        case ZWJ:
+            emoji = emoji == EmojiExtend ? EmojiZWJ : EmojiNone;
+            break;
+        default:
+            emoji = EmojiNone;
+            break;
+        }
+
+        regionalIndicators += prop == RegionalIndicator;
+
+        if (codepoint == 0xFE0F)
+        {
+            columns = 2;
+        }
+
+        prev = prop;
+        end = next;
+    }
+
+    if (width)
+    {
+        *width = columns;
+    }
+    return end;
+}
+
+// Routine Description:
+// - finds the start of the extended grapheme cluster (UAX #29) that ends at `offset`.
+//   It's the counterpart to GraphemeNext.
+// - Looks back at most MaxGraphemeClusterLength code units (plus one regional indicator).
+//   Within runs of joined codepoints that are longer than that, GraphemeNext splits clusters relative
+//   to the start of the run, which is out of sight, so the boundaries found here may differ from it.
+// Arguments:
+// - str - the utf16 encoded text to segment
+// - offset - the position of the end of a grapheme cluster in str
+// - width - optional, receives the width of the cluster in columns
+// Return Value:
+// - the position of the start of the preceding grapheme cluster
+size_t CodepointWidthDetector::GraphemePrev(const std::wstring_view& str, size_t offset, int* width) noexcept
+{
+    offset = std::min(offset, str.size());
+
+    if (offset == 0)
+    {
+        if (width)
+        {
+            *width = 0;
+        }
+        return 0;
+    }
+
+    // ASCII fast lane: Two adjacent ASCII characters always form a boundary, except for CR LF.
+    {
+        const auto wch = til::at(str, offset - 1);
+        if (wch < 0x80 && (offset == 1 || (til::at(str, offset - 2) < 0x80 && !(wch == L'\n' && til::at(str, offset - 2) == L'\r'))))
+        {
+            if (width)
+            {
+                *width = 1;
+            }
+            return offset - 1;
+        }
+    }
+
+    // Walk backwards until we find a boundary that's independent of any preceding context...
+    char32_t codepoint;
+    auto beg = til::utf16_iterate_prev(str, offset);
+    decodeCodepoint(str, beg, codepoint);
+    auto prop = graphemeBreakProperty(codepoint);
+
+    while (beg > 0)
+    {
+        const auto prevBeg = til::utf16_iterate_prev(str, beg);
+        if (offset - prevBeg > MaxGraphemeClusterLength)
+        {
+            // Regional indicators pair up from the start of their run (GB12/GB13). If we stopped inside such a run,
+            // its length tells us whether beg is in the middle of a flag. Counting them is just a tight loop.
+            if (prop == RegionalIndicator)
+            {
+                size_t count = 0;
+                for (auto i = beg; i >= 2 && isRegionalIndicator(til::at(str, i - 2), til::at(str, i - 1)); i -= 2)
+                {
+                    ++count;
+                }
+                beg -= (count & 1) * 2;
+            }
+            break;
+        }
+
+        decodeCodepoint(str, prevBeg, codepoint);
+        const auto prev = graphemeBreakProperty(codepoint);
+
+        if (!graphemeJoins(prev, prop) &&
+            !(prev == ZWJ && prop == ExtendedPictographic) &&
+            !(prev == RegionalIndicator && prop == RegionalIndicator))
+        {
+            break;
+        }
+
+        beg = prevBeg;
+        prop = prev;
+    }
+
+    // ...and then segment forward from there, because only forward iteration knows about GB11 to GB13.
+    for (;;)
+    {
+        const auto end = GraphemeNext(str, beg, width);
+        if (end >= offset)
+        {
+            return beg;
+        }
+        beg = end;
+    }
+}
+
 // GetWidth's slow-path for non-ASCII characters. Returns the number of columns the codepoint takes up in the terminal.
 uint8_t CodepointWidthDetector::_lookupGlyphWidth(const char32_t codepoint, const std::wstring_view& glyph) noexcept
 {
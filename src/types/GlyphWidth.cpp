@@ -25,6 +25,22 @@ bool IsGlyphFullWidth(const wchar_t wch) noexcept
     return wch < 0x80 ? false : IsGlyphFullWidth({ &wch, 1 });
 }
 
+// Function Description:
+// - returns the end of the grapheme cluster starting at `position` and,
+//      optionally, the number of columns it occupies. See CodepointWidthDetector::GraphemeNext
+size_t GraphemeClusterNext(const std::wstring_view& chars, size_t position, int* width) noexcept
+{
+    return widthDetector.GraphemeNext(chars, position, width);
+}
+
+// Function Description:
+// - returns the start of the grapheme cluster ending at `position` and,
+//      optionally, the number of columns it occupies. See CodepointWidthDetector::GraphemePrev
+size_t GraphemeClusterPrev(const std::wstring_view& chars, size_t position, int* width) noexcept
+{
+    return widthDetector.GraphemePrev(chars, position, width);
+}
+
 // Function Description:
 // - Sets a function that should be used by the global CodepointWidthDetector
 //      as the fallback mechanism for determining a particular glyph's width,
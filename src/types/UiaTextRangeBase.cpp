@@ -14,6 +14,64 @@ static constexpr long _RemoveAlpha(COLORREF color) noexcept
     return color & 0x00ffffff;
 }
 
+// Calls func(attr, y, beginX, endX) for each run of identical attributes within the cells [begin, end)
+// of a (non-block) range, in buffer order or in reverse if backwards is true. Iteration stops early
+// if func returns false. Unlike walking the range with a TextBufferCellIterator, this looks at the
+// attributes of each run only once, instead of once for every single cell.
+template<typename Func>
+static void _forEachAttributeRun(const TextBuffer& buffer, const til::point begin, const til::point end, const bool backwards, Func&& func)
+{
+    const auto bottomInclusive = buffer.GetSize().BottomInclusive();
+    const auto visitRow = [&](const til::CoordType y) {
+        const auto& row = buffer.GetRowByOffset(y);
+        const auto& runs = row.Attributes().runs();
+        const auto beginX = y == begin.y ? begin.x : 0;
+        const auto endX = y == end.y ? end.x : til::CoordType{ row.size() };
+
+        if (!backwards)
+        {
+            til::CoordType x = 0;
+            for (auto it = runs.begin(); it != runs.end() && x < endX; ++it)
+            {
+                const auto runBegin = x;
+                x += it->length;
+                if (x > beginX && !func(it->value, y, std::max(runBegin, beginX), std::min(x, endX)))
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            til::CoordType x = row.size();
+            for (auto it = runs.rbegin(); it != runs.rend() && x > beginX; ++it)
+            {
+                const auto runEnd = x;
+                x -= it->length;
+                if (x < endX && !func(it->value, y, std::max(x, beginX), std::min(runEnd, endX)))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    };
+
+    if (!backwards)
+    {
+        for (auto y = begin.y; y <= std::min(end.y, bottomInclusive) && visitRow(y); ++y)
+        {
+        }
+    }
+    else
+    {
+        for (auto y = std::min(end.y, bottomInclusive); y >= begin.y && visitRow(y); --y)
+        {
+        }
+    }
+}
+
 // degenerate range constructor.
 #pragma warning(suppress : 26434) // WRL RuntimeClassInitialize base is a no-op and we need this for MakeAndInitialize
 HRESULT UiaTextRangeBase::RuntimeClassInitialize(_In_ Render::IRenderData* pData, _In_ IRawElementProviderSimple* const pProvider, _In_ std::wstring_view wordDelimiters) noexcept
@@ -505,43 +563,7 @@ try
     //       We'll do some post-processing to fix this on the way out.
     std::optional<til::point> resultFirstAnchor;
     std::optional<til::point> resultSecondAnchor;
-    const auto attemptUpdateAnchors = [=, &resultFirstAnchor, &resultSecondAnchor](const TextBufferCellIterator iter) {
-        const auto attrFound{ _verifyAttr(attributeId, val, iter->TextAttr()).value() };
-        if (attrFound)
-        {
-            // populate the first anchor if it's not populated.
-            // otherwise, populate the second anchor.
-            if (!resultFirstAnchor.has_value())
-            {
-                resultFirstAnchor = iter.Pos();
-                resultSecondAnchor = iter.Pos();
-            }
-            else
-            {
-                resultSecondAnchor = iter.Pos();
-            }
-        }
-        return attrFound;
-    };
-
-    // Start/End for the direction to perform the search in
-    // We need searchEnd to be exclusive. This allows the for-loop below to
-    // iterate up until the exclusive searchEnd, and not attempt to read the
-    // data at that position.
-    const auto searchStart{ searchBackwards ? inclusiveEnd : _start };
-    const auto searchEndInclusive{ searchBackwards ? _start : inclusiveEnd };
-    auto searchEndExclusive{ searchEndInclusive };
-    if (searchBackwards)
-    {
-        bufferSize.DecrementInBounds(searchEndExclusive, true);
-    }
-    else
-    {
-        bufferSize.IncrementInBounds(searchEndExclusive, true);
-    }
 
-    // Iterate from searchStart to searchEnd in the buffer.
-    // If we find the attribute we're looking for, we update resultFirstAnchor/SecondAnchor appropriately.
 #pragma warning(suppress : 26496) // TRANSITIONAL: false positive in VS 16.11
     auto viewportRange{ bufferSize };
     if (_blockRange)
@@ -551,28 +573,87 @@ try
         const auto width{ std::abs(inclusiveEnd.x - _start.x + 1) };
         const auto height{ std::abs(inclusiveEnd.y - _start.y + 1) };
         viewportRange = Viewport::FromDimensions({ originX, originY }, width, height);
-    }
-    auto iter{ buffer.GetCellDataAt(searchStart, viewportRange) };
-    const auto iterStep{ searchBackwards ? -1 : 1 };
-    for (; iter && iter.Pos() != searchEndExclusive; iter += iterStep)
-    {
-        if (!attemptUpdateAnchors(iter) && resultFirstAnchor.has_value() && resultSecondAnchor.has_value())
+
+        const auto attemptUpdateAnchors = [=, &resultFirstAnchor, &resultSecondAnchor](const TextBufferCellIterator iter) {
+            const auto attrFound{ _verifyAttr(attributeId, val, iter->TextAttr()).value() };
+            if (attrFound)
+            {
+                // populate the first anchor if it's not populated.
+                // otherwise, populate the second anchor.
+                if (!resultFirstAnchor.has_value())
+                {
+                    resultFirstAnchor = iter.Pos();
+                    resultSecondAnchor = iter.Pos();
+                }
+                else
+                {
+                    resultSecondAnchor = iter.Pos();
+                }
+            }
+            return attrFound;
+        };
+
+        // Start/End for the direction to perform the search in
+        // We need searchEnd to be exclusive. This allows the for-loop below to
+        // iterate up until the exclusive searchEnd, and not attempt to read the
+        // data at that position.
+        const auto searchStart{ searchBackwards ? inclusiveEnd : _start };
+        const auto searchEndInclusive{ searchBackwards ? _start : inclusiveEnd };
+        auto searchEndExclusive{ searchEndInclusive };
+        if (searchBackwards)
         {
-            // Exit the loop early if...
-            // - the cell we're looking at doesn't have the attr we're looking for
-            // - the anchors have been populated
-            // This means that we've found a contiguous range where the text attribute was found.
-            // No point in searching through the rest of the search space.
-            // TLDR: keep updating the second anchor and make the range wider until the attribute changes.
-            break;
+            bufferSize.DecrementInBounds(searchEndExclusive, true);
+        }
+        else
+        {
+            bufferSize.IncrementInBounds(searchEndExclusive, true);
+        }
+
+        // Iterate from searchStart to searchEnd in the buffer.
+        // If we find the attribute we're looking for, we update resultFirstAnchor/SecondAnchor appropriately.
+        auto iter{ buffer.GetCellDataAt(searchStart, viewportRange) };
+        const auto iterStep{ searchBackwards ? -1 : 1 };
+        for (; iter && iter.Pos() != searchEndExclusive; iter += iterStep)
+        {
+            if (!attemptUpdateAnchors(iter) && resultFirstAnchor.has_value() && resultSecondAnchor.has_value())
+            {
+                // Exit the loop early if...
+                // - the cell we're looking at doesn't have the attr we're looking for
+                // - the anchors have been populated
+                // This means that we've found a contiguous range where the text attribute was found.
+                // No point in searching through the rest of the search space.
+                // TLDR: keep updating the second anchor and make the range wider until the attribute changes.
+                break;
+            }
         }
-    }
 
-    // Corner case: we couldn't actually move the searchEnd to make it exclusive
-    // (i.e. DecrementInBounds on Origin doesn't move it)
-    if (searchEndInclusive == searchEndExclusive)
+        // Corner case: we couldn't actually move the searchEnd to make it exclusive
+        // (i.e. DecrementInBounds on Origin doesn't move it)
+        if (searchEndInclusive == searchEndExclusive)
+        {
+            attemptUpdateAnchors(iter);
+        }
+    }
+    else
     {
-        attemptUpdateAnchors(iter);
+        // For contiguous ranges we can check each attribute run once instead of every cell.
+        // The same rules as above apply: We keep widening the result until the attribute changes.
+        auto exclusiveEnd{ inclusiveEnd };
+        bufferSize.IncrementInBounds(exclusiveEnd, true);
+
+        _forEachAttributeRun(buffer, _start, exclusiveEnd, searchBackwards, [&](const TextAttribute& attr, const til::CoordType y, const til::CoordType beginX, const til::CoordType endX) {
+            if (!_verifyAttr(attributeId, val, attr).value())
+            {
+                return !resultFirstAnchor.has_value();
+            }
+
+            if (!resultFirstAnchor.has_value())
+            {
+                resultFirstAnchor = til::point{ searchBackwards ? endX - 1 : beginX, y };
+            }
+            resultSecondAnchor = til::point{ searchBackwards ? beginX : endX - 1, y };
+            return true;
+        });
     }
 
     // If a result was found, populate ppRetVal with the UiaTextRange
@@ -805,29 +886,39 @@ try
     const auto inclusiveEnd{ _getInclusiveEnd() };
 
     // Check if the entire text range has that text attribute
-#pragma warning(suppress : 26496) // TRANSITIONAL: false positive in VS 16.11
-    auto viewportRange{ bufferSize };
+    auto mixed = false;
     if (_blockRange)
     {
         const auto originX{ std::min(_start.x, inclusiveEnd.x) };
         const auto originY{ std::min(_start.y, inclusiveEnd.y) };
         const auto width{ std::abs(inclusiveEnd.x - _start.x + 1) };
         const auto height{ std::abs(inclusiveEnd.y - _start.y + 1) };
-        viewportRange = Viewport::FromDimensions({ originX, originY }, width, height);
-    }
-    auto iter{ buffer.GetCellDataAt(_start, viewportRange) };
-    for (; iter && iter.Pos() != inclusiveEnd; ++iter)
-    {
-        if (!_verifyAttr(attributeId, *pRetVal, iter->TextAttr()).value())
+        const auto viewportRange = Viewport::FromDimensions({ originX, originY }, width, height);
+
+        auto iter{ buffer.GetCellDataAt(_start, viewportRange) };
+        for (; iter && iter.Pos() != inclusiveEnd && !mixed; ++iter)
         {
-            // The value of the specified attribute varies over the text range
-            // return UiaGetReservedMixedAttributeValue.
-            // Source: https://docs.microsoft.com/en-us/windows/win32/api/uiautomationcore/nf-uiautomationcore-itextrangeprovider-getattributevalue
-            pRetVal->vt = VT_UNKNOWN;
-            UiaTracing::TextRange::GetAttributeValue(*this, attributeId, *pRetVal, UiaTracing::AttributeType::Mixed);
-            return UiaGetReservedMixedAttributeValue(&pRetVal->punkVal);
+            mixed = !_verifyAttr(attributeId, *pRetVal, iter->TextAttr()).value();
         }
     }
+    else
+    {
+        // Ranges are usually contiguous, in which case we can simply check each attribute run once.
+        _forEachAttributeRun(buffer, _start, inclusiveEnd, false, [&](const TextAttribute& attr, auto, auto, auto) {
+            mixed = !_verifyAttr(attributeId, *pRetVal, attr).value();
+            return !mixed;
+        });
+    }
+
+    if (mixed)
+    {
+        // The value of the specified attribute varies over the text range
+        // return UiaGetReservedMixedAttributeValue.
+        // Source: https://docs.microsoft.com/en-us/windows/win32/api/uiautomationcore/nf-uiautomationcore-itextrangeprovider-getattributevalue
+        pRetVal->vt = VT_UNKNOWN;
+        UiaTracing::TextRange::GetAttributeValue(*this, attributeId, *pRetVal, UiaTracing::AttributeType::Mixed);
+        return UiaGetReservedMixedAttributeValue(&pRetVal->punkVal);
+    }
 
     UiaTracing::TextRange::GetAttributeValue(*this, attributeId, *pRetVal);
     return S_OK;
@@ -1405,34 +1496,11 @@ void UiaTextRangeBase::_moveEndpointByUnitCharacter(_In_ const int moveCount,
     }
 
     const auto allowBottomExclusive = !preventBufferEnd;
-    const auto moveDirection = (moveCount > 0) ? MovementDirection::Forward : MovementDirection::Backward;
     const auto& buffer = _pData->GetTextBuffer();
 
-    auto success = true;
     til::point target{ GetEndpoint(endpoint) };
     const auto documentEnd{ _getDocumentEnd() };
-    while (std::abs(*pAmountMoved) < std::abs(moveCount) && success)
-    {
-        switch (moveDirection)
-        {
-        case MovementDirection::Forward:
-            success = buffer.MoveToNextGlyph(target, allowBottomExclusive, documentEnd);
-            if (success)
-            {
-                (*pAmountMoved)++;
-            }
-            break;
-        case MovementDirection::Backward:
-            success = buffer.MoveToPreviousGlyph(target, documentEnd);
-            if (success)
-            {
-                (*pAmountMoved)--;
-            }
-            break;
-        default:
-            break;
-        }
-    }
+    *pAmountMoved = buffer.MoveByGlyphs(target, moveCount, allowBottomExclusive, documentEnd);
 
     SetEndpoint(endpoint, target);
 }
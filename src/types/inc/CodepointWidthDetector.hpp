@@ -19,8 +19,15 @@ Author:
 class CodepointWidthDetector final
 {
 public:
+    // GraphemeNext() ends clusters after at most this many UTF-16 code units, even if UAX #29 says otherwise.
+    // This keeps long runs of combining marks from growing a single cell (and its ROW) without bound.
+    // It's comfortably longer than any emoji ZWJ or tag sequence in use today.
+    static constexpr size_t MaxGraphemeClusterLength = 32;
+
     CodepointWidth GetWidth(const std::wstring_view& glyph) noexcept;
     bool IsWide(const std::wstring_view& glyph) noexcept;
+    size_t GraphemeNext(const std::wstring_view& str, size_t offset, int* width) noexcept;
+    size_t GraphemePrev(const std::wstring_view& str, size_t offset, int* width) noexcept;
     void SetFallbackMethod(std::function<bool(const std::wstring_view&)> pfnFallback) noexcept;
     void NotifyFontChanged() noexcept;
 
@@ -17,5 +17,7 @@ Abstract:
 
 bool IsGlyphFullWidth(const std::wstring_view& glyph) noexcept;
 bool IsGlyphFullWidth(const wchar_t wch) noexcept;
+size_t GraphemeClusterNext(const std::wstring_view& chars, size_t position, int* width) noexcept;
+size_t GraphemeClusterPrev(const std::wstring_view& chars, size_t position, int* width) noexcept;
 void SetGlyphWidthFallback(std::function<bool(const std::wstring_view&)> pfnFallback) noexcept;
 void NotifyGlyphWidthFontChanged() noexcept;
@@ -0,0 +1,127 @@
+# Copyright (c) Microsoft Corporation.
+# Licensed under the MIT license.
+
+#Requires -Version 7
+
+################################################################################
+# This script generates the s_graphemeBreakTable array in
+# src/types/CodepointWidthDetector.cpp from a Unicode UCD XML document[1]
+# compliant with UAX#42[2].
+#
+# Every entry in the table marks the first codepoint of a run of codepoints
+# sharing the same Grapheme_Cluster_Break property as defined by UAX#29[3].
+# Codepoints with Grapheme_Cluster_Break=Other and Extended_Pictographic=Yes
+# are given their own ExtendedPictographic value, because rule GB11 needs them.
+#
+# This script was developed against the flat "no han unification" UCD
+# "ucd.nounihan.flat.xml".
+#
+# Invoke this script from the root of this repository as:
+#   .\tools\Generate-GraphemeBreakTableFromUCD.ps1 -Path .\path\to\ucd.nounihan.flat.xml
+#
+# [1]: https://www.unicode.org/Public/UCD/latest/ucdxml/
+# [2]: https://www.unicode.org/reports/tr42/
+# [3]: https://www.unicode.org/reports/tr29/
+
+[Diagnostics.CodeAnalysis.SuppressMessageAttribute('PSAvoidUsingPositionalParameters', '')]
+[CmdletBinding()]
+Param(
+    [Parameter(Position=0, ValueFromPipeline=$true, ParameterSetName="Parsed")]
+    [System.Xml.XmlDocument]$InputObject,
+
+    [Parameter(Position=0, ValueFromPipelineByPropertyName=$true, ParameterSetName="Unparsed")]
+    [string]$Path = "ucd.nounihan.flat.xml"
+)
+
+# Maps the UCD short names of Grapheme_Cluster_Break values
+# to the enum used by CodepointWidthDetector.cpp.
+$GraphemeBreakNames = @{
+    "XX"  = "Other";
+    "CR"  = "CR";
+    "LF"  = "LF";
+    "CN"  = "Control";
+    "EX"  = "Extend";
+    "ZWJ" = "ZWJ";
+    "RI"  = "RegionalIndicator";
+    "PP"  = "Prepend";
+    "SM"  = "SpacingMark";
+    "L"   = "L";
+    "V"   = "V";
+    "T"   = "T";
+    "LV"  = "LV";
+    "LVT" = "LVT";
+}
+
+Function Get-UCDEntryRange($entry) {
+    $s = $e = 0
+    if ($null -ne $entry.cp) {
+        # Individual Codepoint
+        $s = $e = [int]("0x"+$entry.cp)
+    } ElseIf ($null -ne $entry."first-cp") {
+        # Range of Codepoints
+        $s = [int]("0x"+$entry."first-cp")
+        $e = [int]("0x"+$entry."last-cp")
+    }
+    $s
+    $e
+}
+
+Function Get-UCDEntryGraphemeBreak($entry) {
+    $name = $GraphemeBreakNames[$entry.GCB ?? "XX"]
+    If ($null -eq $name) {
+        throw "Unexpected Grapheme_Cluster_Break property"
+    }
+    If ($name -eq "Other" -and $entry.ExtPict -eq "Y") {
+        $name = "ExtendedPictographic"
+    }
+    $name
+}
+
+# Ingest UCD
+If ($null -eq $InputObject) {
+    $InputObject = [xml](Get-Content $Path)
+}
+
+$UCDRepertoire = $InputObject.ucd.repertoire.ChildNodes | Sort-Object {
+    # Sort by either cp or first-cp (for ranges)
+    if ($null -ne $_.cp) {
+        [int]("0x"+$_.cp)
+    } ElseIf ($null -ne $_."first-cp") {
+        [int]("0x"+$_."first-cp")
+    }
+}
+
+# Collect the start of each run. Codepoints missing
+# from the repertoire are treated as Other.
+$runs = [System.Collections.Generic.List[Object]]::New(2048)
+$next = 0
+$last = $null
+
+Function Add-Run([int]$start, [string]$value) {
+    If ($script:last -ne $value) {
+        $script:runs.Add([pscustomobject]@{ Start = $start; Value = $value })
+        $script:last = $value
+    }
+}
+
+ForEach($v in $UCDRepertoire) {
+    $s, $e = Get-UCDEntryRange $v
+    If ($s -gt $next) {
+        Add-Run $next "Other"
+    }
+    Add-Run $s (Get-UCDEntryGraphemeBreak $v)
+    $next = $e + 1
+}
+
+If ($next -le 0x10FFFF) {
+    Add-Run $next "Other"
+}
+
+# Emit Code
+"    // Generated by {0}" -f $MyInvocation.MyCommand.Name
+"    // on {0} from {1}." -f (Get-Date -AsUTC -Format "u"), $InputObject.ucd.description
+"    static constexpr std::array<GraphemeBreakRange, {0}> s_graphemeBreakTable{{" -f $runs.Count
+ForEach($_ in $runs) {
+"        GraphemeBreakRange{{ 0x{0:x}, {1} }}," -f $_.Start, $_.Value
+}
+"    };"
@@ -0,0 +1,72 @@
+# Copyright (c) Microsoft Corporation.
+# Licensed under the MIT license.
+
+#Requires -Version 7
+
+################################################################################
+# This script generates the graphemeBreakTests array in
+# src/host/ut_host/CodepointWidthDetectorTests.cpp from the
+# GraphemeBreakTest.txt[1] test data that accompanies UAX#29[2].
+#
+# Every test case is emitted as the list of grapheme clusters it consists of.
+# Test cases containing any of the -ExcludeCodepoints are skipped. This allows
+# using test data that is newer than the Unicode version s_graphemeBreakTable
+# was generated from, by skipping the codepoints whose behavior has changed.
+#
+# Invoke this script from the root of this repository as:
+#   .\tools\Generate-GraphemeBreakTests.ps1 -Path .\path\to\GraphemeBreakTest.txt
+#
+# [1]: https://www.unicode.org/Public/UCD/latest/ucd/auxiliary/GraphemeBreakTest.txt
+# [2]: https://www.unicode.org/reports/tr29/
+
+[CmdletBinding()]
+Param(
+    [Parameter(Position=0, ValueFromPipelineByPropertyName=$true)]
+    [string]$Path = "GraphemeBreakTest.txt",
+
+    [string[]]$ExcludeCodepoints = @()
+)
+
+$Exclude = $ExcludeCodepoints | ForEach-Object { [int]("0x"+$_) }
+$Lines = Get-Content -Encoding utf8 $Path
+$Tests = [System.Collections.Generic.List[string]]::New(1024)
+
+ForEach($line in $Lines) {
+    # Each test case looks like "÷ 0020 × 0308 ÷ 0020 ÷	# <comment>".
+    $line = ($line -split "#", 2)[0].Trim()
+    If ($line -eq "") {
+        Continue
+    }
+
+    $graphemes = [System.Collections.Generic.List[string]]::New()
+    $current = ""
+    $skip = $false
+
+    ForEach($token in $line -split "\s+") {
+        If ($token -eq "÷") {
+            If ($current -ne "") {
+                $graphemes.Add("L`"$current`"")
+                $current = ""
+            }
+        } ElseIf ($token -ne "×") {
+            $cp = [int]("0x"+$token)
+            If ($Exclude -contains $cp) {
+                $skip = $true
+            }
+            ForEach($ch in [char[]][char]::ConvertFromUtf32($cp)) {
+                $current += "\x{0:X4}" -f [int]$ch
+            }
+        }
+    }
+
+    If (-not $skip) {
+        $Tests.Add("    {{ {0} }}," -f ($graphemes -join ", "))
+    }
+}
+
+# Emit Code
+"// Generated by {0} -ExcludeCodepoints {1}" -f $MyInvocation.MyCommand.Name, ($ExcludeCodepoints -join ",")
+"// from {0}." -f $Lines[0].TrimStart("# ")
+"static constexpr GraphemeBreakTest graphemeBreakTests[] = {"
+$Tests
+"};"